@@ -19,6 +19,10 @@
 // Author S.Arcelli
 // silvia.Arcelli@cern.ch
 
+#include <TBits.h>
+#include <TH1.h>
+#include <TArrayD.h>
+#include <TObjArray.h>
 #include "AliCFCutBase.h"
 
 
@@ -54,3 +58,65 @@ AliCFCutBase::AliCFCutBase(const AliCFCutBase& obj):
   // Copy Constructor
   //
 }
+
+//___________________________________________________________________________
+Int_t AliCFCutBase::IsSelectedBatch(const TObjArray *objects, TBits &accepted)
+{
+  //
+  // Selection of all the objects of an array (e.g. the tracks of an event):
+  // bit i of accepted is set if object i is selected, returns the number of
+  // selected objects. Cut classes can override it with a columnar evaluation
+  //
+  accepted.ResetAllBits();
+  Int_t nSelected = 0;
+  const Int_t nObjects = objects ? objects->GetEntriesFast() : 0;
+  for (Int_t i=0; i<nObjects; i++) {
+    if (!IsSelected(objects->UncheckedAt(i))) continue;
+    accepted.SetBitNumber(i);
+    nSelected++;
+  }
+  return nSelected;
+}
+
+//___________________________________________________________________________
+void AliCFCutBase::AddCutStatistics(TH1 *statistics, TH1 *correlation, const UInt_t *failed, Int_t nObjects, Int_t nCuts)
+{
+  //
+  // Cut statistics and correlation of a batch of objects, from the bitmaps of
+  // the failed single selections (bit i set if cut i failed, nCuts<=32).
+  // Same bin contents and errors as one Fill(bit+1) of statistics and
+  // Fill(bit+1,bit2+1) of correlation per object and failed cut(s), but the
+  // counts are added once per call
+  //
+  if (nObjects<=0) return;
+  Long64_t nFailed[32] = {0};
+  Long64_t nFailedBoth[32][32] = {{0}};
+  for (Int_t i=0; i<nObjects; i++) {
+    const UInt_t objFailed = failed[i];
+    if (!objFailed) continue;
+    for (Int_t bit=0; bit<nCuts; bit++) {
+      if (!(objFailed & (1u << bit))) continue;
+      nFailed[bit]++;
+      for (Int_t bit2=bit; bit2<nCuts; bit2++)
+        if (objFailed & (1u << bit2)) nFailedBoth[bit][bit2]++;
+    }
+  }
+  Bool_t filled = kFALSE;
+  for (Int_t bit=0; bit<nCuts; bit++) {
+    if (!nFailed[bit]) continue;
+    filled = kTRUE;
+    Int_t bin = bit+1;
+    statistics->AddBinContent(bin, nFailed[bit]);
+    if (statistics->GetSumw2N()) statistics->GetSumw2()->AddAt(statistics->GetSumw2()->At(bin) + nFailed[bit], bin);
+    for (Int_t bit2=bit; bit2<nCuts; bit2++) {
+      if (!nFailedBoth[bit][bit2]) continue;
+      bin = correlation->GetBin(bit+1,bit2+1);
+      correlation->AddBinContent(bin, nFailedBoth[bit][bit2]);
+      if (correlation->GetSumw2N()) correlation->GetSumw2()->AddAt(correlation->GetSumw2()->At(bin) + nFailedBoth[bit][bit2], bin);
+    }
+  }
+  if (filled) {
+    statistics->ResetStats();
+    correlation->ResetStats();
+  }
+}
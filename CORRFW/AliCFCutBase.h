@@ -22,7 +22,9 @@
 
 #include <AliAnalysisCuts.h>
 class TBits;
+class TH1;
 class TList;
+class TObjArray;
 //___________________________________________________________________________
 class AliCFCutBase : public AliAnalysisCuts
 {
@@ -35,10 +37,12 @@ class AliCFCutBase : public AliAnalysisCuts
   virtual void SetQAOn(TList* list) {fIsQAOn=kTRUE; AddQAHistograms(list);} //QA flag setter
   virtual void  SetMCEventInfo(const TObject *) {} //Pass pointer to MC event
   virtual void SetRecEventInfo(const TObject *) {} //Pass pointer to reconstructed event
+  virtual Int_t IsSelectedBatch(const TObjArray *objects, TBits &accepted); //selection of all objects of an array
   
  protected:
   Bool_t fIsQAOn;//qa checking on/off
   virtual void AddQAHistograms(TList*) {;}; //QA Histos
+  static void AddCutStatistics(TH1 *statistics, TH1 *correlation, const UInt_t *failed, Int_t nObjects, Int_t nCuts); //cut statistics of a batch
 
   ClassDef(AliCFCutBase, 1); // Base class for Correction Framework Cuts
 };
@@ -21,6 +21,8 @@
 // efficiency calculation.
 // prototype version by S.Arcelli silvia.arcelli@cern.ch
 ///////////////////////////////////////////////////////////////////////////
+#include <TBits.h>
+#include <TObjArray.h>
 #include "AliCFCutBase.h"
 #include "AliCFManager.h"
 
@@ -115,6 +117,46 @@ Bool_t AliCFManager::CheckParticleCuts(Int_t isel, TObject *obj, const TString
   return kTRUE;
 }
 
+//_____________________________________________________________________________
+Int_t AliCFManager::CheckParticleCutsBatch(Int_t isel, const TObjArray *objects, TBits &accepted, const TString &selcuts) const {
+  //
+  // check which objects of the array pass particle-level selection isel, with
+  // AliCFCutBase::IsSelectedBatch. As in CheckParticleCuts, each cut only sees
+  // the objects accepted by the previous ones. Returns the number of accepted objects
+  //
+
+  const Int_t nObjects = objects ? objects->GetEntriesFast() : 0;
+  if(isel>=fNStepPart){
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepPart));
+    return accepted.CountBits();
+  }
+  if(!fPartCutList[isel] || !nObjects)return accepted.CountBits();
+
+  TObjArray selected(nObjects);
+  Int_t *index = new Int_t[nObjects];
+  TBits cutAccepted(nObjects);
+  TObjArrayIter iter(fPartCutList[isel]);
+  AliCFCutBase *cut = 0;
+  while ( (cut = (AliCFCutBase*)iter.Next()) ) {
+    TString cutName=cut->GetName();
+    if(!CompareStrings(cutName,selcuts)) continue;
+    // the objects still accepted
+    selected.Clear();
+    Int_t nSelected=0;
+    for(Int_t i=0; i<nObjects; i++){
+      if(!accepted.TestBitNumber(i)) continue;
+      index[nSelected]=i;
+      selected.AddAt(objects->UncheckedAt(i),nSelected++);
+    }
+    if(!nSelected) break;
+    cut->IsSelectedBatch(&selected,cutAccepted);
+    for(Int_t i=0; i<nSelected; i++)
+      if(!cutAccepted.TestBitNumber(i)) accepted.SetBitNumber(index[i],kFALSE);
+  }
+  delete [] index;
+  return accepted.CountBits();
+}
+
 //_____________________________________________________________________________
 Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, const TString  &selcuts) const{
   //
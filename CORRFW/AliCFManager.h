@@ -28,6 +28,9 @@
 #include "AliCFContainer.h"
 #include "AliLog.h"
 
+class TBits;
+class TObjArray;
+
 //____________________________________________________________________________
 class AliCFManager : public TNamed 
 {
@@ -115,6 +118,9 @@ class AliCFManager : public TNamed
  
   virtual Bool_t CheckEventCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
   virtual Bool_t CheckParticleCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
+  //same for all objects of an array (e.g. the tracks of an event): only the objects
+  //with their bit set in accepted are checked, the bits of the rejected ones are cleared
+  virtual Int_t CheckParticleCutsBatch(Int_t isel, const TObjArray *objects, TBits &accepted, const TString &selcuts="all") const;
 
  private:
   
@@ -52,6 +52,7 @@
 #include <TDirectory.h>
 #include <TH2.h>
 #include <TBits.h>
+#include <TObjArray.h>
 
 #include <AliESDtrack.h>
 #include <AliAODTrack.h>
@@ -101,7 +102,11 @@ AliCFTrackIsPrimaryCuts::AliCFTrackIsPrimaryCuts() :
   fhBinLimDcaXYnorm(0x0),
   fhBinLimDcaZnorm(0x0),
   fhBinLimSigmaDcaXY(0x0),
-  fhBinLimSigmaDcaZ(0x0)
+  fhBinLimSigmaDcaZ(0x0),
+  fBatchValues(),
+  fBatchFailedCuts(),
+  fBatchIndex(),
+  fBatchIsESD()
 {
   //
   // Default constructor
@@ -147,7 +152,11 @@ AliCFTrackIsPrimaryCuts::AliCFTrackIsPrimaryCuts(const Char_t* name, const Char_
   fhBinLimDcaXYnorm(0x0),
   fhBinLimDcaZnorm(0x0),
   fhBinLimSigmaDcaXY(0x0),
-  fhBinLimSigmaDcaZ(0x0)
+  fhBinLimSigmaDcaZ(0x0),
+  fBatchValues(),
+  fBatchFailedCuts(),
+  fBatchIndex(),
+  fBatchIsESD()
 {
   //
   // Constructor
@@ -193,7 +202,11 @@ AliCFTrackIsPrimaryCuts::AliCFTrackIsPrimaryCuts(const AliCFTrackIsPrimaryCuts&
   fhBinLimDcaXYnorm(c.fhBinLimDcaXYnorm),
   fhBinLimDcaZnorm(c.fhBinLimDcaZnorm),
   fhBinLimSigmaDcaXY(c.fhBinLimSigmaDcaXY),
-  fhBinLimSigmaDcaZ(c.fhBinLimSigmaDcaZ)
+  fhBinLimSigmaDcaZ(c.fhBinLimSigmaDcaZ),
+  fBatchValues(),
+  fBatchFailedCuts(),
+  fBatchIndex(),
+  fBatchIsESD()
 {
   //
   // copy constructor
@@ -626,6 +639,134 @@ Bool_t AliCFTrackIsPrimaryCuts::IsSelected(TObject* obj) {
   return kTRUE;
 }
 //__________________________________________________________________________________
+namespace {
+  // columns of IsSelectedBatch
+  enum { kBatchDcaXY=0, kBatchDcaZ, kBatchSigmaDcaXY, kBatchSigmaDcaZ, kBatchNSigma, kBatchKinkIndex, kNBatchColumns };
+}
+//__________________________________________________________________________________
+Int_t AliCFTrackIsPrimaryCuts::IsSelectedBatch(const TObjArray *objects, TBits &accepted) {
+  //
+  // selection of all tracks of an array, same decisions and QA histograms
+  // as IsSelected for each track:
+  // the impact parameters are computed once per track (GetDCA) and stored in
+  // columns, each single selection is applied to whole columns and the cut
+  // statistics are added to the QA histograms once per call
+  //
+  accepted.ResetAllBits();
+  const Int_t nObjects = objects ? objects->GetEntriesFast() : 0;
+  if (!nObjects) return 0;
+
+  // all cuts fail for objects which are no ESD or AOD track (as in SelectionBitMap)
+  const UInt_t allCuts = (1u << kNCuts) - 1;
+  fBatchIndex.clear();
+  fBatchIsESD.clear();
+  fBatchFailedCuts.clear();
+  fBatchValues.assign(kNBatchColumns*nObjects, 0.);
+  Double_t *values = fBatchValues.data();
+  for (Int_t i=0; i<nObjects; i++) {
+    TObject *obj = objects->UncheckedAt(i);
+    if (!obj) continue;
+    const Int_t iTrack = fBatchIndex.size();
+    fBatchIndex.push_back(i);
+    fBatchIsESD.push_back(kFALSE);
+    fBatchFailedCuts.push_back(allCuts);
+    if (!obj->InheritsFrom("AliVParticle")) {
+      AliError("object must derived from AliVParticle !");
+      continue;
+    }
+    AliESDtrack * esdTrack = dynamic_cast<AliESDtrack*>(obj);
+    AliAODTrack * aodTrack = dynamic_cast<AliAODTrack*>(obj);
+    if (!(esdTrack || aodTrack)) {
+      AliError("object must be an ESDtrack or an AODtrack !");
+      continue;
+    }
+    const Bool_t isESDTrack = esdTrack && strcmp(obj->ClassName(),"AliESDtrack") == 0;
+    const Bool_t isAODTrack = aodTrack && strcmp(obj->ClassName(),"AliAODTrack") == 0;
+    fBatchIsESD[iTrack] = isESDTrack;
+
+    // fDCA keeps the values of the previous track for other track classes, as in SelectionBitMap
+    if (isESDTrack) GetDCA(esdTrack);
+    if (isAODTrack) GetDCA(aodTrack);
+    values[kBatchDcaXY*nObjects + iTrack] = fDCA[0];
+    values[kBatchDcaZ*nObjects + iTrack] = fDCA[1];
+    values[kBatchSigmaDcaXY*nObjects + iTrack] = fDCA[2];
+    values[kBatchSigmaDcaZ*nObjects + iTrack] = fDCA[3];
+    values[kBatchNSigma*nObjects + iTrack] = fDCA[5];
+    values[kBatchKinkIndex*nObjects + iTrack] = esdTrack ? esdTrack->GetKinkIndex(0) : 0;
+
+    // the AOD track type is not kept in a column
+    Bool_t typeOK = !isAODTrack || fAODType==AliAODTrack::kUndef || fAODType == aodTrack->GetType();
+    fBatchFailedCuts[iTrack] = (UInt_t)!typeOK << (kNCuts-1);
+  }
+  const Int_t nTracks = fBatchIndex.size();
+  UInt_t *failed = fBatchFailedCuts.data();
+  const Double_t *dcaXY = values + kBatchDcaXY*nObjects;
+  const Double_t *dcaZ = values + kBatchDcaZ*nObjects;
+  const Double_t *sigmaDcaXY = values + kBatchSigmaDcaXY*nObjects;
+  const Double_t *sigmaDcaZ = values + kBatchSigmaDcaZ*nObjects;
+  const Double_t *nSigma = values + kBatchNSigma*nObjects;
+  const Double_t *kinkIndex = values + kBatchKinkIndex*nObjects;
+
+  // single selections in the order of the bits of SelectionBitMap, with the same
+  // single precision of the absolute and 2D distances; all cuts pass without dca info
+  const Bool_t useMin2D = fMinDCAToVertexXY>0 && fMinDCAToVertexZ>0;
+  const Bool_t useMax2D = fMaxDCAToVertexXY>0 && fMaxDCAToVertexZ>0;
+  for (Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+    if (failed[iTrack] == allCuts) continue;
+    const Bool_t dcaInfo = dcaXY[iTrack]>-990. && dcaZ[iTrack]>-990.;
+    if (!dcaInfo) continue;
+    const Float_t bxy = TMath::Abs(dcaXY[iTrack]);
+    const Float_t bz  = TMath::Abs(dcaZ[iTrack]);
+    UInt_t trackFailed = 0;
+    if (fDCAToVertex2D) {
+      Float_t b2Dmin = 0, b2Dmax = 0;
+      if (useMin2D) b2Dmin = dcaXY[iTrack]*dcaXY[iTrack]/fMinDCAToVertexXY/fMinDCAToVertexXY + dcaZ[iTrack]*dcaZ[iTrack]/fMinDCAToVertexZ/fMinDCAToVertexZ;
+      if (useMax2D) b2Dmax = dcaXY[iTrack]*dcaXY[iTrack]/fMaxDCAToVertexXY/fMaxDCAToVertexXY + dcaZ[iTrack]*dcaZ[iTrack]/fMaxDCAToVertexZ/fMaxDCAToVertexZ;
+      trackFailed |= (UInt_t)!((TMath::Sqrt(b2Dmin) > 1) & (TMath::Sqrt(b2Dmax) < 1)) << 2;
+    }
+    else {
+      trackFailed |= (UInt_t)!((bxy >= fMinDCAToVertexXY) & (bxy <= fMaxDCAToVertexXY));
+      trackFailed |= (UInt_t)!((bz >= fMinDCAToVertexZ) & (bz <= fMaxDCAToVertexZ)) << 1;
+    }
+    trackFailed |= (UInt_t)!((nSigma[iTrack] >= fNSigmaToVertexMin) & (nSigma[iTrack] <= fNSigmaToVertexMax)) << 3;
+    trackFailed |= (UInt_t)!(sigmaDcaXY[iTrack] < fSigmaDCAxy) << 4;
+    trackFailed |= (UInt_t)!(sigmaDcaZ[iTrack] < fSigmaDCAz) << 5;
+    trackFailed |= (UInt_t)(fRequireSigmaToVertex && !(nSigma[iTrack] >= 0)) << 6;
+    trackFailed |= (UInt_t)(!fAcceptKinkDaughters && kinkIndex[iTrack] > 0) << 7;
+    failed[iTrack] |= trackFailed;
+  }
+
+  Int_t nSelected = 0;
+  for (Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+    if (failed[iTrack]) continue;
+    accepted.SetBitNumber(fBatchIndex[iTrack]);
+    nSelected++;
+  }
+  if (!fIsQAOn) return nSelected;
+
+  // QA histograms before and after the cuts, as in FillHistograms (ESD tracks only)
+  const UChar_t *isESD = fBatchIsESD.data();
+  for (Int_t iStep=0; iStep<kNStepQA; iStep++) {
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+      if (!isESD[iTrack] || (iStep && failed[iTrack])) continue;
+      fhQA[kDcaZ][iStep]->Fill(dcaZ[iTrack]);
+      fhQA[kDcaXY][iStep]->Fill(dcaXY[iTrack]);
+      fhDcaXYvsDcaZ[iStep]->Fill(dcaZ[iTrack],dcaXY[iTrack]);
+      fhQA[kSigmaDcaXY][iStep]->Fill(sigmaDcaXY[iTrack]);
+      fhQA[kSigmaDcaZ][iStep]->Fill(sigmaDcaZ[iTrack]);
+      fhQA[kDcaZnorm][iStep]->Fill(dcaZ[iTrack]);
+      fhQA[kDcaXYnorm][iStep]->Fill(dcaXY[iTrack]);
+      fhQA[kCutNSigmaToVertex][iStep]->Fill(nSigma[iTrack]);
+      fhQA[kCutRequireSigmaToVertex][iStep]->Fill((nSigma[iTrack]<0 && fRequireSigmaToVertex) ? 0. : 1.);
+      fhQA[kCutAcceptKinkDaughters][iStep]->Fill((!fAcceptKinkDaughters && kinkIndex[iTrack]>0) ? 0. : 1.);
+    }
+  }
+
+  // cut statistics and correlation
+  AddCutStatistics(fhCutStatistics, fhCutCorrelation, failed, nTracks, kNCuts);
+  return nSelected;
+}
+//__________________________________________________________________________________
 void AliCFTrackIsPrimaryCuts::SetHistogramBins(Int_t index, Int_t nbins, Double_t *bins)
 {
   //
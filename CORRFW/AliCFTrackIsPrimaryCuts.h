@@ -51,6 +51,7 @@
 #ifndef ALICFTRACKISPRIMARYCUTS_H
 #define ALICFTRACKISPRIMARYCUTS_H
 
+#include <vector>
 #include "AliCFCutBase.h"
 #include "AliAODTrack.h"
 #include <TH2.h>
@@ -72,6 +73,7 @@ class AliCFTrackIsPrimaryCuts : public AliCFCutBase
 
   Bool_t IsSelected(TObject* obj);
   Bool_t IsSelected(TList* /*list*/) {return kTRUE;}
+  Int_t IsSelectedBatch(const TObjArray *objects, TBits &accepted);
 
   // cut value setter
   void UseSPDvertex(Bool_t b=kFALSE);
@@ -173,7 +175,13 @@ class AliCFTrackIsPrimaryCuts : public AliCFCutBase
   Double_t *fhBinLimSigmaDcaXY; //[fhNBinsSigmaDcaXY] bin limits: impact parameter in transverse plane
   Double_t *fhBinLimSigmaDcaZ; //[fhNBinsSigmaDcaZ] bin limits: impact parameter along beam axis
 
-  ClassDef(AliCFTrackIsPrimaryCuts,3);
+  // buffers of IsSelectedBatch
+  std::vector<Double_t> fBatchValues;	//! impact parameters and kink index, one column per quantity
+  std::vector<UInt_t> fBatchFailedCuts;	//! bitmap of the failed single selections per track
+  std::vector<Int_t> fBatchIndex;	//! index of the track in the input array
+  std::vector<UChar_t> fBatchIsESD;	//! track is an AliESDtrack
+
+  ClassDef(AliCFTrackIsPrimaryCuts,4);
 };
 
 #endif
@@ -48,6 +48,7 @@
 #include <TDirectory.h>
 #include <TH2.h>
 #include <TBits.h>
+#include <TObjArray.h>
 
 #include <AliVParticle.h>
 #include <AliLog.h>
@@ -96,7 +97,10 @@ AliCFTrackKineCuts::AliCFTrackKineCuts() :
   fhBinLimEta(0x0),
   fhBinLimRapidity(0x0),
   fhBinLimPhi(0x0),
-  fhBinLimCharge(0x0)
+  fhBinLimCharge(0x0),
+  fBatchValues(),
+  fBatchFailedCuts(),
+  fBatchIndex()
 {
   //
   // Default constructor
@@ -144,7 +148,10 @@ AliCFTrackKineCuts::AliCFTrackKineCuts(const Char_t* name, const Char_t* title)
   fhBinLimEta(0x0),
   fhBinLimRapidity(0x0),
   fhBinLimPhi(0x0),
-  fhBinLimCharge(0x0)
+  fhBinLimCharge(0x0),
+  fBatchValues(),
+  fBatchFailedCuts(),
+  fBatchIndex()
 {
   //
   // Constructor
@@ -192,7 +199,10 @@ AliCFTrackKineCuts::AliCFTrackKineCuts(const AliCFTrackKineCuts& c) :
   fhBinLimEta(c.fhBinLimEta),
   fhBinLimRapidity(c.fhBinLimRapidity),
   fhBinLimPhi(c.fhBinLimPhi),
-  fhBinLimCharge(c.fhBinLimCharge)
+  fhBinLimCharge(c.fhBinLimCharge),
+  fBatchValues(),
+  fBatchFailedCuts(),
+  fBatchIndex()
 {
   //
   // copy constructor
@@ -431,6 +441,85 @@ Bool_t AliCFTrackKineCuts::IsSelected(TObject* obj) {
   return kTRUE;
 }
 //__________________________________________________________________________________
+Int_t AliCFTrackKineCuts::IsSelectedBatch(const TObjArray *objects, TBits &accepted) {
+  //
+  // selection of all particles of an array, same decisions and QA histograms
+  // as IsSelected for each particle:
+  // the particle quantities are extracted once into columns, each single
+  // selection is applied to a whole column and the cut statistics are
+  // counted and added to the QA histograms once per call
+  //
+  accepted.ResetAllBits();
+  const Int_t nObjects = objects ? objects->GetEntriesFast() : 0;
+  if (!nObjects) return 0;
+
+  // columns of the particle quantities, objects which are no AliVParticle are rejected
+  fBatchIndex.clear();
+  fBatchValues.resize(kNHist*nObjects);
+  for (Int_t i=0; i<nObjects; i++) {
+    TObject *obj = objects->UncheckedAt(i);
+    if (!obj) continue;
+    if (!obj->InheritsFrom("AliVParticle")) AliError("object must derived from AliVParticle !");
+    AliVParticle* particle = dynamic_cast<AliVParticle *>(obj);
+    if ( !particle ) continue;
+    const Int_t iTrack = fBatchIndex.size();
+    fBatchIndex.push_back(i);
+    fBatchValues[kCutP*nObjects + iTrack] = particle->P();
+    fBatchValues[kCutPt*nObjects + iTrack] = particle->Pt();
+    fBatchValues[kCutPx*nObjects + iTrack] = particle->Px();
+    fBatchValues[kCutPy*nObjects + iTrack] = particle->Py();
+    fBatchValues[kCutPz*nObjects + iTrack] = particle->Pz();
+    fBatchValues[kCutRapidity*nObjects + iTrack] = particle->Y();
+    fBatchValues[kCutEta*nObjects + iTrack] = particle->Eta();
+    fBatchValues[kCutPhi*nObjects + iTrack] = particle->Phi();
+    fBatchValues[kCutCharge*nObjects + iTrack] = particle->Charge();
+  }
+  const Int_t nTracks = fBatchIndex.size();
+
+  // single selections in the order of the bits of SelectionBitMap
+  const Int_t kNRangeCuts = 8;
+  const Int_t column[kNRangeCuts] = {kCutP, kCutPt, kCutPx, kCutPy, kCutPz, kCutEta, kCutRapidity, kCutPhi};
+  const Double_t rangeMin[kNRangeCuts] = {fMomentumMin, fPtMin, fPxMin, fPyMin, fPzMin, fEtaMin, fRapidityMin, fPhiMin};
+  const Double_t rangeMax[kNRangeCuts] = {fMomentumMax, fPtMax, fPxMax, fPyMax, fPzMax, fEtaMax, fRapidityMax, fPhiMax};
+  fBatchFailedCuts.assign(nTracks, 0);
+  UInt_t *failed = fBatchFailedCuts.data();
+  for (Int_t iCutBit=0; iCutBit<kNRangeCuts; iCutBit++) {
+    const Double_t *values = fBatchValues.data() + column[iCutBit]*nObjects;
+    const Double_t min = rangeMin[iCutBit], max = rangeMax[iCutBit];
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++)
+      failed[iTrack] |= (UInt_t)!((values[iTrack] >= min) & (values[iTrack] <= max)) << iCutBit;
+  }
+  const Double_t *charge = fBatchValues.data() + kCutCharge*nObjects;
+  if (fCharge < 10) {
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++)
+      failed[iTrack] |= (UInt_t)(charge[iTrack] != fCharge) << kNRangeCuts;
+  }
+  if (fRequireIsCharged) {
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++)
+      failed[iTrack] |= (UInt_t)(charge[iTrack] == 0) << (kNRangeCuts+1);
+  }
+
+  Int_t nSelected = 0;
+  for (Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+    if (failed[iTrack]) continue;
+    accepted.SetBitNumber(fBatchIndex[iTrack]);
+    nSelected++;
+  }
+  if (!fIsQAOn) return nSelected;
+
+  // QA histograms before and after the cuts
+  for (Int_t iHist=0; iHist<kNHist; iHist++) {
+    const Double_t *values = fBatchValues.data() + iHist*nObjects;
+    if (nTracks) fhQA[iHist][0]->FillN(nTracks, values, 0);
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++)
+      if (!failed[iTrack]) fhQA[iHist][1]->Fill(values[iTrack]);
+  }
+
+  // cut statistics and correlation
+  AddCutStatistics(fhCutStatistics, fhCutCorrelation, failed, nTracks, kNCuts);
+  return nSelected;
+}
+//__________________________________________________________________________________
 void AliCFTrackKineCuts::SetHistogramBins(Int_t index, Int_t nbins, Double_t *bins)
 {
   //
@@ -47,6 +47,7 @@
 #ifndef ALICFTRACKKINECUTS_H
 #define ALICFTRACKKINECUTS_H
 
+#include <vector>
 #include "AliCFCutBase.h"
 
 class TH2 ;
@@ -65,6 +66,7 @@ class AliCFTrackKineCuts : public AliCFCutBase
 
   Bool_t IsSelected(TObject* obj);
   Bool_t IsSelected(TList* /*list*/) {return kTRUE;}
+  Int_t IsSelectedBatch(const TObjArray *objects, TBits &accepted);
 
   // cut value setter
   void SetMomentumRange(Double_t momentumMin=0., Double_t momentumMax=1e99) {fMomentumMin=momentumMin; fMomentumMax=momentumMax;}
@@ -156,7 +158,12 @@ class AliCFTrackKineCuts : public AliCFCutBase
   Double_t *fhBinLimPhi;	//[fhNBinsPhi] bin limits: phi
   Double_t *fhBinLimCharge;	//[fhNBinsCharge] bin limits: charge
 
-  ClassDef(AliCFTrackKineCuts,2);
+  // buffers of IsSelectedBatch
+  std::vector<Double_t> fBatchValues;	//! track quantities, one column per QA histogram index
+  std::vector<UInt_t> fBatchFailedCuts;	//! bitmap of the failed single selections per track
+  std::vector<Int_t> fBatchIndex;	//! index of the track in the input array
+
+  ClassDef(AliCFTrackKineCuts,3);
 };
 
 #endif
@@ -50,6 +50,7 @@
 #include <TDirectory.h>
 #include <TH2.h>
 #include <TBits.h>
+#include <TObjArray.h>
 
 #include <AliESDtrack.h>
 #include <AliESDtrackCuts.h>
@@ -111,7 +112,11 @@ AliCFTrackQualityCuts::AliCFTrackQualityCuts() :
   fhBinLimCovariance22(0x0),
   fhBinLimCovariance33(0x0),
   fhBinLimCovariance44(0x0),
-  fhBinLimCovariance55(0x0)
+  fhBinLimCovariance55(0x0),
+  fBatchValues(),
+  fBatchFailedCuts(),
+  fBatchIndex(),
+  fBatchIsESD()
 {
   //
   // Default constructor
@@ -170,7 +175,11 @@ AliCFTrackQualityCuts::AliCFTrackQualityCuts(const Char_t* name, const Char_t* t
   fhBinLimCovariance22(0x0),
   fhBinLimCovariance33(0x0),
   fhBinLimCovariance44(0x0),
-  fhBinLimCovariance55(0x0)
+  fhBinLimCovariance55(0x0),
+  fBatchValues(),
+  fBatchFailedCuts(),
+  fBatchIndex(),
+  fBatchIsESD()
 {
   //
   // Constructor
@@ -229,7 +238,11 @@ AliCFTrackQualityCuts::AliCFTrackQualityCuts(const AliCFTrackQualityCuts& c) :
   fhBinLimCovariance22(c.fhBinLimCovariance22),
   fhBinLimCovariance33(c.fhBinLimCovariance33),
   fhBinLimCovariance44(c.fhBinLimCovariance44),
-  fhBinLimCovariance55(c.fhBinLimCovariance55)
+  fhBinLimCovariance55(c.fhBinLimCovariance55),
+  fBatchValues(),
+  fBatchFailedCuts(),
+  fBatchIndex(),
+  fBatchIsESD()
 {
   //
   // copy constructor
@@ -584,6 +597,148 @@ Bool_t AliCFTrackQualityCuts::IsSelected(TObject* obj) {
   return kTRUE;
 }
 //__________________________________________________________________________________
+Int_t AliCFTrackQualityCuts::IsSelectedBatch(const TObjArray *objects, TBits &accepted) {
+  //
+  // selection of all tracks of an array, same decisions and QA histograms
+  // as IsSelected for each track:
+  // the cut quantities are extracted once into columns (as in SelectionBitMap),
+  // each single selection is applied to a whole column and the cut statistics
+  // are added to the QA histograms once per call
+  //
+  accepted.ResetAllBits();
+  const Int_t nObjects = objects ? objects->GetEntriesFast() : 0;
+  if (!nObjects) return 0;
+
+  // columns of the cut quantities, objects which are no ESD or AOD track are rejected
+  fBatchIndex.clear();
+  fBatchIsESD.clear();
+  fBatchFailedCuts.clear();
+  fBatchValues.assign(kNHist*nObjects, 0.);
+  Double_t *values = fBatchValues.data();
+  for (Int_t i=0; i<nObjects; i++) {
+    TObject *obj = objects->UncheckedAt(i);
+    if (!obj) continue;
+    if (!obj->InheritsFrom("AliVParticle")) {
+      AliError("object must derived from AliVParticle !");
+      continue;
+    }
+    AliESDtrack * esdTrack = dynamic_cast<AliESDtrack*>(obj);
+    AliAODTrack * aodTrack = dynamic_cast<AliAODTrack*>(obj);
+    if (!(esdTrack || aodTrack)) {
+      AliError("object must be an ESDtrack or an AODtrack !");
+      continue;
+    }
+    const Bool_t isESDTrack = esdTrack && strcmp(obj->ClassName(),"AliESDtrack") == 0;
+    const Int_t iTrack = fBatchIndex.size();
+    fBatchIndex.push_back(i);
+    fBatchIsESD.push_back(isESDTrack);
+
+    // same types and conversions as in SelectionBitMap
+    Int_t    nClustersTPC = 0;
+    Int_t    nClustersITS = 0 ;
+    Float_t  chi2PerClusterTPC =  0 ;
+    Float_t  chi2PerClusterITS = 0 ;
+    Double_t extCov[15]={0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+    Int_t   nClustersTRD = 0;
+    Int_t   nTrackletsTRD = 0;
+    Float_t chi2PerTrackletTRD = 0;
+    Float_t fractionFoundClustersTPC = 0;
+    if (isESDTrack) {
+      nClustersTRD = esdTrack->GetTRDncls();
+      nTrackletsTRD = esdTrack->GetTRDntracklets();
+      if (nTrackletsTRD != 0) chi2PerTrackletTRD = esdTrack->GetTRDchi2() / Float_t(nTrackletsTRD);
+      nClustersTPC = esdTrack->GetTPCclusters(0x0);
+      nClustersITS = esdTrack->GetITSclusters(0x0);
+      if (nClustersTPC != 0) chi2PerClusterTPC = esdTrack->GetTPCchi2() / Float_t(nClustersTPC);
+      if (nClustersITS != 0) chi2PerClusterITS = esdTrack->GetITSchi2() / Float_t(nClustersITS);
+      esdTrack->GetExternalCovariance(extCov);
+      if (esdTrack->GetTPCNclsF() != 0) fractionFoundClustersTPC = float(nClustersTPC) / float(esdTrack->GetTPCNclsF());
+      values[kCutTrackletTRDpid*nObjects + iTrack] = esdTrack->GetTRDntrackletsPID();
+      values[kCutdEdxClusterTPC*nObjects + iTrack] = esdTrack->GetTPCsignalN();
+    }
+    values[kCutClusterTPC*nObjects + iTrack] = nClustersTPC;
+    values[kCutClusterITS*nObjects + iTrack] = nClustersITS;
+    values[kCutClusterTRD*nObjects + iTrack] = nClustersTRD;
+    values[kCutMinFoundClusterTPC*nObjects + iTrack] = fractionFoundClustersTPC;
+    values[kCutTrackletTRD*nObjects + iTrack] = nTrackletsTRD;
+    values[kCutChi2TPC*nObjects + iTrack] = chi2PerClusterTPC;
+    values[kCutChi2ITS*nObjects + iTrack] = chi2PerClusterITS;
+    values[kCutChi2TRD*nObjects + iTrack] = chi2PerTrackletTRD;
+    values[kCutCovElement11*nObjects + iTrack] = extCov[0];
+    values[kCutCovElement22*nObjects + iTrack] = extCov[2];
+    values[kCutCovElement33*nObjects + iTrack] = extCov[5];
+    values[kCutCovElement44*nObjects + iTrack] = extCov[9];
+    values[kCutCovElement55*nObjects + iTrack] = extCov[14];
+
+    // the status word is not kept in a column
+    const ULong_t status = isESDTrack ? esdTrack->GetStatus() : (aodTrack ? aodTrack->GetStatus() : esdTrack->GetStatus());
+    fBatchFailedCuts.push_back((UInt_t)((status & fStatus) != fStatus) << kCutStatus);
+  }
+  const Int_t nTracks = fBatchIndex.size();
+  UInt_t *failed = fBatchFailedCuts.data();
+  const UChar_t *isESD = fBatchIsESD.data();
+
+  // single selections in the order of the bits of SelectionBitMap
+  const Int_t kNMinCuts = 3, kNMaxCuts = 8;
+  const Int_t minColumn[kNMinCuts] = {kCutClusterTPC, kCutClusterITS, kCutClusterTRD};
+  const Double_t minValue[kNMinCuts] = {(Double_t)fMinNClusterTPC, (Double_t)fMinNClusterITS, fMinNClusterTRD};
+  for (Int_t iCut=0; iCut<kNMinCuts; iCut++) {
+    const Double_t *column = values + minColumn[iCut]*nObjects;
+    const Double_t min = minValue[iCut];
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++)
+      failed[iTrack] |= (UInt_t)!(column[iTrack] >= min) << minColumn[iCut];
+  }
+  const Double_t *clustersTPC = values + kCutClusterTPC*nObjects;
+  if (fMinFoundClusterTPC > 0) {
+    const Double_t *fraction = values + kCutMinFoundClusterTPC*nObjects;
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++)
+      failed[iTrack] |= (UInt_t)!((clustersTPC[iTrack] > 0) & (fraction[iTrack] >= fMinFoundClusterTPC)) << kCutMinFoundClusterTPC;
+  }
+  const Double_t *trackletsTRD = values + kCutTrackletTRD*nObjects;
+  for (Int_t iTrack=0; iTrack<nTracks; iTrack++)
+    failed[iTrack] |= (UInt_t)!(trackletsTRD[iTrack] >= fMinNTrackletTRD) << kCutTrackletTRD;
+  // ESD only cuts
+  const Double_t *trackletsTRDpid = values + kCutTrackletTRDpid*nObjects;
+  const Double_t *dEdxClustersTPC = values + kCutdEdxClusterTPC*nObjects;
+  for (Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+    failed[iTrack] |= (UInt_t)(isESD[iTrack] & !(trackletsTRDpid[iTrack] >= fMinNTrackletTRDpid)) << kCutTrackletTRDpid;
+    failed[iTrack] |= (UInt_t)(isESD[iTrack] & !(dEdxClustersTPC[iTrack] >= fMinNdEdxClusterTPC)) << kCutdEdxClusterTPC;
+  }
+  const Int_t maxColumn[kNMaxCuts] = {kCutChi2TPC, kCutChi2ITS, kCutChi2TRD, kCutCovElement11, kCutCovElement22, kCutCovElement33, kCutCovElement44, kCutCovElement55};
+  const Double_t maxValue[kNMaxCuts] = {fMaxChi2PerClusterTPC, fMaxChi2PerClusterITS, fMaxChi2PerTrackletTRD, fCovariance11Max, fCovariance22Max, fCovariance33Max, fCovariance44Max, fCovariance55Max};
+  for (Int_t iCut=0; iCut<kNMaxCuts; iCut++) {
+    const Double_t *column = values + maxColumn[iCut]*nObjects;
+    const Double_t max = maxValue[iCut];
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++)
+      failed[iTrack] |= (UInt_t)!(column[iTrack] <= max) << maxColumn[iCut];
+  }
+
+  Int_t nSelected = 0;
+  for (Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+    if (failed[iTrack]) continue;
+    accepted.SetBitNumber(fBatchIndex[iTrack]);
+    nSelected++;
+  }
+  if (!fIsQAOn) return nSelected;
+
+  // QA histograms before and after the cuts, as in FillHistograms
+  for (Int_t iHist=0; iHist<kNHist; iHist++) {
+    const Double_t *column = values + iHist*nObjects;
+    const Bool_t esdOnly = iHist == kCutTrackletTRDpid || iHist == kCutdEdxClusterTPC;
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+      if (esdOnly && !isESD[iTrack]) continue;
+      fhQA[iHist][0]->Fill(column[iTrack]);
+      if (failed[iTrack]) continue;
+      if (iHist == kCutMinFoundClusterTPC && !(clustersTPC[iTrack] > 0)) continue;
+      fhQA[iHist][1]->Fill(column[iTrack]);
+    }
+  }
+
+  // cut statistics and correlation
+  AddCutStatistics(fhCutStatistics, fhCutCorrelation, failed, nTracks, kNCuts);
+  return nSelected;
+}
+//__________________________________________________________________________________
 void AliCFTrackQualityCuts::SetHistogramBins(Int_t index, Int_t nbins, Double_t *bins)
 {
   //
@@ -47,6 +47,7 @@
 #ifndef ALICFTRACKQUALITYCUTS_H
 #define ALICFTRACKQUALITYCUTS_H
 
+#include <vector>
 #include "AliCFCutBase.h"
 
 class TH2F;
@@ -67,6 +68,7 @@ class AliCFTrackQualityCuts : public AliCFCutBase
 
   Bool_t IsSelected(TObject* obj);
   Bool_t IsSelected(TList* /*list*/) {return kTRUE;}
+  Int_t IsSelectedBatch(const TObjArray *objects, TBits &accepted);
 
   // cut value setter
   void SetMinNClusterTPC(Int_t cluster=-1)		{fMinNClusterTPC = cluster;}
@@ -179,7 +181,13 @@ class AliCFTrackQualityCuts : public AliCFCutBase
   Double_t *fhBinLimCovariance44;//[fhNBinsCovariance44] bin limits: covariance matrix element 44
   Double_t *fhBinLimCovariance55;//[fhNBinsCovariance55] bin limits: covariance matrix element 55
 
-  ClassDef(AliCFTrackQualityCuts,4);
+  // buffers of IsSelectedBatch
+  std::vector<Double_t> fBatchValues;	//! track quantities, one column per QA histogram index
+  std::vector<UInt_t> fBatchFailedCuts;	//! bitmap of the failed single selections per track
+  std::vector<Int_t> fBatchIndex;	//! index of the track in the input array
+  std::vector<UChar_t> fBatchIsESD;	//! track is an AliESDtrack
+
+  ClassDef(AliCFTrackQualityCuts,5);
 };
 
 #endif
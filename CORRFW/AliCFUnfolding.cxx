@@ -65,6 +65,12 @@
 // If no argument is passed to this function, then the second option   //
 // is used.                                                            //
 //                                                                     //
+// For large multi-dimensional problems ::SetUseMatrixBackend flattens //
+// the response into a list of (measured,true) entries and the spectra //
+// into dense arrays once; the iterations then run as matrix-vector    //
+// products and the random iterations of the error calculation can be  //
+// run on several threads (not available together with smoothing).     //
+//                                                                     //
 // IMPORTANT:                                                          //
 //-----------                                                          //
 // With this approach, the efficiency map must be calculated           //
@@ -92,6 +98,7 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TRandom3.h"
+#include <thread>
 
 
 ClassImp(AliCFUnfolding)
@@ -130,7 +137,9 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fUseMatrixBackend(kFALSE),
+  fNThreads(1)
 {
   //
   // default constructor
@@ -174,7 +183,9 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fUseMatrixBackend(kFALSE),
+  fNThreads(1)
 {
   //
   // named constructor
@@ -350,6 +361,14 @@ void AliCFUnfolding::Unfold() {
   // several iterations are performed until a reasonable chi2 or convergence criterion is reached
   //
 
+  if (fUseMatrixBackend && fNCalcCorrErrors == 0) {
+    if (fUseSmoothing) AliWarning("Smoothing is not available with the matrix backend, using THnSparse bin access");
+    else {
+      UnfoldMatrix();
+      return;
+    }
+  }
+
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
@@ -575,6 +594,272 @@ void AliCFUnfolding::FillDeltaUnfoldedProfile() {
 
 //______________________________________________________________
 
+static Long64_t GetDenseIndex(Int_t nDim, const Int_t* coord, const Int_t* nCells) {
+  //
+  // linear index of a cell (under/overflow included) in a dense N-dim array
+  //
+  Long64_t index = 0;
+  for (Int_t iDim=nDim-1; iDim>=0; iDim--) index = index*nCells[iDim] + coord[iDim];
+  return index;
+}
+
+//______________________________________________________________
+
+static void GetDenseCoordinates(Long64_t index, Int_t nDim, const Int_t* nCells, Int_t* coord) {
+  //
+  // inverse of GetDenseIndex
+  //
+  for (Int_t iDim=0; iDim<nDim; iDim++) {
+    coord[iDim] = index % nCells[iDim];
+    index /= nCells[iDim];
+  }
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::BayesIterations(const std::vector<Long64_t>& entryM, const std::vector<Long64_t>& entryT, const std::vector<Double_t>& cond,
+				      const std::vector<Double_t>& eff, const std::vector<Double_t>& measured,
+				      std::vector<Double_t>& prior, std::vector<Double_t>& unfolded,
+				      std::vector<Double_t>& estMeasured, std::vector<Double_t>& invResponse,
+				      Int_t maxIter, Double_t maxConvergence, Double_t& convergence) {
+  //
+  // Bayesian iterations on flattened arrays : same algebra as
+  // CreateEstMeasured(), CreateInvResponse(), CreateUnfolded() and GetConvergence(),
+  // the conditional matrix being stored as a list of (measured, true, value) entries.
+  // The prior is updated at the end of each iteration.
+  // Returns the iteration at which the convergence criterion is met (maxIter if never met)
+  //
+
+  const Long_t nEntries = cond.size();
+  const Long_t nT = prior.size();
+  std::vector<Double_t> priorTimesEff(nT);
+
+  for (Int_t iIter=0; iIter<maxIter; iIter++) {
+
+    for (Long_t iT=0; iT<nT; iT++) priorTimesEff[iT] = prior[iT]*eff[iT];
+
+    // M(i) = SUM_k { COND(i,k) * T(k) * E (k)}
+    estMeasured.assign(estMeasured.size(),0.);
+    for (Long_t iEntry=0; iEntry<nEntries; iEntry++) {
+      Double_t fill = cond[iEntry] * priorTimesEff[entryT[iEntry]];
+      if (fill>0.) estMeasured[entryM[iEntry]] += fill;
+    }
+
+    // INV(i,j) = COND(i,j) * T(j) * E(j) / M(i)
+    for (Long_t iEntry=0; iEntry<nEntries; iEntry++) {
+      Double_t estMeasuredValue = estMeasured[entryM[iEntry]];
+      invResponse[iEntry] = (estMeasuredValue>0. ? cond[iEntry] * priorTimesEff[entryT[iEntry]] / estMeasuredValue : 0.);
+    }
+
+    // T(i) = SUM_k { INV(i,k) * M(k) } / E(i)
+    unfolded.assign(nT,0.);
+    for (Long_t iEntry=0; iEntry<nEntries; iEntry++) {
+      Double_t effValue = eff[entryT[iEntry]];
+      Double_t fill = (effValue>0. ? invResponse[iEntry] * measured[entryM[iEntry]] / effValue : 0.);
+      if (fill>0.) unfolded[entryT[iEntry]] += fill;
+    }
+
+    convergence = 0.;
+    for (Long_t iT=0; iT<nT; iT++) {
+      if (prior[iT] > 0.) convergence += ((prior[iT]-unfolded[iT])/prior[iT])*((prior[iT]-unfolded[iT])/prior[iT]);
+    }
+    if (maxConvergence>0. && convergence<maxConvergence) return iIter;
+
+    prior = unfolded;
+  }
+  return maxIter;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::UnfoldMatrix() {
+  //
+  // Unfolding and correlated error calculation on flattened arrays.
+  // The response is converted once into a list of (measured cell, true cell, P(M|T)) entries,
+  // the measured, efficiency and prior spectra into dense arrays (under/overflow included).
+  // The bayesian iterations are then matrix-vector products (BayesIterations).
+  // The fNRandomIterations randomized unfoldings of the error calculation are independent :
+  // they are distributed over fNThreads threads, each random iteration using its own TRandom3
+  // seeded from fRandom3, so that the result does not depend on the number of threads.
+  // As in CalculateCorrelatedErrors(), the conditional matrix is not re-computed for the
+  // randomized passes, therefore only efficiency and measured spectra are randomized.
+  // The THnSparse outputs (unfolded, prior, conditional, inverse response, measured estimate,
+  // delta profile) are filled at the end.
+  //
+
+  const Int_t nVar = fNVariables;
+  Int_t* nCellsM = new Int_t[nVar];
+  Int_t* nCellsT = new Int_t[nVar];
+  Long64_t nM = 1, nT = 1;
+  for (Int_t iVar=0; iVar<nVar; iVar++) {
+    nCellsM[iVar] = fResponse->GetAxis(iVar     )->GetNbins()+2;
+    nCellsT[iVar] = fResponse->GetAxis(iVar+nVar)->GetNbins()+2;
+    nM *= nCellsM[iVar];
+    nT *= nCellsT[iVar];
+  }
+
+  // conditional matrix P(M|T) as a list of entries, in the bin order of fConditional
+  const Long_t nEntries = fConditional->GetNbins();
+  std::vector<Long64_t> entryM(nEntries), entryT(nEntries);
+  std::vector<Double_t> cond(nEntries);
+  for (Long_t iBin=0; iBin<nEntries; iBin++) {
+    cond[iBin] = fConditional->GetBinContent(iBin,fCoordinates2N);
+    GetCoordinates();
+    entryM[iBin] = GetDenseIndex(nVar,fCoordinatesN_M,nCellsM);
+    entryT[iBin] = GetDenseIndex(nVar,fCoordinatesN_T,nCellsT);
+  }
+
+  // dense spectra
+  std::vector<Double_t> eff(nT,0.), measured(nM,0.), priorOrig(nT,0.);
+  for (Long_t iBin=0; iBin<fEfficiency->GetNbins(); iBin++) {
+    Double_t val = fEfficiency->GetBinContent(iBin,fCoordinatesN_T);
+    eff[GetDenseIndex(nVar,fCoordinatesN_T,nCellsT)] = val;
+  }
+  for (Long_t iBin=0; iBin<fMeasured->GetNbins(); iBin++) {
+    Double_t val = fMeasured->GetBinContent(iBin,fCoordinatesN_M);
+    measured[GetDenseIndex(nVar,fCoordinatesN_M,nCellsM)] = val;
+  }
+  for (Long_t iBin=0; iBin<fPriorOrig->GetNbins(); iBin++) {
+    Double_t val = fPriorOrig->GetBinContent(iBin,fCoordinatesN_T);
+    priorOrig[GetDenseIndex(nVar,fCoordinatesN_T,nCellsT)] = val;
+  }
+
+  // (index, mean, sigma) of the filled bins of the original efficiency and measured spectra
+  std::vector<Long64_t> effIndex(fEfficiencyOrig->GetNbins()), measIndex(fMeasuredOrig->GetNbins());
+  std::vector<Double_t> effVal  (effIndex.size()),              measVal  (measIndex.size());
+  std::vector<Double_t> effErr  (effIndex.size()),              measErr  (measIndex.size());
+  for (UInt_t iBin=0; iBin<effIndex.size(); iBin++) {
+    effVal[iBin]   = fEfficiencyOrig->GetBinContent(iBin,fCoordinatesN_T);
+    effErr[iBin]   = fEfficiencyOrig->GetBinError(fCoordinatesN_T);
+    effIndex[iBin] = GetDenseIndex(nVar,fCoordinatesN_T,nCellsT);
+  }
+  for (UInt_t iBin=0; iBin<measIndex.size(); iBin++) {
+    measVal[iBin]   = fMeasuredOrig->GetBinContent(iBin,fCoordinatesN_M);
+    measErr[iBin]   = fMeasuredOrig->GetBinError(fCoordinatesN_M);
+    measIndex[iBin] = GetDenseIndex(nVar,fCoordinatesN_M,nCellsM);
+  }
+
+  //
+  // main unfolding
+  //
+  std::vector<Double_t> prior(priorOrig), unfolded(nT,0.), estMeasured(nM,0.), invResponse(nEntries,0.);
+  Double_t convergence = 0.;
+  Int_t iIterBayes = BayesIterations(entryM,entryT,cond,eff,measured,prior,unfolded,estMeasured,invResponse,
+				     fMaxNumIterations,fMaxConvergence,convergence);
+  if (iIterBayes<fMaxNumIterations) {
+    fNRandomIterations = iIterBayes;
+    AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+  }
+
+  // cells of the final unfolded spectrum
+  std::vector<Long64_t> finalIndex;
+  for (Long_t iT=0; iT<nT; iT++) if (unfolded[iT]>0.) finalIndex.push_back(iT);
+  const Long_t nFinal = finalIndex.size();
+
+  //
+  // randomized unfoldings for the error calculation
+  //
+  AliInfo("\n================================================\nFinished bayes iteration, now calculating errors...\n================================================\n");
+  fNCalcCorrErrors = 1;
+
+  const Int_t nRandom = fNRandomIterations;
+  std::vector<UInt_t> seeds(nRandom);
+  for (Int_t iRandom=0; iRandom<nRandom; iRandom++) seeds[iRandom] = 1 + fRandom3->Integer(kMaxUInt-1);
+
+  std::vector<Double_t> delta((Long_t)nRandom*nFinal,0.);
+
+  auto randomIterations = [&](Int_t iThread) {
+    std::vector<Double_t> effRandom(nT), measRandom(nM);
+    std::vector<Double_t> priorRandom(nT), unfoldedRandom(nT), estRandom(nM), invRandom(nEntries);
+    for (Int_t iRandom=iThread; iRandom<nRandom; iRandom+=fNThreads) {
+      TRandom3 random(seeds[iRandom]);
+      effRandom.assign(nT,0.);
+      measRandom.assign(nM,0.);
+      for (UInt_t iBin=0; iBin<effIndex.size();  iBin++) effRandom [effIndex [iBin]] = random.Gaus(effVal [iBin],effErr [iBin]);
+      for (UInt_t iBin=0; iBin<measIndex.size(); iBin++) measRandom[measIndex[iBin]] = random.Gaus(measVal[iBin],measErr[iBin]);
+      priorRandom = priorOrig;
+      Double_t convRandom = 0.;
+      BayesIterations(entryM,entryT,cond,effRandom,measRandom,priorRandom,unfoldedRandom,estRandom,invRandom,
+		      fMaxNumIterations,0.,convRandom);
+      for (Long_t iFinal=0; iFinal<nFinal; iFinal++)
+	delta[(Long_t)iRandom*nFinal+iFinal] = unfolded[finalIndex[iFinal]] - unfoldedRandom[finalIndex[iFinal]];
+    }
+  };
+
+  if (fNThreads>1) {
+    std::vector<std::thread> threads;
+    for (Int_t iThread=0; iThread<fNThreads; iThread++) threads.push_back(std::thread(randomIterations,iThread));
+    for (UInt_t iThread=0; iThread<threads.size(); iThread++) threads[iThread].join();
+  }
+  else randomIterations(0);
+
+  //
+  // THnSparse outputs
+  //
+  Int_t* coord = new Int_t[nVar];
+
+  fUnfolded->Reset();
+  fUnfoldedFinal = (THnSparse*) fUnfolded->Clone();
+  fDeltaUnfoldedP->Reset();
+  fDeltaUnfoldedN->Reset();
+  for (Long_t iFinal=0; iFinal<nFinal; iFinal++) {
+    GetDenseCoordinates(finalIndex[iFinal],nVar,nCellsT,coord);
+    Double_t value = unfolded[finalIndex[iFinal]];
+    fUnfolded->SetBinContent(coord,value);
+    fUnfolded->SetBinError  (coord,0.);
+
+    // running mean of delta and delta^2, in the order of the random iterations (as in FillDeltaUnfoldedProfile)
+    Double_t mean = 0., meanx2 = 0.;
+    for (Int_t iRandom=0; iRandom<nRandom; iRandom++) {
+      Double_t deltaInBin = delta[(Long_t)iRandom*nFinal+iFinal];
+      mean   = (mean  *iRandom + deltaInBin)           / (iRandom+1);
+      meanx2 = (meanx2*iRandom + deltaInBin*deltaInBin) / (iRandom+1);
+    }
+    Double_t sigma = (nRandom > 1 ? TMath::Sqrt((nRandom/(nRandom-1.))*TMath::Abs(meanx2-mean*mean)) : 0.);
+    fUnfoldedFinal->SetBinContent(coord,value);
+    fUnfoldedFinal->SetBinError  (coord,sigma);
+    fDeltaUnfoldedP->SetBinContent(coord,mean);
+    fDeltaUnfoldedP->SetBinError  (coord,meanx2);
+    fDeltaUnfoldedN->SetBinContent(coord,nRandom);
+  }
+
+  if (fPrior) delete fPrior;
+  fPrior = (THnSparse*) fPriorOrig->Clone();
+  fPrior->Reset();
+  fPrior->SetTitle("Prior");
+  for (Long_t iT=0; iT<nT; iT++) {
+    if (prior[iT]<=0.) continue;
+    GetDenseCoordinates(iT,nVar,nCellsT,coord);
+    fPrior->SetBinContent(coord,prior[iT]);
+    fPrior->SetBinError  (coord,0.);
+  }
+
+  fMeasuredEstimate->Reset();
+  for (Long_t iM=0; iM<nM; iM++) {
+    if (estMeasured[iM]<=0.) continue;
+    GetDenseCoordinates(iM,nVar,nCellsM,coord);
+    fMeasuredEstimate->SetBinContent(coord,estMeasured[iM]);
+    fMeasuredEstimate->SetBinError  (coord,0.);
+  }
+
+  // fInverseResponse and fConditional are clones of fResponse : same bin order as the entries
+  for (Long_t iBin=0; iBin<nEntries; iBin++) {
+    if (invResponse[iBin]>0. || fInverseResponse->GetBinContent(iBin)>0.) {
+      fInverseResponse->SetBinContent(iBin,invResponse[iBin]);
+      fInverseResponse->SetBinError  (iBin,0.);
+    }
+  }
+
+  delete [] coord;
+  delete [] nCellsM;
+  delete [] nCellsT;
+
+  fNCalcCorrErrors = 2;
+  AliInfo(Form("\n\n=======================\nFinished at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+}
+
+//______________________________________________________________
+
 void AliCFUnfolding::GetCoordinates() {
   //
   // assign coordinates in Measured and True spaces (dim=N) from coordinates in global space (dim=2N)
@@ -10,6 +10,7 @@
 // Author : renaud.vernet@cern.ch                                     //
 //--------------------------------------------------------------------//
 
+#include <vector>
 #include "TNamed.h"
 #include "THnSparse.h"
 #include "AliLog.h"
@@ -37,6 +38,11 @@ class AliCFUnfolding : public TNamed {
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
 
+  void SetUseMatrixBackend(Bool_t b = kTRUE, Int_t nThreads = 1) { // unfold on flattened arrays instead of THnSparse bin access
+    fUseMatrixBackend = b;                                         // the random iterations for the errors are spread over nThreads threads
+    fNThreads = nThreads > 0 ? nThreads : 1;                       // (not used together with smoothing)
+  }
+
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
     fSmoothFunction=fcn;                                   // the option "opt" is used if "fcn" is specified
@@ -112,6 +118,10 @@ class AliCFUnfolding : public TNamed {
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
 
+  /* flattened (matrix) backend */
+  Bool_t         fUseMatrixBackend;  // Use the dense/sparse-array implementation of the bayesian iterations
+  Int_t          fNThreads;          // Number of threads for the random iterations of the error calculation
+
 
   // functions
   void     Init();                  // initialisation of the internal settings
@@ -132,7 +142,15 @@ class AliCFUnfolding : public TNamed {
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  /* flattened (matrix) backend */
+  void     UnfoldMatrix();              // Unfold + CalculateCorrelatedErrors on flattened arrays
+  static Int_t BayesIterations(const std::vector<Long64_t>& entryM, const std::vector<Long64_t>& entryT, const std::vector<Double_t>& cond,
+                               const std::vector<Double_t>& eff, const std::vector<Double_t>& measured,
+                               std::vector<Double_t>& prior, std::vector<Double_t>& unfolded,
+                               std::vector<Double_t>& estMeasured, std::vector<Double_t>& invResponse,
+                               Int_t maxIter, Double_t maxConvergence, Double_t& convergence); // bayesian iterations as matrix-vector kernels
+
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
@@ -3,10 +3,12 @@
 #include <algorithm>
 #include <array>
 using std::array;
+#include <functional>
 #include <memory>
 using std::string;
 using std::vector;
 
+#include <TBufferFile.h>
 #include <TClonesArray.h>
 #include <TH1D.h>
 #include <TH1I.h>
@@ -35,8 +37,62 @@ using std::vector;
 #include <AliLog.h>
 
 ClassImp(AliEventCutsContainer);
+ClassImp(AliEventCutsResultCache);
 ClassImp(AliEventCuts);
 
+namespace {
+  /// Combine the hash of a value with the seed (as boost::hash_combine)
+  template<typename T> void HashCombine(unsigned long &seed, const T &value) {
+    seed ^= std::hash<T>()(value) + 0x9e3779b9ul + (seed << 6) + (seed >> 2);
+  }
+}
+
+/// Get the cache attached to the event, creating it if needed. The cached results are dropped
+/// if the event changed since they were stored.
+///
+AliEventCutsResultCache* AliEventCutsResultCache::GetCache(AliVEvent *ev) {
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr) return nullptr;
+
+  AliEventCutsResultCache* cache = static_cast<AliEventCutsResultCache*>(ev->FindListObject("AliEventCutsResultCache"));
+  if (!cache) {
+    cache = new AliEventCutsResultCache;
+    ev->AddObject(cache);
+  }
+
+  const Long64_t entry = mgr->GetCurrentEntry();
+  const unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
+  const int run = ev->GetRunNumber();
+  const int ntracks = ev->GetNumberOfTracks();
+  if (cache->fEntry != entry || cache->fEventId != evid || cache->fRunNumber != run || cache->fNTracks != ntracks) {
+    cache->fEntry = entry;
+    cache->fEventId = evid;
+    cache->fRunNumber = run;
+    cache->fNTracks = ntracks;
+    cache->fConfigurations.clear();
+    cache->fFlags.clear();
+    cache->fCentPercentiles.clear();
+    cache->fDeltaZ.clear();
+  }
+  return cache;
+}
+
+/// Index of the result for the given configuration, -1 if it is not cached
+///
+int AliEventCutsResultCache::Find(unsigned long configuration) const {
+  for (size_t iC = 0; iC < fConfigurations.size(); ++iC)
+    if (fConfigurations[iC] == configuration) return iC;
+  return -1;
+}
+
+void AliEventCutsResultCache::Add(unsigned long configuration, unsigned long flag, const float *centPercentiles, double deltaZ) {
+  fConfigurations.push_back(configuration);
+  fFlags.push_back(flag);
+  fCentPercentiles.push_back(centPercentiles[0]);
+  fCentPercentiles.push_back(centPercentiles[1]);
+  fDeltaZ.push_back(deltaZ);
+}
+
 
 
 /// Standard constructor with null selection
@@ -103,6 +159,8 @@ AliEventCuts::AliEventCuts(bool saveplots) : TList(),
   fSelectInelGt0{false},
   fOverrideInelGt0{false},
   fOverrideCentralityFramework{false},
+  fUseSharedSelectionCache{true},
+  fUtilsHash{0ul},
   fTimeRangeCut{},
   fEMCALLEDEventsCut{},
   fCutStats{nullptr},
@@ -146,12 +204,91 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     if (fUseTimeRangeCut) {
       fTimeRangeCut.InitFromRunNumber(fCurrentRun);
     }
+    /// The pile-up settings of the analysis utils are only accessible through the streamer
+    TBufferFile utilsBuffer(TBuffer::kWrite);
+    utilsBuffer.WriteObjectAny(&fUtils, AliAnalysisUtils::Class());
+    fUtilsHash = std::hash<string>()(string(utilsBuffer.Buffer(), utilsBuffer.Length()));
   }
 
   if (fSavePlots && !this->Last()) {
     AddQAplotsToList();
   }
 
+  /// The instances with the same configuration share the selection result of the event. The configuration
+  /// of the EMCal LED events cut is not part of the hash, so in that case the cuts are always evaluated.
+  AliEventCutsResultCache* cache = (fUseSharedSelectionCache && !fUseEMCALLEDEventsCut) ? AliEventCutsResultCache::GetCache(ev) : nullptr;
+  const unsigned long configuration = cache ? ConfigurationHash() : 0ul;
+  const int cached = cache ? cache->Find(configuration) : -1;
+  const int ntrkl = ev->GetMultiplicity()->GetNumberOfTracklets();
+  double dz = 0.;
+  if (cached >= 0) {
+    fFlag = cache->fFlags[cached];
+    fCentPercentiles[0] = cache->fCentPercentiles[2 * cached];
+    fCentPercentiles[1] = cache->fCentPercentiles[2 * cached + 1];
+    dz = cache->fDeltaZ[cached];
+    fPrimaryVertex = const_cast<AliVVertex*>(bool(fFlag & BIT(kVertexTracks)) ? ev->GetPrimaryVertex() : ev->GetPrimaryVertexSPD());
+    if (fUseMultiplicityDependentPileUpCuts) SetMultiplicityDependentPileUpCuts(ntrkl);
+    /// The multiplicities are cached in the AliEventCutsContainer attached to the event
+    if (fUseVariablesCorrelationCuts || fTOFvsFB32[0]) ComputeTrackMultiplicity(ev);
+  } else {
+    dz = ComputeSelection(ev);
+    if (cache) cache->Add(configuration, fFlag, fCentPercentiles, dz);
+  }
+
+  const AliVVertex* vtx = fPrimaryVertex;
+  bool allcuts = TESTBIT(fFlag,kAllCuts);
+  if (fCutStats) {
+    for (int iCut = kNoCuts; iCut <= kAllCuts; ++iCut) {
+      if (TESTBIT(fFlag,iCut)) {
+        fCutStats->Fill(iCut);
+        if (TESTBIT(fFlag,kTrigger)) {
+          fCutStatsAfterTrigger->Fill(iCut);
+        }
+        if (TESTBIT(fFlag,kMultiplicity)) {
+          fCutStatsAfterMultSelection->Fill(iCut);
+        }
+      }
+    }
+  }
+
+  /// Filling normalisation histogram
+  array <NormMask,5> norm_masks {
+    kAnyEvent,
+    kTriggeredEvent,
+    kPassesNonVertexRelatedSelections,
+    kHasReconstructedVertex,
+    kPassesAllCuts
+  };
+  for (int iC = 0; iC < 5; ++iC) {
+    if (CheckNormalisationMask(norm_masks[iC])) {
+      if (fNormalisationHist) {
+        fNormalisationHist->Fill(iC);
+      }
+    }
+  }
+
+  /// Filling the monitoring histograms (first iteration always filled, second iteration only for selected events.
+  for (int befaft = 0; befaft < 2; ++befaft) {
+    if (fCentrality[befaft]) fCentrality[befaft]->Fill(fCentPercentiles[0]);
+    if (fEstimCorrelation[befaft]) fEstimCorrelation[befaft]->Fill(fCentPercentiles[1],fCentPercentiles[0]);
+    if (fMultCentCorrelation[befaft]) fMultCentCorrelation[befaft]->Fill(fCentPercentiles[0],ntrkl);
+    if (fVtz[befaft]) fVtz[befaft]->Fill(vtx->GetZ());
+    if (fDeltaTrackSPDvtz[befaft]) fDeltaTrackSPDvtz[befaft]->Fill(dz);
+    if (fTOFvsFB32[befaft]) fTOFvsFB32[befaft]->Fill(fContainer.fMultTrkFB32,fContainer.fMultTrkFB32TOF);
+    if (fTPCvsAll[befaft])  fTPCvsAll[befaft]->Fill(fContainer.fMultTrkTPC,float(fContainer.fMultESD) - fESDvsTPConlyLinearCut[1] * fContainer.fMultTrkTPC);
+    if (fMultvsV0M[befaft]) fMultvsV0M[befaft]->Fill(GetCentrality(),fContainer.fMultTrkFB32Acc);
+    if (fTPCvsTrkl[befaft]) fTPCvsTrkl[befaft]->Fill(ntrkl,fContainer.fMultTrkTPC);
+    if (fVZEROvsTPCout[befaft]) fVZEROvsTPCout[befaft]->Fill(fContainer.fMultTrkTPCout,fContainer.fMultVZERO);
+    if (!allcuts) return false; /// Do not fill the "after" histograms if the event does not pass the cuts.
+  }
+
+  return true;
+}
+
+/// Evaluate the cuts on the event, setting fFlag, the centrality percentiles and the primary vertex.
+/// Returns the difference between the track and SPD vertex z positions (for the QA plots).
+///
+double AliEventCuts::ComputeSelection(AliVEvent *ev) {
   /// Event selection flag, as soon as the event does not pass one cut this becomes false.
   fFlag = BIT(kNoCuts);
 
@@ -226,11 +363,7 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   bool usePileUpSPD = (fUseCombinedMVSPDcut && vtx == vtSPD) || fUseSPDpileUpCut;
   AliVMultiplicity* mult = ev->GetMultiplicity();
   const int ntrkl = mult->GetNumberOfTracklets();
-  if (fUseMultiplicityDependentPileUpCuts) {
-    if (ntrkl < 20) fSPDpileupMinContributors = 3;
-    else if (ntrkl < 50) fSPDpileupMinContributors = 4;
-    else fSPDpileupMinContributors = 5;
-  }
+  if (fUseMultiplicityDependentPileUpCuts) SetMultiplicityDependentPileUpCuts(ntrkl);
   if ((!usePileUpSPD || !ev->IsPileupFromSPD(fSPDpileupMinContributors,fSPDpileupMinZdist,fSPDpileupNsigmaZdist,fSPDpileupNsigmaDiamXY,fSPDpileupNsigmaDiamZ)) &&
       (!fTrackletBGcut || !fUtils.IsSPDClusterVsTrackletBG(ev)) &&
       (!usePileUpMV || !fUtils.IsPileUpMV(ev)))
@@ -321,56 +454,78 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   //
   
   /// Ignore SPD/tracks vertex position and reconstruction individual flags
-  bool allcuts = CheckNormalisationMask(kPassesAllCuts);
-  if (allcuts) {
+  if (CheckNormalisationMask(kPassesAllCuts)) {
     fFlag |= BIT(kAllCuts);
   }
-  if (fCutStats) {
-    for (int iCut = kNoCuts; iCut <= kAllCuts; ++iCut) {
-      if (TESTBIT(fFlag,iCut)) {
-        fCutStats->Fill(iCut);
-        if (TESTBIT(fFlag,kTrigger)) {
-          fCutStatsAfterTrigger->Fill(iCut);
-        }
-        if (TESTBIT(fFlag,kMultiplicity)) {
-          fCutStatsAfterMultSelection->Fill(iCut);
-        }
-      }
-    }
-  }
 
-  /// Filling normalisation histogram
-  array <NormMask,5> norm_masks {
-    kAnyEvent,
-    kTriggeredEvent,
-    kPassesNonVertexRelatedSelections,
-    kHasReconstructedVertex,
-    kPassesAllCuts
-  };
-  for (int iC = 0; iC < 5; ++iC) {
-    if (CheckNormalisationMask(norm_masks[iC])) {
-      if (fNormalisationHist) {
-        fNormalisationHist->Fill(iC);
-      }
-    }
-  }
+  return dz;
+}
 
-  /// Filling the monitoring histograms (first iteration always filled, second iteration only for selected events.
-  for (int befaft = 0; befaft < 2; ++befaft) {
-    if (fCentrality[befaft]) fCentrality[befaft]->Fill(fCentPercentiles[0]);
-    if (fEstimCorrelation[befaft]) fEstimCorrelation[befaft]->Fill(fCentPercentiles[1],fCentPercentiles[0]);
-    if (fMultCentCorrelation[befaft]) fMultCentCorrelation[befaft]->Fill(fCentPercentiles[0],ntrkl);
-    if (fVtz[befaft]) fVtz[befaft]->Fill(vtx->GetZ());
-    if (fDeltaTrackSPDvtz[befaft]) fDeltaTrackSPDvtz[befaft]->Fill(dz);
-    if (fTOFvsFB32[befaft]) fTOFvsFB32[befaft]->Fill(fContainer.fMultTrkFB32,fContainer.fMultTrkFB32TOF);
-    if (fTPCvsAll[befaft])  fTPCvsAll[befaft]->Fill(fContainer.fMultTrkTPC,float(fContainer.fMultESD) - fESDvsTPConlyLinearCut[1] * fContainer.fMultTrkTPC);
-    if (fMultvsV0M[befaft]) fMultvsV0M[befaft]->Fill(GetCentrality(),fContainer.fMultTrkFB32Acc);
-    if (fTPCvsTrkl[befaft]) fTPCvsTrkl[befaft]->Fill(ntrkl,fContainer.fMultTrkTPC);
-    if (fVZEROvsTPCout[befaft]) fVZEROvsTPCout[befaft]->Fill(fContainer.fMultTrkTPCout,fContainer.fMultVZERO);
-    if (!allcuts) return false; /// Do not fill the "after" histograms if the event does not pass the cuts.
-  }
+void AliEventCuts::SetMultiplicityDependentPileUpCuts(int ntrkl) {
+  if (ntrkl < 20) fSPDpileupMinContributors = 3;
+  else if (ntrkl < 50) fSPDpileupMinContributors = 4;
+  else fSPDpileupMinContributors = 5;
+}
 
-  return true;
+/// Hash of all the settings which determine the selection result of an event
+///
+unsigned long AliEventCuts::ConfigurationHash() const {
+  unsigned long seed = 0ul;
+  HashCombine(seed, fCurrentRun);
+  HashCombine(seed, fUtilsHash);
+  HashCombine(seed, fMC);
+  HashCombine(seed, fRequireTrackVertex);
+  HashCombine(seed, fMinVtz);
+  HashCombine(seed, fMaxVtz);
+  HashCombine(seed, fMaxDeltaSpdTrackAbsolute);
+  HashCombine(seed, fMaxDeltaSpdTrackNsigmaSPD);
+  HashCombine(seed, fMaxDeltaSpdTrackNsigmaTrack);
+  HashCombine(seed, fMaxResolutionSPDvertex);
+  HashCombine(seed, fMaxDispersionSPDvertex);
+  HashCombine(seed, fCheckAODvertex);
+  HashCombine(seed, fRejectDAQincomplete);
+  HashCombine(seed, fRequiredSolenoidPolarity);
+  HashCombine(seed, fUseCombinedMVSPDcut);
+  HashCombine(seed, fUseMultiplicityDependentPileUpCuts);
+  HashCombine(seed, fUseSPDpileUpCut);
+  /// With the multiplicity dependent cuts the number of contributors is set event by event
+  if (!fUseMultiplicityDependentPileUpCuts) HashCombine(seed, fSPDpileupMinContributors);
+  HashCombine(seed, fSPDpileupMinZdist);
+  HashCombine(seed, fSPDpileupNsigmaZdist);
+  HashCombine(seed, fSPDpileupNsigmaDiamXY);
+  HashCombine(seed, fSPDpileupNsigmaDiamZ);
+  HashCombine(seed, fTrackletBGcut);
+  HashCombine(seed, fPileUpCutMV);
+  HashCombine(seed, fCentralityFramework);
+  HashCombine(seed, fMinCentrality);
+  HashCombine(seed, fMaxCentrality);
+  HashCombine(seed, fUseVariablesCorrelationCuts);
+  HashCombine(seed, fUseEstimatorsCorrelationCut);
+  HashCombine(seed, fUseStrongVarCorrelationCut);
+  for (double par : fEstimatorsCorrelationCoef) HashCombine(seed, par);
+  for (double par : fEstimatorsSigmaPars) HashCombine(seed, par);
+  for (double par : fDeltaEstimatorNsigma) HashCombine(seed, par);
+  for (double par : fTOFvsFB32correlationPars) HashCombine(seed, par);
+  for (double par : fTOFvsFB32sigmaPars) HashCombine(seed, par);
+  for (double par : fTOFvsFB32nSigmaCut) HashCombine(seed, par);
+  for (double par : fESDvsTPConlyLinearCut) HashCombine(seed, par);
+  if (fMultiplicityV0McorrCut) {
+    HashCombine(seed, string(fMultiplicityV0McorrCut->GetExpFormula().Data()));
+    for (int iPar = 0; iPar < fMultiplicityV0McorrCut->GetNpar(); ++iPar)
+      HashCombine(seed, fMultiplicityV0McorrCut->GetParameter(iPar));
+  }
+  for (double par : fFB128vsTrklLinearCut) HashCombine(seed, par);
+  for (double par : fVZEROvsTPCoutPolCut) HashCombine(seed, par);
+  HashCombine(seed, fRequireExactTriggerMask);
+  HashCombine(seed, fTriggerMask);
+  for (const string& trClass : fTriggerClasses) HashCombine(seed, trClass);
+  HashCombine(seed, fCentEstimators[0]);
+  HashCombine(seed, fCentEstimators[1]);
+  HashCombine(seed, fMultSelectionEvCuts);
+  HashCombine(seed, fSelectInelGt0);
+  HashCombine(seed, fUseTimeRangeCut);
+  if (fUseTimeRangeCut) HashCombine(seed, string(fTimeRangeCut.GetOADPath().Data()));
+  return seed;
 }
 
 void AliEventCuts::AddQAplotsToList(TList *qaList, bool addCorrelationPlots) {
@@ -46,6 +46,36 @@ class AliEventCutsContainer : public TNamed {
   ClassDef(AliEventCutsContainer,2)
 };
 
+/// Selection results of the AliEventCuts instances of an analysis for the current event. It is attached
+/// to the event (as AliEventCutsContainer) so that all the AliEventCuts instances with the same configuration,
+/// e.g. in different wagons of a train, evaluate the cuts only once per event.
+class AliEventCutsResultCache : public TNamed {
+  public:
+    AliEventCutsResultCache() : TNamed("AliEventCutsResultCache","AliEventCutsResultCache"),
+    fEntry(-1),
+    fEventId(0u),
+    fRunNumber(-1),
+    fNTracks(-1),
+    fConfigurations(),
+    fFlags(),
+    fCentPercentiles(),
+    fDeltaZ() {}
+
+    static AliEventCutsResultCache* GetCache(AliVEvent *ev);
+    int  Find(unsigned long configuration) const;
+    void Add(unsigned long configuration, unsigned long flag, const float *centPercentiles, double deltaZ);
+
+    Long64_t fEntry;                              ///< Entry of the analysis manager the results refer to
+    unsigned long fEventId;                       ///< Event identifier (bunch crossing and time stamp)
+    int fRunNumber;                               ///< Run number of the event
+    int fNTracks;                                 ///< Number of tracks of the event
+    std::vector<unsigned long> fConfigurations;   //!<! Hash of the configuration of each cached result
+    std::vector<unsigned long> fFlags;            //!<! Flag of the passed cuts
+    std::vector<float> fCentPercentiles;          //!<! Centrality percentiles (two per result)
+    std::vector<double> fDeltaZ;                  //!<! Difference between the track and SPD vertex z positions
+  ClassDef(AliEventCutsResultCache,1)
+};
+
 class AliEventCuts : public TList {
   public:
     AliEventCuts(bool savePlots = false);
@@ -101,6 +131,8 @@ class AliEventCuts : public TList {
     void   SetupRun2pA(int iPeriod);
     void   UseMultSelectionEventSelection(bool useIt = true);
     void   SetAcceptedTriggerClasses(TString classes);
+    /// Share the selection result of each event with the other instances with the same configuration (on by default)
+    void   UseSharedSelectionCache(bool useIt = true) { fUseSharedSelectionCache = useIt; }
 
     static bool GoodPrimaryAODVertex(AliVEvent *ev);
 
@@ -191,6 +223,9 @@ class AliEventCuts : public TList {
     AliEventCuts operator=(const AliEventCuts& copy);
     void          AutomaticSetup (AliVEvent *ev);
     void          ComputeTrackMultiplicity(AliVEvent *ev);
+    double        ComputeSelection(AliVEvent *ev);
+    void          SetMultiplicityDependentPileUpCuts(int ntrkl);
+    unsigned long ConfigurationHash() const;
     template<typename F> F PolN(F x, F* coef, int n);
 
     bool          fManualMode;                    ///< if true the cuts are not loaded automatically looking at the run number
@@ -214,6 +249,8 @@ class AliEventCuts : public TList {
     bool          fSelectInelGt0;                 ///< Select only INEL > 0 events
     bool          fOverrideInelGt0;               ///< If the user ask for a configuration, let's not touch it
     bool          fOverrideCentralityFramework;   ///< If the user ask (not) to run a centrality framework this should be onored by AliEventCuts 
+    bool          fUseSharedSelectionCache;       ///< If true the selection result is shared among the instances with the same configuration
+    unsigned long fUtilsHash;                     //!<! Hash of the fUtils configuration, computed at each run change
 
     AliTimeRangeCut fTimeRangeCut;       ///< Time Range cut
   
@@ -239,7 +276,7 @@ class AliEventCuts : public TList {
     AliESDtrackCuts* fFB32trackCuts; //!<! Cuts corresponding to FB32 in the ESD (used only for correlations cuts in ESDs)
     AliESDtrackCuts* fTPConlyCuts;   //!<! Cuts corresponding to the standalone TPC cuts in the ESDs (used only for correlations cuts in ESDs)
 
-    ClassDef(AliEventCuts, 13)
+    ClassDef(AliEventCuts, 14)
 };
 
 template<typename F> F AliEventCuts::PolN(F x,F* coef, int n) {
@@ -75,6 +75,9 @@ void AliTimeRangeCut::InitFromRunNumber(const Int_t run)
 
   fTimeRangeMasking = (AliTimeRangeMasking<ULong64_t, UShort_t>*)cont.GetObject(run, "", passName);
 
+  // ===| sorted lookup index, once per run |===
+  if (fTimeRangeMasking) fTimeRangeMasking->BuildIndex();
+
 }
 
 //______________________________________________________________________________
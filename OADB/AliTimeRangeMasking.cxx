@@ -14,6 +14,8 @@
  **************************************************************************/
 
 #include <iostream>
+#include <algorithm>
+#include <numeric>
 
 #include "AliLog.h"
 
@@ -88,7 +90,26 @@ templateClassImp(AliTimeRangeMasking)
 template<typename time_type, typename bitmap_type>
 AliTimeRangeMasking<time_type, bitmap_type>::AliTimeRangeMasking()
   : TObject(),
-    fArrTimeRanges("AliTimeRangeMask<ULong64_t, UShort_t>", 10)
+    fArrTimeRanges("AliTimeRangeMask<ULong64_t, UShort_t>", 10),
+    fIndexStart(),
+    fIndexEnd(),
+    fIndexRange(),
+    fIndexSize(-1),
+    fIndexOverlaps(kFALSE),
+    fCursor(0)
+{
+}
+
+template<typename time_type, typename bitmap_type>
+AliTimeRangeMasking<time_type, bitmap_type>::AliTimeRangeMasking(AliTimeRangeMasking const& other)
+  : TObject(other),
+    fArrTimeRanges(other.fArrTimeRanges),
+    fIndexStart(),
+    fIndexEnd(),
+    fIndexRange(),
+    fIndexSize(-1),
+    fIndexOverlaps(kFALSE),
+    fCursor(0)
 {
 }
 
@@ -96,14 +117,14 @@ AliTimeRangeMasking<time_type, bitmap_type>::AliTimeRangeMasking()
 template<typename time_type, typename bitmap_type>
 AliTimeRangeMask<time_type, bitmap_type>* AliTimeRangeMasking<time_type, bitmap_type>::AddTimeRangeMask(time_type start, time_type end, bitmap_type reasons)
 {
-  if ( const auto* range = FindTimeRangeMask(start))  {
+  if ( const auto* range = FindTimeRangeMaskLinear(start))  {
     const std::string reasonsString = range->CollectMaskReasonNames();
     AliErrorF("Start time %llu already in range [%llu, %llu]: %s", 
         start, range->GetStart(), range->GetEnd(), reasonsString.data());
     return nullptr;
   }
 
-  if ( const auto* range = FindTimeRangeMask(end))  {
+  if ( const auto* range = FindTimeRangeMaskLinear(end))  {
     const std::string reasonsString= range->CollectMaskReasonNames();
     AliErrorF("End time %llu already in range [%llu, %llu]: %s", 
         end, range->GetStart(), range->GetEnd(), reasonsString.data());
@@ -115,6 +136,37 @@ AliTimeRangeMask<time_type, bitmap_type>* AliTimeRangeMasking<time_type, bitmap_
 
 template<typename time_type, typename bitmap_type>
 AliTimeRangeMask<time_type, bitmap_type>* AliTimeRangeMasking<time_type, bitmap_type>::FindTimeRangeMask(time_type time) const
+{
+  if (fIndexSize != fArrTimeRanges.GetEntriesFast()) BuildIndex();
+  if (fIndexOverlaps) return FindTimeRangeMaskLinear(time);
+
+  const size_t nRanges = fIndexStart.size();
+  if (!nRanges) return nullptr;
+
+  // times are usually looked up in increasing order: try the last range found and the following one
+  size_t pos = fCursor;
+  if (time >= fIndexStart[pos]) {
+    if (time > fIndexEnd[pos] && pos + 1 < nRanges && time >= fIndexStart[pos + 1]) {
+      ++pos;
+      if (pos + 1 < nRanges && time >= fIndexStart[pos + 1]) {
+        pos = std::upper_bound(fIndexStart.begin() + pos, fIndexStart.end(), time) - fIndexStart.begin() - 1;
+      }
+    }
+  } else {
+    const size_t next = std::upper_bound(fIndexStart.begin(), fIndexStart.begin() + pos, time) - fIndexStart.begin();
+    if (next == 0) return nullptr; // before the first range
+    pos = next - 1;
+  }
+
+  // pos is the last range starting at or before time
+  fCursor = pos;
+  if (time <= fIndexEnd[pos]) return fIndexRange[pos];
+  return nullptr;
+}
+
+/// Linear search in the order in which the ranges were added
+template<typename time_type, typename bitmap_type>
+AliTimeRangeMask<time_type, bitmap_type>* AliTimeRangeMasking<time_type, bitmap_type>::FindTimeRangeMaskLinear(time_type time) const
 {
   for (auto o : fArrTimeRanges) {
     auto const val = (AliTimeRangeMask<time_type, bitmap_type>*)o;
@@ -123,6 +175,37 @@ AliTimeRangeMask<time_type, bitmap_type>* AliTimeRangeMasking<time_type, bitmap_
   return nullptr;
 }
 
+/// Build the index of the ranges sorted by start time
+template<typename time_type, typename bitmap_type>
+void AliTimeRangeMasking<time_type, bitmap_type>::BuildIndex() const
+{
+  const Int_t nRanges = fArrTimeRanges.GetEntriesFast();
+  std::vector<Int_t> order(nRanges);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](Int_t a, Int_t b) {
+    return static_cast<AliTimeRangeMask<time_type, bitmap_type>*>(fArrTimeRanges.UncheckedAt(a))->GetStart() <
+           static_cast<AliTimeRangeMask<time_type, bitmap_type>*>(fArrTimeRanges.UncheckedAt(b))->GetStart();
+  });
+
+  fIndexStart.resize(nRanges);
+  fIndexEnd.resize(nRanges);
+  fIndexRange.resize(nRanges);
+  fIndexOverlaps = kFALSE;
+  for (Int_t i = 0; i < nRanges; ++i) {
+    auto range = static_cast<AliTimeRangeMask<time_type, bitmap_type>*>(fArrTimeRanges.UncheckedAt(order[i]));
+    fIndexStart[i] = range->GetStart();
+    fIndexEnd[i] = range->GetEnd();
+    fIndexRange[i] = range;
+    if (i > 0 && fIndexStart[i] <= fIndexEnd[i - 1]) fIndexOverlaps = kTRUE;
+  }
+  if (fIndexOverlaps) {
+    AliWarning("Overlapping time ranges, using the linear search");
+  }
+
+  fIndexSize = nRanges;
+  fCursor = 0;
+}
+
 template<typename time_type, typename bitmap_type>
 void AliTimeRangeMasking<time_type, bitmap_type>::Print(Option_t* option) const
 {
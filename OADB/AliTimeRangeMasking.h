@@ -72,22 +72,42 @@ class AliTimeRangeMask : public TObject {
 
 /// \class AliTimeRangeMasking
 /// A Class for keeping several time ranges with mask of type AliTimeRangeMask
+///
+/// The lookup uses an index of the ranges sorted by start time, built at the first lookup
+/// (or explicitly with BuildIndex()) and rebuilt when ranges are added. A search costs
+/// O(log n), and O(1) when the times are looked up in increasing order (e.g. events of a run),
+/// since the range of the previous lookup and the following one are checked first.
+/// If ranges overlap, the linear search is used.
 template<typename time_type, typename bitmap_type>
 class AliTimeRangeMasking : public TObject {
   public:
     AliTimeRangeMasking();
+    AliTimeRangeMasking(AliTimeRangeMasking const&);
 
     AliTimeRangeMask<time_type, bitmap_type>* AddTimeRangeMask(time_type start, time_type end, bitmap_type reasons = {});
 
 
     AliTimeRangeMask<time_type, bitmap_type>* FindTimeRangeMask(time_type time) const;
+    AliTimeRangeMask<time_type, bitmap_type>* FindTimeRangeMaskLinear(time_type time) const;
+
+    void BuildIndex() const;
+    Int_t GetNumberOfTimeRanges() const { return fArrTimeRanges.GetEntriesFast(); }
 
     virtual void Print(Option_t* option = "") const;
 
   private:
+    AliTimeRangeMasking& operator= (AliTimeRangeMasking const&);
+
     TClonesArray fArrTimeRanges;
 
-    ClassDef(AliTimeRangeMasking, 1);
+    mutable std::vector<time_type> fIndexStart;  //!<! start times of the ranges, sorted
+    mutable std::vector<time_type> fIndexEnd;    //!<! end times of the ranges, in the order of fIndexStart
+    mutable std::vector<AliTimeRangeMask<time_type, bitmap_type>*> fIndexRange; //!<! ranges, in the order of fIndexStart
+    mutable Int_t fIndexSize;                    //!<! number of ranges when the index was built, -1 if not built
+    mutable Bool_t fIndexOverlaps;               //!<! ranges overlap, the index cannot be used
+    mutable size_t fCursor;                      //!<! position in the index of the last range found
+
+    ClassDef(AliTimeRangeMasking, 2);
 };
 
 #endif
@@ -19,12 +19,200 @@
 #include "TObjString.h"
 #include "TBrowser.h"
 #include "TFormula.h"
+#include "TMath.h"
 #include "RVersion.h"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+    //Operations of the compiled definitions (stack machine)
+    enum EMultOp {
+        kOpConst = 0, kOpVar, kOpNeg, kOpNot,
+        kOpAdd, kOpSub, kOpMul, kOpDiv,
+        kOpLt, kOpLe, kOpGt, kOpGe, kOpEq, kOpNe, kOpAnd, kOpOr,
+        kOpPow, kOpAbs, kOpSqrt, kOpExp, kOpLog
+    };
+    const Int_t kMaxStack = 32;
+    
+    //Recursive descent parser of the definitions, after substitution of
+    //the variables by parameters [i], with the C++ operator precedence
+    //used by TFormula. Anything not understood (or any integer division,
+    //which TFormula would do in integer arithmetic) makes the compilation
+    //fail, the TFormula is used in that case.
+    class AliMultDefinitionParser {
+    public:
+        AliMultDefinitionParser(const char* lExpr) :
+        fPos(lExpr), fDepth(0), fMaxDepth(0), fOk(kTRUE) {}
+        
+        Bool_t Parse() {
+            Bool_t lInt;
+            ParseOr(lInt);
+            SkipSpaces();
+            return fOk && *fPos == '\0' && fMaxDepth <= kMaxStack;
+        }
+        std::vector<Int_t>    fCode;      //Operations and operands
+        std::vector<Double_t> fConstants; //Constants
+        std::vector<Int_t>    fParams;    //Parameter index of each variable slot
+        
+    private:
+        void SkipSpaces() { while (*fPos == ' ' || *fPos == '\t' || *fPos == '\n') fPos++; }
+        Bool_t Accept(const char* lToken) {
+            SkipSpaces();
+            size_t lLen = strlen(lToken);
+            if (strncmp(fPos, lToken, lLen)) return kFALSE;
+            fPos += lLen;
+            return kTRUE;
+        }
+        //Peek at a one-character operator not followed by one of lNot
+        Bool_t AcceptSingle(char lChar, const char* lNot) {
+            SkipSpaces();
+            if (*fPos != lChar || (fPos[1] && strchr(lNot, fPos[1]))) return kFALSE;
+            fPos++;
+            return kTRUE;
+        }
+        void Emit(Int_t lOp, Int_t lDepthChange) {
+            fCode.push_back(lOp);
+            fDepth += lDepthChange;
+            if (fDepth > fMaxDepth) fMaxDepth = fDepth;
+        }
+        void Binary(Int_t lOp, Bool_t& lInt, Bool_t lIntRight, Bool_t lIntResult) {
+            Emit(lOp, -1);
+            lInt = lIntResult ? kTRUE : (lInt && lIntRight);
+        }
+        void ParseOr(Bool_t& lInt) {
+            ParseAnd(lInt);
+            while (fOk && Accept("||")) { Bool_t r; ParseAnd(r); Binary(kOpOr, lInt, r, kTRUE); }
+        }
+        void ParseAnd(Bool_t& lInt) {
+            ParseEquality(lInt);
+            while (fOk && Accept("&&")) { Bool_t r; ParseEquality(r); Binary(kOpAnd, lInt, r, kTRUE); }
+        }
+        void ParseEquality(Bool_t& lInt) {
+            ParseRelational(lInt);
+            while (fOk) {
+                Bool_t r;
+                if      (Accept("==")) { ParseRelational(r); Binary(kOpEq, lInt, r, kTRUE); }
+                else if (Accept("!=")) { ParseRelational(r); Binary(kOpNe, lInt, r, kTRUE); }
+                else break;
+            }
+        }
+        void ParseRelational(Bool_t& lInt) {
+            ParseAdditive(lInt);
+            while (fOk) {
+                Bool_t r;
+                if      (Accept("<=")) { ParseAdditive(r); Binary(kOpLe, lInt, r, kTRUE); }
+                else if (Accept(">=")) { ParseAdditive(r); Binary(kOpGe, lInt, r, kTRUE); }
+                else if (AcceptSingle('<', "<")) { ParseAdditive(r); Binary(kOpLt, lInt, r, kTRUE); }
+                else if (AcceptSingle('>', ">")) { ParseAdditive(r); Binary(kOpGt, lInt, r, kTRUE); }
+                else break;
+            }
+        }
+        void ParseAdditive(Bool_t& lInt) {
+            ParseMultiplicative(lInt);
+            while (fOk) {
+                Bool_t r;
+                if      (AcceptSingle('+', "+=")) { ParseMultiplicative(r); Binary(kOpAdd, lInt, r, kFALSE); }
+                else if (AcceptSingle('-', "-=")) { ParseMultiplicative(r); Binary(kOpSub, lInt, r, kFALSE); }
+                else break;
+            }
+        }
+        void ParseMultiplicative(Bool_t& lInt) {
+            ParseUnary(lInt);
+            while (fOk) {
+                Bool_t r;
+                if (AcceptSingle('*', "=")) { ParseUnary(r); Binary(kOpMul, lInt, r, kFALSE); }
+                else if (AcceptSingle('/', "=")) {
+                    ParseUnary(r);
+                    if (lInt && r) fOk = kFALSE; //integer division
+                    Binary(kOpDiv, lInt, r, kFALSE);
+                }
+                else break;
+            }
+        }
+        void ParseUnary(Bool_t& lInt) {
+            if (AcceptSingle('-', "-=")) { ParseUnary(lInt); Emit(kOpNeg, 0); return; }
+            if (AcceptSingle('+', "+=")) { ParseUnary(lInt); return; }
+            if (AcceptSingle('!', "=")) { ParseUnary(lInt); Emit(kOpNot, 0); lInt = kTRUE; return; }
+            ParsePrimary(lInt);
+        }
+        void ParseFunction(Int_t lOp, Int_t lNArgs, Bool_t& lInt) {
+            if (!Accept("(")) { fOk = kFALSE; return; }
+            Bool_t lIntArg = kFALSE;
+            ParseOr(lIntArg);
+            if (lNArgs == 2) {
+                Bool_t lIntArg2;
+                if (!fOk || !Accept(",")) { fOk = kFALSE; return; }
+                ParseOr(lIntArg2);
+            }
+            if (!fOk || !Accept(")")) { fOk = kFALSE; return; }
+            Emit(lOp, 1 - lNArgs);
+            //TMath::Abs keeps the type of its argument
+            lInt = (lOp == kOpAbs) ? lIntArg : kFALSE;
+        }
+        void ParsePrimary(Bool_t& lInt) {
+            lInt = kFALSE;
+            SkipSpaces();
+            if (Accept("(")) {
+                ParseOr(lInt);
+                if (!fOk || !Accept(")")) fOk = kFALSE;
+                return;
+            }
+            if (*fPos == '[') {
+                char* lEnd = 0;
+                long lIdx = strtol(fPos+1, &lEnd, 10);
+                if (lEnd == fPos+1 || *lEnd != ']' || lIdx < 0) { fOk = kFALSE; return; }
+                fPos = lEnd + 1;
+                Int_t lSlot = 0;
+                while (lSlot < (Int_t)fParams.size() && fParams[lSlot] != lIdx) lSlot++;
+                if (lSlot == (Int_t)fParams.size()) fParams.push_back(lIdx);
+                Emit(kOpVar, 1);
+                fCode.push_back(lSlot);
+                return;
+            }
+            if ((*fPos >= '0' && *fPos <= '9') || *fPos == '.') {
+                const char* lStart = fPos;
+                while ((*fPos >= '0' && *fPos <= '9')) fPos++;
+                Bool_t lIsInt = kTRUE;
+                if (*fPos == '.') { lIsInt = kFALSE; fPos++; while (*fPos >= '0' && *fPos <= '9') fPos++; }
+                if (fPos - lStart == 1 && *lStart == '.') { fOk = kFALSE; return; }
+                if (*fPos == 'e' || *fPos == 'E') {
+                    lIsInt = kFALSE;
+                    fPos++;
+                    if (*fPos == '+' || *fPos == '-') fPos++;
+                    if (!(*fPos >= '0' && *fPos <= '9')) { fOk = kFALSE; return; }
+                    while (*fPos >= '0' && *fPos <= '9') fPos++;
+                }
+                //no literal suffixes, octal or hexadecimal constants
+                if ((*fPos >= 'a' && *fPos <= 'z') || (*fPos >= 'A' && *fPos <= 'Z') || *fPos == '_' ||
+                    (lIsInt && *lStart == '0' && fPos - lStart > 1)) { fOk = kFALSE; return; }
+                fConstants.push_back(strtod(TString(lStart, fPos - lStart).Data(), 0));
+                Emit(kOpConst, 1);
+                fCode.push_back(fConstants.size() - 1);
+                lInt = lIsInt;
+                return;
+            }
+            if (Accept("TMath::Power") || Accept("pow"))  { ParseFunction(kOpPow,  2, lInt); return; }
+            if (Accept("TMath::Abs"))                     { ParseFunction(kOpAbs,  1, lInt); return; }
+            if (Accept("TMath::Sqrt") || Accept("sqrt"))  { ParseFunction(kOpSqrt, 1, lInt); return; }
+            if (Accept("TMath::Exp") || Accept("exp"))    { ParseFunction(kOpExp,  1, lInt); return; }
+            if (Accept("TMath::Log") || Accept("log"))    { ParseFunction(kOpLog,  1, lInt); return; }
+            fOk = kFALSE;
+        }
+        
+        const char* fPos;   //Current position
+        Int_t  fDepth;      //Current stack depth
+        Int_t  fMaxDepth;   //Maximum stack depth
+        Bool_t fOk;         //No error so far
+    };
+}
 
 ClassImp(AliMultEstimator);
+Int_t AliMultEstimator::fgNCompiledChecks = 100;
 //________________________________________________________________
 AliMultEstimator::AliMultEstimator() :
   TNamed(), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+  fCode(), fConstants(), fVariables(), fCompiledInput(0), fNCheckCompiled(0),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
   // Constructor
@@ -32,6 +220,7 @@ fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 }
 AliMultEstimator::AliMultEstimator(const char * name, const char * title, TString lInitDef):
 TNamed(name,title), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fCode(), fConstants(), fVariables(), fCompiledInput(0), fNCheckCompiled(0),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
     //Named, titled, definition constructor
@@ -46,6 +235,11 @@ fValue(e.fValue),
 fMean(e.fMean),
 fPercentile(e.fPercentile),
 fFormula(0),
+fCode(e.fCode),
+fConstants(e.fConstants),
+fVariables(e.fVariables),
+fCompiledInput(e.fCompiledInput),
+fNCheckCompiled(e.fNCheckCompiled),
 fkUseAnchor(e.fkUseAnchor),
 fAnchorPoint(e.fAnchorPoint),
 fAnchorPercentile(e.fAnchorPercentile)
@@ -67,6 +261,11 @@ AliMultEstimator& AliMultEstimator::operator=(const AliMultEstimator& e)
     if (fFormula) delete fFormula;
     fFormula = 0;
     if (e.fFormula) fFormula = new TFormula(*e.fFormula);
+    fCode          = e.fCode;
+    fConstants     = e.fConstants;
+    fVariables     = e.fVariables;
+    fCompiledInput = e.fCompiledInput;
+    fNCheckCompiled = e.fNCheckCompiled;
     
     //Anchor point configs
     fkUseAnchor         = e.fkUseAnchor;
@@ -121,13 +320,85 @@ void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
         lVarName.Prepend("(");
         expr.ReplaceAll(lVarName, repl);
     }
+    if (fFormula) delete fFormula;
     fFormula = new TFormula(Form("e%s", GetName()), expr);
 #if ROOT_VERSION_CODE < ROOT_VERSION(5,99,4)
     fFormula->Optimize();
 #endif
+    //Compiled code, checked against the TFormula at the first evaluation
+    fCode.Set(0);
+    fConstants.Set(0);
+    fVariables.Clear();
+    if (!Compile(lInput, expr))
+        Info("SetupFormula", "%s: definition not compiled, using TFormula: %s", GetName(), fDefinition.Data());
 }
 //________________________________________________________________
-Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
+Bool_t AliMultEstimator::Compile(const AliMultInput* lInput, const TString& lExpr)
+{
+    //Compile the definition, with variables replaced by parameters [i],
+    //into the code of a small stack machine, with the variables bound
+    //to those of lInput. Returns false if the definition uses constructs
+    //not handled here (TFormula used then).
+    AliMultDefinitionParser lParser(lExpr.Data());
+    if (!lParser.Parse()) return kFALSE;
+    
+    fVariables.Expand(lParser.fParams.size());
+    for (UInt_t i = 0; i < lParser.fParams.size(); i++) {
+        AliMultVariable* v = lInput->GetVariable(lParser.fParams[i]);
+        if (!v) { fVariables.Clear(); return kFALSE; }
+        fVariables.AddAt(v, i);
+    }
+    fConstants.Set(lParser.fConstants.size());
+    for (UInt_t i = 0; i < lParser.fConstants.size(); i++) fConstants[i] = lParser.fConstants[i];
+    fCode.Set(lParser.fCode.size());
+    for (UInt_t i = 0; i < lParser.fCode.size(); i++) fCode[i] = lParser.fCode[i];
+    fCompiledInput = lInput;
+    fNCheckCompiled = fgNCompiledChecks;
+    return kTRUE;
+}
+//________________________________________________________________
+Double_t AliMultEstimator::EvaluateCompiled() const
+{
+    //Run the compiled code: same operations, in the same order, as the
+    //compiled TFormula expression
+    Double_t     lStack[kMaxStack];
+    Int_t        n     = 0;
+    const Int_t* lCode = fCode.GetArray();
+    const Int_t  lSize = fCode.GetSize();
+    for (Int_t i = 0; i < lSize; i++) {
+        switch (lCode[i]) {
+            case kOpConst: lStack[n++] = fConstants[lCode[++i]]; break;
+            case kOpVar: {
+                //same conversion as for the TFormula parameters
+                const AliMultVariable* v = static_cast<const AliMultVariable*>(fVariables.UncheckedAt(lCode[++i]));
+                lStack[n++] = v->IsInteger() ? v->GetValueInteger() : v->GetValue();
+                break;
+            }
+            case kOpNeg:  lStack[n-1] = -lStack[n-1]; break;
+            case kOpNot:  lStack[n-1] = !lStack[n-1]; break;
+            case kOpAdd:  n--; lStack[n-1] = lStack[n-1] + lStack[n]; break;
+            case kOpSub:  n--; lStack[n-1] = lStack[n-1] - lStack[n]; break;
+            case kOpMul:  n--; lStack[n-1] = lStack[n-1] * lStack[n]; break;
+            case kOpDiv:  n--; lStack[n-1] = lStack[n-1] / lStack[n]; break;
+            case kOpLt:   n--; lStack[n-1] = lStack[n-1] <  lStack[n]; break;
+            case kOpLe:   n--; lStack[n-1] = lStack[n-1] <= lStack[n]; break;
+            case kOpGt:   n--; lStack[n-1] = lStack[n-1] >  lStack[n]; break;
+            case kOpGe:   n--; lStack[n-1] = lStack[n-1] >= lStack[n]; break;
+            case kOpEq:   n--; lStack[n-1] = lStack[n-1] == lStack[n]; break;
+            case kOpNe:   n--; lStack[n-1] = lStack[n-1] != lStack[n]; break;
+            case kOpAnd:  n--; lStack[n-1] = lStack[n-1] && lStack[n]; break;
+            case kOpOr:   n--; lStack[n-1] = lStack[n-1] || lStack[n]; break;
+            case kOpPow:  n--; lStack[n-1] = TMath::Power(lStack[n-1], lStack[n]); break;
+            case kOpAbs:  lStack[n-1] = TMath::Abs(lStack[n-1]); break;
+            case kOpSqrt: lStack[n-1] = TMath::Sqrt(lStack[n-1]); break;
+            case kOpExp:  lStack[n-1] = TMath::Exp(lStack[n-1]); break;
+            case kOpLog:  lStack[n-1] = TMath::Log(lStack[n-1]); break;
+        }
+    }
+    return lStack[0];
+}
+//________________________________________________________________
+Float_t AliMultEstimator::EvaluateFormula(const AliMultInput* lInput)
 {
     if (!fFormula) return fValue = 0;
     for (Int_t i = 0; i < lInput->GetNVariables(); i++) {
@@ -138,3 +409,31 @@ Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
     }
     return fValue = fFormula->Eval(0);
 }
+//________________________________________________________________
+void AliMultEstimator::SetNCompiledChecks(Int_t lN)
+{
+    //Number of evaluations after each setup compared with the TFormula
+    //(0: none, negative: all evaluations)
+    fgNCompiledChecks = lN;
+}
+//________________________________________________________________
+Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
+{
+    if (!fFormula) return fValue = 0;
+    if (!IsCompiled() || lInput != fCompiledInput) return EvaluateFormula(lInput);
+    Double_t lValue = EvaluateCompiled();
+    if (fNCheckCompiled) {
+        //First evaluations after setup: bitwise comparison with the TFormula
+        if (fNCheckCompiled > 0) fNCheckCompiled--;
+        EvaluateFormula(lInput);
+        Double_t lReference = fFormula->Eval(0);
+        if (memcmp(&lValue, &lReference, sizeof(Double_t))) {
+            Warning("Evaluate", "%s: compiled definition gives %.17g instead of %.17g, using TFormula",
+                    GetName(), lValue, lReference);
+            fCode.Set(0);
+            fNCheckCompiled = 0;
+            lValue = lReference;
+        }
+    }
+    return fValue = lValue;
+}
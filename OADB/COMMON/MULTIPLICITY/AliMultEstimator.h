@@ -1,6 +1,9 @@
 #ifndef AliMultEstimator_H
 #define AliMultEstimator_H
 #include <TNamed.h>
+#include <TArrayI.h>
+#include <TArrayD.h>
+#include <TObjArray.h>
 class AliMultInput;
 class TFormula;
 
@@ -43,8 +46,21 @@ public:
     //Pre-processing for speed
     void SetupFormula(const AliMultInput* lInput);
     Float_t Evaluate(const AliMultInput* lInput);
+    //Evaluation through the TFormula only (reference for the compiled code)
+    Float_t EvaluateFormula(const AliMultInput* lInput);
+    //True if the definition is evaluated with the compiled code
+    Bool_t  IsCompiled() const { return fCode.GetSize() > 0; }
+    //Number of evaluations compared with the TFormula after each setup,
+    //falling back to the TFormula on mismatch (negative: all evaluations)
+    static void SetNCompiledChecks(Int_t lN);
+    static Int_t GetNCompiledChecks() { return fgNCompiledChecks; }
     
 private:
+    //Compile the definition into code for a small stack machine
+    Bool_t Compile(const AliMultInput* lInput, const TString& lExpr);
+    Double_t EvaluateCompiled() const;
+    
+
     TString fDefinition; //How to evaluate based on AliMultVariables
     Bool_t fIsInteger; //Requires special treatment when calibrating
     
@@ -53,11 +69,19 @@ private:
     Float_t fPercentile;   //Percentile
     TFormula* fFormula; //!
     
+    //Compiled definition (see Compile)
+    TArrayI   fCode;        //! Operations and their operands
+    TArrayD   fConstants;   //! Numerical constants of the definition
+    TObjArray fVariables;   //! Variables used by the definition (not owned)
+    const AliMultInput* fCompiledInput; //! Input the variables belong to
+    Int_t     fNCheckCompiled; //! Evaluations still to compare with the TFormula
+    static Int_t fgNCompiledChecks; // Evaluations compared after each setup
+    
     //Anchor point definition
     Bool_t  fkUseAnchor;        //Use Anchor Logic (default: No)
     Float_t fAnchorPoint;       //Raw value below which
     Float_t fAnchorPercentile;  //Percentile of X-section at anchor point
     
-    ClassDef(AliMultEstimator, 1)
+    ClassDef(AliMultEstimator, 2)
 };
 #endif
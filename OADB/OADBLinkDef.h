@@ -24,6 +24,7 @@
 #pragma link C++ class AliCollisionNormalizationTask+;
 #pragma link C++ class AliEventCuts+;
 #pragma link C++ class AliEventCutsContainer+;
+#pragma link C++ class AliEventCutsResultCache+;
 #pragma link C++ class AliTimeRangeMask<ULong64_t, UShort_t>+;
 #pragma link C++ class AliTimeRangeMasking<ULong64_t, UShort_t>+;
 #pragma link C++ class AliTimeRangeCut;
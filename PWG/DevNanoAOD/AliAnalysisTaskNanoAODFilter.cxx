@@ -42,6 +42,7 @@
 #include "AliNanoAODReplicator.h"
 #include "AliNanoAODTrackMapping.h"
 #include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackColumns.h"
 #include "AliNanoFilterNormalisation.h"
 #include "AliMultSelectionTask.h"
 
@@ -139,7 +140,8 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
 
   ext->DropUnspecifiedBranches(); // all branches not part of a FilterBranch call (below) will be dropped
       
-  ext->FilterBranch("tracks",fReplicator);
+  if (!fReplicator->GetColumnarTracks()) // otherwise the track columns are added to the tree in UserExec
+    ext->FilterBranch("tracks",fReplicator);
   ext->FilterBranch("vertices",fReplicator);  
   ext->FilterBranch("header",fReplicator);  
             
@@ -198,6 +200,7 @@ void AliAnalysisTaskNanoAODFilter::UserExec(Option_t *)
    if ( extNanoAOD ) {				
      extNanoAOD->SetEvent(lAODevent);
      extNanoAOD->SelectEvent();
+     fReplicator->ConnectTrackColumns(extNanoAOD->GetTree()); // only once, and only in columnar mode
      extNanoAOD->FinishEvent();
    }
   }
@@ -228,6 +231,15 @@ void AliAnalysisTaskNanoAODFilter::FinishTaskOutput() {
   Printf("****************************************************************");
   
   extNanoAOD->GetTree()->GetUserInfo()->Add(fNormalisation->Clone());
+
+  if (fReplicator->GetTrackColumns()) {
+    extNanoAOD->GetTree()->FlushBaskets();
+    TH1* columnSizes = fReplicator->GetTrackColumns()->GetColumnSizes(extNanoAOD->GetTree());
+    Printf("Compressed size of the track columns (bytes/event):");
+    for (Int_t i=1; i<=columnSizes->GetNbinsX(); i++)
+      Printf("  %-40s %10.1f", columnSizes->GetXaxis()->GetBinLabel(i), columnSizes->GetBinContent(i));
+    extNanoAOD->GetTree()->GetUserInfo()->Add(columnSizes);
+  }
 }
 
 void AliAnalysisTaskNanoAODFilter::AddPIDField(AliNanoAODTrack::ENanoPIDResponse response, AliPID::EParticleType particle)
@@ -56,6 +56,7 @@ public:
   void  SaveConversionPhotons(Bool_t var, AliAnalysisCuts* cuts = 0) { fReplicator->SetSaveConversionPhotons(var); fReplicator->SetConversionPhotonCuts(cuts); if (fSaveCutsFlag && cuts) fQAOutput->Add(cuts); }
   void  SaveConversionPhotonsFromDelta(Bool_t var, TString name, AliAnalysisCuts* cuts = 0) { fReplicator->SetSaveConversionPhotons(var); fReplicator->SetPhotonDeltaBranchName(name); fReplicator->SetConversionPhotonCuts(cuts); if (fSaveCutsFlag && cuts) fQAOutput->Add(cuts); }
   void  FilterMCStack(AliAnalysisCuts* cuts = nullptr) { fReplicator->SetMCParticleCuts(cuts); if (fSaveCutsFlag && cuts) fQAOutput->Add(cuts); }
+  void  SetColumnarTracks(Bool_t var)                     { fReplicator->SetColumnarTracks(var); }
   
   AliNanoAODReplicator* GetReplicator() { return fReplicator; }
 
@@ -67,6 +67,8 @@ class AliAODRecoDecay;
 #include "TH1.h"
 #include "TCanvas.h"
 #include "AliNanoAODHeader.h"
+#include "AliNanoAODTrackColumns.h"
+#include "TTree.h"
 #include "AliNanoAODCustomSetter.h"
 #include "AliV0ReaderV1.h"
 #include "AliAnalysisNanoAODCuts.h"
@@ -111,6 +113,8 @@ AliAODBranchReplicator(),
   fDeltaAODBranchName(""),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fColumnarTracks(kFALSE),
+  fTrackColumns(0x0),
   fKeepDaughters(),
   fClonedVertices()
   {
@@ -151,6 +155,8 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title)
   fDeltaAODBranchName(""),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fColumnarTracks(kFALSE),
+  fTrackColumns(0x0),
   fKeepDaughters(),
   fClonedVertices()
 {
@@ -163,6 +169,9 @@ AliNanoAODReplicator::~AliNanoAODReplicator()
   // dtor
   delete fTrackCuts;
   delete fList;
+  if (fColumnarTracks)
+    delete fTracks; // not owned by fList in columnar mode
+  delete fTrackColumns;
 }
 
 //_____________________________________________________________________________
@@ -568,13 +577,21 @@ TList* AliNanoAODReplicator::GetList() const
         if (AliNanoAODTrackMapping::GetInstance()->GetVarIndex("ID") == -1)
           AliFatal("Conversion Photons requested but field 'id' missing in track variables");
       }
+      if (fColumnarTracks) {
+        // V0s, cascades and photons reference their daughters with TRefs to the track array
+        if (fSaveV0s || fSaveCascades || fSaveConversionPhotons)
+          AliFatal("Columnar tracks cannot be used together with V0s, cascades or conversion photons");
+        AliNanoAODTrackMapping::GetInstance(fVarList);
+      }
       
       fList = new TList;
       fList->SetOwner(kTRUE);
 
+      // in columnar mode the array is only used internally and the tracks are written by fTrackColumns
       fTracks = new TClonesArray("AliNanoAODTrack");
       fTracks->SetName(fOutputArrayName.Data());
-      fList->Add(fTracks);
+      if (!fColumnarTracks)
+        fList->Add(fTracks);
 
       Int_t numberOfHeaderParam = 0;
       Int_t numberOfHeaderParamInt = 0;
@@ -884,6 +901,22 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   if ( fMCMode > 0 ) {
     FilterMC(source);      
   }
+
+  // copy to the columns after the MC relabelling
+  if (fTrackColumns)
+    fTrackColumns->Fill(fTracks);
+}
+
+//_____________________________________________________________________________
+void AliNanoAODReplicator::ConnectTrackColumns(TTree* tree)
+{
+  // create the column branches of the tracks in the output tree (columnar mode)
+  
+  if (!fColumnarTracks || fTrackColumns)
+    return;
+  
+  fTrackColumns = new AliNanoAODTrackColumns(fOutputArrayName.Data());
+  fTrackColumns->Branch(tree);
 }
 
 void AliNanoAODReplicator::Terminate()
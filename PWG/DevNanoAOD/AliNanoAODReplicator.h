@@ -52,6 +52,8 @@ class AliNanoAODTrack;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
 class AliAODZDC;
+class AliNanoAODTrackColumns;
+class TTree;
 
 class AliNanoAODReplicator : public AliAODBranchReplicator
 {
@@ -97,6 +99,11 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
 
   void SetVarListHeaderTC(TString var) {fVarListHeader_fTC=var;}
+
+  void SetColumnarTracks(Bool_t b) { fColumnarTracks = b; }
+  Bool_t GetColumnarTracks() const { return fColumnarTracks; }
+  AliNanoAODTrackColumns* GetTrackColumns() const { return fTrackColumns; }
+  void ConnectTrackColumns(TTree* tree);
     
  private:
 
@@ -152,6 +159,9 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   TString fInputArrayName; // name of array if tracks are stored in a TObjectArray
   TString fOutputArrayName; // name of the output array, where the NanoAODTracks are stored
+
+  Bool_t fColumnarTracks; // if kTRUE the tracks are stored as one branch per variable (AliNanoAODTrackColumns) instead of a TClonesArray
+  AliNanoAODTrackColumns* fTrackColumns; //! columnar track storage (fColumnarTracks)
   
   std::map<AliAODVertex*, std::vector<TObject*> > fKeepDaughters; //! Tracks needed as references to V0s and cascades
   std::map<AliAODVertex*, AliAODVertex*> fClonedVertices; //! avoid that vertices are stored several times
@@ -159,7 +169,7 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
 
-  ClassDef(AliNanoAODReplicator, 7) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator, 8) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
@@ -0,0 +1,199 @@
+#include "AliNanoAODTrackColumns.h"
+#include "AliNanoAODTrackMapping.h"
+#include "AliNanoAODTrack.h"
+#include "AliLog.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TClonesArray.h"
+#include "TH1D.h"
+#include <set>
+
+ClassImp(AliNanoAODTrackColumns)
+
+AliNanoAODTrackColumns::AliNanoAODTrackColumns() :
+  TObject(),
+  fPrefix("tracks"),
+  fVars(),
+  fVarsInt(),
+  fLabel(0),
+  fNanoFlags(0),
+  fBranchNames(),
+  fPt(0),
+  fPhi(0),
+  fTheta(0),
+  fID(0),
+  fTPCncls(0),
+  fFilterMap(0),
+  fStatusHigh(0),
+  fStatusLow(0)
+{
+  /// default ctor
+}
+
+AliNanoAODTrackColumns::AliNanoAODTrackColumns(const char * prefix) :
+  TObject(),
+  fPrefix(prefix),
+  fVars(),
+  fVarsInt(),
+  fLabel(0),
+  fNanoFlags(0),
+  fBranchNames(),
+  fPt(0),
+  fPhi(0),
+  fTheta(0),
+  fID(0),
+  fTPCncls(0),
+  fFilterMap(0),
+  fStatusHigh(0),
+  fStatusLow(0)
+{
+  /// ctor: prefix is used for the branch names (<prefix>_<variable>)
+}
+
+AliNanoAODTrackColumns::~AliNanoAODTrackColumns()
+{
+  /// dtor
+  DeleteColumns();
+}
+
+void AliNanoAODTrackColumns::DeleteColumns()
+{
+  for (UInt_t i=0; i<fVars.size(); i++)    delete fVars[i];
+  for (UInt_t i=0; i<fVarsInt.size(); i++) delete fVarsInt[i];
+  fVars.clear();
+  fVarsInt.clear();
+  delete fLabel;
+  delete fNanoFlags;
+  fLabel = 0;
+  fNanoFlags = 0;
+  fBranchNames.clear();
+}
+
+void AliNanoAODTrackColumns::CreateColumns()
+{
+  /// allocate one column per variable of the current AliNanoAODTrackMapping
+
+  if (fLabel)
+    return;
+
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  std::set<TString> usedNames;
+  for (Int_t i=0; i<mapping->GetSize(); i++) {
+    fVars.push_back(new std::vector<Float_t>);
+    TString name(mapping->GetVarName(i));
+    name.ReplaceAll(".", "_");
+    name.Prepend(fPrefix + "_");
+    if (usedNames.count(name)) name += TString::Format("_%d", i);
+    usedNames.insert(name);
+    fBranchNames.push_back(name);
+  }
+  for (Int_t i=0; i<mapping->GetSizeInt(); i++) {
+    fVarsInt.push_back(new std::vector<Int_t>);
+    TString name(mapping->GetVarNameInt(i));
+    name.Prepend(fPrefix + "_");
+    if (usedNames.count(name)) name += TString::Format("_%d", i); // e.g. the two words of the status
+    usedNames.insert(name);
+    fBranchNames.push_back(name);
+  }
+  fLabel = new std::vector<Int_t>;
+  fBranchNames.push_back(fPrefix + "_Label");
+  fNanoFlags = new std::vector<UInt_t>;
+  fBranchNames.push_back(fPrefix + "_NanoFlags");
+
+  ResolveColumns();
+}
+
+void AliNanoAODTrackColumns::ResolveColumns()
+{
+  /// look up once the columns used by AliNanoAODTrackView
+
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  fPt         = mapping->GetPt()        != -1 ? fVars[mapping->GetPt()]           : 0;
+  fPhi        = mapping->GetPhi()       != -1 ? fVars[mapping->GetPhi()]          : 0;
+  fTheta      = mapping->GetTheta()     != -1 ? fVars[mapping->GetTheta()]        : 0;
+  fID         = mapping->GetID()        != -1 ? fVars[mapping->GetID()]           : 0;
+  fTPCncls    = mapping->GetTPCncls()   != -1 ? fVarsInt[mapping->GetTPCncls()]   : 0;
+  fFilterMap  = mapping->GetFilterMap() != -1 ? fVarsInt[mapping->GetFilterMap()] : 0;
+  fStatusHigh = mapping->GetStatus()    != -1 ? fVarsInt[mapping->GetStatus()]    : 0;
+  fStatusLow  = mapping->GetStatus()    != -1 ? fVarsInt[mapping->GetStatus()+1]  : 0;
+}
+
+void AliNanoAODTrackColumns::Branch(TTree * tree)
+{
+  /// create the column branches in the output tree. Must be called before the first Fill of the tree
+
+  CreateColumns();
+
+  Int_t iBranch = 0;
+  for (UInt_t i=0; i<fVars.size(); i++)
+    tree->Branch(fBranchNames[iBranch++].Data(), &fVars[i]);
+  for (UInt_t i=0; i<fVarsInt.size(); i++)
+    tree->Branch(fBranchNames[iBranch++].Data(), &fVarsInt[i]);
+  tree->Branch(fBranchNames[iBranch++].Data(), &fLabel);
+  tree->Branch(fBranchNames[iBranch++].Data(), &fNanoFlags);
+}
+
+void AliNanoAODTrackColumns::Fill(const TClonesArray * tracks)
+{
+  /// copy the tracks of the current event into the columns
+
+  for (UInt_t i=0; i<fVars.size(); i++)    fVars[i]->clear();
+  for (UInt_t i=0; i<fVarsInt.size(); i++) fVarsInt[i]->clear();
+  fLabel->clear();
+  fNanoFlags->clear();
+
+  const Int_t nTracks = tracks->GetEntriesFast();
+  for (Int_t iTrack=0; iTrack<nTracks; iTrack++) {
+    AliNanoAODTrack * track = static_cast<AliNanoAODTrack*>(tracks->UncheckedAt(iTrack));
+    for (UInt_t i=0; i<fVars.size(); i++)    fVars[i]->push_back(track->GetVar(i));
+    for (UInt_t i=0; i<fVarsInt.size(); i++) fVarsInt[i]->push_back(track->GetVarInt(i));
+    fLabel->push_back(track->GetLabel());
+    fNanoFlags->push_back(track->GetNanoFlags());
+  }
+}
+
+Bool_t AliNanoAODTrackColumns::Connect(TTree * tree)
+{
+  /// connect to the column branches of a NanoAOD tree and resolve the columns.
+  /// The mapping is taken from the user info of the file (AliNanoAODTrackMapping::GetInstance)
+
+  CreateColumns();
+
+  Int_t iBranch = 0;
+  for (UInt_t i=0; i<fVars.size(); i++, iBranch++) {
+    if (!tree->GetBranch(fBranchNames[iBranch].Data())) {
+      AliError(Form("Branch %s not found", fBranchNames[iBranch].Data()));
+      return kFALSE;
+    }
+    tree->SetBranchAddress(fBranchNames[iBranch].Data(), &fVars[i]);
+  }
+  for (UInt_t i=0; i<fVarsInt.size(); i++, iBranch++) {
+    if (!tree->GetBranch(fBranchNames[iBranch].Data())) {
+      AliError(Form("Branch %s not found", fBranchNames[iBranch].Data()));
+      return kFALSE;
+    }
+    tree->SetBranchAddress(fBranchNames[iBranch].Data(), &fVarsInt[i]);
+  }
+  tree->SetBranchAddress(fBranchNames[iBranch++].Data(), &fLabel);
+  tree->SetBranchAddress(fBranchNames[iBranch++].Data(), &fNanoFlags);
+
+  ResolveColumns();
+  return kTRUE;
+}
+
+TH1* AliNanoAODTrackColumns::GetColumnSizes(TTree * tree) const
+{
+  /// histogram of the compressed size per event (bytes) of each column branch
+
+  const Int_t nColumns = fBranchNames.size();
+  TH1D * hist = new TH1D(fPrefix + "_ColumnSizes", "Compressed size per event;;bytes/event", nColumns, -0.5, nColumns - 0.5);
+  hist->SetDirectory(0);
+  const Double_t nEvents = tree->GetEntries();
+  for (Int_t i=0; i<nColumns; i++) {
+    hist->GetXaxis()->SetBinLabel(i+1, fBranchNames[i].Data());
+    TBranch * branch = tree->GetBranch(fBranchNames[i].Data());
+    if (branch && nEvents > 0)
+      hist->SetBinContent(i+1, branch->GetZipBytes("*") / nEvents);
+  }
+  return hist;
+}
@@ -0,0 +1,121 @@
+/// \class AliNanoAODTrackColumns
+/// \brief Columnar storage of NanoAOD tracks
+///
+/// Instead of a TClonesArray of AliNanoAODTrack, the tracks of an event are stored as
+/// one branch per variable of the AliNanoAODTrackMapping (struct-of-arrays), each branch
+/// holding the values of all the tracks of the event. Homogeneous columns compress better
+/// and a reader only reads the columns it needs.
+///
+/// Writing is done by AliNanoAODReplicator (SetColumnarTracks). For reading, call
+/// Connect(tree) once per file (e.g. in UserNotify): the column of each variable is
+/// resolved there, so that the AliNanoAODTrackView accessors do not need any lookup
+/// in the mapping.
+
+#ifndef _ALINANOAODTRACKCOLUMNS_H_
+#define _ALINANOAODTRACKCOLUMNS_H_
+
+#include "TObject.h"
+#include "TString.h"
+#include "TMath.h"
+#include "AliNanoAODTrack.h"
+#include <vector>
+
+class TTree;
+class TClonesArray;
+class TH1;
+class AliNanoAODTrackView;
+
+class AliNanoAODTrackColumns : public TObject
+{
+public:
+  AliNanoAODTrackColumns();
+  AliNanoAODTrackColumns(const char * prefix);
+  virtual ~AliNanoAODTrackColumns();
+
+  // writing
+  void   Branch(TTree * tree);                  // create one branch per variable of the mapping
+  void   Fill(const TClonesArray * tracks);     // copy the AliNanoAODTracks of the event into the columns
+
+  // reading
+  Bool_t Connect(TTree * tree);                 // set the branch addresses, resolve the columns. Once per file
+
+  Int_t  GetNumberOfTracks() const { return fLabel ? fLabel->size() : 0; }
+  inline AliNanoAODTrackView GetTrack(Int_t i) const;
+
+  Int_t       GetNColumns() const { return fBranchNames.size(); }
+  const char* GetColumnName(Int_t i) const { return fBranchNames[i].Data(); }
+  TH1*        GetColumnSizes(TTree * tree) const; // compressed bytes/event of each column
+
+private:
+  friend class AliNanoAODTrackView;
+
+  void CreateColumns();
+  void DeleteColumns();
+  void ResolveColumns();
+
+  TString fPrefix;                             ///< prefix of the branch names
+  std::vector<std::vector<Float_t>*> fVars;    //!<! one column per float variable of the mapping
+  std::vector<std::vector<Int_t>*>   fVarsInt; //!<! one column per int variable of the mapping
+  std::vector<Int_t>*  fLabel;                 //!<! MC label column
+  std::vector<UInt_t>* fNanoFlags;             //!<! nano flags column
+  std::vector<TString> fBranchNames;           //!<! names of the branches (float, int, label, flags)
+
+  // columns resolved once per file
+  const std::vector<Float_t>* fPt;             //!<! pt column
+  const std::vector<Float_t>* fPhi;            //!<! phi column
+  const std::vector<Float_t>* fTheta;          //!<! theta column
+  const std::vector<Float_t>* fID;             //!<! ID column
+  const std::vector<Int_t>*   fTPCncls;        //!<! TPCncls column
+  const std::vector<Int_t>*   fFilterMap;      //!<! FilterMap column
+  const std::vector<Int_t>*   fStatusHigh;     //!<! Status column (high word)
+  const std::vector<Int_t>*   fStatusLow;      //!<! Status column (low word)
+
+  AliNanoAODTrackColumns(const AliNanoAODTrackColumns&); // not implemented
+  AliNanoAODTrackColumns& operator=(const AliNanoAODTrackColumns&); // not implemented
+
+  ClassDef(AliNanoAODTrackColumns, 1)
+};
+
+/// \class AliNanoAODTrackView
+/// \brief Light accessor to a track of AliNanoAODTrackColumns
+///
+/// Same getters as AliNanoAODTrack for the most used variables; the variable
+/// must be part of the track variable list (-999 is returned otherwise).
+class AliNanoAODTrackView
+{
+public:
+  AliNanoAODTrackView(const AliNanoAODTrackColumns * columns, Int_t index) : fColumns(columns), fIndex(index) {}
+
+  Double_t Pt()    const { return fColumns->fPt    ? (*fColumns->fPt)   [fIndex] : -999.; }
+  Double_t Phi()   const { return fColumns->fPhi   ? (*fColumns->fPhi)  [fIndex] : -999.; }
+  Double_t Theta() const { return fColumns->fTheta ? (*fColumns->fTheta)[fIndex] : -999.; }
+  Double_t Eta()   const { return -TMath::Log(TMath::Tan(0.5 * Theta())); }
+  Double_t Px()    const { return Pt() * TMath::Cos(Phi()); }
+  Double_t Py()    const { return Pt() * TMath::Sin(Phi()); }
+  Double_t Pz()    const { return Pt() / TMath::Tan(Theta()); }
+
+  Short_t  Charge() const { return TESTBIT((*fColumns->fNanoFlags)[fIndex], AliNanoAODTrack::kNanoCharge) ? 1 : -1; }
+  Bool_t   HasPointOnITSLayer(Int_t i) const { return TESTBIT((*fColumns->fNanoFlags)[fIndex], i+AliNanoAODTrack::kNanoClusterITS0); }
+  UInt_t   GetNanoFlags() const { return (*fColumns->fNanoFlags)[fIndex]; }
+  Int_t    GetLabel() const { return (*fColumns->fLabel)[fIndex]; }
+  Int_t    GetID() const { return fColumns->fID ? (Int_t) (*fColumns->fID)[fIndex] : -999; }
+  UShort_t GetTPCncls() const { return fColumns->fTPCncls ? (*fColumns->fTPCncls)[fIndex] : 0; }
+  UInt_t   GetFilterMap() const { return fColumns->fFilterMap ? (*fColumns->fFilterMap)[fIndex] : 0; }
+  Bool_t   TestFilterBit(UInt_t filterBit) const { return (Bool_t) ((filterBit & GetFilterMap()) != 0); }
+  ULong64_t GetStatus() const { return fColumns->fStatusHigh ? (ULong64_t((*fColumns->fStatusHigh)[fIndex]) << 32) + UInt_t((*fColumns->fStatusLow)[fIndex]) : 0; }
+
+  /// generic access with the index of AliNanoAODTrackMapping (e.g. AliNanoAODTrack::GetPIDIndex)
+  Double_t GetVar(Int_t index)    const { return (*fColumns->fVars[index])[fIndex]; }
+  Int_t    GetVarInt(Int_t index) const { return (*fColumns->fVarsInt[index])[fIndex]; }
+
+private:
+  const AliNanoAODTrackColumns * fColumns; ///< columns of the event
+  Int_t fIndex;                            ///< index of the track in the columns
+};
+
+inline AliNanoAODTrackView AliNanoAODTrackColumns::GetTrack(Int_t i) const
+{
+  return AliNanoAODTrackView(this, i);
+}
+
+#endif /* _ALINANOAODTRACKCOLUMNS_H_ */
@@ -35,6 +35,11 @@
 #include <TH1F.h>
 #include <TRandom3.h>
 #include <TList.h>
+#include <TMap.h>
+#include <TObjString.h>
+#include <TArrayI.h>
+#include <TEnv.h>
+#include <TTreeCacheUnzip.h>
 
 #include <AliLog.h>
 #include <AliAnalysisManager.h>
@@ -169,7 +174,13 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fAcceptedEntryIndexFilename(""),
+  fEmbeddedTreeCacheSize(0),
+  fEmbeddedTreeAsyncPrefetching(false),
+  fAcceptedEntries(),
+  fCurrentAcceptedEntries(nullptr),
+  fSelectingForIndex(false)
 {
   if (fgInstance != nullptr) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -243,7 +254,13 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fAcceptedEntryIndexFilename(""),
+  fEmbeddedTreeCacheSize(0),
+  fEmbeddedTreeAsyncPrefetching(false),
+  fAcceptedEntries(),
+  fCurrentAcceptedEntries(nullptr),
+  fSelectingForIndex(false)
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -328,6 +345,10 @@ void AliAnalysisTaskEmcalEmbeddingHelper::RetrieveTaskPropertiesFromYAMLConfig()
   res = fYAMLConfig.GetProperty("randomFileAccess", fRandomFileAccess, false);
   res = fYAMLConfig.GetProperty("createHisto", fCreateHisto, false);
   res = fYAMLConfig.GetProperty("printTimingInfoInLog", fPrintTimingInfoToLog, false);
+  // Reading of the embedded events
+  res = fYAMLConfig.GetProperty("acceptedEntryIndexFilename", fAcceptedEntryIndexFilename, false);
+  res = fYAMLConfig.GetProperty("embeddedTreeCacheSize", fEmbeddedTreeCacheSize, false);
+  res = fYAMLConfig.GetProperty("embeddedTreeAsyncPrefetching", fEmbeddedTreeAsyncPrefetching, false);
   // More general embedding helper properties
   res = fYAMLConfig.GetProperty("filePattern", fFilePattern, false);
   res = fYAMLConfig.GetProperty("inputFilename", fInputFilename, false);
@@ -823,50 +844,50 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
   Int_t attempts = -1;
 
   do {
-    // Reset to start of tree
-    if (fCurrentEntry == fUpperEntry) {
-      fCurrentEntry = fLowerEntry;
-      fWrappedAroundTree = true;
-    }
+    // Find the next entry to load. If the tree is included in the accepted entry index, the entries which are
+    // known to fail the embedded event selection are skipped without being read.
+    do {
+      // Reset to start of tree
+      if (fCurrentEntry == fUpperEntry) {
+        fCurrentEntry = fLowerEntry;
+        fWrappedAroundTree = true;
+      }
 
-    if ((fCurrentEntry < fLowerEntry + fOffset) || !fWrappedAroundTree) {
-      // Continue with GetEntry as normal
-    }
-    else {
-      // NOTE: On transition from one file to the next, this calls the next entry that would be expected.
-      //       However, if it is for the last file, it tries to GetEntry() of one entry past the end of the last
-      //       file. Normally, this would be a problem, however GetEntry() just doesn't fill the fields of an
-      //       invalid index instead of throwing an error. So "invalid values" are filled for a file that doesn't
-      //       exist, but then they are immediately replaced by the lines below that reset the access values and
-      //       re-init the tree. The benefit of this approach is it simplies file counting (we don't need to
-      //       carefully increment here and in InitTree()) and preserves the desired behavior when we are not at
-      //       the last file.
-      InitTree();
-    }
+      if ((fCurrentEntry < fLowerEntry + fOffset) || !fWrappedAroundTree) {
+        // Continue with GetEntry as normal
+      }
+      else {
+        // NOTE: On transition from one file to the next, this calls the next entry that would be expected.
+        //       However, if it is for the last file, it tries to GetEntry() of one entry past the end of the last
+        //       file. Normally, this would be a problem, however GetEntry() just doesn't fill the fields of an
+        //       invalid index instead of throwing an error. So "invalid values" are filled for a file that doesn't
+        //       exist, but then they are immediately replaced by the lines below that reset the access values and
+        //       re-init the tree. The benefit of this approach is it simplies file counting (we don't need to
+        //       carefully increment here and in InitTree()) and preserves the desired behavior when we are not at
+        //       the last file.
+        InitTree();
+      }
+
+      // Can be a simple less than, because fFileNumber counts from 0.
+      if (fFileNumber >= fMaxNumberOfFiles) {
+        AliError("====================================================================================================");
+        AliError("== No more files available to embed from the TChain! Restarting from the beginning of the TChain! ==");
+        AliError("== Be careful to check that this is the desired action!                                           ==");
+        AliError("====================================================================================================");
+
+        // Reset the relevant access values
+        // fCurrentEntry and fLowerEntry are automatically reset in InitTree()
+        fFileNumber = 0;
+        fUpperEntry = 0;
+
+        // Re-init back to the start
+        // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
+        InitTree();
+      }
+    } while (!SkipToAcceptedEntry());
 
     // Load current event
-    // Can be a simple less than, because fFileNumber counts from 0.
-    if (fFileNumber < fMaxNumberOfFiles) {
-      fChain->GetEntry(fCurrentEntry);
-    }
-    else {
-      AliError("====================================================================================================");
-      AliError("== No more files available to embed from the TChain! Restarting from the beginning of the TChain! ==");
-      AliError("== Be careful to check that this is the desired action!                                           ==");
-      AliError("====================================================================================================");
-
-      // Reset the relevant access values
-      // fCurrentEntry and fLowerEntry are automatically reset in InitTree()
-      fFileNumber = 0;
-      fUpperEntry = 0;
-
-      // Re-init back to the start
-      InitTree();
-
-      // Access the relevant entry
-      // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
-      fChain->GetEntry(fCurrentEntry);
-    }
+    fChain->GetEntry(fCurrentEntry);
     AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
 
     // Set relevant event properties
@@ -1019,10 +1040,10 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
   Double_t externalVertex[3]={0};
   Double_t inputVertex[3]={0};
   const AliVVertex *externalVert = fExternalEvent->GetPrimaryVertex();
-  const AliVVertex *inputVert = AliAnalysisTaskSE::InputEvent()->GetPrimaryVertex();
-  if (externalVert && inputVert) {
+  // There is no internal event when creating the accepted entry index
+  const AliVVertex *inputVert = fSelectingForIndex ? nullptr : AliAnalysisTaskSE::InputEvent()->GetPrimaryVertex();
+  if (externalVert && (inputVert || fSelectingForIndex)) {
     externalVert->GetXYZ(externalVertex);
-    inputVert->GetXYZ(inputVertex);
 
     if (TMath::Abs(externalVertex[2]) > fZVertexCut) {
       AliDebug(3, Form("Event rejected due to Z vertex selection. Event Z vertex: %f, Z vertex cut: %f",
@@ -1032,6 +1053,10 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
       }
       return kFALSE;
     }
+  }
+  // The distance to the internal event vertex cannot be part of the accepted entry index
+  if (externalVert && inputVert) {
+    inputVert->GetXYZ(inputVertex);
     Double_t dist = TMath::Sqrt((externalVertex[0]-inputVertex[0])*(externalVertex[0]-inputVertex[0])+(externalVertex[1]-inputVertex[1])*(externalVertex[1]-inputVertex[1])+(externalVertex[2]-inputVertex[2])*(externalVertex[2]-inputVertex[2]));
     if (dist > fMaxVertexDist) {
       AliDebug(3, Form("Event rejected because the distance between the current and embedded vertices is > %f. "
@@ -1069,7 +1094,9 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()
         //Compare jet pT and pt Hard
         if (jet.Pt() > fPtHardJetPtRejectionFactor * fPythiaPtHard) {
           AliDebugStream(3) << "Event rejected because of MC outlier removal. Pythia header jet with: pT Hard " << fPythiaPtHard << ", pycell jet pT " << jet.Pt() << ", rejection factor " << fPtHardJetPtRejectionFactor << "\n";
-          fHistManager.FillTH1("fHistEmbeddedEventRejection", "MCOutlier", 1);
+          if (fCreateHisto) {
+            fHistManager.FillTH1("fHistEmbeddedEventRejection", "MCOutlier", 1);
+          }
           return kFALSE;
         }
       }
@@ -1207,6 +1234,13 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserCreateOutputObjects()
   }
   histEmbeddedEventRejection->GetYaxis()->SetTitle("Counts");
 
+  // Entries which were not read thanks to the accepted entry index
+  if (fAcceptedEntryIndexFilename != "") {
+    histName = "fHistEntriesSkippedByIndex";
+    histTitle = "Number of embedded entries skipped using the accepted entry index;;Number of entries";
+    fHistManager.CreateTH1(histName, histTitle, 1, 0, 1);
+  }
+
   // Rejected events in embedded event selection
   histName = "fHistEmbeddedEventsAttempted";
   histTitle = "Number of embedded events rejected by event selection before success;Number of rejected events;Counts";
@@ -1323,10 +1357,16 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
     AliErrorStream() << "Number of input files (" << fFilenames.size() << ") is larger than the number of available files (" << fMaxNumberOfFiles << "). Something went wrong when adding some of those files to the TChain!\n";
   }
 
+  // Setup reading ahead of the embedded events. Must be done before any file in the TChain is opened.
+  SetupEmbeddedTreeCache();
+
   // Setup input event
   Bool_t res = InitEvent();
   if (!res) return kFALSE;
 
+  // Restrict the embedded events to the accepted entries, if available
+  LoadAcceptedEntryIndex();
+
   return kTRUE;
 }
 
@@ -1442,6 +1482,16 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   // next tree (in the next file) since entries are indexed starting from 0.
   fChain->GetEntry(fUpperEntry);
 
+  // All branches of the embedded event are read, so the tree cache does not need to learn them
+  if (fEmbeddedTreeCacheSize > 0) {
+    fChain->AddBranchToCache("*", kTRUE);
+    fChain->StopCacheLearningPhase();
+  }
+
+  // Accepted entries of the new tree, if it is included in the accepted entry index
+  auto acceptedEntries = fAcceptedEntries.find(fChain->GetTreeNumber());
+  fCurrentAcceptedEntries = (acceptedEntries != fAcceptedEntries.end()) ? &(acceptedEntries->second) : nullptr;
+
   // Determine tree size and current entry
   // Set the limits of the new tree
   fLowerEntry = fUpperEntry;
@@ -1510,6 +1560,245 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
 
 }
 
+/**
+ * Setup the TTreeCache of the embedded TChain, so that the baskets of the embedded events are read
+ * in a few large requests rather than one request per branch and entry. If requested, the baskets of
+ * the next cluster of entries are also read (TFile asynchronous prefetching) and decompressed
+ * (TTreeCacheUnzip) in background threads while the current event is processed.
+ *
+ * NOTE: Asynchronous prefetching is a global ROOT setting, so it also applies to the other files
+ *       opened in the same process.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::SetupEmbeddedTreeCache()
+{
+  if (fEmbeddedTreeCacheSize <= 0) {
+    if (fEmbeddedTreeAsyncPrefetching) {
+      AliWarningStream() << "Asynchronous prefetching requires the embedded tree cache. Set its size to enable it.\n";
+    }
+    return;
+  }
+
+  if (fEmbeddedTreeAsyncPrefetching) {
+    AliInfoStream() << "Enabling asynchronous prefetching and parallel unzipping of the embedded events.\n";
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+    TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+  }
+
+  AliDebugStream(2) << "Setting the embedded tree cache size to " << fEmbeddedTreeCacheSize << " bytes.\n";
+  fChain->SetCacheSize(fEmbeddedTreeCacheSize);
+}
+
+/**
+ * Describes the embedded event selection which is applied when creating the accepted entry index.
+ * An index is only used if it was created with the same selection.
+ *
+ * @return String describing the selection.
+ */
+std::string AliAnalysisTaskEmcalEmbeddingHelper::AcceptedEntryIndexSelection() const
+{
+  std::stringstream tempSS;
+  tempSS << "treeName: " << fTreeName << ", triggerMask: " << fTriggerMask << ", zVertexCut: " << fZVertexCut;
+  tempSS << ", rejectOutliers: " << fMCRejectOutliers << ", ptHardJetPtRejectionFactor: " << fPtHardJetPtRejectionFactor;
+  return tempSS.str();
+}
+
+/**
+ * Create an index of the entries of each file to embed which pass the embedded event selection, and write
+ * it to a file. The index is then used by setting it with SetAcceptedEntryIndexFilename(), such that only
+ * the accepted entries are read during embedding. It must be called after Initialize(), such that the
+ * files to embed are known. It is meant to run once as a pre-pass (for example, in a local macro), not on
+ * the train.
+ *
+ * Only the cuts which depend solely on the embedded event are part of the index: pt hard = 0, physics
+ * selection, z vertex and MC outliers. The distance to the internal event vertex (and the additional
+ * selection of derived classes) is still applied during embedding.
+ *
+ * @param[in] outputFilename Name of the file where the index is written.
+ *
+ * @return true if the index was created successfully.
+ */
+bool AliAnalysisTaskEmcalEmbeddingHelper::CreateAcceptedEntryIndex(const std::string & outputFilename)
+{
+  if (fFilenames.size() == 0) {
+    AliErrorStream() << "No files to embed. Check that Initialize() was called before creating the accepted entry index.\n";
+    return false;
+  }
+  if (fTreeName != "aodTree") {
+    AliErrorStream() << "The accepted entry index is only available when embedding AODs.\n";
+    return false;
+  }
+
+  // The selection is performed using the members of the task, so they are stored and restored afterwards.
+  AliVEvent * externalEvent = fExternalEvent;
+  AliGenPythiaEventHeader * pythiaHeader = fPythiaHeader;
+  bool createHisto = fCreateHisto;
+  fCreateHisto = false;
+  fSelectingForIndex = true;
+
+  // Accepted entries, keyed by the filename as it is added to the TChain
+  TMap index;
+  index.SetOwnerKeyValue(kTRUE, kTRUE);
+  Long64_t nEntries = 0;
+  Long64_t nAccepted = 0;
+  for (auto filename : fFilenames)
+  {
+    if (filename.find("alien://") != std::string::npos) {
+      ::ConnectToAliEn();
+    }
+
+    std::unique_ptr<TFile> file(TFile::Open(filename.c_str()));
+    TTree * tree = nullptr;
+    if (file && !file->IsZombie()) {
+      file->GetObject(fTreeName, tree);
+    }
+    if (!tree) {
+      AliWarningStream() << "Cannot read the tree \"" << fTreeName << "\" from file \"" << filename << "\". It will not be indexed.\n";
+      continue;
+    }
+
+    AliAODEvent event;
+    event.ReadFromTree(tree);
+    fExternalEvent = &event;
+    fPythiaHeader = nullptr;
+
+    std::vector<Int_t> accepted;
+    for (Long64_t entry = 0; entry < tree->GetEntries(); entry++)
+    {
+      tree->GetEntry(entry);
+      SetEmbeddedEventProperties();
+      // Derived classes may select on objects which are not available here, so only the base selection is applied
+      if (AliAnalysisTaskEmcalEmbeddingHelper::CheckIsEmbeddedEventSelected()) {
+        accepted.push_back(entry);
+      }
+    }
+    AliDebugStream(2) << "File \"" << filename << "\": " << accepted.size() << " out of " << tree->GetEntries() << " entries accepted.\n";
+    nEntries += tree->GetEntries();
+    nAccepted += accepted.size();
+
+    index.Add(new TObjString(filename.c_str()), new TArrayI(accepted.size(), accepted.data()));
+
+    // The event is deleted at the end of the iteration
+    tree->ResetBranchAddresses();
+    fPythiaHeader = nullptr;
+  }
+
+  fExternalEvent = externalEvent;
+  fPythiaHeader = pythiaHeader;
+  fCreateHisto = createHisto;
+  fSelectingForIndex = false;
+
+  std::unique_ptr<TFile> output(TFile::Open(outputFilename.c_str(), "RECREATE"));
+  if (!output || output->IsZombie()) {
+    AliErrorStream() << "Cannot open file \"" << outputFilename << "\" to write the accepted entry index.\n";
+    return false;
+  }
+  index.Write("AcceptedEntryIndex", TObject::kSingleKey);
+  TNamed selection("AcceptedEntryIndexSelection", AcceptedEntryIndexSelection().c_str());
+  selection.Write();
+  output->Close();
+
+  AliInfoStream() << "Accepted entry index written to \"" << outputFilename << "\": " << nAccepted << " out of " << nEntries << " entries in " << index.GetSize() << " files accepted.\n";
+
+  return true;
+}
+
+/**
+ * Load the accepted entry index (see CreateAcceptedEntryIndex()) for the files in the TChain. Files which are
+ * not in the index are embedded from all of their entries. If the index cannot be read or was created with
+ * a different embedded event selection, it is not used.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::LoadAcceptedEntryIndex()
+{
+  fAcceptedEntries.clear();
+  fCurrentAcceptedEntries = nullptr;
+  if (fAcceptedEntryIndexFilename == "") {
+    return;
+  }
+
+  if (fAcceptedEntryIndexFilename.find("alien://") != std::string::npos) {
+    ::ConnectToAliEn();
+  }
+  std::unique_ptr<TFile> file(TFile::Open(fAcceptedEntryIndexFilename.c_str()));
+  if (!file || file->IsZombie()) {
+    AliErrorStream() << "Cannot open the accepted entry index \"" << fAcceptedEntryIndexFilename << "\". All entries will be read.\n";
+    return;
+  }
+
+  TNamed * selectionPtr = nullptr;
+  TMap * indexPtr = nullptr;
+  file->GetObject("AcceptedEntryIndexSelection", selectionPtr);
+  file->GetObject("AcceptedEntryIndex", indexPtr);
+  std::unique_ptr<TNamed> selection(selectionPtr);
+  std::unique_ptr<TMap> index(indexPtr);
+  if (!selection || !index) {
+    AliErrorStream() << "File \"" << fAcceptedEntryIndexFilename << "\" does not contain an accepted entry index. All entries will be read.\n";
+    if (index) index->DeleteAll();
+    return;
+  }
+  if (AcceptedEntryIndexSelection() != selection->GetTitle()) {
+    AliErrorStream() << "The accepted entry index was created with the selection \"" << selection->GetTitle() << "\", but the current selection is \""
+             << AcceptedEntryIndexSelection() << "\". It will not be used.\n";
+    index->DeleteAll();
+    return;
+  }
+
+  // The files in the TChain are in the order in which they were added (ie. starting from fFilenameIndex)
+  TObjArray * chainFiles = fChain->GetListOfFiles();
+  int nMissing = 0;
+  Long64_t nAccepted = 0;
+  for (int i = 0; i < chainFiles->GetEntries(); i++)
+  {
+    TArrayI * entries = dynamic_cast<TArrayI *>(index->GetValue(chainFiles->At(i)->GetTitle()));
+    if (!entries) {
+      AliDebugStream(3) << "File \"" << chainFiles->At(i)->GetTitle() << "\" is not in the accepted entry index.\n";
+      nMissing++;
+      continue;
+    }
+    fAcceptedEntries[i] = std::vector<Int_t>(entries->GetArray(), entries->GetArray() + entries->GetSize());
+    nAccepted += entries->GetSize();
+  }
+  index->DeleteAll();
+
+  if (nMissing > 0) {
+    AliWarningStream() << nMissing << " out of " << chainFiles->GetEntries() << " files to embed are not in the accepted entry index. All of their entries will be read.\n";
+  }
+  else if (nAccepted == 0) {
+    AliFatal("No entries of the files to embed are accepted according to the accepted entry index!");
+  }
+  AliInfoStream() << "Using the accepted entry index \"" << fAcceptedEntryIndexFilename << "\" with " << nAccepted << " accepted entries.\n";
+}
+
+/**
+ * If the current tree is included in the accepted entry index and the current entry was not accepted, move
+ * to the next accepted entry of the tree. The move stops at the end of the tree and, after wrapping around,
+ * at the entry where embedding from this tree started, such that the wrapping and tree initialization in
+ * GetNextEntry() are unchanged.
+ *
+ * @return true if the current entry should be read.
+ */
+bool AliAnalysisTaskEmcalEmbeddingHelper::SkipToAcceptedEntry()
+{
+  if (!fCurrentAcceptedEntries) {
+    return true;
+  }
+
+  auto next = std::lower_bound(fCurrentAcceptedEntries->begin(), fCurrentAcceptedEntries->end(), fCurrentEntry - fLowerEntry);
+  if (next != fCurrentAcceptedEntries->end() && fLowerEntry + *next == fCurrentEntry) {
+    return true;
+  }
+
+  Int_t nextEntry = (next != fCurrentAcceptedEntries->end()) ? fLowerEntry + *next : fUpperEntry;
+  if (fWrappedAroundTree) {
+    nextEntry = std::min(nextEntry, fLowerEntry + fOffset);
+  }
+  if (fCreateHisto) {
+    fHistManager.FillTH1("fHistEntriesSkippedByIndex", 0.5, nextEntry - fCurrentEntry);
+  }
+  fCurrentEntry = nextEntry;
+
+  return false;
+}
+
 /**
  * Extract pythia information from a cross section file. Modified from AliAnalysisTaskEmcal::PythiaInfoFromFile().
  *
@@ -1889,6 +2178,9 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "File list filename: \"" << fFileListFilename << "\"\n";
   tempSS << "Tree name: " << fTreeName << "\n";
   tempSS << "Print timing info to log: " << fPrintTimingInfoToLog << "\n";
+  tempSS << "Accepted entry index filename: \"" << fAcceptedEntryIndexFilename << "\"\n";
+  tempSS << "Embedded tree cache size: " << fEmbeddedTreeCacheSize << "\n";
+  tempSS << "Embedded tree asynchronous prefetching: " << fEmbeddedTreeAsyncPrefetching << "\n";
   tempSS << "Random event number access: " << fRandomEventNumberAccess << "\n";
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
@@ -27,6 +27,7 @@ class AliEmcalList;
 #include <iosfwd>
 #include <vector>
 #include <string>
+#include <map>
 
 #include <TStopwatch.h>
 #include <TRandom3.h>
@@ -203,6 +204,27 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetMaxVertexDistance(Double_t distance)                    { fMaxVertexDist = distance; }
   /* @} */
 
+  /**
+   * @{
+   * @name Reading of the embedded events
+   */
+  std::string GetAcceptedEntryIndexFilename()               const { return fAcceptedEntryIndexFilename; }
+  Long64_t GetEmbeddedTreeCacheSize()                       const { return fEmbeddedTreeCacheSize; }
+  bool GetEmbeddedTreeAsyncPrefetching()                    const { return fEmbeddedTreeAsyncPrefetching; }
+
+  /**
+   * Set the file containing the accepted entry index of the files to embed, as created by
+   * CreateAcceptedEntryIndex(). Only the accepted entries are then read. An empty filename disables the index.
+   */
+  void SetAcceptedEntryIndexFilename(std::string filename)        { fAcceptedEntryIndexFilename = filename; }
+  /// Set the size (in bytes) of the TTreeCache of the embedded TChain. 0 keeps the ROOT default.
+  void SetEmbeddedTreeCacheSize(Long64_t size)                    { fEmbeddedTreeCacheSize = size; }
+  /// Read ahead and decompress the baskets of the embedded events in the background. Requires the tree cache.
+  void SetEmbeddedTreeAsyncPrefetching(bool b = true)             { fEmbeddedTreeAsyncPrefetching = b; }
+
+  bool CreateAcceptedEntryIndex(const std::string & outputFilename);
+  /* @} */
+
   /**
    * @{
    * @name Properties of the embedded event
@@ -299,6 +321,10 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   virtual Bool_t  CheckIsEmbeddedEventSelected();
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
+  void            SetupEmbeddedTreeCache();
+  void            LoadAcceptedEntryIndex();
+  bool            SkipToAcceptedEntry() ;
+  std::string     AcceptedEntryIndexSelection() const;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
   // Validation helper
   void            ValidatePhysicsSelectionForInternalEventSelection();
@@ -375,6 +401,13 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   bool                                          fPrintTimingInfoToLog; ///< Flag to print time to execute InitTree(), for logging purposes
   TStopwatch                                    fTimer            ;    //!<! Timer for the InitTree() function
 
+  std::string                          fAcceptedEntryIndexFilename; ///<  File containing the accepted entry index of the files to embed
+  Long64_t                                  fEmbeddedTreeCacheSize; ///<  Size of the TTreeCache of the embedded TChain (0 keeps the ROOT default)
+  bool                               fEmbeddedTreeAsyncPrefetching; ///<  If true, baskets of the embedded events are read and decompressed in the background
+  std::map<int, std::vector<Int_t> >             fAcceptedEntries; //!<! Accepted entries within each indexed tree, by tree number in the TChain
+  const std::vector<Int_t>               *fCurrentAcceptedEntries; //!<! Accepted entries of the current tree (null if it is not indexed)
+  bool                                         fSelectingForIndex; //!<! True while creating the accepted entry index (there is no internal event)
+
   static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
 
  private:
@@ -382,7 +415,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 12);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 13);
   /// \endcond
 };
 #endif
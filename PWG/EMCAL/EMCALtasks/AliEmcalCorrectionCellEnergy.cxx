@@ -31,6 +31,8 @@ AliEmcalCorrectionCellEnergy::AliEmcalCorrectionCellEnergy() :
   ,fUseShaperCorrection(0)
   ,fCustomRecalibFilePath("")
   ,fLoad1DRecalibFactors(0)
+  ,fPrecomputeRecalibFactors(0)
+  ,fCellRecalibFactors()
 {
 }
 
@@ -65,6 +67,9 @@ Bool_t AliEmcalCorrectionCellEnergy::Initialize()
   //
   GetProperty("load1DRecalibFactors",fLoad1DRecalibFactors);
 
+  // check the YAML configuration if the cells should be calibrated with per-cell factors computed once per run (default is false)
+  GetProperty("precomputeCalibrationFactors",fPrecomputeRecalibFactors);
+
   if (!fRecoUtils)
     fRecoUtils  = new AliEMCALRecoUtils;
 
@@ -123,8 +128,9 @@ Bool_t AliEmcalCorrectionCellEnergy::Run()
     FillCellQA(fCellEnergyDistBefore); // "before" QA
   
   // CELL RECALIBRATION -------------------------------------------------------
-  // update cell objects
-  UpdateCells();
+  // update cell objects, with the per-cell factors of the run if possible
+  if (!RecalibrateCellsFromFactors())
+    UpdateCells();
   
   if(fCreateHisto)
     FillCellQA(fCellEnergyDistAfter); // "after" QA
@@ -497,5 +503,80 @@ Bool_t AliEmcalCorrectionCellEnergy::CheckIfRunChanged()
   {
     fRecoUtils->SetUseTowerShaperNonlinarityCorrection(kTRUE);
   }
+
+  if (runChanged && fPrecomputeRecalibFactors)
+    FillCellRecalibFactors();
+
   return runChanged;
 }
+
+/**
+ * Fill the energy calibration factor of each cell for the current run into a flat array
+ * indexed by the cell abs ID, with the lookup of AliEMCALRecoUtils::AcceptCalibrateCell.
+ * Cells which do not exist get a negative factor.
+ */
+void AliEmcalCorrectionCellEnergy::FillCellRecalibFactors()
+{
+  Int_t nCells = 24*48*fGeom->GetNumberOfSuperModules();
+  fCellRecalibFactors.assign(nCells, -1.);
+
+  Int_t imod = -1, iTower = -1, iIphi = -1, iIeta = -1, iphi = -1, ieta = -1;
+  for (Int_t absID = 0; absID < nCells; absID++)
+  {
+    if (!fGeom->GetCellIndex(absID, imod, iTower, iIphi, iIeta))
+      continue;
+    fGeom->GetCellPhiEtaIndexInSModule(imod, iTower, iIphi, iIeta, iphi, ieta);
+    if (fLoad1DRecalibFactors)
+      fCellRecalibFactors[absID] = fRecoUtils->GetEMCALChannelRecalibrationFactor1D(absID);
+    else
+      fCellRecalibFactors[absID] = fRecoUtils->GetEMCALChannelRecalibrationFactor(imod, ieta, iphi);
+  }
+
+  AliInfo(Form("Filled energy calibration factors of %d cells for run %d", nCells, fRun));
+}
+
+/**
+ * Calibrate the cells with the per-cell factors of the run. Gives the same cells as
+ * UpdateCells(), which is used instead (return value false) if the factors are not
+ * requested or if the reco utils of the component are configured for more than the
+ * energy calibration (bad channels, time calibration, PAR runs).
+ *
+ * @return True if the cells were calibrated
+ */
+Bool_t AliEmcalCorrectionCellEnergy::RecalibrateCellsFromFactors()
+{
+  if (!fPrecomputeRecalibFactors || fCellRecalibFactors.empty())
+    return kFALSE;
+  if (fRecoUtils->IsBadChannelsRemovalSwitchedOn() || fRecoUtils->IsTimeRecalibrationOn() ||
+      fRecoUtils->IsL1PhaseInTimeRecalibrationOn() || fRecoUtils->IsParRun())
+    return kFALSE;
+
+  const Int_t nFactors = fCellRecalibFactors.size();
+  const Float_t timeShift = fRecoUtils->GetConstantTimeShift();
+  Short_t absId = -1;
+  Int_t mclabel = -1;
+  Double_t ecellin = 0, tcellin = 0, efrac = 0;
+  Int_t nCells = fCaloCells->GetNumberOfCells();
+  for (Int_t iCell = 0; iCell < nCells; iCell++)
+  {
+    fCaloCells->GetCell(iCell, absId, ecellin, tcellin, mclabel, efrac);
+
+    Float_t factor = (absId >= 0 && absId < nFactors) ? fCellRecalibFactors[absId] : -1.;
+    Float_t ecell = 0;
+    Double_t tcell = -1;
+    if (factor >= 0)
+    {
+      ecell = fCaloCells->GetCellAmplitude(absId);
+      ecell *= factor;
+      if (fUseShaperCorrection && !fCaloCells->GetCellHighGain(absId))
+        ecell = fRecoUtils->CorrectShaperNonLin(ecell, factor);
+      tcell = fCaloCells->GetCellTime(absId);
+      tcell -= timeShift*1e-9;
+    }
+
+    fCaloCells->SetCell(iCell, absId, ecell, tcell, mclabel, efrac);
+  }
+
+  fCaloCells->Sort();
+  return kTRUE;
+}
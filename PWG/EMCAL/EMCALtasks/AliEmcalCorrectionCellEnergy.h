@@ -1,6 +1,8 @@
 #ifndef ALIEMCALCORRECTIONCELLENERGY_H
 #define ALIEMCALCORRECTIONCELLENERGY_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
 
 /**
@@ -40,6 +42,8 @@ protected:
 private:
   Int_t                  InitRecalib();
   Int_t                  InitRunDepRecalib();
+  void                   FillCellRecalibFactors();
+  Bool_t                 RecalibrateCellsFromFactors();
   
   // Change to false if experts
   Bool_t                 fUseAutomaticRecalib;       ///< On by default the check in the OADB of the energy recalibration
@@ -48,6 +52,8 @@ private:
   Bool_t                 fUseShaperCorrection;       ///< Off by default the correction for the shaper nonlinearity
   TString                fCustomRecalibFilePath;     ///< Empty string by default the path to the OADB file of the custom energy recalibration
   Bool_t                 fLoad1DRecalibFactors;      ///< Flag to load 1D energy recalibration factors
+  Bool_t                 fPrecomputeRecalibFactors;  ///< Calibrate the cells with the per-cell factors computed at run change
+  std::vector<Float_t>   fCellRecalibFactors;        //!<! Energy calibration factor per cell abs ID (negative for not existing cells), filled at run change
   
   AliEmcalCorrectionCellEnergy(const AliEmcalCorrectionCellEnergy &);               // Not implemented
   AliEmcalCorrectionCellEnergy &operator=(const AliEmcalCorrectionCellEnergy &);    // Not implemented
@@ -56,7 +62,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionCellEnergy> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionCellEnergy, 6); // EMCal cell energy correction component
+  ClassDef(AliEmcalCorrectionCellEnergy, 7); // EMCal cell energy correction component
   /// \endcond
 };
 
@@ -14,6 +14,7 @@
 #include <algorithm>
 
 #include <TChain.h>
+#include <TH1D.h>
 
 #include <AliAnalysisManager.h>
 #include <AliVEventHandler.h>
@@ -64,7 +65,12 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
-  fOutput(0)
+  fOutput(0),
+  fDoComponentProfiling(kFALSE),
+  fComponentTimer(),
+  fhComponentWallTime(0),
+  fhComponentCPUTime(0),
+  fhComponentCalls(0)
 {
   // Default constructor
   AliDebug(3, Form("%s", __PRETTY_FUNCTION__));
@@ -109,7 +115,12 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
-  fOutput(0)
+  fOutput(0),
+  fDoComponentProfiling(kFALSE),
+  fComponentTimer(),
+  fhComponentWallTime(0),
+  fhComponentCPUTime(0),
+  fhComponentCalls(0)
 {
   // Standard constructor
   AliDebug(3, Form("%s", __PRETTY_FUNCTION__));
@@ -153,7 +164,12 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fGeom(task.fGeom),
   fParticleCollArray(*(static_cast<TObjArray *>(task.fParticleCollArray.Clone()))),
   fClusterCollArray(*(static_cast<TObjArray *>(task.fClusterCollArray.Clone()))),
-  fOutput(task.fOutput)                           // TODO: More care is needed here!
+  fOutput(task.fOutput),                          // TODO: More care is needed here!
+  fDoComponentProfiling(task.fDoComponentProfiling),
+  fComponentTimer(),
+  fhComponentWallTime(task.fhComponentWallTime),
+  fhComponentCPUTime(task.fhComponentCPUTime),
+  fhComponentCalls(task.fhComponentCalls)
 {
   // Vertex position
   std::copy(std::begin(task.fVertex), std::end(task.fVertex), std::begin(fVertex));
@@ -218,6 +234,10 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fClusterCollArray, second.fClusterCollArray);
   swap(first.fCellCollArray, second.fCellCollArray);
   swap(first.fOutput, second.fOutput);
+  swap(first.fDoComponentProfiling, second.fDoComponentProfiling);
+  swap(first.fhComponentWallTime, second.fhComponentWallTime);
+  swap(first.fhComponentCPUTime, second.fhComponentCPUTime);
+  swap(first.fhComponentCalls, second.fhComponentCalls);
 }
 
 /**
@@ -1038,9 +1058,38 @@ void AliEmcalCorrectionTask::UserCreateOutputObjects()
 
   UserCreateOutputObjectsComponents();
 
+  if (fDoComponentProfiling)
+    CreateComponentProfilingHistograms();
+
   PostData(1, fOutput);
 }
 
+/**
+ * Creates the histograms of the component profiling, with one bin per component (in the
+ * order of execution), in a dedicated list of the output.
+ */
+void AliEmcalCorrectionTask::CreateComponentProfilingHistograms()
+{
+  Int_t nComponents = fCorrectionComponents.size();
+  TList * profiling = new TList();
+  profiling->SetName("ComponentProfiling");
+  profiling->SetOwner();
+
+  fhComponentWallTime = new TH1D("hComponentWallTime", "Wall time per component;;t_{wall} (s)", nComponents, 0, nComponents);
+  fhComponentCPUTime = new TH1D("hComponentCPUTime", "CPU time per component;;t_{CPU} (s)", nComponents, 0, nComponents);
+  fhComponentCalls = new TH1D("hComponentCalls", "Number of calls per component;;calls", nComponents, 0, nComponents);
+  for (auto hist : {fhComponentWallTime, fhComponentCPUTime, fhComponentCalls})
+  {
+    for (Int_t i = 0; i < nComponents; i++)
+    {
+      hist->GetXaxis()->SetBinLabel(i + 1, fCorrectionComponents[i]->GetName());
+    }
+    profiling->Add(hist);
+  }
+
+  fOutput->Add(profiling);
+}
+
 /**
  * Calls UserCreateOutputObjects() for each component and ensures that the output from the correction
  * components is eventually output by the correction task.
@@ -1297,15 +1346,26 @@ Bool_t AliEmcalCorrectionTask::RetrieveEventObjects()
 Bool_t AliEmcalCorrectionTask::Run()
 {
   // Run the initialization for all derived classes.
-  for (auto component : fCorrectionComponents)
+  for (std::size_t i = 0; i < fCorrectionComponents.size(); i++)
   {
+    AliEmcalCorrectionComponent * component = fCorrectionComponents[i];
     component->SetInputEvent(InputEvent());
     component->SetMCEvent(MCEvent());
     component->SetCentralityBin(fCentBin);
     component->SetCentrality(fCent);
     component->SetVertex(fVertex);
 
-    component->Run();
+    if (fhComponentWallTime) {
+      fComponentTimer.Start(kTRUE);
+      component->Run();
+      fComponentTimer.Stop();
+      fhComponentWallTime->AddBinContent(i + 1, fComponentTimer.RealTime());
+      fhComponentCPUTime->AddBinContent(i + 1, fComponentTimer.CpuTime());
+      fhComponentCalls->AddBinContent(i + 1);
+    }
+    else {
+      component->Run();
+    }
   }
 
   PostData(1, fOutput);
@@ -1327,6 +1387,55 @@ Bool_t AliEmcalCorrectionTask::UserNotify()
   return kTRUE;
 }
 
+/**
+ * Reports the slowest components if the component profiling is enabled.
+ */
+void AliEmcalCorrectionTask::Terminate(Option_t *)
+{
+  TList * output = fOutput ? fOutput : dynamic_cast<TList *>(GetOutputData(1));
+  if (fDoComponentProfiling && output)
+    PrintComponentProfiling(output);
+}
+
+/**
+ * Prints the components ordered by the wall time they spent in Run(), with
+ * the time per call and the fraction of the time of all components.
+ *
+ * @param output Output list of the task
+ */
+void AliEmcalCorrectionTask::PrintComponentProfiling(TList * output) const
+{
+  TList * profiling = dynamic_cast<TList *>(output->FindObject("ComponentProfiling"));
+  if (!profiling)
+    return;
+  TH1 * wallTime = static_cast<TH1 *>(profiling->FindObject("hComponentWallTime"));
+  TH1 * cpuTime = static_cast<TH1 *>(profiling->FindObject("hComponentCPUTime"));
+  TH1 * calls = static_cast<TH1 *>(profiling->FindObject("hComponentCalls"));
+  if (!wallTime || !cpuTime || !calls)
+    return;
+
+  Int_t nComponents = wallTime->GetNbinsX();
+  std::vector <Int_t> order(nComponents);
+  for (Int_t i = 0; i < nComponents; i++) order[i] = i + 1;
+  std::sort(order.begin(), order.end(), [wallTime](Int_t a, Int_t b) { return wallTime->GetBinContent(a) > wallTime->GetBinContent(b); });
+  Double_t totalWallTime = 0;
+  for (Int_t i = 1; i <= nComponents; i++) totalWallTime += wallTime->GetBinContent(i);
+
+  std::stringstream tempSS;
+  tempSS << "EMCal correction components ordered by wall time (total " << totalWallTime << " s):\n";
+  for (auto bin : order)
+  {
+    Double_t nCalls = calls->GetBinContent(bin);
+    tempSS << "\t" << wallTime->GetXaxis()->GetBinLabel(bin)
+           << ": wall " << wallTime->GetBinContent(bin) << " s"
+           << " (" << (totalWallTime > 0 ? 100. * wallTime->GetBinContent(bin) / totalWallTime : 0.) << "%)"
+           << ", CPU " << cpuTime->GetBinContent(bin) << " s"
+           << ", " << (nCalls > 0 ? 1e6 * wallTime->GetBinContent(bin) / nCalls : 0.) << " us/call"
+           << " in " << nCalls << " calls\n";
+  }
+  std::cout << tempSS.str();
+}
+
 /**
  * Print configuration string
  *
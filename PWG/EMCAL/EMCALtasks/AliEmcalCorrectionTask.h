@@ -5,6 +5,9 @@ class AliEmcalCorrectionCellContainer;
 class AliEmcalCorrectionComponent;
 class AliEMCALGeometry;
 class AliVEvent;
+class TH1;
+
+#include <TStopwatch.h>
 
 #include <AliAnalysisTaskSE.h>
 #include <AliVCluster.h>
@@ -100,6 +103,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Set
   void                        SetForceBeamType(BeamType f)                          { fForceBeamType     = f                              ; }
   void                        SetNeedEmcalGeometry(Bool_t b)                        { fNeedEmcalGeom     = b                              ; }
+  /// Record the wall and CPU time of each correction component in the output, the slowest are reported at Terminate
+  void                        SetComponentProfiling(Bool_t b)                       { fDoComponentProfiling = b                           ; }
   // Centrality options
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
@@ -142,6 +147,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   void UserCreateOutputObjects();
   void UserExec(Option_t * option);
   Bool_t UserNotify();
+  void Terminate(Option_t * option);
 
   // Aditional steering functions
   virtual void ExecOnce();
@@ -191,6 +197,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Execute component functions
   void UserCreateOutputObjectsComponents();
   void ExecOnceComponents();
+  void CreateComponentProfilingHistograms();
+  void PrintComponentProfiling(TList * output) const;
 
   // Initialization functions
   void InitializeConfiguration();
@@ -248,8 +256,14 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   
   TList *                     fOutput;                     //!<! Output for histograms
 
+  Bool_t                      fDoComponentProfiling;       ///< Record the wall and CPU time of each component
+  TStopwatch                  fComponentTimer;             //!<! Timer of the component currently running
+  TH1                        *fhComponentWallTime;         //!<! Wall time spent in Run() of each component (s)
+  TH1                        *fhComponentCPUTime;          //!<! CPU time spent in Run() of each component (s)
+  TH1                        *fhComponentCalls;            //!<! Number of Run() calls of each component
+
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 9); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 10); // EMCal correction task
   /// \endcond
 };
 
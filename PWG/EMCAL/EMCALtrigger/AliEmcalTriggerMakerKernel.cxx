@@ -32,6 +32,7 @@
 #include "AliEMCALTriggerRawPatch.h"
 #include "AliEmcalTriggerMakerKernel.h"
 #include "AliEmcalTriggerSetupInfo.h"
+#include "AliEmcalTriggerSlidingWindowPatchFinder.h"
 #include "AliLog.h"
 #include "AliVCaloCells.h"
 #include "AliVCaloTrigger.h"
@@ -50,6 +51,9 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fTriggerBitConfig(nullptr),
   fPatchFinder(nullptr),
   fLevel0PatchFinder(nullptr),
+  fSlidingWindowPatchFinder(nullptr),
+  fSlidingWindowLevel0PatchFinder(nullptr),
+  fUseSlidingWindowPatchFinder(kFALSE),
   fL0MinTime(7),
   fL0MaxTime(10),
   fMinCellAmp(0),
@@ -93,6 +97,8 @@ AliEmcalTriggerMakerKernel::~AliEmcalTriggerMakerKernel() {
   delete fTriggerBitMap;
   delete fPatchFinder;
   delete fLevel0PatchFinder;
+  delete fSlidingWindowPatchFinder;
+  delete fSlidingWindowLevel0PatchFinder;
   if(fTriggerBitConfig) delete fTriggerBitConfig;
 }
 
@@ -132,6 +138,9 @@ void AliEmcalTriggerMakerKernel::AddL1TriggerAlgorithm(Int_t rowmin, Int_t rowma
   trigger->SetPatchSize(patchSize);
   trigger->SetSubregionSize(subregionSize);
   fPatchFinder->AddTriggerAlgorithm(trigger);
+
+  if (!fSlidingWindowPatchFinder) fSlidingWindowPatchFinder = new PWG::EMCAL::AliEmcalTriggerSlidingWindowPatchFinder;
+  fSlidingWindowPatchFinder->AddAlgorithm(rowmin, rowmax, bitmask, patchSize, subregionSize);
 }
 
 void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
@@ -140,6 +149,10 @@ void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowma
   fLevel0PatchFinder = new AliEMCALTriggerAlgorithm<double>(rowmin, rowmax, bitmask);
   fLevel0PatchFinder->SetPatchSize(patchSize);
   fLevel0PatchFinder->SetSubregionSize(subregionSize);
+
+  if (!fSlidingWindowLevel0PatchFinder) fSlidingWindowLevel0PatchFinder = new PWG::EMCAL::AliEmcalTriggerSlidingWindowPatchFinder;
+  fSlidingWindowLevel0PatchFinder->ClearAlgorithms();
+  fSlidingWindowLevel0PatchFinder->AddAlgorithm(rowmin, rowmax, bitmask, patchSize, subregionSize);
 }
 
 void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
@@ -150,6 +163,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSlidingWindowPatchFinder) fSlidingWindowPatchFinder->ClearAlgorithms();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -168,6 +182,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSlidingWindowPatchFinder) fSlidingWindowPatchFinder->ClearAlgorithms();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -185,6 +200,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP20158x8()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSlidingWindowPatchFinder) fSlidingWindowPatchFinder->ClearAlgorithms();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -202,6 +218,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPPb2013()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSlidingWindowPatchFinder) fSlidingWindowPatchFinder->ClearAlgorithms();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -217,6 +234,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2012()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSlidingWindowPatchFinder) fSlidingWindowPatchFinder->ClearAlgorithms();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -232,6 +250,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSlidingWindowPatchFinder) fSlidingWindowPatchFinder->ClearAlgorithms();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -247,6 +266,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSlidingWindowPatchFinder) fSlidingWindowPatchFinder->ClearAlgorithms();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   fConfigured = true;
@@ -531,7 +551,11 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
       //l0PatchMask = 1 << fTriggerBitConfig->GetLevel0Bit();
 
   std::vector<AliEMCALTriggerRawPatch> patches;
-  if (fPatchFinder) {
+  if (fUseSlidingWindowPatchFinder && fSlidingWindowPatchFinder) {
+    patches.reserve(fSlidingWindowPatchFinder->GetMaxNumberOfPatches(fPatchADC->GetNumberOfCols(), fPatchADC->GetNumberOfRows()));
+    fSlidingWindowPatchFinder->FindPatches(useL0amp ? *fPatchAmplitudes : *fPatchADC, *fPatchADCSimple, patches);
+  }
+  else if (fPatchFinder) {
     if (useL0amp) {
       patches = fPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
     }
@@ -539,7 +563,17 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
       patches = fPatchFinder->FindPatches(*fPatchADC, *fPatchADCSimple);
     }
   }
+
+  // Find Level0 patches
+  std::vector<AliEMCALTriggerRawPatch> l0patches;
+  if (fUseSlidingWindowPatchFinder && fSlidingWindowLevel0PatchFinder) {
+    l0patches.reserve(fSlidingWindowLevel0PatchFinder->GetMaxNumberOfPatches(fPatchAmplitudes->GetNumberOfCols(), fPatchAmplitudes->GetNumberOfRows()));
+    fSlidingWindowLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple, l0patches);
+  }
+  else if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+
   outputcont.clear();
+  outputcont.reserve(patches.size() + l0patches.size());
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = patches.begin(); patchit != patches.end(); ++patchit){
     // Apply offline and recalc selection
     // Remove unwanted bits from the online bits (gamma bits from jet patches and vice versa)
@@ -591,9 +625,6 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     outputcont.push_back(fullpatch);
   }
 
-  // Find Level0 patches
-  std::vector<AliEMCALTriggerRawPatch> l0patches;
-  if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = l0patches.begin(); patchit != l0patches.end(); ++patchit){
     Int_t offlinebits = 0, onlinebits = 0;
     if(HasPHOSOverlap(*patchit)) continue;
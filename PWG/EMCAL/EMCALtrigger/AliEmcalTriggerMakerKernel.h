@@ -24,6 +24,7 @@ class AliEMCALTriggerBitConfig;
 template<class T> class AliEMCALTriggerDataGrid;
 template<class T> class AliEMCALTriggerAlgorithm;
 template<class T> class AliEMCALTriggerPatchFinder;
+namespace PWG { namespace EMCAL { class AliEmcalTriggerSlidingWindowPatchFinder; } }
 
 // To be moved to AliRoot in AliEMCALTriggerConstants.h at the first occasion
 namespace EMCALTrigger {
@@ -120,6 +121,15 @@ public:
    */
   void SetOnlineBackgroundSubtraction(Bool_t doSubtraction) { fDoBackgroundSubtraction = doSubtraction; }
 
+  /**
+   * @brief Find the patches with the summed-area table patch finder (off by default)
+   *
+   * The patches are the same as from the AliEMCALTriggerAlgorithm patch finders,
+   * which are used when switched off (the default)
+   * @param[in] doUse If true the summed-area table patch finder is used
+   */
+  void SetUseSlidingWindowPatchFinder(Bool_t doUse) { fUseSlidingWindowPatchFinder = doUse; }
+
   /**
    * @brief Get L0 amplitude of a given trigger channel (in col-row space)
    * @param[in] col Column of the trigger channel
@@ -511,6 +521,9 @@ protected:
 
   AliEMCALTriggerPatchFinder<double>       *fPatchFinder;                 ///< The actual patch finder
   AliEMCALTriggerAlgorithm<double>         *fLevel0PatchFinder;           ///< Patch finder for Level0 patches
+  PWG::EMCAL::AliEmcalTriggerSlidingWindowPatchFinder *fSlidingWindowPatchFinder;         ///< Summed-area table patch finder for the L1 algorithms
+  PWG::EMCAL::AliEmcalTriggerSlidingWindowPatchFinder *fSlidingWindowLevel0PatchFinder;   ///< Summed-area table patch finder for Level0 patches
+  Bool_t                                    fUseSlidingWindowPatchFinder; ///< Use the summed-area table patch finders
   Int_t                                     fL0MinTime;                   ///< Minimum L0 time
   Int_t                                     fL0MaxTime;                   ///< Maximum L0 time
   Int_t                                     fMinCellAmp;                  ///< Minimum offline amplitude of the cells used to generate the patches
@@ -545,7 +558,7 @@ protected:
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
@@ -0,0 +1,188 @@
+/************************************************************************************
+ * Copyright (C) 2021, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include "AliEMCALTriggerDataGrid.h"
+#include "AliEMCALTriggerRawPatch.h"
+#include "AliEmcalTriggerSlidingWindowPatchFinder.h"
+
+ClassImp(PWG::EMCAL::AliEmcalTriggerSlidingWindowPatchFinder)
+
+namespace PWG {
+
+namespace EMCAL {
+
+AliEmcalTriggerSlidingWindowPatchFinder::AliEmcalTriggerSlidingWindowPatchFinder():
+  TObject(),
+  fRowMin(),
+  fRowMax(),
+  fBitMask(),
+  fPatchSize(),
+  fSubregionSize(),
+  fThreshold(0.),
+  fOfflineThreshold(0.),
+  fNCols(0),
+  fNRows(0),
+  fMaxRoundingADC(0.),
+  fMaxRoundingOfflineADC(0.),
+  fSumADC(),
+  fSumOfflineADC(),
+  fSumNonZero(),
+  fWindowADC(),
+  fWindowOfflineADC(),
+  fWindowNonZero(),
+  fWindowAccepted()
+{
+}
+
+void AliEmcalTriggerSlidingWindowPatchFinder::AddAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize){
+  fRowMin.push_back(rowmin);
+  fRowMax.push_back(rowmax);
+  fBitMask.push_back(bitmask);
+  fPatchSize.push_back(patchSize);
+  fSubregionSize.push_back(subregionSize);
+}
+
+void AliEmcalTriggerSlidingWindowPatchFinder::ClearAlgorithms(){
+  fRowMin.clear();
+  fRowMax.clear();
+  fBitMask.clear();
+  fPatchSize.clear();
+  fSubregionSize.clear();
+}
+
+Int_t AliEmcalTriggerSlidingWindowPatchFinder::GetMaxNumberOfPatches(Int_t ncols, Int_t nrows) const {
+  Int_t npatches = 0;
+  for(size_t ialgo = 0; ialgo < fRowMin.size(); ialgo++){
+    Int_t rowStartMax = std::min(fRowMax[ialgo], nrows - 1) - (fPatchSize[ialgo] - 1),
+          colStartMax = ncols - fPatchSize[ialgo];
+    if(rowStartMax < fRowMin[ialgo] || colStartMax < 0) continue;
+    npatches += ((rowStartMax - fRowMin[ialgo]) / fSubregionSize[ialgo] + 1) * (colStartMax / fSubregionSize[ialgo] + 1);
+  }
+  return npatches;
+}
+
+void AliEmcalTriggerSlidingWindowPatchFinder::BuildTables(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc){
+  fNCols = adc.GetNumberOfCols();
+  fNRows = adc.GetNumberOfRows();
+  const Int_t width = fNCols + 1,
+              offlineCols = offlineAdc.GetNumberOfCols(),
+              offlineRows = offlineAdc.GetNumberOfRows();
+  // first row and first column stay 0
+  fSumADC.assign((fNRows + 1) * width, 0.);
+  fSumOfflineADC.assign((fNRows + 1) * width, 0.);
+  fSumNonZero.assign((fNRows + 1) * width, 0);
+  Double_t absADC = 0., absOfflineADC = 0.;
+  for(Int_t irow = 0; irow < fNRows; irow++){
+    Double_t rowADC = 0., rowOfflineADC = 0.;
+    Int_t rowNonZero = 0;
+    const Int_t below = irow * width, current = (irow + 1) * width;
+    for(Int_t icol = 0; icol < fNCols; icol++){
+      Double_t cellADC = adc(icol, irow),
+               cellOfflineADC = (icol < offlineCols && irow < offlineRows) ? offlineAdc(icol, irow) : 0.;
+      rowADC += cellADC;
+      rowOfflineADC += cellOfflineADC;
+      absADC += std::abs(cellADC);
+      absOfflineADC += std::abs(cellOfflineADC);
+      if(cellADC != 0. || cellOfflineADC != 0.) rowNonZero++;
+      fSumADC[current + icol + 1] = fSumADC[below + icol + 1] + rowADC;
+      fSumOfflineADC[current + icol + 1] = fSumOfflineADC[below + icol + 1] + rowOfflineADC;
+      fSumNonZero[current + icol + 1] = fSumNonZero[below + icol + 1] + rowNonZero;
+    }
+  }
+  // each table entry sums at most fNCols x fNRows cells, a window sum is the difference of four entries
+  const Double_t roundingPerADC = 4. * fNCols * fNRows * DBL_EPSILON;
+  fMaxRoundingADC = roundingPerADC * absADC;
+  fMaxRoundingOfflineADC = roundingPerADC * absOfflineADC;
+}
+
+void AliEmcalTriggerSlidingWindowPatchFinder::SumWindow(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc, Int_t col, Int_t row, Int_t patchSize, Double_t &adcSum, Double_t &offlineAdcSum) const {
+  const Int_t offlineCols = offlineAdc.GetNumberOfCols(),
+              offlineRows = offlineAdc.GetNumberOfRows();
+  adcSum = 0.;
+  offlineAdcSum = 0.;
+  for(Int_t irow = std::max(row, 0); irow < std::min(row + patchSize, fNRows); irow++){
+    for(Int_t icol = col; icol < col + patchSize; icol++){
+      adcSum += adc(icol, irow);
+      if(icol < offlineCols && irow < offlineRows) offlineAdcSum += offlineAdc(icol, irow);
+    }
+  }
+}
+
+void AliEmcalTriggerSlidingWindowPatchFinder::FindPatches(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc, std::vector<AliEMCALTriggerRawPatch> &patches){
+  if(fRowMin.empty()) return;
+  BuildTables(adc, offlineAdc);
+  const Int_t width = fNCols + 1;
+
+  for(size_t ialgo = 0; ialgo < fRowMin.size(); ialgo++){
+    const Int_t patchSize = fPatchSize[ialgo], subregionSize = fSubregionSize[ialgo],
+                rowStartMax = fRowMax[ialgo] - (patchSize - 1),
+                colStartMax = fNCols - patchSize;
+    if(colStartMax < 0) continue;
+    const Int_t nwindows = colStartMax / subregionSize + 1;
+    fWindowADC.resize(nwindows);
+    fWindowOfflineADC.resize(nwindows);
+    fWindowNonZero.resize(nwindows);
+    fWindowAccepted.resize(nwindows);
+
+    for(Int_t irow = fRowMin[ialgo]; irow <= rowStartMax; irow += subregionSize){
+      // rows outside the grid do not contribute, as in AliEMCALTriggerAlgorithm
+      const Int_t rowLow = std::max(0, std::min(irow, fNRows)) * width,
+                  rowHigh = std::max(0, std::min(irow + patchSize, fNRows)) * width;
+      const Double_t *adcLow = fSumADC.data() + rowLow, *adcHigh = fSumADC.data() + rowHigh,
+                     *offlineLow = fSumOfflineADC.data() + rowLow, *offlineHigh = fSumOfflineADC.data() + rowHigh;
+      const Int_t *nonZeroLow = fSumNonZero.data() + rowLow, *nonZeroHigh = fSumNonZero.data() + rowHigh;
+      for(Int_t iwindow = 0; iwindow < nwindows; iwindow++){
+        const Int_t colLow = iwindow * subregionSize, colHigh = colLow + patchSize;
+        fWindowADC[iwindow] = adcHigh[colHigh] - adcHigh[colLow] - adcLow[colHigh] + adcLow[colLow];
+        fWindowOfflineADC[iwindow] = offlineHigh[colHigh] - offlineHigh[colLow] - offlineLow[colHigh] + offlineLow[colLow];
+        fWindowNonZero[iwindow] = nonZeroHigh[colHigh] - nonZeroHigh[colLow] - nonZeroLow[colHigh] + nonZeroLow[colLow];
+      }
+      // branch-free preselection for the full row of windows, with the
+      // threshold lowered by the rounding error bound of the tables
+      for(Int_t iwindow = 0; iwindow < nwindows; iwindow++){
+        fWindowAccepted[iwindow] = (fWindowNonZero[iwindow] > 0)
+            & ((fWindowADC[iwindow] > fThreshold - fMaxRoundingADC) | (fWindowOfflineADC[iwindow] > fOfflineThreshold - fMaxRoundingOfflineADC));
+      }
+      for(Int_t iwindow = 0; iwindow < nwindows; iwindow++){
+        if(!fWindowAccepted[iwindow]) continue;
+        // the decision and the patch ADC values from the cell by cell sums
+        Double_t adcSum, offlineAdcSum;
+        SumWindow(adc, offlineAdc, iwindow * subregionSize, irow, patchSize, adcSum, offlineAdcSum);
+        if(!(adcSum > fThreshold || offlineAdcSum > fOfflineThreshold)) continue;
+        AliEMCALTriggerRawPatch recpatch(iwindow * subregionSize, irow, patchSize, adcSum, offlineAdcSum);
+        recpatch.SetBitmask(fBitMask[ialgo]);
+        patches.push_back(recpatch);
+      }
+    }
+  }
+}
+
+}
+
+}
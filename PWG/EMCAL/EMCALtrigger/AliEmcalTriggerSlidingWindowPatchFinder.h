@@ -0,0 +1,182 @@
+/************************************************************************************
+ * Copyright (C) 2021, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALTRIGGERSLIDINGWINDOWPATCHFINDER_H
+#define ALIEMCALTRIGGERSLIDINGWINDOWPATCHFINDER_H
+
+#include <vector>
+#include <TObject.h>
+
+class AliEMCALTriggerRawPatch;
+template<class T> class AliEMCALTriggerDataGrid;
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class AliEmcalTriggerSlidingWindowPatchFinder
+ * @brief Patch finder based on summed-area tables of the FastOR grids
+ * @ingroup EMCALTRGFW
+ *
+ * Finds the same patches as a set of AliEMCALTriggerAlgorithm<double>
+ * (sliding windows of a given patch size, moved in steps of the subregion
+ * size within a row range), but instead of summing the FastOR amplitudes
+ * inside each window, the window sums are obtained from 2D summed-area
+ * tables of the online and offline ADC grids:
+ *
+ * ~~~
+ * S(c,r) = sum of the cells with col < c and row < r
+ * sum(window [c0,c1) x [r0,r1)) = S(c1,r1) - S(c0,r1) - S(c1,r0) + S(c0,r0)
+ * ~~~
+ *
+ * The tables are built once per event for all algorithms, so the cost per
+ * window does not depend on the patch size (relevant for the 16x16 and 8x8
+ * jet patches). Windows without any non-zero cell are rejected via a table
+ * counting the non-zero cells, so that empty windows are never accepted
+ * because of rounding in the differences.
+ *
+ * The differences of the tables are only used to preselect the windows: a
+ * window is a candidate when one of its table sums is above the threshold
+ * minus the rounding error bound of the tables. For the candidates the
+ * window sums are recomputed cell by cell in the order of
+ * AliEMCALTriggerAlgorithm, and the threshold decision and the patch ADC
+ * values are taken from these sums, so that the patches do not depend on
+ * rounding in the tables.
+ *
+ * The patches are appended in the order of the algorithms, row by row, as
+ * by AliEMCALTriggerPatchFinder<double>.
+ */
+class AliEmcalTriggerSlidingWindowPatchFinder : public TObject {
+public:
+
+  /**
+   * @brief Default constructor
+   */
+  AliEmcalTriggerSlidingWindowPatchFinder();
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~AliEmcalTriggerSlidingWindowPatchFinder() {}
+
+  /**
+   * @brief Add a sliding window algorithm
+   * @param[in] rowmin Minimum row value
+   * @param[in] rowmax Maximum row value
+   * @param[in] bitmask Offline bit mask to be applied to the patches
+   * @param[in] patchSize Size of the patches
+   * @param[in] subregionSize Size of the sliding sub region
+   */
+  void AddAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize);
+
+  /**
+   * @brief Remove all algorithms
+   */
+  void ClearAlgorithms();
+
+  /**
+   * @brief Set the thresholds a patch has to exceed in online or offline ADC
+   * @param[in] threshold Online ADC threshold
+   * @param[in] offlineThreshold Offline ADC threshold
+   *
+   * Defaults (0) as in AliEMCALTriggerAlgorithm<double>
+   */
+  void SetThresholds(Double_t threshold, Double_t offlineThreshold) { fThreshold = threshold; fOfflineThreshold = offlineThreshold; }
+
+  /**
+   * @brief Get the number of algorithms
+   * @return Number of algorithms
+   */
+  Int_t GetNumberOfAlgorithms() const { return fRowMin.size(); }
+
+  /**
+   * @brief Get the maximum number of patches found on a grid
+   * @param[in] ncols Number of columns of the grid
+   * @param[in] nrows Number of rows of the grid
+   * @return Number of windows of all algorithms
+   *
+   * Used to preallocate the patch container
+   */
+  Int_t GetMaxNumberOfPatches(Int_t ncols, Int_t nrows) const;
+
+  /**
+   * @brief Find the patches of all algorithms
+   * @param[in] adc Grid of the online ADC values
+   * @param[in] offlineAdc Grid of the offline ADC values
+   * @param[out] patches Container the patches are appended to
+   */
+  void FindPatches(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc, std::vector<AliEMCALTriggerRawPatch> &patches);
+
+private:
+
+  /**
+   * @brief Build the summed-area tables of the online and offline ADC and of the non-zero cells
+   * @param[in] adc Grid of the online ADC values
+   * @param[in] offlineAdc Grid of the offline ADC values
+   */
+  void BuildTables(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc);
+
+  /**
+   * @brief Sum the online and offline ADC of a window cell by cell
+   * @param[in] adc Grid of the online ADC values
+   * @param[in] offlineAdc Grid of the offline ADC values
+   * @param[in] col Start column of the window
+   * @param[in] row Start row of the window
+   * @param[in] patchSize Size of the window
+   * @param[out] adcSum Online ADC sum
+   * @param[out] offlineAdcSum Offline ADC sum
+   */
+  void SumWindow(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc, Int_t col, Int_t row, Int_t patchSize, Double_t &adcSum, Double_t &offlineAdcSum) const;
+
+  std::vector<Int_t>              fRowMin;              ///< Minimum row of the algorithms
+  std::vector<Int_t>              fRowMax;              ///< Maximum row of the algorithms
+  std::vector<UInt_t>             fBitMask;             ///< Offline bit mask of the algorithms
+  std::vector<Int_t>              fPatchSize;           ///< Patch size of the algorithms
+  std::vector<Int_t>              fSubregionSize;       ///< Subregion size of the algorithms
+  Double_t                        fThreshold;           ///< Online ADC threshold
+  Double_t                        fOfflineThreshold;    ///< Offline ADC threshold
+
+  Int_t                           fNCols;               //!<! Number of columns of the tables
+  Int_t                           fNRows;               //!<! Number of rows of the tables
+  Double_t                        fMaxRoundingADC;      //!<! Bound of the rounding error of the online window sums from the tables
+  Double_t                        fMaxRoundingOfflineADC; //!<! Bound of the rounding error of the offline window sums from the tables
+  std::vector<Double_t>           fSumADC;              //!<! Summed-area table of the online ADC, (fNRows+1) x (fNCols+1)
+  std::vector<Double_t>           fSumOfflineADC;       //!<! Summed-area table of the offline ADC
+  std::vector<Int_t>              fSumNonZero;          //!<! Summed-area table of the cells with non-zero ADC
+  std::vector<Double_t>           fWindowADC;           //!<! Online window sums of a row of windows
+  std::vector<Double_t>           fWindowOfflineADC;    //!<! Offline window sums of a row of windows
+  std::vector<Int_t>              fWindowNonZero;       //!<! Non-zero cells of a row of windows
+  std::vector<UChar_t>            fWindowAccepted;      //!<! Threshold decision of a row of windows
+
+  ClassDef(AliEmcalTriggerSlidingWindowPatchFinder, 1);
+};
+
+}
+
+}
+
+#endif
@@ -29,6 +29,8 @@
 #include "TH2F.h"
 #include "TH3F.h"
 #include "TArrayD.h"
+#include "TBits.h"
+#include "TObjArray.h"
 #include "TProfile.h"
 #include "AliMCEvent.h"
 #include "AliMCParticle.h"
@@ -321,6 +323,24 @@ AliFlowEvent::AliFlowEvent( const AliESDEvent* anInput,
 
   Int_t iNumberOfInputTracks = anInput->GetNumberOfTracks() ;
 
+  //check the cuts for all tracks at once
+  TBits rpAccepted(iNumberOfInputTracks);
+  TBits poiAccepted(iNumberOfInputTracks);
+  if (rpCFManager && poiCFManager)
+  {
+    TObjArray tracks(iNumberOfInputTracks);
+    for (Int_t itrkN=0; itrkN<iNumberOfInputTracks; itrkN++)
+    {
+      tracks.AddAt(anInput->GetTrack(itrkN),itrkN);
+      rpAccepted.SetBitNumber(itrkN);
+      poiAccepted.SetBitNumber(itrkN);
+    }
+    rpCFManager->CheckParticleCutsBatch(AliCFManager::kPartRecCuts,&tracks,rpAccepted);
+    rpCFManager->CheckParticleCutsBatch(AliCFManager::kPartSelCuts,&tracks,rpAccepted);
+    poiCFManager->CheckParticleCutsBatch(AliCFManager::kPartRecCuts,&tracks,poiAccepted);
+    poiCFManager->CheckParticleCutsBatch(AliCFManager::kPartSelCuts,&tracks,poiAccepted);
+  }
+
   //loop over tracks
   for (Int_t itrkN=0; itrkN<iNumberOfInputTracks; itrkN++)
   {
@@ -331,10 +351,8 @@ AliFlowEvent::AliFlowEvent( const AliESDEvent* anInput,
     Bool_t poiOK = kTRUE;
     if (rpCFManager && poiCFManager)
     {
-      rpOK = ( rpCFManager->CheckParticleCuts(AliCFManager::kPartRecCuts,pParticle) &&
-               rpCFManager->CheckParticleCuts(AliCFManager::kPartSelCuts,pParticle));
-      poiOK = ( poiCFManager->CheckParticleCuts(AliCFManager::kPartRecCuts,pParticle) &&
-                poiCFManager->CheckParticleCuts(AliCFManager::kPartSelCuts,pParticle));
+      rpOK = rpAccepted.TestBitNumber(itrkN);
+      poiOK = poiAccepted.TestBitNumber(itrkN);
     }
     if (!(rpOK || poiOK)) continue;
 
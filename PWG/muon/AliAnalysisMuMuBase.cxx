@@ -31,11 +31,16 @@
  * - \ref Event to access the current event
  * - \ref MCEvent to access to current MC event (if available)
  *
+ * Histograms filled for many combinations of event selection, trigger class and centrality
+ * can be accessed through handles (\ref PathHandle, \ref HistoId) instead of their path,
+ * see AliAnalysisMuMuSingle::FillHistosForTrack.
+ *
  * A few trivial cut methods (\ref AlwaysTrue and \ref AlwaysFalse) are defined as well and
  * can be used to register some control cut combinations (see \ref AliAnalysisMuMuCutCombination)
  *
  */
 
+#include <algorithm>
 #include "AliMergeableCollection.h"
 #include "AliCounterCollection.h"
 #include "TList.h"
@@ -69,7 +74,13 @@ fCutRegistry(0x0),
 fEvent(0x0),
 fMCEvent(0x0),
 fHistogramToDisable(0x0),
-fHasMC(kFALSE)
+fHasMC(kFALSE),
+fHandleNames(),
+fPathHandles(),
+fHandlePaths(),
+fHistoIds(),
+fHistoNames(),
+fHistoTable()
 {
  /// default ctor
 }
@@ -90,6 +101,103 @@ TString AliAnalysisMuMuBase::BuildPath(const char* eventSelection, const char* t
   return path;
 }
 
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::PathHandle(const char* eventSelection, const char* triggerClassName,
+                                      const char* centrality, const char* what, Bool_t mc)
+{
+  /// Dense handle of the path eventSelection/triggerClassName/centrality[/what] (see BuildPath),
+  /// or of the corresponding MC input path (see BuildMCPath), created at the first call
+
+  const char* names[4] = { eventSelection, triggerClassName, centrality, what };
+  std::array<Int_t,5> key;
+
+  for ( Int_t i = 0; i < 4; ++i )
+  {
+    NameIndex_t::const_iterator it = fHandleNames[i].find(std::string(names[i]));
+    if ( it == fHandleNames[i].end() )
+    {
+      it = fHandleNames[i].insert(std::make_pair(std::string(names[i]),(Int_t)fHandleNames[i].size())).first;
+    }
+    key[i] = it->second;
+  }
+  key[4] = mc ? 1 : 0;
+
+  std::map<std::array<Int_t,5>,Int_t>::const_iterator it = fPathHandles.find(key);
+  if ( it != fPathHandles.end() ) return it->second;
+
+  Int_t handle = fHandlePaths.size();
+  fPathHandles[key] = handle;
+  fHandlePaths.push_back(mc ? BuildMCPath(eventSelection,triggerClassName,centrality,what).Data()
+                            : BuildPath(eventSelection,triggerClassName,centrality,what).Data());
+  fHistoTable.push_back(std::vector<TObject*>(fHistoNames.size(),0x0));
+  return handle;
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::HistoId(const char* histoname)
+{
+  /// Dense id of a histogram name, created at the first call
+
+  NameIndex_t::const_iterator it = fHistoIds.find(std::string(histoname));
+  if ( it != fHistoIds.end() ) return it->second;
+
+  Int_t id = fHistoNames.size();
+  fHistoIds[histoname] = id;
+  fHistoNames.push_back(histoname);
+  return id;
+}
+
+//_____________________________________________________________________________
+TObject* AliAnalysisMuMuBase::Object(Int_t pathHandle, Int_t histoId)
+{
+  /// Get one object (histo, profile, sparse...) back from its handles. The object is looked
+  /// up in the collection only until it exists
+
+  if ( !fHistogramCollection || pathHandle < 0 || histoId < 0 ) return 0x0;
+
+  std::vector<TObject*>& row = fHistoTable[pathHandle];
+  if ( histoId >= (Int_t)row.size() ) row.resize(fHistoNames.size(),0x0);
+
+  TObject* o = row[histoId];
+  if ( !o )
+  {
+    o = fHistogramCollection->GetObject(fHandlePaths[pathHandle].c_str(),fHistoNames[histoId].c_str());
+    row[histoId] = o;
+  }
+  return o;
+}
+
+//_____________________________________________________________________________
+TH1* AliAnalysisMuMuBase::Histo(Int_t pathHandle, Int_t histoId)
+{
+  /// Get one histo back from its handles. The histogram is looked up in the collection
+  /// only until it exists
+
+  if ( !fHistogramCollection || pathHandle < 0 || histoId < 0 ) return 0x0;
+
+  std::vector<TObject*>& row = fHistoTable[pathHandle];
+  if ( histoId >= (Int_t)row.size() ) row.resize(fHistoNames.size(),0x0);
+
+  TH1* h = dynamic_cast<TH1*>(row[histoId]);
+  if ( !h )
+  {
+    h = fHistogramCollection->Histo(fHandlePaths[pathHandle].c_str(),fHistoNames[histoId].c_str());
+    if ( h ) row[histoId] = h;
+  }
+  return h;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::ClearHistoHandles()
+{
+  /// Forget the resolved histograms (the handles and ids stay valid)
+
+  for ( std::vector<std::vector<TObject*> >::iterator it = fHistoTable.begin(); it != fHistoTable.end(); ++it )
+  {
+    std::fill(it->begin(),it->end(),static_cast<TObject*>(0x0));
+  }
+}
+
 //_____________________________________________________________________________
 TString AliAnalysisMuMuBase::BuildMCPath(const char* eventSelection, const char* triggerClassName,
                                           const char* centrality, const char* cut) const
@@ -518,6 +626,8 @@ void AliAnalysisMuMuBase::Init(AliCounterCollection& cc,
   fHistogramCollection = &hc;
   fBinning             = &binning;
   fCutRegistry         = &registry;
+
+  ClearHistoHandles();
 }
 
 //_____________________________________________________________________________
@@ -10,6 +10,10 @@
  * \author L. Aphecetche (Subatech)
  */
 
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
 #include "TObject.h"
 #include "TString.h"
 #include "TProfile.h"
@@ -101,7 +105,7 @@ public:
   Bool_t AlwaysFalse(const AliVParticle& /*particle*/, const AliVParticle& /*particle*/) const { return kFALSE; }
   void NameOfAlwaysFalse(TString& name) const { name = "NONE"; }
 
-  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; }
+  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; ClearHistoHandles(); }
 
 protected:
 
@@ -192,6 +196,23 @@ protected:
   TProfile* MCProf(const char* eventSelection, const char* triggerClassName, const char* cent,
                  const char* what, const char* histoname);
 
+  /** Histogram handles : the path eventSelection/triggerClassName/centrality[/what] and the
+   * histogram name are resolved into dense integers, and the histograms into a table indexed
+   * by both, so that fill sites do not build and hash the full path for each histogram.
+   * The path handles are obtained with a few lookups of short names, typically once per
+   * FillHistosForXXX call, the histogram ids once per job (e.g. in DefineHistogramCollection).
+   * With mc=kTRUE the handle is the one of the MC input path (see BuildMCPath).
+   */
+  Int_t PathHandle(const char* eventSelection, const char* triggerClassName, const char* centrality,
+                   const char* what="", Bool_t mc=kFALSE);
+  Int_t HistoId(const char* histoname);
+  TObject* Object(Int_t pathHandle, Int_t histoId);
+  TH1* Histo(Int_t pathHandle, Int_t histoId);
+  TProfile* Prof(Int_t pathHandle, Int_t histoId) { return static_cast<TProfile*>(Object(pathHandle,histoId)); }
+  const char* PathOfHandle(Int_t pathHandle) const { return fHandlePaths[pathHandle].c_str(); }
+  const char* NameOfHistoId(Int_t histoId) const { return fHistoNames[histoId].c_str(); }
+  void ClearHistoHandles();
+
   Int_t GetNbins(Double_t xmin, Double_t xmax, Double_t xstep);
 
   AliCounterCollection* CounterCollection() const { return fEventCounters; }
@@ -215,7 +236,15 @@ private:
   TList* fHistogramToDisable; // list of regexp of histo name to disable
   Bool_t fHasMC; // whether or not we're dealing with MC data
 
-  ClassDef(AliAnalysisMuMuBase,1) // base class for a companion class to AliAnalysisMuMu
+  typedef std::map<std::string,Int_t> NameIndex_t; // index of each name
+  NameIndex_t fHandleNames[4]; //! index of the event selections, trigger classes, centralities and whats
+  std::map<std::array<Int_t,5>,Int_t> fPathHandles; //! path handle of each (selection,trigger,centrality,what,mc)
+  std::vector<std::string> fHandlePaths; //! path of each handle
+  NameIndex_t fHistoIds; //! id of each histogram name
+  std::vector<std::string> fHistoNames; //! histogram name of each id
+  std::vector<std::vector<TObject*> > fHistoTable; //! objects per path handle and histogram id (0x0 - not resolved yet)
+
+  ClassDef(AliAnalysisMuMuBase,2) // base class for a companion class to AliAnalysisMuMu
 };
 
 #endif
@@ -49,7 +49,11 @@ fMinvBinSize(0.025),
 fMinvMin(0.0),
 fMinvMax(16.0),
 fmcptcutmin(0.0),
-fmcptcutmax(12.0)
+fmcptcutmax(12.0),
+fPairHistoIdsResolved(kFALSE),
+fPtPaireVsPtTrackDisabled(kFALSE),
+fMinvHistoIds(),
+fMinvHistoDisabled()
 {
   // FIXME ? find the AccxEff histogram from HistogramCollection()->Histo("/EXCHANGE/JpsiAccEff")
 
@@ -312,6 +316,66 @@ void AliAnalysisMuMuMinv::DefineMinvRange(Double_t minvMin, Double_t minvMax, Do
   fMinvBinSize = minvBinSize;
 }
 
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuMinv::MinvHistoIndex(Int_t bin, Bool_t accEffCorrected, Double_t pairCharge, Bool_t mix) const
+{
+  /// Index of the ids of the minv histograms (see EMinvHisto) in fMinvHistoIds
+
+  Int_t charge = ( pairCharge == 2 ) ? 1 : ( ( pairCharge == -2 ) ? 2 : 0 );
+  return ((( bin*2 + (accEffCorrected ? 1 : 0) )*3 + charge )*2 + (mix ? 1 : 0))*kNMinvHistos;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuMinv::ResolvePairHistoIds()
+{
+  /// Histogram ids and disabled flags of the histograms filled for each pair,
+  /// so that FillHistosForPair neither formats names nor matches patterns
+
+  const char* names[kNPairHistos] = { "PtPaireVsPtTrack", "PtRecVsSim", "Pt", "Y", "Eta", "NchForJpsi", "NchForPsiP" };
+  for ( Int_t i = 0; i < kNPairHistos; ++i ) fPairHistoIds[i] = HistoId(names[i]);
+  fPtPaireVsPtTrackDisabled = IsHistogramDisabled("PtPaireVsPtTrack");
+
+  const char* sparseNames[kNPairSparses] = { "Pt", "Y", "Eta" };
+  const char* mixNames[2] = { "", "Mix" };
+  const char* chargeNames[3] = { "", "PP", "MM" };
+  for ( Int_t i = 0; i < kNPairSparses; ++i )
+  {
+    fPairSparseDisabled[i] = IsHistogramDisabled(sparseNames[i]);
+    for ( Int_t m = 0; m < 2; ++m )
+    {
+      for ( Int_t c = 0; c < 3; ++c )
+      {
+        fPairSparseIds[i][m][c] = HistoId(Form("%s%s%s",sparseNames[i],mixNames[m],chargeNames[c]));
+      }
+    }
+  }
+
+  const Double_t pairCharges[3] = { 0, 2, -2 };
+  Int_t nbins = fBinsToFill ? fBinsToFill->GetEntriesFast() : 0;
+  fMinvHistoIds.assign(MinvHistoIndex(nbins,kFALSE,0,kFALSE),-1);
+  fMinvHistoDisabled.assign(fMinvHistoIds.size(),kTRUE);
+  for ( Int_t ibin = 0; ibin < nbins; ++ibin )
+  {
+    AliAnalysisMuMuBinning::Range* r = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsToFill->UncheckedAt(ibin));
+    for ( Int_t a = 0; a < 2; ++a )
+    {
+      for ( Int_t c = 0; c < 3; ++c )
+      {
+        for ( Int_t m = 0; m < 2; ++m )
+        {
+          Int_t index = MinvHistoIndex(ibin,a,pairCharges[c],m);
+          TString minvName = GetMinvHistoName(*r,a,pairCharges[c],m);
+          fMinvHistoIds[index+kMinv]         = HistoId(minvName.Data());
+          fMinvHistoIds[index+kMeanPt]       = HistoId(Form("MeanPtVs%s",minvName.Data()));
+          fMinvHistoIds[index+kMeanPtSquare] = HistoId(Form("MeanPtSquareVs%s",minvName.Data()));
+          fMinvHistoDisabled[index] = IsHistogramDisabled(minvName.Data());
+        }
+      }
+    }
+  }
+  fPairHistoIdsResolved = kTRUE;
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
                                             const char* triggerClassName,
@@ -324,15 +388,18 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   /// Fill histograms for unlike-sign reconstructed  muon pairs.
   /// For the MC case, we check that only tracks with an associated MC label are selected (usefull when running on embedding).
   /// A weight is also applied for MC case at the pair or the muon track level according to SetMuonWeight() and systLevel.
+  /// The histograms are accessed through their handles (see ResolvePairHistoIds).
 
   // Usual cuts
   if (!AliAnalysisMuonUtility::IsMuonTrack(&tracki) || !AliAnalysisMuonUtility::IsMuonTrack(&trackj) ) return;
 
+  if ( !fPairHistoIdsResolved ) ResolvePairHistoIds();
+
   // Get total charge in order to get the correct histo name
   Double_t PairCharge = tracki.Charge() + trackj.Charge();
-  TString scharge  = "";
-  if( PairCharge == +2 )      scharge = "PP";
-  else if( PairCharge == -2 ) scharge = "MM";
+  Int_t icharge = 0;
+  if( PairCharge == +2 )      icharge = 1;
+  else if( PairCharge == -2 ) icharge = 2;
 
   // Pointers in case running on MC
   Int_t labeli               = 0;
@@ -342,12 +409,11 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   TLorentzVector             * pair4MomentumMC(0x0);
   Double_t inputWeightMC(1.);
 
-  // Usefull string :)
-  TString smix = IsMixedHisto ? "Mix" : "";
+  Int_t imix = IsMixedHisto ? 1 : 0;
 
-  // Create proxy in AliMergeableCollection
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,pairCutName));
-  AliMergeableCollectionProxy* mcProxy(0x0); // to be set later maybe
+  // Handles of the histogram paths
+  Int_t pathHandle = PathHandle(eventSelection,triggerClassName,centrality,pairCutName);
+  Int_t mcPathHandle(-1); // to be set later maybe
 
   // Construct dimuons vector
   TLorentzVector pi(tracki.Px(),tracki.Py(),tracki.Pz(),
@@ -373,47 +439,23 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     // Check if first track is a muon
     mcTracki = MCEvent()->GetTrack(labeli);
     if(!mcTracki) return;
-    if ( TMath::Abs(mcTracki->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if ( TMath::Abs(mcTracki->PdgCode()) != 13 ) return;
 
     // Check if second track is a muon
     mcTrackj = MCEvent()->GetTrack(labelj);
     if(!mcTrackj) return;
-    if ( TMath::Abs(mcTrackj->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if ( TMath::Abs(mcTrackj->PdgCode()) != 13 ) return;
 
     // Check if tracks has the same mother
     Int_t currMotheri = mcTracki->GetMother();
     Int_t currMotherj = mcTrackj->GetMother();
-    if( currMotheri!=currMotherj ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
-    if( currMotheri<0 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if( currMotheri!=currMotherj ) return;
+    if( currMotheri<0 ) return;
 
     // Check if mother is J/psi
     AliMCParticle* mother = static_cast<AliMCParticle*>(MCEvent()->GetTrack(currMotheri));
-    if(!mother){
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
-    if(mother->PdgCode() !=443) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if(!mother) return;
+    if(mother->PdgCode() !=443) return;
 
     // Weight tracks if specified
     if(!fWeightMuon)      inputWeightMC = WeightPairDistribution(mother->Pt(),mother->Y());
@@ -423,16 +465,11 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
 
     if(!mcTracki || !mcTrackj){
       AliError("Miss one or several MC track");
-      delete proxy;
-      delete mcProxy;
       return;
     }
 
-    // Create proxy for MC
-    mcProxy = HistogramCollection()->CreateProxy(BuildMCPath(eventSelection,triggerClassName,centrality,pairCutName));
-    TLorentzVector mcpi(mcTracki->Px(),mcTracki->Py(),mcTracki->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTracki->P()*mcTracki->P()));
-    TLorentzVector mcpj(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
-    mcpj+=mcpi;
+    // Handle of the MC path
+    mcPathHandle = PathHandle(eventSelection,triggerClassName,centrality,pairCutName,kTRUE);
   }
 
   // Weight tracks if specified
@@ -441,25 +478,18 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   else if(fWeightMuon)  inputWeight = WeightMuonDistribution(tracki.Pt()) * WeightMuonDistribution(trackj.Pt());
 
   // Fill some distribution histos
-  if ( !IsHistogramDisabled("Pt")  ) {
-    Double_t x[2] = {pair4Momentum.Pt(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
-  }
-  if ( !IsHistogramDisabled("Y")   ){
-    Double_t x[2] = {pair4Momentum.Rapidity(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
-  }
-  if ( !IsHistogramDisabled("Eta") ){
-    Double_t x[2] = {pair4Momentum.Eta(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+  const Double_t sparseX[kNPairSparses] = { pair4Momentum.Pt(), pair4Momentum.Rapidity(), pair4Momentum.Eta() };
+  for ( Int_t i = 0; i < kNPairSparses; ++i ) {
+    if ( fPairSparseDisabled[i] ) continue;
+    Double_t x[2] = {sparseX[i],pair4Momentum.M()};
+    THnSparse* hs = static_cast<THnSparse*>(Object(pathHandle,fPairSparseIds[i][imix][icharge]));
+    if(hs) hs->Fill(x,inputWeight);
   }
 
-  if ( !IsHistogramDisabled("PtPaireVsPtTrack") && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
+  if ( !fPtPaireVsPtTrackDisabled && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
+    TH2* h = static_cast<TH2*>(Histo(pathHandle,fPairHistoIds[kPtPaireVsPtTrack]));
+    h->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
+    h->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
   }
 
   // Fill histos with MC stack info (only opposite charge muons)
@@ -472,21 +502,22 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
 
 
     // Fill histo
-    if ( proxy->Histo("PtRecVsSim") )  proxy->Histo("PtRecVsSim")->Fill(mcpj.Pt(),pair4Momentum.Pt());
-    if ( mcProxy->Histo("Pt"))  mcProxy->Histo("Pt")->Fill(mcpj.Pt(),inputWeightMC);
-    if ( mcProxy->Histo("Y"))   mcProxy->Histo("Y")->Fill(mcpj.Rapidity(),inputWeightMC);
-    if ( mcProxy->Histo("Eta")) mcProxy->Histo("Eta")->Fill(mcpj.Eta());
+    TH1* h(0x0);
+    if ( ( h = Histo(pathHandle,fPairHistoIds[kPtRecVsSim]) ) ) h->Fill(mcpj.Pt(),pair4Momentum.Pt());
+    if ( ( h = Histo(mcPathHandle,fPairHistoIds[kMCPt]) ) )     h->Fill(mcpj.Pt(),inputWeightMC);
+    if ( ( h = Histo(mcPathHandle,fPairHistoIds[kMCY]) ) )      h->Fill(mcpj.Rapidity(),inputWeightMC);
+    if ( ( h = Histo(mcPathHandle,fPairHistoIds[kMCEta]) ) )    h->Fill(mcpj.Eta());
 
     // set pair4MomentumMC for the rest of the function
     pair4MomentumMC = &mcpj;
   }
 
-  TIter nextBin(fBinsToFill);
-  nextBin.Reset();
-  AliAnalysisMuMuBinning::Range* r;
+  Int_t nbins = fBinsToFill ? fBinsToFill->GetEntriesFast() : 0;
 
   // Loop over all bin ranges
-  while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) ){
+  for ( Int_t ibin = 0; ibin < nbins; ++ibin ){
+
+    AliAnalysisMuMuBinning::Range* r = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsToFill->UncheckedAt(ibin));
 
     // --- In this loop we first check if the pairs pass some tests and we fill histo accordingly. ---
 
@@ -494,19 +525,20 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     Bool_t ok(kFALSE);
     Bool_t okMC(kFALSE);
 
-    ok = CheckBinRangeCut(r,&pair4Momentum,proxy);
-    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,proxy);
+    ok = CheckBinRangeCut(r,&pair4Momentum,pathHandle);
+    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,pathHandle);
 
     // Check if pair pass all conditions, either MC or not, and fill Minv Histogrames
     if ( ok )
     {
-      // Get Minv histo name associated to the bin
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight);
+      // Get Minv histo ids associated to the bin
+      Int_t index = MinvHistoIndex(ibin,kFALSE,PairCharge,IsMixedHisto);
+      if ( !fMinvHistoDisabled[index] )
+      {
+        TProfile* hprof        = Prof(pathHandle,fMinvHistoIds[index+kMeanPt]);
+        TProfile* hprofsquare  = Prof(pathHandle,fMinvHistoIds[index+kMeanPtSquare]);
+        FillMinvHisto(pathHandle,fMinvHistoIds[index+kMinv],hprof,hprofsquare,&pair4Momentum,inputWeight);
+      }
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() )
@@ -519,23 +551,25 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4Momentum.Pt(),pair4Momentum.Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight/AccxEff);
+        index = MinvHistoIndex(ibin,kTRUE,PairCharge,IsMixedHisto);
+        if( okAccEff && !fMinvHistoDisabled[index] )
+        {
+          TProfile* hprof       = Prof(pathHandle,fMinvHistoIds[index+kMeanPt]);
+          TProfile* hprofsquare = Prof(pathHandle,fMinvHistoIds[index+kMeanPtSquare]);
+          FillMinvHisto(pathHandle,fMinvHistoIds[index+kMinv],hprof,hprofsquare,&pair4Momentum,inputWeight/AccxEff);
+        }
       }
     }
 
     if ( okMC ) {
 
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight);
+      Int_t index = MinvHistoIndex(ibin,kFALSE,PairCharge,IsMixedHisto);
+      if ( !fMinvHistoDisabled[index] )
+      {
+        TProfile* hprof        = Prof(mcPathHandle,fMinvHistoIds[index+kMeanPt]);
+        TProfile* hprofsquare  = Prof(mcPathHandle,fMinvHistoIds[index+kMeanPtSquare]);
+        FillMinvHisto(mcPathHandle,fMinvHistoIds[index+kMinv],hprof,hprofsquare,&pair4Momentum,inputWeight);
+      }
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() ){
@@ -548,18 +582,16 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4MomentumMC->Pt(),pair4MomentumMC->Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight/AccxEff);
-
+        index = MinvHistoIndex(ibin,kTRUE,PairCharge,IsMixedHisto);
+        if( okAccEff && !fMinvHistoDisabled[index] )
+        {
+          TProfile* hprof       = Prof(mcPathHandle,fMinvHistoIds[index+kMeanPt]);
+          TProfile* hprofsquare = Prof(mcPathHandle,fMinvHistoIds[index+kMeanPtSquare]);
+          FillMinvHisto(mcPathHandle,fMinvHistoIds[index+kMinv],hprof,hprofsquare,&pair4Momentum,inputWeight/AccxEff);
+        }
       }
     }
   }
-  delete proxy;
-  delete mcProxy;
 }
 
 
@@ -687,23 +719,19 @@ void AliAnalysisMuMuMinv::FillHistosForMCEvent(const char* eventSelection,const
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuMinv::FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight)
+void AliAnalysisMuMuMinv::FillMinvHisto(Int_t pathHandle, Int_t minvId, TProfile* hprof, TProfile* hprof2, TLorentzVector* pair4Momentum, Double_t inputWeight)
 {
-  /// Create, fill and store Minv histo
-  if (!IsHistogramDisabled(minvName->Data())){
+  /// Fill Minv histo (the caller checks that it is not disabled)
 
-    TH1* h(0x0);
-
-    h = proxy->Histo(minvName->Data());
-    if (h) h->Fill(pair4Momentum->M(),inputWeight);
+  TH1* h = Histo(pathHandle,minvId);
+  if (h) h->Fill(pair4Momentum->M(),inputWeight);
 
-    // Fill Mean pT
-    if ( fComputeMeanPt ){
-      if ( !hprof ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
-      else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
-      if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
-      else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
-    }
+  // Fill Mean pT
+  if ( fComputeMeanPt ){
+    if ( !hprof ) AliError(Form("Could not get hprofile for %s",NameOfHistoId(minvId)));
+    else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
+    if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",NameOfHistoId(minvId)));
+    else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
   }
 }
 
@@ -818,7 +846,7 @@ Bool_t AliAnalysisMuMuMinv::IsPtInRange(const AliVParticle& t1, const AliVPartic
 }
 
 //_____________________________________________________________________________
-Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy)
+Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, Int_t pathHandle)
 {
   /// Check if our pairs match conditions from the binning range
 
@@ -835,7 +863,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
     // Fill NchForJpsi histo according to pair4Momentum.M()
     if ( pair4Momentum->M() >= 2.9 && pair4Momentum->M() <= 3.3 ){
 
-      h = proxy->Histo("NchForJpsi");
+      h = Histo(pathHandle,fPairHistoIds[kNchForJpsi]);
 
       Double_t ntrcorr = (-1.);
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -859,7 +887,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
     }
     else if ( pair4Momentum->M() >= 3.6 && pair4Momentum->M() <= 3.9){
 
-      h = proxy->Histo("NchForPsiP");
+      h = Histo(pathHandle,fPairHistoIds[kNchForPsiP]);
       Double_t ntrcorr = (-1.);
 
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -1110,6 +1138,7 @@ void AliAnalysisMuMuMinv::SetBinsToFill(const char* particle, const char* bins)
 {
   delete fBinsToFill;
   fBinsToFill = Binning()->CreateBinObjArray(particle,bins,"");
+  fPairHistoIdsResolved = kFALSE;
 }
 
 //________________________________________________________________________
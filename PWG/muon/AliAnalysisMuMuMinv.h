@@ -14,6 +14,7 @@
 #include "TString.h"
 #include "TLorentzVector.h"
 #include "TH2.h"
+#include <vector>
 
 class TH2F;
 class AliVParticle;
@@ -43,7 +44,7 @@ public:
 
   void SetMuonWeight() { fWeightMuon=kTRUE; }
 
-  void SetLegacyBinNaming() { fMinvBinSeparator = ""; }
+  void SetLegacyBinNaming() { fMinvBinSeparator = ""; fPairHistoIdsResolved = kFALSE; }
 
   void SetBinsToFill(const char* particle, const char* bins);
 
@@ -72,7 +73,17 @@ protected:
 
   void FillHistosForMCEvent(const char* eventSelection,const char* triggerClassName,const char* centrality);
 
-  void FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight);
+  void FillMinvHisto(Int_t pathHandle, Int_t minvId, TProfile* hprof, TProfile* hprof2, TLorentzVector* pair4Momentum, Double_t inputWeight);
+
+  /// histograms filled by FillHistosForPair, with a single name
+  enum EPairHisto { kPtPaireVsPtTrack, kPtRecVsSim, kMCPt, kMCY, kMCEta, kNchForJpsi, kNchForPsiP, kNPairHistos };
+  /// sparses filled by FillHistosForPair, per mix and pair charge
+  enum EPairSparse { kSparsePt, kSparseY, kSparseEta, kNPairSparses };
+  /// histograms filled by FillMinvHisto, per bin, acc x eff correction, pair charge and mix
+  enum EMinvHisto { kMinv, kMeanPt, kMeanPtSquare, kNMinvHistos };
+
+  void ResolvePairHistoIds();
+  Int_t MinvHistoIndex(Int_t bin, Bool_t accEffCorrected, Double_t pairCharge, Bool_t mix) const;
 
 private:
 
@@ -91,7 +102,7 @@ private:
 
   Double_t TriggerLptApt(Double_t *x, Double_t *par);
 
-  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy);
+  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, Int_t pathHandle);
 
   Bool_t CheckMCTracksMatchingStackAndMother(Int_t labeli, Int_t labelj, AliVParticle* mcTracki, AliVParticle* mcTrackj, Double_t inputWeightMC);
 
@@ -112,7 +123,15 @@ private:
   Double_t fmcptcutmin;
   Double_t fmcptcutmax;
 
-  ClassDef(AliAnalysisMuMuMinv,8) // implementation of AliAnalysisMuMuBase for muon pairs
+  Bool_t fPairHistoIdsResolved; //! whether the histogram ids and disabled flags below are set
+  Int_t fPairHistoIds[kNPairHistos]; //! histogram ids of EPairHisto
+  Int_t fPairSparseIds[kNPairSparses][2][3]; //! sparse ids per mix and pair charge (0, ++, --)
+  Bool_t fPairSparseDisabled[kNPairSparses]; //! whether the sparses are disabled
+  Bool_t fPtPaireVsPtTrackDisabled; //! whether PtPaireVsPtTrack is disabled
+  std::vector<Int_t> fMinvHistoIds; //! ids of EMinvHisto, see MinvHistoIndex
+  std::vector<Bool_t> fMinvHistoDisabled; //! whether the minv histograms are disabled, see MinvHistoIndex
+
+  ClassDef(AliAnalysisMuMuMinv,9) // implementation of AliAnalysisMuMuBase for muon pairs
 };
 
 #endif
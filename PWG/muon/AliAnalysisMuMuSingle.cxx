@@ -36,7 +36,8 @@ fMuonTrackCuts(0x0),
 fShouldSeparatePlusAndMinus(kFALSE),
 fAccEffHisto(0x0),
 fPtEtaSpectraPerBCX(kFALSE),
-fDCAHistos(kFALSE)
+fDCAHistos(kFALSE),
+fTrackHistoIdsResolved(kFALSE)
 {
   /// ctor
 }
@@ -190,7 +191,7 @@ void AliAnalysisMuMuSingle::DefineHistogramCollection(const char* eventSelection
   /// Actually create the histograms for phyics/triggerClassName
 
 
-  if ( Histo(eventSelection,triggerClassName,centrality,"AliAnalysisMuMuSingle") )
+  if ( Histo(PathHandle(eventSelection,triggerClassName,centrality),HistoId("AliAnalysisMuMuSingle")) )
   {
     return;
   }
@@ -265,7 +266,34 @@ void AliAnalysisMuMuSingle::DefineHistogramCollection(const char* eventSelection
 
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy& proxy,
+void AliAnalysisMuMuSingle::ResolveTrackHistoIds()
+{
+  /// Histogram ids and disabled flags of the histograms filled for each track,
+  /// so that FillHistosForMuonTrack neither formats names nor matches patterns
+
+  const char* names[kNTrackHistos] = { "BCX", "Chi2MatchTrigger", "EtaRapidityMu", "PtEtaMu", "PtRapidityMu", "PEtaMu", "PtPhiMu",
+                                       "Chi2Mu", "dcaP23Mu", "dcaPwPtCut23Mu", "dcaP310Mu", "dcaPwPtCut310Mu" };
+  const char* suffix[] = { "Plus", "Minus" };
+
+  for ( Int_t i = 0; i < kNTrackHistos; ++i )
+  {
+    // BCX and Chi2MatchTrigger are never separated per charge
+    Bool_t perCharge = ( i != kBCX && i != kChi2MatchTrigger );
+
+    fTrackHistoDisabled[i] = IsHistogramDisabled(perCharge ? Form("%s*",names[i]) : names[i]);
+
+    for ( Int_t c = 0; c < 2; ++c )
+    {
+      TString hname(names[i]);
+      if ( perCharge && ShouldSeparatePlusAndMinus() ) hname += suffix[c];
+      fTrackHistoIds[i][c] = HistoId(hname.Data());
+    }
+  }
+  fTrackHistoIdsResolved = kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuSingle::FillHistosForMuonTrack(Int_t pathHandle,
                                                    const AliVParticle& track)
 {
   /// Fill histograms for one track
@@ -281,78 +309,72 @@ void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy&
                    TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+track.P()*track.P()));
 
 
-  TString charge("");
-
-  if ( ShouldSeparatePlusAndMinus() )
-  {
-    if ( track.Charge() < 0 )
-    {
-      charge = "Minus";
-    }
-    else
-    {
-      charge = "Plus";
-    }
-  }
+  // index of the charge in fTrackHistoIds (both indices give the same histogram if not separated)
+  Int_t c = ( track.Charge() < 0 ) ? 1 : 0;
 
   Double_t dca = EAGetTrackDCA(track);
 
   Double_t theta = AliAnalysisMuonUtility::GetThetaAbsDeg(&track);
 
-  if (!IsHistogramDisabled("BCX"))
+  if (!fTrackHistoDisabled[kBCX])
   {
-    proxy.Histo("BCX")->Fill(1.0*Event()->GetBunchCrossNumber());
+    Histo(pathHandle,fTrackHistoIds[kBCX][c])->Fill(1.0*Event()->GetBunchCrossNumber());
   }
 
-  if (!IsHistogramDisabled("Chi2MatchTrigger"))
+  if (!fTrackHistoDisabled[kChi2MatchTrigger])
   {
-    proxy.Histo("Chi2MatchTrigger")->Fill(AliAnalysisMuonUtility::GetChi2MatchTrigger(&track));
+    Histo(pathHandle,fTrackHistoIds[kChi2MatchTrigger][c])->Fill(AliAnalysisMuonUtility::GetChi2MatchTrigger(&track));
   }
 
-  if (!IsHistogramDisabled("EtaRapidityMu*"))
+  if (!fTrackHistoDisabled[kEtaRapidityMu])
   {
-    proxy.Histo(Form("EtaRapidityMu%s",charge.Data()))->Fill(p.Rapidity(),p.Eta());
+    Histo(pathHandle,fTrackHistoIds[kEtaRapidityMu][c])->Fill(p.Rapidity(),p.Eta());
   }
 
-  if (!IsHistogramDisabled("PtEtaMu*"))
+  if (!fTrackHistoDisabled[kPtEtaMu])
   {
-    TH1* h = proxy.Histo(Form("PtEtaMu%s",charge.Data()));
+    TH1* h = Histo(pathHandle,fTrackHistoIds[kPtEtaMu][c]);
 
     h->Fill(p.Eta(),p.Pt());
 
     if  ( fPtEtaSpectraPerBCX )
     {
-      if (!IsHistogramDisabled("BCX"))
+      if (!fTrackHistoDisabled[kBCX])
       {
-        TH1* hbcx = proxy.Histo(Form("PtEtaMu%sBCX%d",charge.Data(),Event()->GetBunchCrossNumber()));
+        // one histogram per bunch crossing : by name, these are created on the fly
+        TString charge("");
+        if ( ShouldSeparatePlusAndMinus() ) charge = c ? "Minus" : "Plus";
+
+        TString hbcxName(Form("PtEtaMu%sBCX%d",charge.Data(),Event()->GetBunchCrossNumber()));
+        TH1* hbcx = HistogramCollection()->Histo(PathOfHandle(pathHandle),hbcxName.Data());
 
         if (!hbcx)
         {
-          hbcx = static_cast<TH1*>(h->Clone(Form("PtEtaMu%sBCX%d",charge.Data(),Event()->GetBunchCrossNumber())));
-          proxy.Adopt(hbcx);
+          hbcx = static_cast<TH1*>(h->Clone(hbcxName.Data()));
+          HistogramCollection()->Adopt(PathOfHandle(pathHandle),hbcx);
         }
       }
     }
   }
 
-  if (!IsHistogramDisabled("PtRapidityMu*"))
+  if (!fTrackHistoDisabled[kPtRapidityMu])
   {
-    proxy.Histo(Form("PtRapidityMu%s",charge.Data()))->Fill(p.Rapidity(),p.Pt());
+    Histo(pathHandle,fTrackHistoIds[kPtRapidityMu][c])->Fill(p.Rapidity(),p.Pt());
   }
 
-  if (!IsHistogramDisabled("PEtaMu*"))
+  if (!fTrackHistoDisabled[kPEtaMu])
   {
-    proxy.Histo(Form("PEtaMu%s",charge.Data()))->Fill(p.Eta(),p.P());
+    Histo(pathHandle,fTrackHistoIds[kPEtaMu][c])->Fill(p.Eta(),p.P());
   }
 
-  if (!IsHistogramDisabled("PtPhiMu*"))
+  if (!fTrackHistoDisabled[kPtPhiMu])
   {
-    proxy.Histo(Form("PtPhiMu%s",charge.Data()))->Fill(p.Phi(),p.Pt());
+    Histo(pathHandle,fTrackHistoIds[kPtPhiMu][c])->Fill(p.Phi(),p.Pt());
   }
 
-  if (!IsHistogramDisabled("Chi2Mu*"))
+  if (!fTrackHistoDisabled[kChi2Mu])
   {
-    proxy.Histo(Form("Chi2Mu%s",charge.Data()))->Fill(AliAnalysisMuonUtility::GetChi2perNDFtracker(&track));
+    Histo(pathHandle,fTrackHistoIds[kChi2Mu][c])->Fill(AliAnalysisMuonUtility::GetChi2perNDFtracker(&track));
   }
 
   // if (!IsHistogramDisabled("HitperTriggerLocalBoardMu*"))
@@ -373,30 +395,30 @@ void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy&
   if ( theta >= 2.0 && theta < 3.0 )
   {
 
-    if (!IsHistogramDisabled("dcaP23Mu*"))
+    if (!fTrackHistoDisabled[kdcaP23Mu])
     {
-      proxy.Histo(Form("dcaP23Mu%s",charge.Data()))->Fill(p.P(),dca);
+      Histo(pathHandle,fTrackHistoIds[kdcaP23Mu][c])->Fill(p.P(),dca);
     }
 
     if ( p.Pt() > 2 )
     {
-      if (!IsHistogramDisabled("dcaPwPtCut23Mu*"))
+      if (!fTrackHistoDisabled[kdcaPwPtCut23Mu])
       {
-        proxy.Histo(Form("dcaPwPtCut23Mu%s",charge.Data()))->Fill(p.P(),dca);
+        Histo(pathHandle,fTrackHistoIds[kdcaPwPtCut23Mu][c])->Fill(p.P(),dca);
       }
     }
   }
   else if ( theta >= 3.0 && theta < 10.0 )
   {
-    if (!IsHistogramDisabled("dcaP310Mu*"))
+    if (!fTrackHistoDisabled[kdcaP310Mu])
     {
-      proxy.Histo(Form("dcaP310Mu%s",charge.Data()))->Fill(p.P(),dca);
+      Histo(pathHandle,fTrackHistoIds[kdcaP310Mu][c])->Fill(p.P(),dca);
     }
     if ( p.Pt() > 2 )
     {
-      if (!IsHistogramDisabled("dcaPwPtCut310Mu*"))
+      if (!fTrackHistoDisabled[kdcaPwPtCut310Mu])
       {
-        proxy.Histo(Form("dcaPwPtCut310Mu%s",charge.Data()))->Fill(p.P(),dca);
+        Histo(pathHandle,fTrackHistoIds[kdcaPwPtCut310Mu][c])->Fill(p.P(),dca);
       }
     }
   }
@@ -413,11 +435,9 @@ void AliAnalysisMuMuSingle::FillHistosForTrack(const char* eventSelection,
 
   if (!AliAnalysisMuonUtility::IsMuonTrack(&track) ) return;
 
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,trackCutName));
-
-  FillHistosForMuonTrack(*proxy,track);
+  if ( !fTrackHistoIdsResolved ) ResolveTrackHistoIds();
 
-  delete proxy;
+  FillHistosForMuonTrack(PathHandle(eventSelection,triggerClassName,centrality,trackCutName),track);
 }
 
 //_____________________________________________________________________________
@@ -71,7 +71,7 @@ protected:
                                   const char* trackCutName,
                                   const AliVParticle& part);
 
-  void FillHistosForMuonTrack(AliMergeableCollectionProxy& proxy, const AliVParticle& track);
+  void FillHistosForMuonTrack(Int_t pathHandle, const AliVParticle& track);
 
 
 private:
@@ -104,6 +104,12 @@ private:
 
   Double_t EAGetTrackDCA(const AliVParticle& particle) const;
 
+  /// histograms filled by FillHistosForMuonTrack
+  enum ETrackHisto { kBCX, kChi2MatchTrigger, kEtaRapidityMu, kPtEtaMu, kPtRapidityMu, kPEtaMu, kPtPhiMu,
+                     kChi2Mu, kdcaP23Mu, kdcaPwPtCut23Mu, kdcaP310Mu, kdcaPwPtCut310Mu, kNTrackHistos };
+
+  void ResolveTrackHistoIds();
+
 private:
 
   /// not implemented on purpose
@@ -118,7 +124,11 @@ private:
   Bool_t fPtEtaSpectraPerBCX; // make pt vs eta spectra bunch by bunch (caution : much slower !)
   Bool_t fDCAHistos; // make DCA histograms
 
-  ClassDef(AliAnalysisMuMuSingle,3) // implementation of AliAnalysisMuMuBase for single mu analysis
+  Bool_t fTrackHistoIdsResolved; //! whether fTrackHistoIds and fTrackHistoDisabled are set
+  Int_t fTrackHistoIds[kNTrackHistos][2]; //! histogram ids for mu+ and mu- (identical if not separated)
+  Bool_t fTrackHistoDisabled[kNTrackHistos]; //! whether the histograms are disabled
+
+  ClassDef(AliAnalysisMuMuSingle,4) // implementation of AliAnalysisMuMuBase for single mu analysis
 };
 
 #endif
@@ -431,6 +431,29 @@ void AliBalancePsi::InitHistograms() {
 
 }
 
+namespace {
+  // radii at which dphistar is evaluated by the HBT cut: the scan from 0.8 to 2.5 in steps
+  // of 0.01 (same values as the loop of the cut), then 0.8, 2.5 and the middle of the TPC 1.65
+  std::vector<Float_t> DPhiStarRadii() {
+    std::vector<Float_t> radii;
+    for (Double_t rad=0.8; rad<2.51; rad+=0.01) radii.push_back(rad);
+    radii.push_back(0.8);
+    radii.push_back(2.5);
+    radii.push_back(1.65);
+    return radii;
+  }
+  const std::vector<Float_t> gDPhiStarRadii = DPhiStarRadii();
+
+  // bending ASin(0.075*radius/pt) of each particle at all radii (row per particle)
+  void FillBendingTable(const TArrayF &pt, Int_t n, std::vector<Double_t> &table) {
+    const Int_t nRadii = gDPhiStarRadii.size();
+    table.resize(n*nRadii);
+    for (Int_t i = 0; i < n; i++)
+      for (Int_t r = 0; r < nRadii; r++)
+	table[i*nRadii+r] = TMath::ASin(0.075 * gDPhiStarRadii[r] / pt[i]);
+  }
+}
+
 //____________________________________________________________________//
 void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
 				     TObjArray *particles, 
@@ -484,6 +507,26 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     if (fSameLabelMCCut) secondLabel[i]  = (Int_t)((AliBFBasicParticle*) particlesSecond->At(i))->GetLabel(); 
     if (fResonancesLabelCut) secondMotherLabel[i] = (Int_t)((AliBFBasicParticle*) particlesSecond->At(i))->GetMotherLabel();
   }
+
+  // the bending of the tracks entering dphistar is computed once per particle and radius
+  // (instead of for each pair and radius in the HBT cut)
+  const Int_t nRadii = gDPhiStarRadii.size();
+  const Int_t kRadiusScanEnd = nRadii-3, kRadiusInner = nRadii-3, kRadiusOuter = nRadii-2, kRadiusMiddle = nRadii-1;
+  std::vector<Double_t> secondBending, firstBendingMixed;
+  if (fHBTCut) {
+    FillBendingTable(secondPt, jMax, secondBending);
+    if (particlesMixed) {
+      TArrayF firstPtMixed(iMax);
+      for (Int_t i=0; i<iMax; i++) firstPtMixed[i] = ((AliVParticle*) particles->At(i))->Pt();
+      FillBendingTable(firstPtMixed, iMax, firstBendingMixed);
+    }
+  }
+  const std::vector<Double_t> &firstBending = (particlesMixed) ? firstBendingMixed : secondBending;
+
+  // delta eta, delta phi and preselection of the pairs of one trigger particle
+  std::vector<Double_t> pairDeltaEta(jMax);
+  std::vector<Double_t> pairDeltaPhi(jMax);
+  std::vector<Char_t> pairAccepted(jMax);
   
   //TLorenzVector implementation for resonances
   TLorentzVector vectorMother, vectorDaughter[2];
@@ -560,36 +603,32 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     //fill single particle histograms
     if(charge1 > 0)      fHistP->Fill(trackVariablesSingle,0,firstCorrection); //==========================correction
     else if(charge1 < 0) fHistN->Fill(trackVariablesSingle,0,firstCorrection);  //==========================correction
+
+    // delta eta, delta phi and preselection of all pairs of this particle
+    // (branch free loop over the cached arrays, vectorized by the compiler)
+    const Double_t kPi = TMath::Pi();
+    for(Int_t j = 0; j < jMax; j++) {
+      Double_t dphi = firstPhi - secondPhi[j];
+      dphi = (dphi > kPi) ? dphi - 2.*kPi : dphi;     // delta phi between -pi and pi
+      dphi = (dphi < -kPi) ? dphi + 2.*kPi : dphi;
+      dphi = (dphi < -kPi/2.) ? dphi + 2.*kPi : dphi;
+      pairDeltaEta[j] = firstEta - secondEta[j];
+      pairDeltaPhi[j] = dphi;
+      // associated particles only; pT,Assoc < pT,Trig (if momentum ordering is switched ON)
+      pairAccepted[j] = (secondTrigOrAssoc[j] != 0) && !(fMomentumOrdering && firstPt < secondPt[j]);
+    }
+    if(!particlesMixed) pairAccepted[i] = 0; // no auto correlations (only for non mixing)
     
     // 2nd particle loop
     for(Int_t j = 0; j < jMax; j++) {   
 
-      if(!particlesMixed && j == i) continue; // no auto correlations (only for non mixing)
-
-      if (secondTrigOrAssoc[j] == 0)
-      continue;
-
-      // pT,Assoc < pT,Trig (if momentum ordering is switched ON)
-      if(fMomentumOrdering){
-	if(firstPt < secondPt[j]) 
-	  continue;
-      }
+      if(!pairAccepted[j]) continue;
 
       Short_t charge2 = secondCharge[j];
       
       trackVariablesPair[0]    =  trackVariablesSingle[0];
-      trackVariablesPair[1]    =  firstEta - secondEta[j];  // delta eta
-      trackVariablesPair[2]    =  firstPhi - secondPhi[j];  // delta phi
-      //if (trackVariablesPair[2] > 180.)   // delta phi between -180 and 180 
-      //trackVariablesPair[2] -= 360.;
-      //if (trackVariablesPair[2] <  - 180.) 
-      //trackVariablesPair[2] += 360.;
-      if (trackVariablesPair[2] > TMath::Pi()) // delta phi between -pi and pi 
-	trackVariablesPair[2] -= 2.*TMath::Pi();
-      if (trackVariablesPair[2] <  - TMath::Pi()) 
-	trackVariablesPair[2] += 2.*TMath::Pi();
-      if (trackVariablesPair[2] <  - TMath::Pi()/2.) 
-      trackVariablesPair[2] += 2.*TMath::Pi();
+      trackVariablesPair[1]    =  pairDeltaEta[j];  // delta eta
+      trackVariablesPair[2]    =  pairDeltaPhi[j];  // delta phi
       
       trackVariablesPair[3]    =  firstPt;      // pt trigger
       trackVariablesPair[4]    =  secondPt[j];  // pt
@@ -674,7 +713,9 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
 	  dphi = secondPhi[j] - firstPhi;
 
 	// for QA: get dphistar in the middle of the TPC R = 1.65
-	Float_t  dphistarMiddle = GetDPhiStar(firstPhi, firstPt, charge1, secondPhi[j], secondPt[j], charge2, 1.65, bSign);
+	const Double_t *bending1 = &firstBending[i*nRadii];
+	const Double_t *bending2 = &secondBending[j*nRadii];
+	Float_t  dphistarMiddle = GetDPhiStar(firstPhi, charge1, bending1[kRadiusMiddle], secondPhi[j], charge2, bending2[kRadiusMiddle], bSign);
 
 	// VERSION 2 (Taken from DPhiCorrelations)
 	// the variables & cuthave been developed by the HBT group 
@@ -692,8 +733,8 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
 	    Float_t phi2rad = secondPhi[j];
 	    
 	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 0.8, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 2.5, bSign);
+	    Float_t dphistar1 = GetDPhiStar(phi1rad, charge1, bending1[kRadiusInner], phi2rad, charge2, bending2[kRadiusInner], bSign);
+	    Float_t dphistar2 = GetDPhiStar(phi1rad, charge1, bending1[kRadiusOuter], phi2rad, charge2, bending2[kRadiusOuter], bSign);
 	    
 	    const Float_t kLimit = fHBTCutValue * 3;
 
@@ -703,8 +744,8 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
 	    //Float_t dphistarmin = 1e5;
 	    
 	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0 ) {
-	      for (Double_t rad=0.8; rad<2.51; rad+=0.01) {
-		Float_t dphistar = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, rad, bSign);
+	      for (Int_t iRad=0; iRad<kRadiusScanEnd; iRad++) { // rad from 0.8 to 2.5
+		Float_t dphistar = GetDPhiStar(phi1rad, charge1, bending1[iRad], phi2rad, charge2, bending2[iRad], bSign);
 		//Printf("inside loop r = %f, dphistar = %f", rad,  dphistar); 
 			    
 		Float_t dphistarabs = TMath::Abs(dphistar);
@@ -2843,7 +2884,15 @@ Float_t AliBalancePsi::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, F
   //
   // calculates dphistar
   //
-  Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
+  return GetDPhiStar(phi1, charge1, TMath::ASin(0.075 * radius / pt1), phi2, charge2, TMath::ASin(0.075 * radius / pt2), bSign);
+}
+
+//____________________________________________________________________//
+Float_t AliBalancePsi::GetDPhiStar(Float_t phi1, Float_t charge1, Double_t bending1, Float_t phi2, Float_t charge2, Double_t bending2, Float_t bSign) { 
+  //
+  // calculates dphistar from the bending ASin(0.075 * radius / pt) of both tracks
+  //
+  Float_t dphistar = phi1 - phi2 - charge1 * bSign * bending1 + charge2 * bSign * bending2;
   
   static const Double_t kPi = TMath::Pi();
   
@@ -33,6 +33,14 @@ void AliFemtoCorrFctn::AddMixedPair(AliFemtoPair*)
 {
   cout << "AliFemtoCorrFctn::AddMixedPair -- Not implemented\n";
 }
+void AliFemtoCorrFctn::AddRealPairs(const AliFemtoPairBlock&)
+{
+  cout << "AliFemtoCorrFctn::AddRealPairs -- Not implemented\n";
+}
+void AliFemtoCorrFctn::AddMixedPairs(const AliFemtoPairBlock&)
+{
+  cout << "AliFemtoCorrFctn::AddMixedPairs -- Not implemented\n";
+}
 
 void AliFemtoCorrFctn::AddFirstParticle(AliFemtoParticle*, bool)
 {
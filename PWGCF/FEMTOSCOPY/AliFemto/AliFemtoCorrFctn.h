@@ -14,6 +14,8 @@
 
 #include <TCollection.h>
 
+class AliFemtoPairBlock;
+
 
 /// \class AliFemtoCorrFctn
 /// \brief The pure-virtual base class for correlation functions
@@ -44,6 +46,16 @@ public:
   /// Not Implemented - Add background pair
   virtual void AddMixedPair(AliFemtoPair* aPir);
 
+  /// Block interface, used by AliFemtoSimpleAnalysis in pair-block mode.
+  /// Correlation functions returning true here receive the pairs through
+  /// AddRealPairs/AddMixedPairs instead of AddRealPair/AddMixedPair and
+  /// must only use the pairs whose pass flag is set.
+  virtual bool SupportsPairBlock() const { return false; }
+  /// Not Implemented - Add block of signal pairs
+  virtual void AddRealPairs(const AliFemtoPairBlock& block);
+  /// Not Implemented - Add block of background pairs
+  virtual void AddMixedPairs(const AliFemtoPairBlock& block);
+
   /// Not Implemented - Add pair with optional
   virtual void AddFirstParticle(AliFemtoParticle *particle, bool mixing);
   virtual void AddSecondParticle(AliFemtoParticle *particle);
@@ -4,6 +4,7 @@
 
 
 #include "AliFemtoCorrFctnNonIdDR.h"
+#include "AliFemtoPairBlock.h"
 #include <TH1D.h>
 //#include "AliFemtoHisto.h"
 #include <cstdio>
@@ -282,6 +283,39 @@ void AliFemtoCorrFctnNonIdDR::AddMixedPair(AliFemtoPair* pair)
   //finish adding
 }
 //____________________________
+// Fill the six k* histograms and the kT monitor (if given) from the
+// passing pairs of a block
+static
+void AddPairBlock(const AliFemtoPairBlock &block,
+                  TH1D &outP, TH1D &outN,
+                  TH1D &sideP, TH1D &sideN,
+                  TH1D &longP, TH1D &longN,
+                  TH1D *ktMonitor)
+{
+  for (unsigned int i = 0; i < block.Size(); ++i) {
+    if (!block.Pass(i)) {
+      continue;
+    }
+    const double tKStar = block.KStar(i);
+    (block.KStarOut(i) > 0.0 ? outP : outN).Fill(tKStar);
+    (block.KStarSide(i) > 0.0 ? sideP : sideN).Fill(tKStar);
+    (block.KStarLong(i) > 0.0 ? longP : longN).Fill(tKStar);
+    if (ktMonitor) {
+      ktMonitor->Fill(block.KT(i));
+    }
+  }
+}
+//____________________________
+void AliFemtoCorrFctnNonIdDR::AddRealPairs(const AliFemtoPairBlock& block)
+{ // add block of true pairs
+  AddPairBlock(block, *fNumOutP, *fNumOutN, *fNumSideP, *fNumSideN, *fNumLongP, *fNumLongN, fkTMonitor);
+}
+//____________________________
+void AliFemtoCorrFctnNonIdDR::AddMixedPairs(const AliFemtoPairBlock& block)
+{ // add block of mixed (background) pairs
+  AddPairBlock(block, *fDenOutP, *fDenOutN, *fDenSideP, *fDenSideN, *fDenLongP, *fDenLongN, nullptr);
+}
+//____________________________
 void AliFemtoCorrFctnNonIdDR::Write()
 {
   fNumOutP->Write();
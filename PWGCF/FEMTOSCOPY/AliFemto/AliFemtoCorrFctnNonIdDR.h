@@ -31,6 +31,12 @@ public:
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
 
+  /// The block interface is used when there is no CF-level pair cut
+  /// and the particle ntuple is not filled
+  virtual bool SupportsPairBlock() const { return !fPairCut && !fParticleP; }
+  virtual void AddRealPairs(const AliFemtoPairBlock& block);
+  virtual void AddMixedPairs(const AliFemtoPairBlock& block);
+
   virtual void Finish();
 
   virtual TList* GetOutputList();
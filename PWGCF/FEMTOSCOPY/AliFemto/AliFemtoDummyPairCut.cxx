@@ -3,6 +3,7 @@
 ///
 
 #include "AliFemtoDummyPairCut.h"
+#include "AliFemtoPairBlock.h"
 #include <string>
 #include <cstdio>
 
@@ -33,6 +34,15 @@ bool AliFemtoDummyPairCut::Pass(const AliFemtoPair* /* pair */)
   return true;
 }
 //__________________
+void AliFemtoDummyPairCut::PassBlock(AliFemtoPairBlock &block)
+{
+  // Pass all pairs of the block
+  for (unsigned int i = 0; i < block.Size(); ++i) {
+    block.SetPass(i, true);
+  }
+  fNPairsPassed += block.Size();
+}
+//__________________
 AliFemtoString AliFemtoDummyPairCut::Report()
 {
   // prepare a report from the execution
@@ -82,6 +82,8 @@ public:
   AliFemtoDummyPairCut& operator=(const AliFemtoDummyPairCut&);
 
   virtual bool Pass(const AliFemtoPair*);
+  virtual bool SupportsPairBlock() const { return true; }
+  virtual void PassBlock(AliFemtoPairBlock &block);
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   AliFemtoDummyPairCut* Clone();
@@ -11,7 +11,19 @@
 //#include "AliFemtoParticleCollection.h"
 //#include "AliFemtoTrackCut.h"
 //#include "AliFemtoV0Cut.h"
+#include "AliFemtoSimpleAnalysis.h"
+#include "AliFemtoCorrFctnCollection.h"
+
+#include <TROOT.h>
+
 #include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -20,12 +32,130 @@
 #endif
 
 
+/// \class AliFemtoManagerWorkerPool
+/// \brief Persistent threads running the analyses of an event together
+///        with the thread of AliFemtoManager::ProcessEvent
+///
+/// Run() hands the analyses to the workers and the calling thread, which
+/// take them one at a time, and returns when all are processed.
+///
+class AliFemtoManagerWorkerPool {
+public:
+  explicit AliFemtoManagerWorkerPool(size_t aNWorkers);
+  ~AliFemtoManagerWorkerPool();
+
+  void Run(const std::vector<AliFemtoAnalysis*> &aAnalyses, AliFemtoEvent* aEvent);
+  size_t NWorkers() const { return fThreads.size(); }
+
+private:
+  void Work();
+  void ProcessAnalyses();
+
+  std::vector<std::thread> fThreads;
+  std::mutex fMutex;                    ///< protects the members below
+  std::condition_variable fStart;       ///< new event or stop
+  std::condition_variable fDone;        ///< all workers done with the event
+  unsigned long fGeneration;            ///< number of events handed to the workers
+  size_t fNBusy;                        ///< workers still processing the current event
+  bool fStop;
+
+  const std::vector<AliFemtoAnalysis*> *fAnalyses;  ///< analyses of the current event
+  AliFemtoEvent* fEvent;                            ///< current event
+  std::atomic<size_t> fNext;                        ///< next analysis to process
+
+  AliFemtoManagerWorkerPool(const AliFemtoManagerWorkerPool&);
+  AliFemtoManagerWorkerPool& operator=(const AliFemtoManagerWorkerPool&);
+};
+
+AliFemtoManagerWorkerPool::AliFemtoManagerWorkerPool(size_t aNWorkers):
+  fThreads(),
+  fMutex(),
+  fStart(),
+  fDone(),
+  fGeneration(0),
+  fNBusy(0),
+  fStop(false),
+  fAnalyses(nullptr),
+  fEvent(nullptr),
+  fNext(0)
+{
+  fThreads.reserve(aNWorkers);
+  for (size_t i = 0; i < aNWorkers; ++i) {
+    fThreads.emplace_back(&AliFemtoManagerWorkerPool::Work, this);
+  }
+}
+
+AliFemtoManagerWorkerPool::~AliFemtoManagerWorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fStart.notify_all();
+  for (auto &thread : fThreads) {
+    thread.join();
+  }
+}
+
+void AliFemtoManagerWorkerPool::Run(const std::vector<AliFemtoAnalysis*> &aAnalyses, AliFemtoEvent* aEvent)
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fAnalyses = &aAnalyses;
+    fEvent = aEvent;
+    fNext = 0;
+    fNBusy = fThreads.size();
+    ++fGeneration;
+  }
+  fStart.notify_all();
+
+  ProcessAnalyses();
+
+  // every worker takes part in each event, so none can miss the next one
+  std::unique_lock<std::mutex> lock(fMutex);
+  fDone.wait(lock, [this] { return fNBusy == 0; });
+}
+
+void AliFemtoManagerWorkerPool::Work()
+{
+  unsigned long generation = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fStart.wait(lock, [this, generation] { return fStop || fGeneration != generation; });
+      if (fStop) {
+        return;
+      }
+      generation = fGeneration;
+    }
+    ProcessAnalyses();
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (--fNBusy == 0) {
+        fDone.notify_one();
+      }
+    }
+  }
+}
+
+void AliFemtoManagerWorkerPool::ProcessAnalyses()
+{
+  for (size_t i = fNext++; i < fAnalyses->size(); i = fNext++) {
+    (*fAnalyses)[i]->ProcessEvent(fEvent);
+  }
+}
+
+
 
 //____________________________
 AliFemtoManager::AliFemtoManager():
   fAnalysisCollection(nullptr),
   fEventReader(nullptr),
-  fEventWriterCollection(nullptr)
+  fEventWriterCollection(nullptr),
+  fNThreads(1),
+  fConcurrentChecked(false),
+  fConcurrent(false),
+  fWorkerPool(nullptr)
 {
   // default constructor
   fAnalysisCollection = new AliFemtoAnalysisCollection;
@@ -35,7 +165,11 @@ AliFemtoManager::AliFemtoManager():
 AliFemtoManager::AliFemtoManager(const AliFemtoManager& aManager):
   fAnalysisCollection(new AliFemtoAnalysisCollection),
   fEventReader(aManager.fEventReader),
-  fEventWriterCollection(new AliFemtoEventWriterCollection)
+  fEventWriterCollection(new AliFemtoEventWriterCollection),
+  fNThreads(aManager.fNThreads),
+  fConcurrentChecked(false),
+  fConcurrent(false),
+  fWorkerPool(nullptr)
 {
   // copy constructor
   for (auto *analysis : *aManager.fAnalysisCollection) {
@@ -50,6 +184,7 @@ AliFemtoManager::AliFemtoManager(const AliFemtoManager& aManager):
 AliFemtoManager::~AliFemtoManager()
 {
   // destructor
+  delete fWorkerPool;
   delete fEventReader;
   // now delete each Analysis in the Collection, and then the Collection itself
   for (auto *analysis : *fAnalysisCollection) {
@@ -71,7 +206,7 @@ AliFemtoManager& AliFemtoManager::operator=(const AliFemtoManager& aManager)
   }
 
   fEventReader = aManager.fEventReader;
-
+  SetNThreads(aManager.fNThreads);
 
   for (auto *analysis : *fAnalysisCollection) {
     delete analysis;
@@ -210,8 +345,19 @@ int AliFemtoManager::ProcessEvent()
   }
 
   // loop over all the Analysis
-  for (auto *analysis : *fAnalysisCollection) {
-    analysis->ProcessEvent(currentHbtEvent);
+  if (fNThreads > 1 && fAnalysisCollection->size() > 1) {
+    if (!fConcurrentChecked) {
+      fConcurrent = AnalysesAreIndependent();
+      fConcurrentChecked = true;
+    }
+  }
+
+  if (fNThreads > 1 && fConcurrent) {
+    ProcessAnalysesConcurrently(currentHbtEvent);
+  } else {
+    for (auto *analysis : *fAnalysisCollection) {
+      analysis->ProcessEvent(currentHbtEvent);
+    }
   }
 
   if (currentHbtEvent) {
@@ -221,3 +367,67 @@ int AliFemtoManager::ProcessEvent()
 
   return 0;    // 0 = "good return"
 }       // ProcessEvent
+//____________________________
+void AliFemtoManager::SetNThreads(int aThreads)
+{
+  /// Set the number of threads running the analyses of an event
+  fNThreads = aThreads < 1 ? 1 : aThreads;
+  fConcurrentChecked = false;
+  delete fWorkerPool;
+  fWorkerPool = nullptr;
+  if (fNThreads > 1) {
+    ROOT::EnableThreadSafety();
+  }
+}
+//____________________________
+bool AliFemtoManager::AnalysesAreIndependent() const
+{
+  /// Check that no cut or correlation function is used by more than one
+  /// analysis, which would be modified from several threads at once.
+  /// Only analyses deriving from AliFemtoSimpleAnalysis can be checked;
+  /// any other analysis makes the manager stay sequential.
+  std::set<const void*> used;
+
+  for (auto *analysis : *fAnalysisCollection) {
+    auto *simple = dynamic_cast<AliFemtoSimpleAnalysis*>(analysis);
+    if (!simple) {
+      cout << "W-AliFemtoManager: analysis type not known to be thread-safe"
+              " - running the analyses sequentially\n";
+      return false;
+    }
+
+    // first and second particle cut may be the same object within one analysis
+    std::set<const void*> objects { simple->EventCut(),
+                                    simple->FirstParticleCut(),
+                                    simple->SecondParticleCut(),
+                                    simple->PairCut() };
+    for (auto *cf : *simple->CorrFctnCollection()) {
+      objects.insert(cf);
+    }
+    objects.erase(nullptr);
+
+    for (const void *object : objects) {
+      if (!used.insert(object).second) {
+        cout << "W-AliFemtoManager: cut or correlation function shared between analyses"
+                " - running the analyses sequentially\n";
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+//____________________________
+void AliFemtoManager::ProcessAnalysesConcurrently(AliFemtoEvent* aEvent)
+{
+  /// Run the analyses on the event, distributed over fNThreads threads
+  /// (the calling one and the workers of the pool, started at the first
+  /// call). Each analysis is processed by exactly one thread; returns when
+  /// all are done.
+  const std::vector<AliFemtoAnalysis*> analyses(fAnalysisCollection->begin(),
+                                                fAnalysisCollection->end());
+  if (!fWorkerPool) {
+    fWorkerPool = new AliFemtoManagerWorkerPool(fNThreads - 1);
+  }
+  fWorkerPool->Run(analyses, aEvent);
+}
@@ -19,6 +19,7 @@
 #include "AliFemtoEventReader.h"
 #include "AliFemtoEventWriter.h"
 
+class AliFemtoManagerWorkerPool;
 
 /// \class AliFemtoManager
 /// \brief Main class for managing femtoscopic analyses
@@ -37,6 +38,24 @@
 /// EventWriters added to them, and is responsible for deleting them
 /// upon its own destruction.
 ///
+/// The analyses of an event may be run concurrently on several threads
+/// (`SetNThreads()`). The event is shared read-only; each analysis keeps
+/// its own cuts, mixing buffer and correlation functions and processes
+/// the events in the same order as in sequential mode, so the results do
+/// not depend on the number of threads. This requires that no cut or
+/// correlation function object is shared between analyses - if one is,
+/// the manager falls back to the sequential loop. Model correlation
+/// functions of different analyses must not share an
+/// AliFemtoModelManager, which is not checked. The threads are started at
+/// the first concurrent event and kept until the manager is deleted or
+/// the number of threads changes.
+///
+/// The Lednicky weights (AliFemtoModelWeightGeneratorLednicky) are
+/// computed by a fortran module with global state, one pair at a time for
+/// all threads; analyses dominated by these weights do not gain from
+/// threads. AliFemtoModelWeightGeneratorLednickyTable needs the module
+/// only to build its tables.
+///
 /// AliFemtoManager objects are not copyable, as the AliFemtoAnalysis
 /// objects they contain have no means of copying/cloning.
 /// Denying copyability by making the copy constructor and assignment
@@ -49,6 +68,13 @@ private:
   AliFemtoAnalysisCollection* fAnalysisCollection;       ///< Collection of analyzes
   AliFemtoEventReader*        fEventReader;              ///< Event reader
   AliFemtoEventWriterCollection* fEventWriterCollection; ///< Event writer collection
+  int  fNThreads;                                        ///< Threads running the analyses of an event
+  bool fConcurrentChecked;                               ///< Analyses have been checked for shared objects
+  bool fConcurrent;                                      ///< Analyses may run concurrently
+  AliFemtoManagerWorkerPool* fWorkerPool;                //!<! Threads running the analyses concurrently, with the calling one
+
+  bool AnalysesAreIndependent() const;
+  void ProcessAnalysesConcurrently(AliFemtoEvent* aEvent);
 
   AliFemtoManager(const AliFemtoManager& aManager);
   AliFemtoManager& operator=(const AliFemtoManager& aManager);
@@ -70,6 +96,11 @@ public:
   AliFemtoEventReader* EventReader();
   void SetEventReader(AliFemtoEventReader* r);
 
+  /// Number of threads running the analyses of each event; 1 (default)
+  /// runs them one after the other in the calling thread
+  void SetNThreads(int aThreads);
+  int GetNThreads() const;
+
   /// Calls `Init()` on all owned EventWriters
   ///
   /// Returns 0 for success, 1 for failure.
@@ -90,7 +121,7 @@ public:
 };
 
 inline AliFemtoAnalysisCollection* AliFemtoManager::AnalysisCollection(){return fAnalysisCollection;}
-inline void AliFemtoManager::AddAnalysis(AliFemtoAnalysis* anal){fAnalysisCollection->push_back(anal);}
+inline void AliFemtoManager::AddAnalysis(AliFemtoAnalysis* anal){fAnalysisCollection->push_back(anal); fConcurrentChecked = false;}
 
 inline AliFemtoEventWriterCollection* AliFemtoManager::EventWriterCollection(){return fEventWriterCollection;}
 inline void AliFemtoManager::AddEventWriter(AliFemtoEventWriter* writer){fEventWriterCollection->push_back(writer);}
@@ -99,4 +130,6 @@ inline void AliFemtoManager::SetEventWriter(AliFemtoEventWriter* writer){fEventW
 inline AliFemtoEventReader* AliFemtoManager::EventReader(){return fEventReader;}
 inline void AliFemtoManager::SetEventReader(AliFemtoEventReader* reader){fEventReader = reader;}
 
+inline int AliFemtoManager::GetNThreads() const {return fNThreads;}
+
 #endif
@@ -20,6 +20,7 @@
 //#include <stream>
 //#include <iomanip>
 #include <sstream>
+#include <mutex>
 
 #ifdef SOLARIS
 # ifndef false
@@ -277,6 +278,105 @@ double AliFemtoModelWeightGeneratorLednicky::GenerateWeight(AliFemtoPair* aPair)
        &hinfo2 = *static_cast<AliFemtoModelHiddenInfo*>(track2.GetHiddenInfo());
 
 
+  const auto &true_p1 = *hinfo1.GetTrueMomentum(),
+             &true_p2 = *hinfo2.GetTrueMomentum();
+
+  if (!CalcPairKinematics(hinfo1, hinfo2)) {
+    return 0.0;
+  }
+
+  const auto &epoint1 = *hinfo1.GetEmissionPoint(),
+             &epoint2 = *hinfo2.GetEmissionPoint();
+
+  const int pdg1 = hinfo1.GetPDGPid(),
+            pdg2 = hinfo2.GetPDGPid();
+
+  // Check bad PID
+  if (!SetPid(pdg1, pdg2)) {
+    fWeightDen = 1.0;
+    //    cout<<" bad PID weight generator pdg1 "<<hinfo1.GetPDGPid()<<" pdg2 " << hinfo2.GetPDGPid()<<endl;
+    return 1; //non-correlated
+  }
+
+  // cout<<" good PID weight generator pdg1 "<<hinfo1.GetPDGPid()<<" pdg2 "<<hinfo2.GetPDGPid()<<endl;
+
+  if (true_p1 == true_p2) {
+    fWeightDen = 0.;
+    return 0;
+  }
+
+  if (epoint1 == epoint2) {
+    fWeightDen=0.;
+    return 0;
+  }
+
+//    if(pdg1==!211||pdg2!=211)cout << "Weight pdg1 pdg2 = " << pdg1<<" "<<pdg2<< endl;
+//     cout << "LL:in GetWeight = " << mLL << endl;
+
+  double p1[] = {true_p1.x(), true_p1.y(), true_p1.z()},
+         p2[] = {true_p2.x(), true_p2.y(), true_p2.z()};
+
+  double x1[] = {epoint1.x(), epoint1.y(), epoint1.z(), epoint1.t()},
+         x2[] = {epoint2.x(), epoint2.y(), epoint2.z(), epoint2.t()};
+
+  //FsiSetLL();
+  const double weight = fSwap ? FsiWeight(p2, p1, x2, x1, true)
+                              : FsiWeight(p1, p2, x1, x2, true);
+
+  aPair->AddWeightToCache(this, weight);
+  return weight;
+}
+
+// the fortran module keeps its state in common blocks shared by all
+// generators, so analyses running on several threads take turns
+static std::recursive_mutex gFsiMutex;
+
+AliFemtoModelWeightGeneratorLednicky::FsiLock::FsiLock()
+{
+  gFsiMutex.lock();
+}
+
+AliFemtoModelWeightGeneratorLednicky::FsiLock::~FsiLock()
+{
+  gFsiMutex.unlock();
+}
+
+double AliFemtoModelWeightGeneratorLednicky::FsiWeight(double *p1, double *p2,
+                                                       double *x1, double *x2,
+                                                       bool init)
+{
+  // Weight of the pair with momenta p1, p2 and emission points x1, x2,
+  // given in the particle order of the current LL. With init, the
+  // fortran module is re-initialized (FsiInit, FsiNucl) before the
+  // calculation, so other generators may use it in between.
+  FsiLock lock;
+
+  fsimomentum(*p1,*p2);
+  fsiposition(*x1,*x2);
+
+  if (init) {
+    FsiInit();
+    FsiNucl();
+  }
+  ltran12();
+  fsiw(1, fWeif, fWei, fWein);
+
+  //  cout<<" fWeif "<<fWeif<<" fWei "<<fWei<<" fWein "<<fWein<<endl;
+
+  if (fI3c == 0) {
+    return fWein;
+  }
+
+  fWeightDen = fWeif;
+  return fWei;
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::CalcPairKinematics(const AliFemtoModelHiddenInfo &hinfo1,
+                                                              const AliFemtoModelHiddenInfo &hinfo2)
+{
+  // Calculate k* and r* (and their out-side-long components) of the pair
+  // from the true momenta and emission points. Returns false for
+  // degenerate kinematics.
   const auto &true_p1 = *hinfo1.GetTrueMomentum(),
              &true_p2 = *hinfo2.GetTrueMomentum();
 
@@ -306,7 +406,7 @@ double AliFemtoModelWeightGeneratorLednicky::GenerateWeight(AliFemtoPair* aPair)
   if (tMt==0 || tE==0 || tM==0 || tPt==0 ) {
     std::cout << " weight generator zero tPt || tMt || tM || tPt"
               << tM1 << " " << tM2 << "\n";
-    return 0.0;
+    return false;
   }
 
 
@@ -376,65 +476,7 @@ double AliFemtoModelWeightGeneratorLednicky::GenerateWeight(AliFemtoPair* aPair)
 
   //cout << "-- weights generator : Got out side " << fRStarOut << " " << fRStarSide << endl;
 
-  const int pdg1 = hinfo1.GetPDGPid(),
-            pdg2 = hinfo2.GetPDGPid();
-
-  // Check bad PID
-  if (!SetPid(pdg1, pdg2)) {
-    fWeightDen = 1.0;
-    //    cout<<" bad PID weight generator pdg1 "<<hinfo1.GetPDGPid()<<" pdg2 " << hinfo2.GetPDGPid()<<endl;
-    return 1; //non-correlated
-  }
-
-  // cout<<" good PID weight generator pdg1 "<<hinfo1.GetPDGPid()<<" pdg2 "<<hinfo2.GetPDGPid()<<endl;
-
-  if (true_p1 == true_p2) {
-    fWeightDen = 0.;
-    return 0;
-  }
-
-  double p1[] = {true_p1.x(), true_p1.y(), true_p1.z()},
-         p2[] = {true_p2.x(), true_p2.y(), true_p2.z()};
-
-  if (fSwap) {
-    fsimomentum(*p2,*p1);
-  } else {
-    fsimomentum(*p1,*p2);
-  }
-
-  if (epoint1 == epoint2) {
-    fWeightDen=0.;
-    return 0;
-  }
-
-//    if(pdg1==!211||pdg2!=211)cout << "Weight pdg1 pdg2 = " << pdg1<<" "<<pdg2<< endl;
-//     cout << "LL:in GetWeight = " << mLL << endl;
-
-  double x1[] = {epoint1.x(), epoint1.y(), epoint1.z(), epoint1.t()},
-         x2[] = {epoint2.x(), epoint2.y(), epoint2.z(), epoint2.t()};
-
-  if (fSwap) {
-    fsiposition(*x2,*x1);
-  } else {
-    fsiposition(*x1,*x2);
-  }
-
-  //FsiSetLL();
-  FsiInit();
-  ltran12();
-  fsiw(1, fWeif, fWei, fWein);
-
-  //  cout<<" fWeif "<<fWeif<<" fWei "<<fWei<<" fWein "<<fWein<<endl;
-
-  if (fI3c == 0) {
-    aPair->AddWeightToCache(this, fWein);
-    return fWein;
-  }
-
-  fWeightDen = fWeif;
-
-  aPair->AddWeightToCache(this, fWei);
-  return fWei;
+  return true;
 }
 
 
@@ -497,18 +539,7 @@ C-   part. 1: K+
 C-   part. 2: K0b 
 C   NS=1 y/n: -  
    */
-   if (fPairType == fgkPionPlusPionPlus) fLL = 8;
-   if (fPairType == fgkPionPlusPionMinus ) fLL = 6;
-   if (fPairType == fgkKaonPlusKaonPlus ) fLL = 15;
-   if (fPairType == fgkKaonPlusKaonMinus ) fLL = 14;
-   if (fPairType == fgkProtonProton ) fLL = 2;
-   if (fPairType == fgkProtonAntiproton ) fLL = 30;
-   if (fPairType == fgkPionPlusKaonPlus ) fLL = 11;
-   if (fPairType == fgkPionPlusKaonMinus ) fLL = 10;
-   if (fPairType == fgkPionPlusProton ) fLL = 12;
-   if (fPairType == fgkPionPlusAntiproton ) fLL = 13;
-   if (fPairType == fgkKaonPlusProton ) fLL = 16;
-   if (fPairType == fgkKaonPlusAntiproton ) fLL = 17;
+   SetLLFromPairType();
 
    cout<<"fPairType: "<<fPairType<<endl;
    cout <<"mItest dans FsiInit() = " << fItest << endl; //ok
@@ -523,6 +554,24 @@ C   NS=1 y/n: -
   fsiini(fItest,fLL,fNS,fIch,fIqs,fIsi,fI3c);
 }
 
+void AliFemtoModelWeightGeneratorLednicky::SetLLFromPairType()
+{
+  // internal pair type used by the fortran module for the pair types
+  // of AliFemtoModelWeightGenerator
+   if (fPairType == fgkPionPlusPionPlus) fLL = 8;
+   if (fPairType == fgkPionPlusPionMinus ) fLL = 6;
+   if (fPairType == fgkKaonPlusKaonPlus ) fLL = 15;
+   if (fPairType == fgkKaonPlusKaonMinus ) fLL = 14;
+   if (fPairType == fgkProtonProton ) fLL = 2;
+   if (fPairType == fgkProtonAntiproton ) fLL = 30;
+   if (fPairType == fgkPionPlusKaonPlus ) fLL = 11;
+   if (fPairType == fgkPionPlusKaonMinus ) fLL = 10;
+   if (fPairType == fgkPionPlusProton ) fLL = 12;
+   if (fPairType == fgkPionPlusAntiproton ) fLL = 13;
+   if (fPairType == fgkKaonPlusProton ) fLL = 16;
+   if (fPairType == fgkKaonPlusAntiproton ) fLL = 17;
+}
+
 void AliFemtoModelWeightGeneratorLednicky::FsiSetKpKmModelType()
 {
   // initialize K+K- model type
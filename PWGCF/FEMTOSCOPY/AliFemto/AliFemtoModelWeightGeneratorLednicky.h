@@ -12,6 +12,8 @@
 #include <vector>
 #include <string>
 
+class AliFemtoModelHiddenInfo;
+
 
 /// \class AliFemtoModelWeightGeneratorLednicky
 /// \brief The most advanced femto weight generator available
@@ -21,6 +23,13 @@
 /// interation and strong interaction ot any combination of the three,
 /// as applicable.
 ///
+/// The weights come from a fortran module whose state (common blocks) is
+/// global, so FsiWeight holds a process-wide lock (FsiLock): with the
+/// analyses running on several threads (AliFemtoManager::SetNThreads) the
+/// weights of all threads are computed one pair at a time. Use
+/// AliFemtoModelWeightGeneratorLednickyTable for concurrent analyses, which
+/// only takes the lock to build its tables.
+///
 class AliFemtoModelWeightGeneratorLednicky : public AliFemtoModelWeightGenerator {
 public:
   /// Constructor
@@ -123,6 +132,26 @@ protected:
   void FsiSetLL();
   void FsiNucl();
   bool SetPid(const int aPid1,const int aPid2);
+  void SetLLFromPairType();
+
+  /// Fill fKStar*, fRStar* from the true momenta and emission points
+  bool CalcPairKinematics(const AliFemtoModelHiddenInfo &hinfo1, const AliFemtoModelHiddenInfo &hinfo2);
+
+  /// Weight from the fortran module, particles in the order of the current LL
+  double FsiWeight(double *p1, double *p2, double *x1, double *x2, bool init);
+
+  /// Scoped lock on the fortran module, whose state is global. Held by
+  /// FsiWeight; take it around sequences of calls which rely on the
+  /// module state set by a previous one (e.g. FsiInit then FsiWeight
+  /// without init). May be nested.
+  class FsiLock {
+  public:
+    FsiLock();
+    ~FsiLock();
+  private:
+    FsiLock(const FsiLock&);
+    FsiLock& operator=(const FsiLock&);
+  };
 
 #ifdef __ROOT__
   ClassDef(AliFemtoModelWeightGeneratorLednicky, 2);
@@ -0,0 +1,444 @@
+///
+/// \file AliFemtoModelWeightGeneratorLednickyTable.cxx
+///
+
+#include "AliFemtoModelWeightGeneratorLednickyTable.h"
+#include "AliFemtoModelHiddenInfo.h"
+#include "AliFemtoPair.h"
+
+#include <TFile.h>
+#include <TNamed.h>
+#include <TVectorF.h>
+#include <TRandom2.h>
+#include <TSystem.h>
+
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+
+using std::cout;
+using std::endl;
+using std::ostringstream;
+
+#ifdef __ROOT__
+  /// \cond CLASSIMP
+  ClassImp(AliFemtoModelWeightGeneratorLednickyTable);
+  /// \endcond
+#endif
+
+AliFemtoModelWeightGeneratorLednickyTable::AliFemtoModelWeightGeneratorLednickyTable()
+  : AliFemtoModelWeightGeneratorLednicky()
+  , fNKStar(100)
+  , fKStarMax(0.3)
+  , fNRStar(150)
+  , fRStarMax(30.0)
+  , fNCosTheta(41)
+  , fCacheDir(".")
+  , fTolerance(0.01)
+  , fNValidationPoints(2000)
+  , fMaxTableError(0.0)
+  , fMeanTableError(0.0)
+  , fNTablePairs(0)
+  , fNExactPairs(0)
+  , fTables()
+{
+  // default constructor
+}
+//______________________
+AliFemtoModelWeightGeneratorLednickyTable
+  ::AliFemtoModelWeightGeneratorLednickyTable(const AliFemtoModelWeightGeneratorLednickyTable &aWeight)
+  : AliFemtoModelWeightGeneratorLednicky(aWeight)
+  , fNKStar(aWeight.fNKStar)
+  , fKStarMax(aWeight.fKStarMax)
+  , fNRStar(aWeight.fNRStar)
+  , fRStarMax(aWeight.fRStarMax)
+  , fNCosTheta(aWeight.fNCosTheta)
+  , fCacheDir(aWeight.fCacheDir)
+  , fTolerance(aWeight.fTolerance)
+  , fNValidationPoints(aWeight.fNValidationPoints)
+  , fMaxTableError(aWeight.fMaxTableError)
+  , fMeanTableError(aWeight.fMeanTableError)
+  , fNTablePairs(0)
+  , fNExactPairs(0)
+  , fTables(aWeight.fTables)
+{
+  // copy constructor
+}
+//______________________
+AliFemtoModelWeightGeneratorLednickyTable&
+AliFemtoModelWeightGeneratorLednickyTable::operator=(const AliFemtoModelWeightGeneratorLednickyTable &aWeight)
+{
+  // assignment operator
+  if (this == &aWeight) {
+    return *this;
+  }
+
+  AliFemtoModelWeightGeneratorLednicky::operator=(aWeight);
+
+  fNKStar = aWeight.fNKStar;
+  fKStarMax = aWeight.fKStarMax;
+  fNRStar = aWeight.fNRStar;
+  fRStarMax = aWeight.fRStarMax;
+  fNCosTheta = aWeight.fNCosTheta;
+  fCacheDir = aWeight.fCacheDir;
+  fTolerance = aWeight.fTolerance;
+  fNValidationPoints = aWeight.fNValidationPoints;
+  fMaxTableError = aWeight.fMaxTableError;
+  fMeanTableError = aWeight.fMeanTableError;
+  fNTablePairs = 0;
+  fNExactPairs = 0;
+  fTables = aWeight.fTables;
+
+  return *this;
+}
+//______________________
+AliFemtoModelWeightGeneratorLednickyTable::~AliFemtoModelWeightGeneratorLednickyTable()
+{
+  // destructor
+}
+//______________________
+Double_t AliFemtoModelWeightGeneratorLednickyTable::GenerateWeight(AliFemtoPair *aPair)
+{
+  // weight interpolated from the table of the pair type, or the exact
+  // weight outside the table range
+  if (fI3c) {
+    fNExactPairs++;
+    return AliFemtoModelWeightGeneratorLednicky::GenerateWeight(aPair);
+  }
+
+  {
+    double cached_weight = aPair->LookupFemtoWeightCache(this);
+    if (!std::isnan(cached_weight)) {
+      return cached_weight;
+    }
+  }
+
+  const AliFemtoTrack &track1 = *aPair->Track1()->Track(),
+                      &track2 = *aPair->Track2()->Track();
+
+  auto &hinfo1 = *static_cast<AliFemtoModelHiddenInfo*>(track1.GetHiddenInfo()),
+       &hinfo2 = *static_cast<AliFemtoModelHiddenInfo*>(track2.GetHiddenInfo());
+
+  const auto &true_p1 = *hinfo1.GetTrueMomentum(),
+             &true_p2 = *hinfo2.GetTrueMomentum();
+
+  if (!CalcPairKinematics(hinfo1, hinfo2)) {
+    return 0.0;
+  }
+
+  const auto &epoint1 = *hinfo1.GetEmissionPoint(),
+             &epoint2 = *hinfo2.GetEmissionPoint();
+
+  if (!SetPid(hinfo1.GetPDGPid(), hinfo2.GetPDGPid())) {
+    fWeightDen = 1.0;
+    return 1; //non-correlated
+  }
+
+  if (true_p1 == true_p2 || epoint1 == epoint2) {
+    fWeightDen = 0.;
+    return 0;
+  }
+
+  double weight;
+
+  if (fKStar < fKStarMax && fRStar < fRStarMax) {
+    // same LL as FsiInit would set in the exact calculation
+    SetLLFromPairType();
+    // the angle is undefined at k* = 0 or r* = 0, where the weight does not depend on it
+    const double kr = fKStar*fRStar;
+    double cosTheta = kr > 0.0 ? (fKStarOut*fRStarOut + fKStarSide*fRStarSide + fKStarLong*fRStarLong) / kr
+                               : 0.0;
+    cosTheta = std::min(std::max(cosTheta, -1.0), 1.0);
+    weight = Interpolate(GetTable(), fKStar, fRStar, cosTheta);
+    fNTablePairs++;
+  } else {
+    double p1[] = {true_p1.x(), true_p1.y(), true_p1.z()},
+           p2[] = {true_p2.x(), true_p2.y(), true_p2.z()};
+
+    double x1[] = {epoint1.x(), epoint1.y(), epoint1.z(), epoint1.t()},
+           x2[] = {epoint2.x(), epoint2.y(), epoint2.z(), epoint2.t()};
+
+    weight = fSwap ? FsiWeight(p2, p1, x2, x1, true)
+                   : FsiWeight(p1, p2, x1, x2, true);
+    fNExactPairs++;
+  }
+
+  aPair->AddWeightToCache(this, weight);
+  return weight;
+}
+//______________________
+Long64_t AliFemtoModelWeightGeneratorLednickyTable::TableKey() const
+{
+  return Long64_t(fLL)
+       | Long64_t(fIch != 0) << 8
+       | Long64_t(fIqs != 0) << 9
+       | Long64_t(fIsi != 0) << 10
+       | Long64_t(fSphereApp) << 11
+       | Long64_t(fT0App) << 12
+       | Long64_t(fPhi_OffOn & 0xf) << 13
+       | Long64_t(fNS & 0xff) << 17
+       | Long64_t(fKpKmModel & 0xffff) << 25;
+}
+//______________________
+TString AliFemtoModelWeightGeneratorLednickyTable::TableSettings() const
+{
+  return TString::Format("LL%d_ich%d_iqs%d_isi%d_ns%d_sph%d_t0%d_kpkm%d-%d_k%d-%g_r%d-%g_c%d",
+                         fLL, fIch, fIqs, fIsi, fNS, fSphereApp, fT0App, fKpKmModel, fPhi_OffOn,
+                         fNKStar, fKStarMax, fNRStar, fRStarMax, fNCosTheta);
+}
+//______________________
+const std::vector<Float_t>& AliFemtoModelWeightGeneratorLednickyTable::GetTable()
+{
+  // table of the current LL and settings, read from the cache or built
+  // on first use
+  const Long64_t key = TableKey();
+  auto it = fTables.find(key);
+  if (it != fTables.end()) {
+    return it->second;
+  }
+
+  std::vector<Float_t> &table = fTables[key];
+  const TString settings = TableSettings();
+  const TString fileName = fCacheDir.IsNull() ? TString()
+                         : TString::Format("%s/LednickyFsiTable_%s.root", fCacheDir.Data(), settings.Data());
+
+  // the fortran module must be set up for this LL for the exact weights,
+  // and stay so until the table is built and validated
+  FsiLock lock;
+  FsiInit();
+  FsiNucl();
+
+  if (fileName.IsNull() || !ReadTable(fileName, settings, table)) {
+    cout << "AliFemtoModelWeightGeneratorLednickyTable: building table " << settings << endl;
+    BuildTable(table);
+    if (!fileName.IsNull()) {
+      WriteTable(fileName, settings, table);
+    }
+  }
+
+  ValidateTable(table);
+  return table;
+}
+//______________________
+Double_t AliFemtoModelWeightGeneratorLednickyTable::TableNodeWeight(Double_t aKStar,
+                                                                    Double_t aRStar,
+                                                                    Double_t aCosTheta)
+{
+  // Pair at rest with k* along z and r* in the xz plane, so that the
+  // lab frame is the pair rest frame and t* = 0
+  const double sinTheta = ::sqrt(std::max(0.0, 1.0 - aCosTheta*aCosTheta));
+
+  double p1[] = {0.0, 0.0, aKStar},
+         p2[] = {0.0, 0.0, -aKStar};
+
+  double x1[] = {aRStar*sinTheta, 0.0, aRStar*aCosTheta, 0.0},
+         x2[] = {0.0, 0.0, 0.0, 0.0};
+
+  return FsiWeight(p1, p2, x1, x2, false);
+}
+//______________________
+void AliFemtoModelWeightGeneratorLednickyTable::BuildTable(std::vector<Float_t> &table)
+{
+  // Nodes are at the bin centers in k* and r* (both weights are singular
+  // or undefined at 0) and from -1 to 1 in cos(theta*)
+  const double dk = fKStarMax / fNKStar,
+               dr = fRStarMax / fNRStar,
+               dc = 2.0 / (fNCosTheta - 1);
+
+  table.resize(fNKStar * fNRStar * fNCosTheta);
+
+  size_t index = 0;
+  for (Int_t ik = 0; ik < fNKStar; ik++) {
+    const double kstar = (ik + 0.5) * dk;
+    for (Int_t ir = 0; ir < fNRStar; ir++) {
+      const double rstar = (ir + 0.5) * dr;
+      for (Int_t ic = 0; ic < fNCosTheta; ic++) {
+        table[index++] = TableNodeWeight(kstar, rstar, -1.0 + ic * dc);
+      }
+    }
+  }
+}
+//______________________
+Double_t AliFemtoModelWeightGeneratorLednickyTable::Interpolate(const std::vector<Float_t> &table,
+                                                                Double_t aKStar,
+                                                                Double_t aRStar,
+                                                                Double_t aCosTheta) const
+{
+  // trilinear interpolation; below the first k* and r* nodes the value
+  // of the first node is used
+  const double fk = std::min(std::max(aKStar * fNKStar / fKStarMax - 0.5, 0.0), fNKStar - 1.0),
+               fr = std::min(std::max(aRStar * fNRStar / fRStarMax - 0.5, 0.0), fNRStar - 1.0),
+               fc = std::min(std::max((aCosTheta + 1.0) * 0.5 * (fNCosTheta - 1), 0.0), fNCosTheta - 1.0);
+
+  const Int_t ik = std::min(Int_t(fk), fNKStar - 2),
+              ir = std::min(Int_t(fr), fNRStar - 2),
+              ic = std::min(Int_t(fc), fNCosTheta - 2);
+
+  const double tk = fk - ik,
+               tr = fr - ir,
+               tc = fc - ic;
+
+  const Int_t strideK = fNRStar * fNCosTheta,
+              strideR = fNCosTheta;
+
+  const Float_t *w = &table[ik * strideK + ir * strideR + ic];
+
+  const double w00 = w[0]                 * (1 - tc) + w[1]                     * tc,
+               w01 = w[strideR]           * (1 - tc) + w[strideR + 1]           * tc,
+               w10 = w[strideK]           * (1 - tc) + w[strideK + 1]           * tc,
+               w11 = w[strideK + strideR] * (1 - tc) + w[strideK + strideR + 1] * tc;
+
+  const double w0 = w00 * (1 - tr) + w01 * tr,
+               w1 = w10 * (1 - tr) + w11 * tr;
+
+  return w0 * (1 - tk) + w1 * tk;
+}
+//______________________
+void AliFemtoModelWeightGeneratorLednickyTable::ValidateTable(const std::vector<Float_t> &table)
+{
+  // compare the interpolation to the exact weight at random points
+  if (fNValidationPoints <= 0) {
+    return;
+  }
+
+  TRandom2 random(12345);
+
+  double maxError = 0.0,
+         sumError = 0.0;
+
+  for (Int_t i = 0; i < fNValidationPoints; i++) {
+    const double kstar = random.Uniform(0.5 * fKStarMax / fNKStar, fKStarMax),
+                 rstar = random.Uniform(0.5 * fRStarMax / fNRStar, fRStarMax),
+                 cosTheta = random.Uniform(-1.0, 1.0);
+
+    const double error = fabs(Interpolate(table, kstar, rstar, cosTheta)
+                              - TableNodeWeight(kstar, rstar, cosTheta));
+    maxError = std::max(maxError, error);
+    sumError += error;
+  }
+
+  fMaxTableError = maxError;
+  fMeanTableError = sumError / fNValidationPoints;
+
+  cout << "AliFemtoModelWeightGeneratorLednickyTable: table " << TableSettings()
+       << " - interpolation error max " << fMaxTableError
+       << " mean " << fMeanTableError << endl;
+
+  if (fMaxTableError > fTolerance) {
+    cout << "WARNING [AliFemtoModelWeightGeneratorLednickyTable] interpolation error "
+         << fMaxTableError << " above tolerance " << fTolerance
+         << " - consider a finer grid" << endl;
+  }
+}
+//______________________
+Bool_t AliFemtoModelWeightGeneratorLednickyTable::ReadTable(const TString &fileName,
+                                                            const TString &settings,
+                                                            std::vector<Float_t> &table)
+{
+  if (gSystem->AccessPathName(fileName)) {
+    return kFALSE;
+  }
+
+  TFile *file = TFile::Open(fileName, "READ");
+  if (!file || file->IsZombie()) {
+    delete file;
+    return kFALSE;
+  }
+
+  Bool_t ok = kFALSE;
+  TNamed *stored = dynamic_cast<TNamed*>(file->Get("settings"));
+  TVectorF *values = dynamic_cast<TVectorF*>(file->Get("table"));
+  if (stored && values && settings == stored->GetTitle()
+      && values->GetNrows() == fNKStar * fNRStar * fNCosTheta) {
+    table.assign(values->GetMatrixArray(), values->GetMatrixArray() + values->GetNrows());
+    cout << "AliFemtoModelWeightGeneratorLednickyTable: table read from " << fileName << endl;
+    ok = kTRUE;
+  }
+
+  delete stored;
+  delete values;
+  delete file;
+  return ok;
+}
+//______________________
+void AliFemtoModelWeightGeneratorLednickyTable::WriteTable(const TString &fileName,
+                                                           const TString &settings,
+                                                           const std::vector<Float_t> &table)
+{
+  TDirectory *savedDir = gDirectory;
+
+  TFile *file = TFile::Open(fileName, "RECREATE");
+  if (!file || file->IsZombie()) {
+    cout << "WARNING [AliFemtoModelWeightGeneratorLednickyTable] cannot write " << fileName << endl;
+    delete file;
+    if (savedDir) {
+      savedDir->cd();
+    }
+    return;
+  }
+
+  TVectorF values(table.size(), table.data());
+  TNamed stored("settings", settings.Data());
+  values.Write("table");
+  stored.Write();
+  file->Close();
+  delete file;
+
+  if (savedDir) {
+    savedDir->cd();
+  }
+}
+//______________________
+void AliFemtoModelWeightGeneratorLednickyTable::SetKStarTable(Int_t aNodes, Double_t aKStarMax)
+{
+  fNKStar = std::max(aNodes, 2);
+  fKStarMax = aKStarMax;
+  ClearTables();
+}
+
+void AliFemtoModelWeightGeneratorLednickyTable::SetRStarTable(Int_t aNodes, Double_t aRStarMax)
+{
+  fNRStar = std::max(aNodes, 2);
+  fRStarMax = aRStarMax;
+  ClearTables();
+}
+
+void AliFemtoModelWeightGeneratorLednickyTable::SetCosThetaTable(Int_t aNodes)
+{
+  fNCosTheta = std::max(aNodes, 2);
+  ClearTables();
+}
+
+void AliFemtoModelWeightGeneratorLednickyTable::SetTableCacheDir(const char *aDir)
+  { fCacheDir = aDir; }
+void AliFemtoModelWeightGeneratorLednickyTable::SetTableTolerance(Double_t aTolerance)
+  { fTolerance = aTolerance; }
+void AliFemtoModelWeightGeneratorLednickyTable::SetNValidationPoints(Int_t aPoints)
+  { fNValidationPoints = aPoints; }
+
+void AliFemtoModelWeightGeneratorLednickyTable::ClearTables()
+{
+  fTables.clear();
+}
+//______________________
+AliFemtoString AliFemtoModelWeightGeneratorLednickyTable::Report()
+{
+  // create report
+  ostringstream tStr;
+  tStr << AliFemtoModelWeightGeneratorLednicky::Report();
+  tStr << "    Tabulated weights: k* " << fNKStar << " nodes up to " << fKStarMax
+       << " GeV/c, r* " << fNRStar << " nodes up to " << fRStarMax
+       << " fm, cos(theta*) " << fNCosTheta << " nodes" << endl;
+  tStr << "    " << fNTablePairs << " pairs interpolated, " << fNExactPairs << " exact" << endl;
+  tStr << "    Interpolation error (last table): max " << fMaxTableError
+       << " mean " << fMeanTableError << endl;
+  AliFemtoString returnThis = tStr.str();
+  return returnThis;
+}
+//______________________
+AliFemtoModelWeightGenerator*
+AliFemtoModelWeightGeneratorLednickyTable::Clone() const
+{
+  AliFemtoModelWeightGenerator* tmp = new AliFemtoModelWeightGeneratorLednickyTable(*this);
+  return tmp;
+}
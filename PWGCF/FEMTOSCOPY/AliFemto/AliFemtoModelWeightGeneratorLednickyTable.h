@@ -0,0 +1,109 @@
+///
+/// \file AliFemtoModelWeightGeneratorLednickyTable.h
+///
+
+#ifndef ALIFEMTOMODELWEIGHTGENERATORLEDNICKYTABLE_H
+#define ALIFEMTOMODELWEIGHTGENERATORLEDNICKYTABLE_H
+
+#include "AliFemtoModelWeightGeneratorLednicky.h"
+
+#include <TString.h>
+
+#include <map>
+#include <vector>
+
+
+/// \class AliFemtoModelWeightGeneratorLednickyTable
+/// \brief Lednicky weight generator interpolating a precomputed table
+///
+/// Drop-in replacement for AliFemtoModelWeightGeneratorLednicky. For each
+/// pair type (LL of the fortran module) the weight is tabulated once on a
+/// regular grid in k*, r* and cos(theta*), the angle between k* and r* in
+/// the pair rest frame, and GenerateWeight interpolates the table
+/// trilinearly instead of calling the fortran routine.
+///
+/// The table is computed with t* = 0, so the dependence of the weight on
+/// the emission time difference is neglected. Pairs outside the table
+/// range, and all pairs when the 3-body interaction is switched on, get
+/// the exact weight.
+///
+/// After a table is built (or read back), the interpolation is compared
+/// to the exact routine at random points inside the range; the maximum
+/// and mean absolute deviations are printed and given in Report(), and a
+/// warning is printed if the maximum exceeds the tolerance. Refine the
+/// grid (SetKStarTable, SetRStarTable, SetCosThetaTable) if needed.
+///
+/// A separate table is kept for each combination of LL and interaction
+/// settings, so the settings may be changed at any time.
+/// Tables are cached as ROOT files in the cache directory ("." by
+/// default, "" disables the cache), one file per pair type and settings.
+///
+class AliFemtoModelWeightGeneratorLednickyTable : public AliFemtoModelWeightGeneratorLednicky {
+public:
+  AliFemtoModelWeightGeneratorLednickyTable();
+  AliFemtoModelWeightGeneratorLednickyTable(const AliFemtoModelWeightGeneratorLednickyTable &aWeight);
+  AliFemtoModelWeightGeneratorLednickyTable& operator=(const AliFemtoModelWeightGeneratorLednickyTable &aWeight);
+  virtual ~AliFemtoModelWeightGeneratorLednickyTable();
+
+  virtual Double_t GenerateWeight(AliFemtoPair *aPair);
+
+  virtual AliFemtoModelWeightGenerator* Clone() const;
+
+  /// Table grid: number of nodes and upper edge of the range (the k* and r*
+  /// nodes are at the bin centers from 0, cos(theta*) nodes span -1 to 1)
+  void SetKStarTable(Int_t aNodes, Double_t aKStarMax);   ///< k* in GeV/c
+  void SetRStarTable(Int_t aNodes, Double_t aRStarMax);   ///< r* in fm
+  void SetCosThetaTable(Int_t aNodes);
+
+  void SetTableCacheDir(const char *aDir);
+  void SetTableTolerance(Double_t aTolerance);           ///< max. allowed |interpolated - exact| weight
+  void SetNValidationPoints(Int_t aPoints);
+
+  Double_t GetMaxTableError() const;
+  Double_t GetMeanTableError() const;
+
+  /// Drop the tables in memory
+  void ClearTables();
+
+  virtual AliFemtoString Report();
+
+protected:
+  Int_t    fNKStar;            ///< number of k* nodes
+  Double_t fKStarMax;          ///< upper edge of the k* range
+  Int_t    fNRStar;            ///< number of r* nodes
+  Double_t fRStarMax;          ///< upper edge of the r* range
+  Int_t    fNCosTheta;         ///< number of cos(theta*) nodes, from -1 to 1
+
+  TString  fCacheDir;          ///< directory of the cached tables, empty for no cache
+  Double_t fTolerance;         ///< tolerance on the interpolation error
+  Int_t    fNValidationPoints; ///< number of points compared to the exact weight
+
+  Double_t fMaxTableError;     ///< max. interpolation error found in the validation
+  Double_t fMeanTableError;    ///< mean interpolation error found in the validation
+
+  Long64_t fNTablePairs;       ///< pairs with interpolated weight
+  Long64_t fNExactPairs;       ///< pairs with exact weight
+
+  std::map<Long64_t, std::vector<Float_t> > fTables; //! weight tables, by TableKey
+
+  Long64_t TableKey() const;   ///< LL and interaction settings of the current calculation
+  const std::vector<Float_t>& GetTable();
+  void     BuildTable(std::vector<Float_t> &table);
+  Bool_t   ReadTable(const TString &fileName, const TString &settings, std::vector<Float_t> &table);
+  void     WriteTable(const TString &fileName, const TString &settings, const std::vector<Float_t> &table);
+  void     ValidateTable(const std::vector<Float_t> &table);
+  TString  TableSettings() const;
+
+  /// exact weight at t* = 0 for the current LL
+  Double_t TableNodeWeight(Double_t aKStar, Double_t aRStar, Double_t aCosTheta);
+  Double_t Interpolate(const std::vector<Float_t> &table, Double_t aKStar, Double_t aRStar, Double_t aCosTheta) const;
+
+#ifdef __ROOT__
+  ClassDef(AliFemtoModelWeightGeneratorLednickyTable, 1);
+#endif
+};
+
+inline Double_t AliFemtoModelWeightGeneratorLednickyTable::GetMaxTableError() const { return fMaxTableError; }
+inline Double_t AliFemtoModelWeightGeneratorLednickyTable::GetMeanTableError() const { return fMeanTableError; }
+
+#endif
@@ -0,0 +1,167 @@
+///
+/// \file AliFemtoPairBlock.cxx
+///
+
+#include "AliFemtoPairBlock.h"
+#include "AliFemtoParticle.h"
+#include "AliFemtoTrack.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include <TMath.h>
+#include <TVector2.h>
+
+
+AliFemtoPackedParticles::AliFemtoPackedParticles():
+  fPx(),
+  fPy(),
+  fPz(),
+  fE(),
+  fMass2(),
+  fPt(),
+  fEta(),
+  fPhi(),
+  fCharge(),
+  fParticle()
+{
+  /* no-op */
+}
+
+void AliFemtoPackedParticles::Pack(const AliFemtoParticleCollection &collection)
+{
+  const size_t n = collection.size();
+
+  fPx.resize(n);
+  fPy.resize(n);
+  fPz.resize(n);
+  fE.resize(n);
+  fMass2.resize(n);
+  fPt.resize(n);
+  fEta.resize(n);
+  fPhi.resize(n);
+  fCharge.resize(n);
+  fParticle.resize(n);
+
+  size_t i = 0;
+  for (AliFemtoParticleConstIterator it = collection.begin(); it != collection.end(); ++it, ++i) {
+    AliFemtoParticle *particle = *it;
+    const AliFemtoLorentzVector &p = particle->FourMomentum();
+
+    fPx[i] = p.x();
+    fPy[i] = p.y();
+    fPz[i] = p.z();
+    fE[i] = p.e();
+    fMass2[i] = std::max(0.0, p.m2());
+    fPt[i] = p.Perp();
+    fEta[i] = p.PseudoRapidity();
+    fPhi[i] = p.Phi();
+    fCharge[i] = particle->Track() ? particle->Track()->Charge() : 0;
+    fParticle[i] = particle;
+  }
+}
+
+//_________________________
+AliFemtoPairBlock::AliFemtoPairBlock():
+  fFirst(nullptr),
+  fSecond(nullptr),
+  fSize(0)
+{
+  /* no-op */
+}
+
+void AliFemtoPairBlock::SetParticles(const AliFemtoPackedParticles *first,
+                                     const AliFemtoPackedParticles *second)
+{
+  fFirst = first;
+  fSecond = second;
+  fSize = 0;
+}
+
+unsigned int AliFemtoPairBlock::NPassed() const
+{
+  return std::count(fPass, fPass + fSize, true);
+}
+
+void AliFemtoPairBlock::Compute()
+{
+  // Same arithmetic as AliFemtoPair::QInv, KT and CalcNonIdPar, with
+  // the particle kinematics gathered from the packed arrays first, so
+  // the loop below only touches contiguous arrays and has no calls.
+
+  const double *px1 = fFirst->fPx.data(),  *px2 = fSecond->fPx.data(),
+               *py1 = fFirst->fPy.data(),  *py2 = fSecond->fPy.data(),
+               *pz1 = fFirst->fPz.data(),  *pz2 = fSecond->fPz.data(),
+               *pE1 = fFirst->fE.data(),   *pE2 = fSecond->fE.data(),
+               *m21 = fFirst->fMass2.data(), *m22 = fSecond->fMass2.data(),
+               *eta1 = fFirst->fEta.data(), *eta2 = fSecond->fEta.data(),
+               *phi1 = fFirst->fPhi.data(), *phi2 = fSecond->fPhi.data();
+
+  for (unsigned int i = 0; i < fSize; ++i) {
+    const unsigned int j1 = fIndex1[i],
+                       j2 = fIndex2[i];
+
+    const double
+      tPx = px1[j1] + px2[j2],
+      tPy = py1[j1] + py2[j2],
+      tPz = pz1[j1] + pz2[j2],
+      tPE = pE1[j1] + pE2[j2],
+
+      dPx = px1[j1] - px2[j2],
+      dPy = py1[j1] - py2[j2],
+      dPz = pz1[j1] - pz2[j2],
+      dPE = pE1[j1] - pE2[j2];
+
+    // QInv: -m() of the four-momentum difference
+    const double tQinvL = dPE*dPE - dPx*dPx - dPy*dPy - dPz*dPz;
+    fQInv[i] = tQinvL < 0 ? ::sqrt(-tQinvL) : -::sqrt(tQinvL);
+
+    double tPtrans = tPx*tPx + tPy*tPy;
+    double tMtrans = tPE*tPE - tPz*tPz;
+    const double tPinv = ::sqrt(tMtrans - tPtrans);
+    tMtrans = ::sqrt(tMtrans);
+    tPtrans = ::sqrt(tPtrans);
+
+    fKT[i] = 0.5 * tPtrans;
+
+    double tQ = (m21[j1] - m22[j2])/tPinv;
+    tQ = ::sqrt(tQ*tQ - tQinvL);
+    fKStar[i] = tQ/2;
+
+    // LCMS
+    double beta = tPz/tPE;
+    double gamma = tPE/tMtrans;
+    fKStarLong[i] = gamma * (pz1[j1] - beta * pE1[j1]);
+    const double pE1L = gamma * (pE1[j1] - beta * pz1[j1]);
+
+    // rotation px -> tPt
+    const double px1R = (px1[j1]*tPx + py1[j1]*tPy)/tPtrans;
+    fKStarSide[i] = (-px1[j1]*tPy + py1[j1]*tPx)/tPtrans;
+
+    // LCMS -> PRF
+    beta = tPtrans/tMtrans;
+    gamma = tMtrans/tPinv;
+    fKStarOut[i] = gamma * (px1R - beta * pE1L);
+
+    fDEta[i] = eta2[j2] - eta1[j1];
+    double dphi = phi2[j2] - phi1[j1];
+    if (dphi >= M_PI) {
+      dphi -= 2 * M_PI;
+    } else if (dphi < -M_PI) {
+      dphi += 2 * M_PI;
+    }
+    fDPhi[i] = dphi;
+  }
+}
+
+double AliFemtoPairBlock::DPhiStar(unsigned int i, double radius, double magField) const
+{
+  const unsigned int j1 = fIndex1[i],
+                     j2 = fIndex2[i];
+
+  const double dps = fSecond->fPhi[j2] - fFirst->fPhi[j1]
+                   + TMath::ASin(-0.15 * magField * fSecond->fCharge[j2] * radius / fSecond->fPt[j2])
+                   - TMath::ASin(-0.15 * magField * fFirst->fCharge[j1] * radius / fFirst->fPt[j1]);
+
+  return TVector2::Phi_mpi_pi(dps);
+}
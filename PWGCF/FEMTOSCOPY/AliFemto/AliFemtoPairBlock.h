@@ -0,0 +1,133 @@
+///
+/// \file AliFemtoPairBlock.h
+///
+
+#ifndef ALIFEMTOPAIRBLOCK_H
+#define ALIFEMTOPAIRBLOCK_H
+
+#include <vector>
+
+#include "AliFemtoParticleCollection.h"
+
+class AliFemtoParticle;
+
+
+/// \class AliFemtoPackedParticles
+/// \brief Kinematics of a particle collection packed into contiguous arrays
+///
+/// Filled once per collection by AliFemtoSimpleAnalysis when making pairs
+/// in block mode, so the pair loop reads plain arrays instead of following
+/// the particle pointers.
+///
+class AliFemtoPackedParticles {
+public:
+  AliFemtoPackedParticles();
+
+  /// Copy the four-momenta (and eta, phi, pT, charge) of all particles
+  void Pack(const AliFemtoParticleCollection &collection);
+
+  unsigned int Size() const { return fParticle.size(); }
+
+  std::vector<double> fPx;
+  std::vector<double> fPy;
+  std::vector<double> fPz;
+  std::vector<double> fE;
+  std::vector<double> fMass2;    ///< max(0, m^2), as in AliFemtoPair::CalcNonIdPar
+  std::vector<double> fPt;
+  std::vector<double> fEta;
+  std::vector<double> fPhi;
+  std::vector<int>    fCharge;   ///< charge of the track, 0 for particles without track
+  std::vector<AliFemtoParticle*> fParticle;
+};
+
+
+/// \class AliFemtoPairBlock
+/// \brief A block of pairs with their kinematics stored as arrays
+///
+/// The block holds the indices of up to kMaxPairs pairs into two
+/// AliFemtoPackedParticles and, after Compute(), the pair quantities
+/// for all of them, computed in one loop with the same formulas as
+/// AliFemtoPair (QInv, KT, CalcNonIdPar). Pair cuts and correlation
+/// functions which support the block interface
+/// (AliFemtoPairCut::PassBlock, AliFemtoCorrFctn::AddRealPairs and
+/// AddMixedPairs) read these arrays directly.
+///
+/// The pass flag of each pair is set by the pair cut of the analysis;
+/// block-aware correlation functions must only use the pairs with
+/// Pass(i) true.
+///
+class AliFemtoPairBlock {
+public:
+  enum { kMaxPairs = 512 };
+
+  AliFemtoPairBlock();
+
+  void SetParticles(const AliFemtoPackedParticles *first, const AliFemtoPackedParticles *second);
+
+  void Clear() { fSize = 0; }
+  bool Full() const { return fSize == kMaxPairs; }
+  unsigned int Size() const { return fSize; }
+
+  /// Add a pair, i1 indexing the first and i2 the second packed particles
+  void AddPair(unsigned int i1, unsigned int i2)
+    { fIndex1[fSize] = i1; fIndex2[fSize] = i2; fPass[fSize] = true; fSize++; }
+
+  /// Compute the pair quantities of all pairs in the block
+  void Compute();
+
+  AliFemtoParticle* Particle1(unsigned int i) const { return fFirst->fParticle[fIndex1[i]]; }
+  AliFemtoParticle* Particle2(unsigned int i) const { return fSecond->fParticle[fIndex2[i]]; }
+  unsigned int Index1(unsigned int i) const { return fIndex1[i]; }
+  unsigned int Index2(unsigned int i) const { return fIndex2[i]; }
+  const AliFemtoPackedParticles& First() const { return *fFirst; }
+  const AliFemtoPackedParticles& Second() const { return *fSecond; }
+
+  bool Pass(unsigned int i) const { return fPass[i]; }
+  void SetPass(unsigned int i, bool pass) { fPass[i] = pass; }
+  unsigned int NPassed() const;
+
+  double QInv(unsigned int i)      const { return fQInv[i]; }      ///< same sign convention as AliFemtoPair::QInv
+  double KT(unsigned int i)        const { return fKT[i]; }
+  double KStar(unsigned int i)     const { return fKStar[i]; }
+  double KStarOut(unsigned int i)  const { return fKStarOut[i]; }
+  double KStarSide(unsigned int i) const { return fKStarSide[i]; }
+  double KStarLong(unsigned int i) const { return fKStarLong[i]; }
+  double DEta(unsigned int i)      const { return fDEta[i]; }      ///< eta2 - eta1
+  double DPhi(unsigned int i)      const { return fDPhi[i]; }      ///< phi2 - phi1, in [-pi, pi)
+
+  /// Δϕ* of pair i at the given radius (m) and magnetic field (T),
+  /// using the convention of AliFemtoPairCutRadialDistance
+  double DPhiStar(unsigned int i, double radius, double magField) const;
+
+  const double* QInvArray()      const { return fQInv; }
+  const double* KTArray()        const { return fKT; }
+  const double* KStarArray()     const { return fKStar; }
+  const double* KStarOutArray()  const { return fKStarOut; }
+  const double* KStarSideArray() const { return fKStarSide; }
+  const double* KStarLongArray() const { return fKStarLong; }
+  const double* DEtaArray()      const { return fDEta; }
+  const double* DPhiArray()      const { return fDPhi; }
+
+private:
+  const AliFemtoPackedParticles *fFirst;
+  const AliFemtoPackedParticles *fSecond;
+
+  unsigned int fSize;
+  unsigned int fIndex1[kMaxPairs];
+  unsigned int fIndex2[kMaxPairs];
+  bool fPass[kMaxPairs];
+
+  double fQInv[kMaxPairs];
+  double fKT[kMaxPairs];
+  double fKStar[kMaxPairs];
+  double fKStarOut[kMaxPairs];
+  double fKStarSide[kMaxPairs];
+  double fKStarLong[kMaxPairs];
+  double fDEta[kMaxPairs];
+  double fDPhi[kMaxPairs];
+
+  AliFemtoPairBlock(const AliFemtoPairBlock&);
+  AliFemtoPairBlock& operator=(const AliFemtoPairBlock&);
+};
+
+#endif
@@ -13,6 +13,7 @@
 #include <string>
 
 class AliFemtoAnalysis;
+class AliFemtoPairBlock;
 
 #include "AliFemtoString.h"
 #include "AliFemtoEvent.h"
@@ -43,6 +44,13 @@ public:
 
   virtual bool Pass(const AliFemtoPair* pair) = 0;  ///< true if pair passes, false if not
 
+  /// Block interface, used by AliFemtoSimpleAnalysis in pair-block mode.
+  /// Cuts which can be evaluated from the pair quantities of an
+  /// AliFemtoPairBlock return true here and implement PassBlock, which
+  /// must set the pass flag of every pair in the block.
+  virtual bool SupportsPairBlock() const { return false; }
+  virtual void PassBlock(AliFemtoPairBlock& /* block */) { /* no-op */ }
+
   virtual AliFemtoString Report() = 0;              ///< user-written method to return string describing cuts
   virtual TList *ListSettings() = 0;                ///< Return a TList of settings
 
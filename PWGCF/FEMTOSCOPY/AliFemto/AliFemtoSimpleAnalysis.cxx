@@ -9,6 +9,7 @@
 #include "AliFemtoXiCut.h"
 #include "AliFemtoXiTrackCut.h"
 #include "AliFemtoPicoEvent.h"
+#include "AliFemtoPairBlock.h"
 
 #include <string>
 #include <iostream>
@@ -183,7 +184,11 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fUsePairBlocks(kFALSE),
+  fPackedParticles1(nullptr),
+  fPackedParticles2(nullptr),
+  fPairBlock(nullptr)
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -205,7 +210,11 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fUsePairBlocks(a.fUsePairBlocks),
+  fPackedParticles1(nullptr),
+  fPackedParticles2(nullptr),
+  fPairBlock(nullptr)
 {
   /// Copy constructor
 
@@ -317,6 +326,10 @@ AliFemtoSimpleAnalysis::~AliFemtoSimpleAnalysis()
     }
     delete fMixingBuffer;
   }
+
+  delete fPackedParticles1;
+  delete fPackedParticles2;
+  delete fPairBlock;
 }
 //______________________
 AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAnalysis& aAna)
@@ -402,6 +415,7 @@ AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAn
   fVerbose = aAna.fVerbose;
   fPerformSharedDaughterCut = aAna.fPerformSharedDaughterCut;
   fEnablePairMonitors = aAna.fEnablePairMonitors;
+  fUsePairBlocks = aAna.fUsePairBlocks;
 
   return *this;
 }
@@ -591,6 +605,17 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
     std::cerr << "Problem with pair type, type = " << typeIn << "\n";
     return;
   }
+  if (fUsePairBlocks && !enablePairMonitors) {
+    bool block_consumer = fPairCut->SupportsPairBlock();
+    for (auto &tCorrFctn : *fCorrFctnCollection) {
+      block_consumer |= tCorrFctn->SupportsPairBlock();
+    }
+    if (block_consumer) {
+      MakePairBlocks(these_are_real_pairs, partCollection1, partCollection2);
+      return;
+    }
+  }
+
   //  int swpart = ((long int) partCollection1) % 2;
 
   // Used to swap particle 1 & 2 in identical-particle analysis
@@ -680,6 +705,105 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
   delete tPair;
 }
 //_________________________
+void AliFemtoSimpleAnalysis::MakePairBlocks(bool realPairs,
+                                            AliFemtoParticleCollection *partCollection1,
+                                            AliFemtoParticleCollection *partCollection2)
+{
+/// Same pairs, in the same order and with the same particle swapping,
+/// as the loop in MakePairs.
+
+  if (!fPairBlock) {
+    fPackedParticles1 = new AliFemtoPackedParticles;
+    fPackedParticles2 = new AliFemtoPackedParticles;
+    fPairBlock = new AliFemtoPairBlock;
+  }
+
+  fPackedParticles1->Pack(*partCollection1);
+  const AliFemtoPackedParticles *packed2 = fPackedParticles1;
+  if (partCollection2) {
+    fPackedParticles2->Pack(*partCollection2);
+    packed2 = fPackedParticles2;
+  }
+  fPairBlock->SetParticles(fPackedParticles1, packed2);
+
+  bool swpart = fNeventsProcessed % 2;
+
+  // used for the pair cuts and correlation functions without block interface
+  AliFemtoPair* tPair = new AliFemtoPair;
+
+  const unsigned int n1 = fPackedParticles1->Size(),
+                     n2 = packed2->Size();
+
+  for (unsigned int i = 0; i < n1; ++i) {
+    for (unsigned int j = partCollection2 ? 0 : i + 1; j < n2; ++j) {
+      if (partCollection2 || !swpart) {
+        fPairBlock->AddPair(i, j);
+      } else {
+        fPairBlock->AddPair(j, i);
+      }
+      if (!partCollection2) {
+        swpart = !swpart;
+      }
+
+      if (fPairBlock->Full()) {
+        ProcessPairBlock(realPairs, tPair);
+        fPairBlock->Clear();
+      }
+    }
+  }
+
+  if (fPairBlock->Size()) {
+    ProcessPairBlock(realPairs, tPair);
+    fPairBlock->Clear();
+  }
+
+  delete tPair;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::ProcessPairBlock(bool realPairs, AliFemtoPair *pair)
+{
+  AliFemtoPairBlock &block = *fPairBlock;
+  const unsigned int n = block.Size();
+
+  block.Compute();
+
+  if (fPairCut->SupportsPairBlock()) {
+    fPairCut->PassBlock(block);
+  } else {
+    for (unsigned int i = 0; i < n; ++i) {
+      pair->SetTrack1(block.Particle1(i));
+      pair->SetTrack2(block.Particle2(i));
+      block.SetPass(i, fPairCut->Pass(pair));
+    }
+  }
+
+  if (block.NPassed() == 0) {
+    return;
+  }
+
+  for (auto &tCorrFctn : *fCorrFctnCollection) {
+    if (tCorrFctn->SupportsPairBlock()) {
+      if (realPairs)
+        tCorrFctn->AddRealPairs(block);
+      else
+        tCorrFctn->AddMixedPairs(block);
+      continue;
+    }
+
+    for (unsigned int i = 0; i < n; ++i) {
+      if (!block.Pass(i)) {
+        continue;
+      }
+      pair->SetTrack1(block.Particle1(i));
+      pair->SetTrack2(block.Particle2(i));
+      if (realPairs)
+        tCorrFctn->AddRealPair(pair);
+      else
+        tCorrFctn->AddMixedPair(pair);
+    }
+  }
+}
+//_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
 {
   /// Perform initialization operations at the beginning of the event processing
@@ -18,6 +18,8 @@
 
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
+class AliFemtoPairBlock;
+class AliFemtoPackedParticles;
 
 ///
 /// \class AliFemtoSimpleAnalysis
@@ -99,6 +101,12 @@ public:
   void SetEnablePairMonitors(Bool_t aEnable);
   Bool_t EnablePairMonitors();
 
+  /// Make pairs in blocks (see AliFemtoPairBlock). Only effective if the
+  /// pair cut or at least one correlation function supports the block
+  /// interface, and pair monitors are disabled.
+  void SetUsePairBlocks(Bool_t aUse);
+  Bool_t UsePairBlocks() const;
+
   unsigned int NumEventsToMix() const;
   void SetNumEventsToMix(const unsigned int& NumberOfEventsToMix);
   AliFemtoPicoEvent* CurrentPicoEvent();
@@ -159,6 +167,17 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Block version of MakePairs: the particle collections are packed
+  /// into arrays and the pairs are passed to the pair cut and the
+  /// correlation functions in blocks of AliFemtoPairBlock::kMaxPairs
+  void MakePairBlocks(bool realPairs,
+                      AliFemtoParticleCollection* ParticlesPassingCut1,
+                      AliFemtoParticleCollection* ParticlesPassingCut2);
+
+  /// Apply the pair cut to the pairs of fPairBlock and give the passing
+  /// ones to the correlation functions
+  void ProcessPairBlock(bool realPairs, AliFemtoPair *pair);
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -177,6 +196,11 @@ protected:
   Bool_t fVerbose;
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
+  Bool_t fUsePairBlocks;                             ///< make pairs in blocks (MakePairBlocks)
+
+  AliFemtoPackedParticles* fPackedParticles1;        //!<! packed kinematics of the first collection (block mode)
+  AliFemtoPackedParticles* fPackedParticles2;        //!<! packed kinematics of the second collection (block mode)
+  AliFemtoPairBlock*       fPairBlock;               //!<! current block of pairs (block mode)
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -305,4 +329,14 @@ inline void AliFemtoSimpleAnalysis::SetEnablePairMonitors(Bool_t aEnable)
   fEnablePairMonitors = aEnable;
 }
 
+inline void AliFemtoSimpleAnalysis::SetUsePairBlocks(Bool_t aUse)
+{
+  fUsePairBlocks = aUse;
+}
+
+inline Bool_t AliFemtoSimpleAnalysis::UsePairBlocks() const
+{
+  return fUsePairBlocks;
+}
+
 #endif
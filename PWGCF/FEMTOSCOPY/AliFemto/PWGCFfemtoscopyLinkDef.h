@@ -67,6 +67,7 @@
 #pragma link C++ class AliFemtoModelGlobalHiddenInfo+;
 #pragma link C++ class AliFemtoModelCorrFctn+;
 #pragma link C++ class AliFemtoModelWeightGeneratorLednicky+;
+#pragma link C++ class AliFemtoModelWeightGeneratorLednickyTable+;
 #pragma link C++ class AliFemtoCutMonitorParticleYPt+;
 #pragma link C++ class AliFemtoCutMonitorParticleYPt_proton+;
 #pragma link C++ class AliFemtoCutMonitorParticleVertPos+;
@@ -10,18 +10,18 @@
 
 int TpcLocalTransform(AliFmThreeVectorD& aPoint, int& aSector, int& aRow, 
 		      float& aU, double& aPhi){
-  static int tNPadAtRow[45]={
+  static const int tNPadAtRow[45]={
   88,96,104,112,118,126,134,142,150,158,166,174,182,
   98,100,102,104,106,106,108,110,112,112,114,116,118,120,122,122,
   124,126,128,128,130,132,134,136,138,138,140,142,144,144,144,144};
-  static double tSectToPhi[24]={2.,1.,0.,11.,10.,9.,8. ,7. ,6.,5.,4.,3.,
+  static const double tSectToPhi[24]={2.,1.,0.,11.,10.,9.,8. ,7. ,6.,5.,4.,3.,
 				4.,5.,6., 7., 8.,9.,10.,11.,0.,1.,2.,3.};
   //static double tPhiToSect[24]={2.,1.,0.,11.,10.,9.,8. ,7. ,6.,5.,4.,3.,
 	//			4.,5.,6., 7., 8.,9.,10.,11.,0.,1.,2.,3.};
-  static double tPadWidthInner = 0.335;
-  static double tPadWidthOuter = 0.67;
+  static const double tPadWidthInner = 0.335;
+  static const double tPadWidthOuter = 0.67;
 
-  static double tPi = TMath::Pi();
+  static const double tPi = TMath::Pi();
   // --- find sector number
   aPhi = aPoint.Phi();
   if(aPhi<0.) aPhi+=(2*tPi);
@@ -24,6 +24,11 @@
 //-----------------------------------------------------------------------
 
 #include "AliHFOfflineCorrelator.h"
+#include "AliHFOfflineCorrelatorIndex.h"
+#include "TROOT.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 //___________________________________________________________________________________________
 AliHFCorrelationBranchD::AliHFCorrelationBranchD():
@@ -115,7 +120,10 @@ fNameCutObj(0),
 fUseEff(0),
 fMake2DPlots(kFALSE),
 fWeightPeriods(kTRUE),
-fRejectSoftPi(kTRUE)
+fRejectSoftPi(kTRUE),
+fUseEventIndex(kFALSE),
+fNThreads(1),
+fIndexDir("")
 {
 
 }
@@ -171,7 +179,10 @@ fNameCutObj(source.fNameCutObj),
 fUseEff(source.fUseEff),
 fMake2DPlots(source.fMake2DPlots),
 fWeightPeriods(source.fWeightPeriods),
-fRejectSoftPi(source.fRejectSoftPi)
+fRejectSoftPi(source.fRejectSoftPi),
+fUseEventIndex(source.fUseEventIndex),
+fNThreads(source.fNThreads),
+fIndexDir(source.fIndexDir)
 {
 
 }
@@ -231,6 +242,9 @@ fUseEff = orig.fUseEff;
 fMake2DPlots = orig.fMake2DPlots;
 fWeightPeriods = orig.fWeightPeriods;
 fRejectSoftPi = orig.fRejectSoftPi;
+fUseEventIndex = orig.fUseEventIndex;
+fNThreads = orig.fNThreads;
+fIndexDir = orig.fIndexDir;
 
 return *this; //returns pointer of the class
 }
@@ -458,11 +472,15 @@ Bool_t AliHFOfflineCorrelator::Correlate() {
     }
   }
 
-  for(Int_t iFile=0; iFile<(int)fFileList.size(); iFile++) {
-    Bool_t success = CorrelateSingleFile(iFile);
-    if(!success) {
-      std::cout << "Error in the evaluation of correlations for file #" << iFile << ". Exiting..." << std::endl;
-      return kFALSE;
+  if(fUseEventIndex || fNThreads>1) {
+    if(!CorrelateFilesIndexed()) return kFALSE;
+  } else {
+    for(Int_t iFile=0; iFile<(int)fFileList.size(); iFile++) {
+      Bool_t success = CorrelateSingleFile(iFile);
+      if(!success) {
+        std::cout << "Error in the evaluation of correlations for file #" << iFile << ". Exiting..." << std::endl;
+        return kFALSE;
+      }
     }
   }
 
@@ -690,6 +708,411 @@ Bool_t AliHFOfflineCorrelator::CorrelateSingleFile(Int_t iFile) {
   return kTRUE;
 }
 
+//___________________________________________________________________________________________
+Bool_t AliHFOfflineCorrelator::CorrelateFilesIndexed() {
+  //
+  // Correlates all input files with CorrelateSingleFileIndexed, on fNThreads threads.
+  // Each thread takes the next unprocessed file and fills its own copy of the output
+  // plots, which are summed to the output at the end (the result differs from the
+  // sequential one only by the rounding of the sums)
+  //
+  const Int_t nFiles = fFileList.size();
+  const Int_t nThreads = TMath::Max(1,TMath::Min(fNThreads,nFiles));
+
+  if(nThreads==1) {
+    for(Int_t iFile=0; iFile<nFiles; iFile++) {
+      if(!CorrelateSingleFileIndexed(iFile,fOutputDistr,fOutputMass)) {
+        std::cout << "Error in the evaluation of correlations for file #" << iFile << ". Exiting..." << std::endl;
+        return kFALSE;
+      }
+    }
+    return kTRUE;
+  }
+
+  ROOT::EnableThreadSafety();
+  TDatabasePDG::Instance(); //created before the threads use it (IsSoftPionFromDstar)
+
+  //the first thread fills the output directly, the others a copy of it
+  std::vector<TList*> outputDistr(nThreads,fOutputDistr), outputMass(nThreads,fOutputMass);
+  for(Int_t iThread=1; iThread<nThreads; iThread++) {
+    TList* lists[2] = {fOutputDistr,fOutputMass};
+    for(Int_t iList=0; iList<2; iList++) {
+      TList *copy = new TList();
+      copy->SetOwner();
+      copy->SetName(lists[iList]->GetName());
+      TIter next(lists[iList]);
+      while(TH1 *h = (TH1*)next()) {
+        TH1 *hCopy = (TH1*)h->Clone();
+        hCopy->SetDirectory(0);
+        copy->Add(hCopy);
+      }
+      if(iList==0) outputDistr[iThread] = copy;
+      else outputMass[iThread] = copy;
+    }
+  }
+
+  std::atomic<Int_t> nextFile(0);
+  std::atomic<Bool_t> failed(kFALSE);
+
+  auto worker = [&](Int_t iThread) {
+    for(Int_t iFile=nextFile++; iFile<nFiles && !failed; iFile=nextFile++) {
+      if(!CorrelateSingleFileIndexed(iFile,outputDistr[iThread],outputMass[iThread])) {
+        std::cout << "Error in the evaluation of correlations for file #" << iFile << ". Exiting..." << std::endl;
+        failed = kTRUE;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for(Int_t iThread=1; iThread<nThreads; iThread++) threads.emplace_back(worker,iThread);
+  worker(0);
+  for(size_t i=0; i<threads.size(); i++) threads[i].join();
+
+  //merge of the copies, in thread order
+  for(Int_t iThread=1; iThread<nThreads; iThread++) {
+    if(!failed) {
+      TIter nextOut(fOutputDistr), nextCopy(outputDistr[iThread]);
+      while(TH1 *h = (TH1*)nextOut()) h->Add((TH1*)nextCopy());
+      TIter nextOutMass(fOutputMass), nextCopyMass(outputMass[iThread]);
+      while(TH1 *h = (TH1*)nextOutMass()) h->Add((TH1*)nextCopyMass());
+    }
+    delete outputDistr[iThread];
+    delete outputMass[iThread];
+  }
+
+  return !failed;
+}
+
+//___________________________________________________________________________________________
+TString AliHFOfflineCorrelator::GetEventIndexFileName(Int_t iFile) const {
+  //
+  // Name of the event index file of input file iFile; empty if the index cannot be
+  // stored (remote input and no index directory set)
+  //
+  TString input = fFileList.at(iFile);
+  TString suffix = Form("_%s_%s_%s_HFCorrIndex.root",fDirName.Data(),fNameTreeD.Data(),fNameTreeTr.Data());
+  suffix.ReplaceAll("/","_");
+
+  if(fIndexDir.IsNull()) {
+    if(input.Contains("://") && !input.BeginsWith("file://")) return "";
+    if(input.EndsWith(".root")) input.Remove(input.Length()-5);
+    return input+suffix;
+  }
+
+  //all the indexes in one directory: the full input path is part of the name
+  input.ReplaceAll("/","_");
+  input.ReplaceAll(":","_");
+  if(input.EndsWith(".root")) input.Remove(input.Length()-5);
+  return fIndexDir+"/"+input+suffix;
+}
+
+//___________________________________________________________________________________________
+AliHFOfflineCorrelatorIndex* AliHFOfflineCorrelator::GetEventIndex(Int_t iFile, TTree *treeD, TTree *treeTr) const {
+  //
+  // Reads the event index of input file iFile, or builds (and stores) it if missing
+  // or not matching the trees. The caller owns the returned index
+  //
+  TString indexFile = GetEventIndexFileName(iFile);
+
+  AliHFOfflineCorrelatorIndex *index = indexFile.IsNull() ? 0x0 : AliHFOfflineCorrelatorIndex::ReadFromFile(indexFile);
+  if(index && !index->Matches(treeD,treeTr)) {
+    std::cout << "Event index " << indexFile << " does not match the trees, rebuilding it" << std::endl;
+    delete index;
+    index = 0x0;
+  }
+
+  if(!index) {
+    std::cout << "Building event index for file " << fFileList.at(iFile) << std::endl;
+    index = new AliHFOfflineCorrelatorIndex();
+    if(!index->Build(treeD,treeTr)) {
+      delete index;
+      return 0x0;
+    }
+    if(!indexFile.IsNull()) index->WriteToFile(indexFile);
+  }
+  index->PrintInfo();
+
+  return index;
+}
+
+//___________________________________________________________________________________________
+Bool_t AliHFOfflineCorrelator::CorrelateSingleFileIndexed(Int_t iFile, TList *outputDistr, TList *outputMass) {
+  //
+  // Same correlations as CorrelateSingleFile, filled in outputDistr and outputMass.
+  // The associated tracks are read once into memory, and for each D meson only the
+  // candidate tracks are looped on: the tracks of the same event (SE, from the event
+  // index) or of the same pool (ME), in increasing entry order as in CorrelateSingleFile.
+  // Only local state is modified, so different files can be processed concurrently
+  //
+  std::cout << "Opening file: " << fFileList.at(iFile) << std::endl;
+
+  TFile *file = TFile::Open((TString)(fFileList.at(iFile)).Data());
+  if(!file){
+    std::cout << "File " << fFileList.at(iFile) << " cannot be opened! check your file path!" << std::endl;
+    return kFALSE;
+  }
+
+  TDirectoryFile *dir = (TDirectoryFile*)file->Get(fDirName.Data());
+  if(!dir){
+    std::cout << "Directory " << fDirName << " is missing! Check its spelling/the file content" << std::endl;
+    file->ls();
+    delete file;
+    return kFALSE;
+  }
+
+  TTree *treeD = (TTree*)dir->Get(fNameTreeD.Data());
+  TTree *treeTr = (TTree*)dir->Get(fNameTreeTr.Data());
+  if(!treeD || !treeTr){
+    std::cout << "TTrees not found! Check its spelling/the directory content" << std::endl;
+    dir->ls();
+    delete file;
+    return kFALSE;
+  }
+
+  TH2F *mapEffD = 0x0;
+  TH3F *mapEffTr = 0x0;
+  if(fUseEff) {
+    AliHFAssociatedTrackCuts *cutObj = (AliHFAssociatedTrackCuts*)dir->Get(fNameCutObj.Data());
+    if(!cutObj){
+      std::cout << "Wrong cut file name, or missing cut file! (you chose: " << fNameCutObj << ")" << std::endl;
+      file->ls();
+      delete file;
+      return kFALSE;
+    }
+    mapEffD = (TH2F*)cutObj->GetTrigEfficiencyWeight();
+    mapEffTr = (TH3F*)cutObj->GetEfficiencyWeight();
+    if(!mapEffD || !mapEffTr){
+      std::cout << "Efficiency maps missing! Check the spelling (you chose: " << fNameMapD << "/" << fNameMapTr << ") or the file content content" << std::endl;
+      file->ls();
+      delete file;
+      return kFALSE;
+    }
+  }
+
+  AliHFOfflineCorrelatorIndex *index = GetEventIndex(iFile,treeD,treeTr);
+  if(!index) {
+    std::cout << "Event index of file " << fFileList.at(iFile) << " cannot be built!" << std::endl;
+    delete file;
+    return kFALSE;
+  }
+
+  const Long64_t nTracks = treeTr->GetEntries();
+  std::cout << "File contains a total of " << treeD->GetEntries() << " D mesons and of " << nTracks << " associated tracks" << std::endl;
+
+  //associated tracks in memory
+  std::vector<AliHFCorrelationBranchTr> tracks(nTracks);
+  AliHFCorrelationBranchTr *brTr = 0;
+  treeTr->SetBranchAddress("branchTr",&brTr);
+  for(Long64_t iTr=0; iTr<nTracks; iTr++) {
+    treeTr->GetEntry(iTr);
+    tracks[iTr] = *brTr;
+  }
+  treeTr->ResetBranchAddresses();
+  delete brTr;
+
+  //ME candidates: tracks of each pool, in increasing entry order
+  std::vector<std::vector<Long64_t> > poolTracks;
+  if(fAnType==kME) {
+    poolTracks.resize(fnPools);
+    for(Long64_t iTr=0; iTr<nTracks; iTr++) {
+      Int_t pool = GetPoolBin(tracks[iTr].mult_Tr,tracks[iTr].zVtx_Tr);
+      if(pool>=0) poolTracks[pool].push_back(iTr);
+    }
+  }
+
+  //output plots, by [D pT bin][assoc. pT range][pool]
+  const Int_t nRng = fPtBinsTrLow.size();
+  const Int_t nPlots = fNBinsPt*nRng*fnPools;
+  std::vector<TH3F*> h3D(nPlots,0x0), h3DSoftPi(nPlots,0x0);
+  std::vector<TH2F*> h2DSign(nPlots,0x0), h2DSB(nPlots,0x0), h2DSignSoftPi(nPlots,0x0), h2DSBSoftPi(nPlots,0x0);
+  std::vector<TH1F*> hEtaD(nPlots,0x0), hEtaTr(nPlots,0x0), hEtaDSign(nPlots,0x0), hEtaTrSign(nPlots,0x0), hEtaDSB(nPlots,0x0), hEtaTrSB(nPlots,0x0);
+  std::vector<TH1F*> hMass(fNBinsPt,0x0), hMassWeig(fNBinsPt,0x0);
+
+  for(Int_t iBin=0; iBin<fNBinsPt; iBin++) {
+    hMass[iBin] = (TH1F*)outputMass->FindObject(Form("histMass_%d",fFirstBinNum+iBin));
+    if(fUseEff) hMassWeig[iBin] = (TH1F*)outputMass->FindObject(Form("histMass_WeigD0Eff_%d",fFirstBinNum+iBin));
+    for(Int_t iRng=0; iRng<nRng; iRng++) {
+      for(Int_t iPool=0; iPool<fnPools; iPool++) {
+        const Int_t iPlot = (iBin*nRng+iRng)*fnPools+iPool;
+        TString suffix = Form("Bin%d_%1.1fto%1.1f_p%d",fFirstBinNum+iBin,fPtBinsTrLow.at(iRng),fPtBinsTrUp.at(iRng),iPool);
+        h3D[iPlot] = (TH3F*)outputDistr->FindObject("h3DCorrelations_"+suffix);
+        h3DSoftPi[iPlot] = (TH3F*)outputDistr->FindObject("h3DCorrelations_"+suffix+"_softpiME");
+        h2DSign[iPlot] = (TH2F*)outputDistr->FindObject("h2DCorrelations_Sign_"+suffix);
+        h2DSB[iPlot] = (TH2F*)outputDistr->FindObject("h2DCorrelations_SB_"+suffix);
+        h2DSignSoftPi[iPlot] = (TH2F*)outputDistr->FindObject("h2DCorrelations_Sign_"+suffix+"_softpiME");
+        h2DSBSoftPi[iPlot] = (TH2F*)outputDistr->FindObject("h2DCorrelations_SB_"+suffix+"_softpiME");
+        hEtaD[iPlot] = (TH1F*)outputDistr->FindObject("hEtaD_"+suffix);
+        hEtaTr[iPlot] = (TH1F*)outputDistr->FindObject("hEtaTr_"+suffix);
+        hEtaDSign[iPlot] = (TH1F*)outputDistr->FindObject("hEtaD_Sign_"+suffix);
+        hEtaTrSign[iPlot] = (TH1F*)outputDistr->FindObject("hEtaTr_Sign_"+suffix);
+        hEtaDSB[iPlot] = (TH1F*)outputDistr->FindObject("hEtaD_SB_"+suffix);
+        hEtaTrSB[iPlot] = (TH1F*)outputDistr->FindObject("hEtaTr_SB_"+suffix);
+      }
+    }
+  }
+
+  std::cout << "Correlating..." << std::endl;
+
+  AliHFCorrelationBranchD *brD = 0;
+  treeD->SetBranchAddress("branchD",&brD);
+
+  Int_t poolD = 0, poolTr = 0;
+  Int_t minDLoop = 0, maxDLoop = treeD->GetEntries();
+  Long64_t minTrackLoop = 0, maxTrackLoop = nTracks;
+
+  Bool_t success = kTRUE;
+  if(fMinD>=0) minDLoop=fMinD;
+  if(fMaxD>=0) maxDLoop=fMaxD;
+  if(fMinD>fMaxD) {printf("Warning! Wrong settings of D-meson loop edges! Exiting...\n"); success = kFALSE; maxDLoop = minDLoop;}
+  else if(fMinD>treeD->GetEntries()) {printf("Warning! The lower edge of D meson loop exceeds the number of D in the TTree! No loop will be done\n"); maxDLoop = minDLoop;}
+  else if(fMaxD>treeD->GetEntries()) {printf("Warning! The upper edge of D meson loop exceeds the number of D in the TTree!\n"); maxDLoop = treeD->GetEntries();}
+
+  TRandom3 rnd;
+  rnd.SetSeed(1);
+
+  TStopwatch tim;
+  tim.Start();
+
+  for(Int_t iD=minDLoop; iD<maxDLoop; iD++) {  //loop on D-mesons in tree
+
+    //time monitoring
+    if(iD%10==0) {
+      tim.Stop();
+      std::cout << "--- D-meson " << iD << std::endl;
+      tim.Print();
+      tim.Continue();
+    }
+
+    treeD->GetEntry(iD);
+    Int_t ptBinD = PtBin(brD->pT_D);
+    if(ptBinD<0) continue;
+    if(fNumSelD>=0 && (brD->sel_D>>fNumSelD)%2!=1) continue; //important in case of multiple selection (default selection is 0)
+    if(fMinCent!=0 && fMaxCent!=0) {if(brD->cent_D < fMinCent || brD->cent_D > fMaxCent) continue;} //skip triggers outside centrality range
+
+    poolD = GetPoolBin(brD->mult_D,brD->zVtx_D);
+
+    if(fMaxTracks>0) { //select random range of 'fMaxTracks' tracks in the TTree of tracks (the range changes for each D meson to use all the sample)
+      if(fMaxTracks>=nTracks) printf("Warning! Requested to loop on more tracks than the available number! Standard loop being done\n");
+      else {
+        minTrackLoop = rnd.Rndm()*(nTracks-fMaxTracks);
+        maxTrackLoop = fMaxTracks+minTrackLoop;
+      }
+    }
+
+    Int_t fillOnce[(int)fPtBinsTrLow.size()]; for(int ii=0;ii<(int)fPtBinsTrLow.size();ii++) fillOnce[ii]=0;
+
+    //Fill mass plots
+    hMass[ptBinD]->Fill(brD->invMass_D);
+    if(fUseEff) hMassWeig[ptBinD]->Fill(brD->invMass_D,EfficiencyWeightDOnly(mapEffD,brD));
+
+    //candidate associated tracks
+    if(poolD<0) continue; //no track would pass the pool matching
+    const Long64_t *candidates = 0x0;
+    Int_t nCandidates = 0;
+    if(fAnType==kSE) {
+      Int_t iEv = index->FindEvent(brD->period_D,brD->orbit_D,brD->BC_D);
+      if(iEv<0) continue;
+      candidates = index->GetTrackEntries(iEv,nCandidates);
+    } else {
+      candidates = poolTracks[poolD].data();
+      nCandidates = poolTracks[poolD].size();
+    }
+    const Long64_t *firstCand = std::lower_bound(candidates,candidates+nCandidates,minTrackLoop);
+    const Long64_t *lastCand = std::lower_bound(firstCand,candidates+nCandidates,maxTrackLoop);
+
+    //Correlation plots!
+    for(const Long64_t *iCand=firstCand; iCand<lastCand; iCand++) {  //loop on associated tracks
+
+      AliHFCorrelationBranchTr *tr = &tracks[*iCand];
+      if(fAnType==kSE && (brD->period_D!=tr->period_Tr || brD->orbit_D!=tr->orbit_Tr || brD->BC_D!=tr->BC_Tr)) continue; //skips D and tracks from different events in ME
+      if(fAnType==kME && (brD->period_D==tr->period_Tr && brD->orbit_D==tr->orbit_Tr && brD->BC_D==tr->BC_Tr)) continue; //skips D and tracks from same event in SE
+
+      if(fAnType==kSE && brD->IDtrig_D==tr->IDtrig_Tr) continue; //skips D0 daughter association with their own trigger (or own soft-pion, for the D0)
+      if(fAnType==kSE && brD->IDtrig_D==tr->IDtrig2_Tr) continue;
+      if(fAnType==kSE && brD->IDtrig_D==tr->IDtrig3_Tr) continue;
+      if(fAnType==kSE && brD->IDtrig_D==tr->IDtrig4_Tr) continue;
+
+      if(fNumSelTr>=0 && (tr->sel_Tr>>fNumSelTr)%2!=1) continue; //important in case of multiple selection (default selection is 0)
+      if(fMinCent!=0 && fMaxCent!=0) {if(tr->cent_Tr < fMinCent || tr->cent_Tr > fMaxCent) continue;} //skip tracks outside centrality range
+
+      poolTr = GetPoolBin(tr->mult_Tr,tr->zVtx_Tr);
+      if(poolTr<0 || poolD!=poolTr) continue;  //skips if pools of D and tracks do not match, or if pool number is wrong
+
+      Double_t weight = 1.;
+      if(fUseEff) weight = EfficiencyWeight(mapEffD,mapEffTr,brD,tr); //efficiency weighting
+      if(fWeightPeriods && fAnType==kME) weight*=fPrdWeights.at(iFile); //period-by-period weighting
+      Double_t deltaPhi, deltaEta;
+      GetCorrelationsValue(brD,tr,deltaPhi,deltaEta);
+
+      Bool_t fillSoftpiME=kFALSE;
+      if(fRejectSoftPi && fDmesonSpecies==kD0toKpi) {
+        if(fAnType==kSE) { //reject softPi in SE events
+          if(IsSoftPionFromDstar(brD,tr)) continue;
+        }
+        if(fAnType==kME && deltaPhi > -0.4 && deltaPhi < 0.4 && deltaEta > -0.4 && deltaEta < 0.4) { //ME fake soft pi cut
+          if(IsSoftPionFromDstar(brD,tr)) fillSoftpiME=kTRUE; //to fill histograms containing only fake softpi in ME analysis
+        }
+      }
+
+      const Bool_t inSign = fMake2DPlots && brD->invMass_D > fMassSignL.at(ptBinD) && brD->invMass_D < fMassSignR.at(ptBinD);
+      const Bool_t inSB1 = fMake2DPlots && brD->invMass_D > fMassSB1L.at(ptBinD) && brD->invMass_D < fMassSB1R.at(ptBinD);
+      const Bool_t inSB2 = fMake2DPlots && fDmesonSpecies!=kDStarD0pi && brD->invMass_D > fMassSB2L.at(ptBinD) && brD->invMass_D < fMassSB2R.at(ptBinD);
+
+      for(Int_t iRng=0; iRng<nRng; iRng++) {  //loop on associated track ranges
+
+        //fill 3D and 2D correlation plots
+        if(tr->pT_Tr < fPtBinsTrLow.at(iRng) || tr->pT_Tr > fPtBinsTrUp.at(iRng)) continue; //skip cases where associated track pT is out of range
+        const Int_t iPlot = (ptBinD*nRng+iRng)*fnPools+poolD;
+        h3D[iPlot]->Fill(deltaPhi,deltaEta,brD->invMass_D,weight);
+        if(fillSoftpiME) h3DSoftPi[iPlot]->Fill(deltaPhi,deltaEta,brD->invMass_D,weight);
+
+        if(inSign) {
+          h2DSign[iPlot]->Fill(deltaPhi,deltaEta,weight);
+          if(fillSoftpiME) h2DSignSoftPi[iPlot]->Fill(deltaPhi,deltaEta,weight);
+        }
+        if(inSB1) {
+          h2DSB[iPlot]->Fill(deltaPhi,deltaEta,weight);
+          if(fillSoftpiME) h2DSBSoftPi[iPlot]->Fill(deltaPhi,deltaEta,weight);
+        }
+        if(inSB2) {
+          h2DSB[iPlot]->Fill(deltaPhi,deltaEta,weight);
+          if(fillSoftpiME) h2DSBSoftPi[iPlot]->Fill(deltaPhi,deltaEta,weight);
+        }
+
+        //***fill debug plots***
+        if(fDebug) {
+          if(fillOnce[iRng]==0) hEtaD[iPlot]->Fill(brD->eta_D);  //in the track loop, fill only once for D-meson!
+          hEtaTr[iPlot]->Fill(tr->eta_Tr);  //fill at each track iteration for the tracks!
+          if(inSign) {
+            if(fillOnce[iRng]==0) hEtaDSign[iPlot]->Fill(brD->eta_D);
+            hEtaTrSign[iPlot]->Fill(tr->eta_Tr);
+          }
+          if(inSB1) {
+            if(fillOnce[iRng]==0) hEtaDSB[iPlot]->Fill(brD->eta_D);
+            hEtaTrSB[iPlot]->Fill(tr->eta_Tr);
+          }
+          if(inSB2) {
+            if(fillOnce[iRng]==0) hEtaDSB[iPlot]->Fill(brD->eta_D);
+            hEtaTrSB[iPlot]->Fill(tr->eta_Tr);
+          }
+          fillOnce[iRng]++; //to avoid re-filling of D-meson debug plots with further tracks for the same meson
+        } //***end fill debug plots***
+
+      } //end ass track ranges
+    } //end ass track loop
+  } //end D-meson loop
+
+  std::cout << "Done! Closing file." << std::endl;
+
+  treeD->ResetBranchAddresses();
+  delete brD;
+  delete index;
+  file->Close();
+  delete file;
+
+  return success;
+}
+
 //___________________________________________________________________________________________
 void AliHFOfflineCorrelator::GetCorrelationsValue(AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr, Double_t &deltaPhi, Double_t &deltaEta) {
 
@@ -705,28 +1128,40 @@ void AliHFOfflineCorrelator::GetCorrelationsValue(AliHFCorrelationBranchD *brD,
 //___________________________________________________________________________________________
 Double_t AliHFOfflineCorrelator::GetEfficiencyWeight(AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr) {
 
+  return EfficiencyWeight(fMapEffD,fMapEffTr,brD,brTr);
+}
+
+//___________________________________________________________________________________________
+Double_t AliHFOfflineCorrelator::GetEfficiencyWeightDOnly(AliHFCorrelationBranchD *brD) {
+
+  return EfficiencyWeightDOnly(fMapEffD,brD);
+}
+
+//___________________________________________________________________________________________
+Double_t AliHFOfflineCorrelator::EfficiencyWeight(TH2F *mapD, TH3F *mapTr, AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr) {
+
   Double_t effD = 1, effTr = 1;
    
-  Int_t binD=fMapEffD->FindBin(brD->pT_D,brD->mult_D);
-  if(fMapEffD->IsBinUnderflow(binD)||fMapEffD->IsBinOverflow(binD))return 1.;
-  effD = fMapEffD->GetBinContent(binD);
+  Int_t binD=mapD->FindBin(brD->pT_D,brD->mult_D);
+  if(mapD->IsBinUnderflow(binD)||mapD->IsBinOverflow(binD))return 1.;
+  effD = mapD->GetBinContent(binD);
 
-  Int_t binTr=fMapEffTr->FindBin(brTr->pT_Tr,brTr->eta_Tr,brTr->zVtx_Tr);
-  if(fMapEffTr->IsBinUnderflow(binTr)||fMapEffTr->IsBinOverflow(binTr))return 1.;
-  effTr = fMapEffTr->GetBinContent(binTr);
+  Int_t binTr=mapTr->FindBin(brTr->pT_Tr,brTr->eta_Tr,brTr->zVtx_Tr);
+  if(mapTr->IsBinUnderflow(binTr)||mapTr->IsBinOverflow(binTr))return 1.;
+  effTr = mapTr->GetBinContent(binTr);
 
   if(effD*effTr==0) return 1.; //safety fix
   return 1./(effD*effTr);
 }
 
 //___________________________________________________________________________________________
-Double_t AliHFOfflineCorrelator::GetEfficiencyWeightDOnly(AliHFCorrelationBranchD *brD) {
+Double_t AliHFOfflineCorrelator::EfficiencyWeightDOnly(TH2F *mapD, AliHFCorrelationBranchD *brD) {
 
   Double_t effD = 1;
    
-  Int_t binD=fMapEffD->FindBin(brD->pT_D,brD->mult_D);
-  if(fMapEffD->IsBinUnderflow(binD)||fMapEffD->IsBinOverflow(binD))return 1.;
-  effD = fMapEffD->GetBinContent(binD);
+  Int_t binD=mapD->FindBin(brD->pT_D,brD->mult_D);
+  if(mapD->IsBinUnderflow(binD)||mapD->IsBinOverflow(binD))return 1.;
+  effD = mapD->GetBinContent(binD);
 
   if(effD==0) return 1.; //safety fix
   return 1./(effD);
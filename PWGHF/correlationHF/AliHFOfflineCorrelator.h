@@ -41,6 +41,8 @@
 
 using std::vector;
 
+class AliHFOfflineCorrelatorIndex;
+
 class AliHFCorrelationBranchD : public TObject
 {
   public:
@@ -124,15 +126,24 @@ public:
     void SetCentralitySelection(Double_t min, Double_t max) {fMinCent=min; fMaxCent=max;} //activated only if both values are != 0
     void SetRejectSoftPion(Bool_t store) {fRejectSoftPi=store;}
     void SetDebugLevel(Int_t deb=0) {fDebug=deb;}
+    void SetUseEventIndex(Bool_t use=kTRUE) {fUseEventIndex=use;} //index of the input trees (see AliHFOfflineCorrelatorIndex)
+    void SetEventIndexDir(TString dir) {fIndexDir=dir;} //where the event indexes are stored (default: next to the input files)
+    void SetNThreads(Int_t nThreads=1) {fNThreads=nThreads;} //input files processed in parallel (uses the event index)
 
     Bool_t Correlate();
 
     void DefineOutputObjects();
     void PrintCfg() const;
     Bool_t CorrelateSingleFile(Int_t iFile);
+    Bool_t CorrelateSingleFileIndexed(Int_t iFile, TList *outputDistr, TList *outputMass);
+    Bool_t CorrelateFilesIndexed();
+    TString GetEventIndexFileName(Int_t iFile) const;
+    AliHFOfflineCorrelatorIndex* GetEventIndex(Int_t iFile, TTree *treeD, TTree *treeTr) const;
     void GetCorrelationsValue(AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr, Double_t &deltaPhi, Double_t &deltaEta);
     Double_t GetEfficiencyWeight(AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr);
     Double_t GetEfficiencyWeightDOnly(AliHFCorrelationBranchD *brD);
+    static Double_t EfficiencyWeight(TH2F *mapD, TH3F *mapTr, AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr);
+    static Double_t EfficiencyWeightDOnly(TH2F *mapD, AliHFCorrelationBranchD *brD);
     Bool_t IsSoftPionFromDstar(AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr);
     Int_t PtBin(Double_t pt) const;
     Int_t GetPoolBin(Double_t mult, Double_t zVtx) const;
@@ -201,8 +212,11 @@ private:
     Bool_t fMake2DPlots; 		//flag to produce 2D plots for sign.region and SB
     Bool_t fWeightPeriods;		//flag to weight periods in ME analysis with max number of tracks used
     Bool_t fRejectSoftPi;	     //flag to remove soft pions in SE and ME analysis for D0 meson (ME rejection is done in extraction code)
+    Bool_t fUseEventIndex;		//flag to loop on the associated tracks through the event index, with the tracks in memory
+    Int_t fNThreads;			//number of threads processing the input files (>1 implies the event index)
+    TString fIndexDir;			//directory of the event index files (empty: next to the input files)
 
-    ClassDef(AliHFOfflineCorrelator,4); // class for plotting HF correlations
+    ClassDef(AliHFOfflineCorrelator,5); // class for plotting HF correlations
 
 };
 
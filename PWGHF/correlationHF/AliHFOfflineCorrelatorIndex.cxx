@@ -0,0 +1,260 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//
+//   Event index of the D-meson and hadron TTrees of AliHFOfflineCorrelator
+//-----------------------------------------------------------------------
+
+#include <iostream>
+#include <map>
+#include <tuple>
+#include "TFile.h"
+#include "TTree.h"
+#include "TSystem.h"
+#include "TUUID.h"
+#include "AliHFOfflineCorrelator.h"
+#include "AliHFOfflineCorrelatorIndex.h"
+
+typedef std::tuple<UInt_t,UInt_t,UShort_t> EventKey_t;
+
+//___________________________________________________________________________________________
+AliHFOfflineCorrelatorIndex::AliHFOfflineCorrelatorIndex():
+// default constructor
+TNamed("HFOfflineCorrelatorIndex","Event index of D-meson and hadron trees"),
+fNEntriesD(0),
+fNEntriesTr(0),
+fZipBytesD(0),
+fZipBytesTr(0),
+fInputFile(""),
+fInputUUID(""),
+fPeriod(0),
+fOrbit(0),
+fBC(0),
+fMult(0),
+fZVtx(0),
+fCent(0),
+fTrEntries(0),
+fTrFirst(0),
+fDEntries(0),
+fDFirst(0)
+{
+
+}
+
+//___________________________________________________________________________________________
+AliHFOfflineCorrelatorIndex::~AliHFOfflineCorrelatorIndex() {
+//destructor
+
+}
+
+//___________________________________________________________________________________________
+Bool_t AliHFOfflineCorrelatorIndex::Build(TTree *treeD, TTree *treeTr) {
+  //
+  // One pass on each tree. Events are numbered in order of appearance
+  // first, then sorted by (period, orbit, BC) at the end; entries are
+  // stored grouped by event and in increasing order within the event.
+  //
+  if(!treeD || !treeTr) return kFALSE;
+
+  fNEntriesD = treeD->GetEntries();
+  fNEntriesTr = treeTr->GetEntries();
+  fZipBytesD = treeD->GetZipBytes();
+  fZipBytesTr = treeTr->GetZipBytes();
+  TFile *input = treeD->GetCurrentFile();
+  fInputFile = input ? input->GetName() : "";
+  fInputUUID = input ? input->GetUUID().AsString() : "";
+
+  std::map<EventKey_t,Int_t> eventIds;
+  std::vector<EventKey_t> keys;
+  std::vector<Float_t> mult, zVtx, cent;
+  std::vector<Bool_t> hasTracks;
+  std::vector<Int_t> evTr(fNEntriesTr), evD(fNEntriesD);
+
+  //events are contiguous in the trees: look up the map only when the event changes
+  EventKey_t lastKey;
+  Int_t lastId = -1;
+
+  AliHFCorrelationBranchTr *brTr = 0;
+  treeTr->SetBranchAddress("branchTr",&brTr);
+  for(Long64_t iTr=0; iTr<fNEntriesTr; iTr++) {
+    treeTr->GetEntry(iTr);
+    EventKey_t key(brTr->period_Tr,brTr->orbit_Tr,brTr->BC_Tr);
+    if(lastId<0 || key!=lastKey) {
+      std::map<EventKey_t,Int_t>::iterator it = eventIds.find(key);
+      if(it==eventIds.end()) {
+        lastId = keys.size();
+        eventIds[key] = lastId;
+        keys.push_back(key);
+        mult.push_back(brTr->mult_Tr);
+        zVtx.push_back(brTr->zVtx_Tr);
+        cent.push_back(brTr->cent_Tr);
+        hasTracks.push_back(kTRUE);
+      } else lastId = it->second;
+      lastKey = key;
+    }
+    evTr[iTr] = lastId;
+  }
+  treeTr->ResetBranchAddresses();
+  delete brTr;
+
+  lastId = -1;
+  AliHFCorrelationBranchD *brD = 0;
+  treeD->SetBranchAddress("branchD",&brD);
+  for(Long64_t iD=0; iD<fNEntriesD; iD++) {
+    treeD->GetEntry(iD);
+    EventKey_t key(brD->period_D,brD->orbit_D,brD->BC_D);
+    if(lastId<0 || key!=lastKey) {
+      std::map<EventKey_t,Int_t>::iterator it = eventIds.find(key);
+      if(it==eventIds.end()) { //event without associated tracks
+        lastId = keys.size();
+        eventIds[key] = lastId;
+        keys.push_back(key);
+        mult.push_back(brD->mult_D);
+        zVtx.push_back(brD->zVtx_D);
+        cent.push_back(brD->cent_D);
+        hasTracks.push_back(kFALSE);
+      } else lastId = it->second;
+      lastKey = key;
+    }
+    evD[iD] = lastId;
+  }
+  treeD->ResetBranchAddresses();
+  delete brD;
+
+  //sorted event numbering (the map is ordered by key)
+  const Int_t nEvents = keys.size();
+  std::vector<Int_t> sortedId(nEvents);
+  fPeriod.resize(nEvents); fOrbit.resize(nEvents); fBC.resize(nEvents);
+  fMult.resize(nEvents); fZVtx.resize(nEvents); fCent.resize(nEvents);
+  Int_t iSorted = 0;
+  for(std::map<EventKey_t,Int_t>::const_iterator it=eventIds.begin(); it!=eventIds.end(); ++it, iSorted++) {
+    const Int_t id = it->second;
+    sortedId[id] = iSorted;
+    fPeriod[iSorted] = std::get<0>(it->first);
+    fOrbit[iSorted] = std::get<1>(it->first);
+    fBC[iSorted] = std::get<2>(it->first);
+    fMult[iSorted] = mult[id];
+    fZVtx[iSorted] = zVtx[id];
+    fCent[iSorted] = cent[id];
+  }
+
+  //counting sort of the entries by event
+  fTrFirst.assign(nEvents+1,0);
+  for(Long64_t iTr=0; iTr<fNEntriesTr; iTr++) fTrFirst[sortedId[evTr[iTr]]+1]++;
+  for(Int_t iEv=0; iEv<nEvents; iEv++) fTrFirst[iEv+1] += fTrFirst[iEv];
+  fTrEntries.resize(fNEntriesTr);
+  std::vector<Int_t> pos(fTrFirst.begin(),fTrFirst.end()-1);
+  for(Long64_t iTr=0; iTr<fNEntriesTr; iTr++) fTrEntries[pos[sortedId[evTr[iTr]]]++] = iTr;
+
+  fDFirst.assign(nEvents+1,0);
+  for(Long64_t iD=0; iD<fNEntriesD; iD++) fDFirst[sortedId[evD[iD]]+1]++;
+  for(Int_t iEv=0; iEv<nEvents; iEv++) fDFirst[iEv+1] += fDFirst[iEv];
+  fDEntries.resize(fNEntriesD);
+  pos.assign(fDFirst.begin(),fDFirst.end()-1);
+  for(Long64_t iD=0; iD<fNEntriesD; iD++) fDEntries[pos[sortedId[evD[iD]]]++] = iD;
+
+  return kTRUE;
+}
+
+//___________________________________________________________________________________________
+Bool_t AliHFOfflineCorrelatorIndex::Matches(TTree *treeD, TTree *treeTr) const {
+  //
+  // The index was built on the same trees: same number of entries and compressed
+  // size, in the same file (name and UUID, which changes when the file is rewritten)
+  //
+  if(!treeD || !treeTr) return kFALSE;
+  TFile *input = treeD->GetCurrentFile();
+  if(!input || fInputUUID.IsNull() || fInputFile!=input->GetName() || fInputUUID!=input->GetUUID().AsString()) return kFALSE;
+  return treeD->GetEntries()==fNEntriesD && treeTr->GetEntries()==fNEntriesTr
+      && treeD->GetZipBytes()==fZipBytesD && treeTr->GetZipBytes()==fZipBytesTr
+      && (Int_t)fTrFirst.size()==GetNEvents()+1 && (Int_t)fDFirst.size()==GetNEvents()+1;
+}
+
+//___________________________________________________________________________________________
+AliHFOfflineCorrelatorIndex* AliHFOfflineCorrelatorIndex::ReadFromFile(TString fileName) {
+
+  if(gSystem->AccessPathName(fileName.Data())) return 0x0; //no such file
+
+  TFile *f = TFile::Open(fileName.Data());
+  if(!f || f->IsZombie()) {delete f; return 0x0;}
+
+  AliHFOfflineCorrelatorIndex *index = 0x0;
+  f->GetObject("HFOfflineCorrelatorIndex",index);
+  f->Close();
+  delete f;
+
+  return index;
+}
+
+//___________________________________________________________________________________________
+Bool_t AliHFOfflineCorrelatorIndex::WriteToFile(TString fileName) const {
+
+  TFile *f = TFile::Open(fileName.Data(),"RECREATE");
+  if(!f || f->IsZombie()) {
+    std::cout << "Warning! Event index cannot be written to " << fileName << std::endl;
+    delete f;
+    return kFALSE;
+  }
+  f->WriteTObject(this,"HFOfflineCorrelatorIndex");
+  f->Close();
+  delete f;
+
+  return kTRUE;
+}
+
+//___________________________________________________________________________________________
+Int_t AliHFOfflineCorrelatorIndex::FindEvent(UInt_t period, UInt_t orbit, UShort_t bc) const {
+  //
+  // Binary search on the sorted events
+  //
+  const EventKey_t key(period,orbit,bc);
+  Int_t low = 0, high = GetNEvents();
+  while(low<high) {
+    const Int_t mid = (low+high)/2;
+    if(EventKey_t(fPeriod[mid],fOrbit[mid],fBC[mid])<key) low = mid+1;
+    else high = mid;
+  }
+  if(low<GetNEvents() && EventKey_t(fPeriod[low],fOrbit[low],fBC[low])==key) return low;
+  return -1;
+}
+
+//___________________________________________________________________________________________
+const Long64_t* AliHFOfflineCorrelatorIndex::GetTrackEntries(Int_t iEv, Int_t &nEntries) const {
+
+  nEntries = fTrFirst[iEv+1]-fTrFirst[iEv];
+  return fTrEntries.data()+fTrFirst[iEv];
+}
+
+//___________________________________________________________________________________________
+const Long64_t* AliHFOfflineCorrelatorIndex::GetDEntries(Int_t iEv, Int_t &nEntries) const {
+
+  nEntries = fDFirst[iEv+1]-fDFirst[iEv];
+  return fDEntries.data()+fDFirst[iEv];
+}
+
+//___________________________________________________________________________________________
+void AliHFOfflineCorrelatorIndex::GetTrackEvents(std::vector<Int_t> &events) const {
+
+  events.assign(fNEntriesTr,-1);
+  for(Int_t iEv=0; iEv<GetNEvents(); iEv++) {
+    for(Int_t i=fTrFirst[iEv]; i<fTrFirst[iEv+1]; i++) events[fTrEntries[i]] = iEv;
+  }
+}
+
+//___________________________________________________________________________________________
+void AliHFOfflineCorrelatorIndex::PrintInfo() const {
+
+  std::cout << "Event index: " << GetNEvents() << " events, " << fNEntriesD << " D mesons, " << fNEntriesTr << " associated tracks" << std::endl;
+}
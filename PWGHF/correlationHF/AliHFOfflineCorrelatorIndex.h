@@ -0,0 +1,96 @@
+#ifndef AliHFOfflineCorrelatorIndex_H
+#define AliHFOfflineCorrelatorIndex_H
+
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//
+//  Event index of the D-meson and hadron TTrees of one input file of
+//  AliHFOfflineCorrelator: for each event (period, orbit, BC) the tree
+//  entries of its D mesons and associated tracks, and the event
+//  multiplicity, z vertex and centrality (from which the mixing pool is
+//  obtained for any pool binning).
+//  Built once per file with a single pass on both trees, and stored in a
+//  ROOT file next to the input, so that further passes on the same input
+//  (e.g. for systematics) only read it back. The index is used only for
+//  trees with the same entries and compressed sizes in a file with the
+//  same name and UUID (a rewritten input file gets a new UUID).
+//-----------------------------------------------------------------------
+
+#include <vector>
+#include "TNamed.h"
+#include "TString.h"
+
+class TTree;
+
+class AliHFOfflineCorrelatorIndex : public TNamed
+{
+
+public:
+
+    AliHFOfflineCorrelatorIndex(); // default constructor
+    virtual ~AliHFOfflineCorrelatorIndex();
+
+    Bool_t Build(TTree *treeD, TTree *treeTr);
+    Bool_t Matches(TTree *treeD, TTree *treeTr) const;
+
+    static AliHFOfflineCorrelatorIndex* ReadFromFile(TString fileName); //0x0 if missing or unreadable
+    Bool_t WriteToFile(TString fileName) const;
+
+    Int_t GetNEvents() const {return fPeriod.size();}
+    Int_t FindEvent(UInt_t period, UInt_t orbit, UShort_t bc) const; //-1 if not found
+
+    Float_t GetMult(Int_t iEv) const {return fMult.at(iEv);}
+    Float_t GetZVtx(Int_t iEv) const {return fZVtx.at(iEv);}
+    Float_t GetCent(Int_t iEv) const {return fCent.at(iEv);}
+
+    //entries of the tracks (D mesons) of event iEv, in increasing order
+    const Long64_t* GetTrackEntries(Int_t iEv, Int_t &nEntries) const;
+    const Long64_t* GetDEntries(Int_t iEv, Int_t &nEntries) const;
+
+    //event of each track entry (-1 for entries not indexed)
+    void GetTrackEvents(std::vector<Int_t> &events) const;
+
+    void PrintInfo() const;
+
+private:
+
+    AliHFOfflineCorrelatorIndex(const AliHFOfflineCorrelatorIndex &source);
+    AliHFOfflineCorrelatorIndex& operator=(const AliHFOfflineCorrelatorIndex& source);
+
+    Long64_t fNEntriesD;		//entries of the D tree when the index was built
+    Long64_t fNEntriesTr;		//entries of the track tree when the index was built
+    Long64_t fZipBytesD;		//compressed size of the D tree when the index was built
+    Long64_t fZipBytesTr;		//compressed size of the track tree when the index was built
+    TString  fInputFile;		//name of the file of the trees
+    TString  fInputUUID;		//UUID of the file of the trees
+
+    std::vector<UInt_t>   fPeriod;	//events, sorted by (period, orbit, BC)
+    std::vector<UInt_t>   fOrbit;	//
+    std::vector<UShort_t> fBC;		//
+    std::vector<Float_t>  fMult;	//event multiplicity
+    std::vector<Float_t>  fZVtx;	//event z vertex
+    std::vector<Float_t>  fCent;	//event centrality
+
+    std::vector<Long64_t> fTrEntries;	//track entries, grouped by event
+    std::vector<Int_t>    fTrFirst;	//first track of each event in fTrEntries (one more element than events)
+    std::vector<Long64_t> fDEntries;	//D-meson entries, grouped by event
+    std::vector<Int_t>    fDFirst;	//first D meson of each event in fDEntries (one more element than events)
+
+    ClassDef(AliHFOfflineCorrelatorIndex,2); // event index of the input trees of AliHFOfflineCorrelator
+
+};
+
+#endif
@@ -19,6 +19,7 @@
 #pragma link C++ class AliHFOfflineCorrelator+;
 #pragma link C++ class AliHFCorrelationBranchD+;
 #pragma link C++ class AliHFCorrelationBranchTr+;
+#pragma link C++ class AliHFOfflineCorrelatorIndex+;
 #pragma link C++ class AliReducedParticle+;
 #pragma link C++ class AliD0hCutOptim+;
 #pragma link C++ class AliDstarhCutOptim+;
@@ -327,6 +327,21 @@ void AliHFEcontainer::FillCFContainer(const Char_t *name, UInt_t step, const Dou
   cont->Fill(content, step, weight);
 }
 
+//__________________________________________________________________
+Int_t AliHFEcontainer::GetStepIndex(const Char_t *name, const Char_t *steptitle) const{
+  //
+  // Index of the step with the given title in the container, -1 if not found
+  // Callers filling the same step for each track resolve the index once and
+  // fill via FillCFContainer
+  //
+  AliCFContainer *cont = GetCFContainer(name);
+  if(!cont) return -1;
+  for(Int_t istep = 0; istep < cont->GetNStep(); istep++){
+    if(!strcmp(cont->GetStepTitle(istep), steptitle)) return istep;
+  }
+  return -1;
+}
+
 //__________________________________________________________________
 void AliHFEcontainer::FillCFContainerStepname(const Char_t *name, const Char_t *steptitle, const Double_t * const content, Double_t weight)const{
   //
@@ -337,8 +352,7 @@ void AliHFEcontainer::FillCFContainerStepname(const Char_t *name, const Char_t *
   // find the matching step title
   Int_t mystep = -1;
   for(Int_t istep = 0; istep < cont->GetNStep(); istep++){
-    TString tstept = cont->GetStepTitle(istep);
-    if(!tstept.CompareTo(steptitle)){
+    if(!strcmp(cont->GetStepTitle(istep), steptitle)){
       mystep = istep;
       break;
     }
@@ -108,6 +108,24 @@ const Char_t * AliHFEcuts::fgkEventCutName[AliHFEcuts::kNcutStepsEvent] = {
 
 const Char_t * AliHFEcuts::fgkUndefined = "Undefined";
 
+const Char_t * AliHFEcuts::fgkCutListName[AliHFEcuts::kNcompiledCutSteps] = {
+  "fPartGenCuts",
+  "fPartEvCutPileupZ",
+  "fPartEvCut",
+  "fPartAccCuts",
+  "fPartRecNoCuts",
+  "fPartRecKineITSTPCCuts",
+  "fPartPrimCuts",
+  "fPartHFECutsITS",
+  "fPartHFECutsTOF",
+  "fPartHFECutsTPC",
+  "fPartHFECutsTRD",
+  "fPartHFECutsDca",
+  "fPartHFECutsSecvtx",
+  "fEvGenCuts",
+  "fEvRecCuts"
+};
+
 //__________________________________________________________________
 AliHFEcuts::AliHFEcuts():
   TNamed(),
@@ -151,12 +169,16 @@ AliHFEcuts::AliHFEcuts():
   fRejectKinkMothers(kTRUE),
   fHistQA(0x0),
   fCutList(0x0),
+  fCompiledCuts(),
+  fCutFirstRejections(),
+  fCutStepsCompiled(kFALSE),
   fDebugLevel(0),
   fPIDResponse(NULL)
 {
   //
   // Dummy Constructor
   //
+  memset(fCompiledStepStart, 0, sizeof(Int_t) * (kNcompiledCutSteps + 1));
   fProdVtx[0] =  -1.e+09;
   fProdVtx[1] =   1.e+09;
   fProdVtx[2] =  -1.e+09;
@@ -214,12 +236,16 @@ AliHFEcuts::AliHFEcuts(const Char_t *name, const Char_t *title):
   fRejectKinkMothers(kTRUE),
   fHistQA(0x0),
   fCutList(0x0),
+  fCompiledCuts(),
+  fCutFirstRejections(),
+  fCutStepsCompiled(kFALSE),
   fDebugLevel(0),
   fPIDResponse(NULL)
 {
   //
   // Default Constructor
   //
+  memset(fCompiledStepStart, 0, sizeof(Int_t) * (kNcompiledCutSteps + 1));
   fProdVtx[0] =  -1.e+09;
   fProdVtx[1] =   1.e+09;
   fProdVtx[2] =  -1.e+09;
@@ -277,12 +303,16 @@ AliHFEcuts::AliHFEcuts(const AliHFEcuts &c):
   fRejectKinkMothers(c.fRejectKinkMothers),
   fHistQA(0x0),
   fCutList(0x0),
+  fCompiledCuts(),
+  fCutFirstRejections(),
+  fCutStepsCompiled(kFALSE),
   fDebugLevel(0),
   fPIDResponse(c.fPIDResponse)
 {
   //
   // Copy Constructor
   //
+  memset(fCompiledStepStart, 0, sizeof(Int_t) * (kNcompiledCutSteps + 1));
   c.Copy(*this);
 }
 
@@ -376,6 +406,11 @@ void AliHFEcuts::Copy(TObject &c) const {
       while((co = dynamic_cast<AliCFCutBase *>(cit1()))) co->SetQAOn(target.fHistQA);
     }
   }
+  // Compiled steps point to the cuts of this object
+  target.fCompiledCuts.clear();
+  target.fCutFirstRejections.clear();
+  memset(target.fCompiledStepStart, 0, sizeof(Int_t) * (kNcompiledCutSteps + 1));
+  target.fCutStepsCompiled = kFALSE;
 }
 
 //__________________________________________________________________
@@ -468,6 +503,7 @@ void AliHFEcuts::Initialize(AliCFManager *cfm){
   cfm->SetParticleCutsList(kStepHFEcutsTRD + kMCOffset, dynamic_cast<TObjArray *>(fCutList->FindObject("fPartHFECutsTRD")));
   cfm->SetParticleCutsList(kStepHFEcutsDca + kRecOffset + kMCOffset, dynamic_cast<TObjArray *>(fCutList->FindObject("fPartHFECutsDca")));
 
+  CompileCutSteps();
 }
 
 //__________________________________________________________________
@@ -513,7 +549,7 @@ void AliHFEcuts::Initialize(){
   SetEventCutList(kEventStepGenerated);
   SetEventCutList(kEventStepReconstructed);
 
-
+  CompileCutSteps();
 }
 
 //__________________________________________________________________
@@ -843,24 +879,58 @@ void AliHFEcuts::SetHFElectronDcaCuts(){
 }
 
 //__________________________________________________________________
-Bool_t AliHFEcuts::CheckParticleCuts(UInt_t step, TObject *o){
+void AliHFEcuts::CompileCutSteps(){
+  //
+  // Resolves the cut lists of the particle and event steps once into a
+  // flat table of cut objects, so that the cut checks neither search
+  // the cut list by name nor cast the cuts for each track or event
   //
-  // Checks the cuts without using the correction framework manager
-  // 
   AliDebug(2, "Called\n");
-  TString stepnames[kNcutStepsMCTrack + kNcutStepsRecTrack + kNcutStepsDETrack + kNcutStepsSecvtxTrack + 1] = {"fPartGenCuts","fPartEvCutPileupZ","fPartEvCut","fPartAccCuts","fPartRecNoCuts","fPartRecKineITSTPCCuts", "fPartPrimCuts", "fPartHFECutsITS","fPartHFECutsTOF","fPartHFECutsTPC","fPartHFECutsTRD","fPartHFECutsDca", "fPartHFECutsSecvtx"};
-  AliDebug(2, Form("Doing cut %s", stepnames[step].Data()));
- TObjArray *cuts = dynamic_cast<TObjArray *>(fCutList->FindObject(stepnames[step].Data()));
-  if(!cuts) return kTRUE;
-  TIter it(cuts);
-  AliCFCutBase *mycut;
+  fCompiledCuts.clear();
+  for(Int_t istep = 0; istep < kNcompiledCutSteps; istep++){
+    fCompiledStepStart[istep] = fCompiledCuts.size();
+    TObjArray *cuts = fCutList ? dynamic_cast<TObjArray *>(fCutList->FindObject(fgkCutListName[istep])) : NULL;
+    if(!cuts) continue;
+    TIter it(cuts);
+    AliCFCutBase *mycut;
+    while((mycut = dynamic_cast<AliCFCutBase *>(it()))) fCompiledCuts.push_back(mycut);
+  }
+  fCompiledStepStart[kNcompiledCutSteps] = fCompiledCuts.size();
+  fCutFirstRejections.assign(fCompiledCuts.size(), 0);
+  fCutStepsCompiled = kTRUE;
+}
+
+//__________________________________________________________________
+Bool_t AliHFEcuts::CheckCompiledStep(Int_t step, TObject *o){
+  //
+  // Checks the cuts of a compiled step. The remaining cuts are skipped
+  // after the first rejection unless the cut QA is filled, as the cuts
+  // fill their QA histograms when they are evaluated. Only the first
+  // rejecting cut is counted, independent of the QA mode
+  //
+  if(!fCutStepsCompiled) CompileCutSteps();
+  const Bool_t stopAtRejection = !(IsQAOn() || fHistQA);
   Bool_t status = kTRUE;
-  while((mycut = dynamic_cast<AliCFCutBase *>(it()))){
-    status &= mycut->IsSelected(o);
+  for(Int_t icut = fCompiledStepStart[step]; icut < fCompiledStepStart[step+1]; icut++){
+    if(fCompiledCuts[icut]->IsSelected(o)) continue;
+    if(status) fCutFirstRejections[icut]++;
+    status = kFALSE;
+    if(stopAtRejection) break;
   }
   return status;
 }
 
+//__________________________________________________________________
+Bool_t AliHFEcuts::CheckParticleCuts(UInt_t step, TObject *o){
+  //
+  // Checks the cuts without using the correction framework manager
+  // 
+  AliDebug(2, "Called\n");
+  if(step >= kNcutStepsParticle) return kTRUE;
+  AliDebug(2, Form("Doing cut %s", fgkCutListName[step]));
+  return CheckCompiledStep(step, o);
+}
+
 
 //__________________________________________________________________
 Bool_t AliHFEcuts::CheckEventCuts(const char*namestep, TObject *o){
@@ -868,7 +938,11 @@ Bool_t AliHFEcuts::CheckEventCuts(const char*namestep, TObject *o){
   // Checks the cuts without using the correction framework manager
   // 
   AliDebug(2, "Called\n");
-  TObjArray *cuts = dynamic_cast<TObjArray *>(fCutList->FindObject(namestep));
+  for(Int_t istep = kNcompiledCutSteps - 1; istep >= 0; istep--){
+    if(!strcmp(namestep, fgkCutListName[istep])) return CheckCompiledStep(istep, o);
+  }
+  // Not a compiled step
+  TObjArray *cuts = fCutList ? dynamic_cast<TObjArray *>(fCutList->FindObject(namestep)) : NULL;
   if(!cuts) return kTRUE;
   TIter it(cuts);
   AliCFCutBase *mycut;
@@ -879,6 +953,42 @@ Bool_t AliHFEcuts::CheckEventCuts(const char*namestep, TObject *o){
   return status;
 }
 
+//__________________________________________________________________
+Long64_t AliHFEcuts::GetNumberOfFirstRejections(const Char_t *cutname) const {
+  //
+  // Number of tracks/events for which the cut was the first rejecting
+  // cut of its step since the compilation of the cut steps (summed over
+  // the steps using a cut with this name)
+  //
+  Long64_t rejections = 0;
+  for(UInt_t icut = 0; icut < fCompiledCuts.size(); icut++){
+    if(!strcmp(fCompiledCuts[icut]->GetName(), cutname)) rejections += fCutFirstRejections[icut];
+  }
+  return rejections;
+}
+
+//__________________________________________________________________
+void AliHFEcuts::ResetFirstRejectionCounters(){
+  //
+  // Reset the number of first rejections of the compiled cuts
+  //
+  fCutFirstRejections.assign(fCompiledCuts.size(), 0);
+}
+
+//__________________________________________________________________
+void AliHFEcuts::PrintFirstRejectionCounters() const {
+  //
+  // Print the number of first rejections per cut step and cut
+  //
+  printf("First rejections by the cuts of %s\n", GetName());
+  for(Int_t istep = 0; istep < kNcompiledCutSteps; istep++){
+    if(fCompiledStepStart[istep] == fCompiledStepStart[istep+1]) continue;
+    printf("  %s\n", fgkCutListName[istep]);
+    for(Int_t icut = fCompiledStepStart[istep]; icut < fCompiledStepStart[istep+1]; icut++)
+      printf("    %-40s %lld\n", fCompiledCuts[icut]->GetName(), fCutFirstRejections[icut]);
+  }
+}
+
 //__________________________________________________________________
 void AliHFEcuts::SetRecEvent(const AliVEvent *ev){
   //
@@ -24,10 +24,13 @@
 #include <TNamed.h>
 #endif
 
+#include <vector>
+
 #ifndef ALIHFEEXTRACUTS_H
 #include "AliHFEextraCuts.h"
 #endif
 
+class AliCFCutBase;
 class AliCFManager;
 class AliESDtrack;
 class AliMCEvent;
@@ -88,6 +91,10 @@ class AliHFEcuts : public TNamed{
 
     Bool_t CheckParticleCuts(UInt_t step, TObject *o);
     Bool_t CheckEventCuts(const char*namestep, TObject *o);
+    void CompileCutSteps();
+    Long64_t GetNumberOfFirstRejections(const Char_t *cutname) const;
+    void ResetFirstRejectionCounters();
+    void PrintFirstRejectionCounters() const;
     void SetRecEvent(const AliVEvent *ev);
     void SetMCEvent(const AliVEvent *ev);
   
@@ -207,6 +214,10 @@ class AliHFEcuts : public TNamed{
     void SetPIDResponse(const AliPIDResponse * const pid) { fPIDResponse = pid; }
 
   private:
+    enum{
+      kNcutStepsParticle = kNcutStepsMCTrack + kNcutStepsRecTrack + kNcutStepsDETrack + kNcutStepsSecvtxTrack,
+      kNcompiledCutSteps = kNcutStepsParticle + 2
+    };
     enum{
       kDebugMode = BIT(14),
       kAOD = BIT(15)
@@ -231,6 +242,7 @@ class AliHFEcuts : public TNamed{
     void SetHFElectronTRDCuts();
     void SetHFElectronDcaCuts();
     void SetEventCutList(Int_t istep);
+    Bool_t CheckCompiledStep(Int_t step, TObject *o);
 
     static const Char_t* fgkMCCutName[kNcutStepsMCTrack];     // Cut step names for MC single Track cuts
     static const Char_t* fgkRecoCutName[kNcutStepsRecTrack];  // Cut step names for Rec single Track cuts
@@ -238,6 +250,7 @@ class AliHFEcuts : public TNamed{
     static const Char_t* fgkSecvtxCutName[kNcutStepsSecvtxTrack];     // Cut step names for secondary vertexing cuts
     static const Char_t* fgkEventCutName[kNcutStepsEvent];    // Cut step names for Event cuts
     static const Char_t* fgkUndefined;                        // Name for undefined (overflow)
+    static const Char_t* fgkCutListName[kNcompiledCutSteps];  // Cut lists of the compiled steps: particle steps, then fEvGenCuts and fEvRecCuts
   
     ULong64_t fRequirements;  	              // Bitmap for requirements
     UChar_t   fTPCclusterDef;                 // TPC cluster definition
@@ -288,12 +301,16 @@ class AliHFEcuts : public TNamed{
     
     TList *fHistQA;		                        //! QA Histograms
     TObjArray *fCutList;	                    //! List of cut objects(Correction Framework Manager)
+    std::vector<AliCFCutBase *> fCompiledCuts;      //! Cut objects of all compiled steps, step after step
+    std::vector<Long64_t> fCutFirstRejections;      //! Number of times each compiled cut was the first to reject in its step
+    Int_t fCompiledStepStart[kNcompiledCutSteps+1]; //! Index of the first cut of each step in fCompiledCuts
+    Bool_t fCutStepsCompiled;                       //! Compiled steps are in sync with fCutList
 
     Int_t fDebugLevel;                        // Debug Level
 
     const AliPIDResponse *fPIDResponse;//! PID Response
     
-  ClassDef(AliHFEcuts, 8)                     // Container for HFE cuts
+  ClassDef(AliHFEcuts, 9)                     // Container for HFE cuts
 };
 
 //__________________________________________________________________
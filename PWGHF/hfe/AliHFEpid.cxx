@@ -67,7 +67,11 @@ AliHFEpid::AliHFEpid():
   fEnabledDetectors(0),
   fNPIDdetectors(0),
   fVarManager(NULL),
-  fCommonObjects(NULL)
+  fCommonObjects(NULL),
+  fStepIndexContainer(NULL),
+  fStepIndexContname(),
+  fRecoContname(),
+  fMCContname()
 {
   //
   // Default constructor
@@ -75,6 +79,8 @@ AliHFEpid::AliHFEpid():
   memset(fDetectorPID, 0, sizeof(AliHFEpidBase *) * kNdetectorPID);
   memset(fDetectorOrder, kUndefined, sizeof(UInt_t) * kNdetectorPID);
   memset(fSortedOrder, 0, sizeof(UInt_t) * kNdetectorPID);
+  memset(fRecoStepIndex, 0, sizeof(Int_t) * kNdetectorPID);
+  memset(fMCStepIndex, 0, sizeof(Int_t) * kNdetectorPID);
 }
 
 //____________________________________________________________
@@ -83,7 +89,11 @@ AliHFEpid::AliHFEpid(const Char_t *name):
   fEnabledDetectors(0),
   fNPIDdetectors(0),
   fVarManager(NULL),
-  fCommonObjects(NULL)
+  fCommonObjects(NULL),
+  fStepIndexContainer(NULL),
+  fStepIndexContname(),
+  fRecoContname(),
+  fMCContname()
 {
   //
   // Default constructor
@@ -92,6 +102,8 @@ AliHFEpid::AliHFEpid(const Char_t *name):
   memset(fDetectorPID, 0, sizeof(AliHFEpidBase *) * kNdetectorPID);
   memset(fDetectorOrder, kUndefined, sizeof(UInt_t) * kNdetectorPID);
   memset(fSortedOrder, 0, sizeof(UInt_t) * kNdetectorPID);
+  memset(fRecoStepIndex, 0, sizeof(Int_t) * kNdetectorPID);
+  memset(fMCStepIndex, 0, sizeof(Int_t) * kNdetectorPID);
 
   fDetectorPID[kMCpid] = new AliHFEpidMC("MCPID");
   fDetectorPID[kBAYESpid] = new AliHFEpidBayes("BAYESPID");
@@ -109,7 +121,11 @@ AliHFEpid::AliHFEpid(const AliHFEpid &c):
   fEnabledDetectors(c.fEnabledDetectors),
   fNPIDdetectors(c.fNPIDdetectors),
   fVarManager(c.fVarManager),
-  fCommonObjects(NULL)
+  fCommonObjects(NULL),
+  fStepIndexContainer(NULL),
+  fStepIndexContname(),
+  fRecoContname(),
+  fMCContname()
 {
   //
   // Copy Constructor
@@ -161,6 +177,7 @@ void AliHFEpid::Copy(TObject &o) const{
   }
   memcpy(target.fDetectorOrder, fDetectorOrder, sizeof(UInt_t) * kNdetectorPID);
   memcpy(target.fSortedOrder, fSortedOrder, sizeof(UInt_t) * kNdetectorPID);
+  target.fStepIndexContainer = NULL;
 }
 
 //____________________________________________________________
@@ -259,15 +276,14 @@ Bool_t AliHFEpid::IsSelected(const AliHFEpidObject * const track, AliHFEcontaine
     }
     AliDebug(2, "Particlae selected by detector");
     if(fVarManager && cont){
-      TString reccontname = contname; reccontname += "Reco";
-      AliDebug(2, Form("Filling container %s", reccontname.Data()));
-      if(fVarManager->IsSignalTrack())
-        fVarManager->FillContainerStepname(cont, reccontname.Data(), SortedDetectorName(idet));
+      if(cont != fStepIndexContainer || fStepIndexContname.CompareTo(contname)) CacheStepIndices(cont, contname);
+      AliDebug(2, Form("Filling container %s", fRecoContname.Data()));
+      if(fVarManager->IsSignalTrack() && fRecoStepIndex[idet] >= 0)
+        fVarManager->FillContainer(cont, fRecoContname.Data(), fRecoStepIndex[idet]);
       if(HasMCData()){
-        TString mccontname = contname; mccontname += "MC";
-        AliDebug(2, Form("MC Information available, Filling container %s", mccontname.Data()));
+        AliDebug(2, Form("MC Information available, Filling container %s", fMCContname.Data()));
         if(fVarManager->IsSignalTrack()) {
-          fVarManager->FillContainerStepname(cont, mccontname.Data(), SortedDetectorName(idet), kTRUE);
+          if(fMCStepIndex[idet] >= 0) fVarManager->FillContainer(cont, fMCContname.Data(), fMCStepIndex[idet], kTRUE);
 	        if(cont->GetCorrelationMatrix("correlationstepafterTOF")){
 	          TString tstept("TOFPID"); 
 	          if(!tstept.CompareTo(SortedDetectorName(idet))) {
@@ -283,6 +299,23 @@ Bool_t AliHFEpid::IsSelected(const AliHFEpidObject * const track, AliHFEcontaine
   return isSelected;
 }
 
+//____________________________________________________________
+void AliHFEpid::CacheStepIndices(const AliHFEcontainer * const cont, const Char_t *contname){
+  //
+  // Resolve the container steps of the sorted detectors once per container,
+  // instead of looking them up by name for each selected track
+  //
+  fStepIndexContainer = cont;
+  fStepIndexContname = contname;
+  fRecoContname = contname; fRecoContname += "Reco";
+  fMCContname = contname; fMCContname += "MC";
+  for(UInt_t idet = 0; idet < fNPIDdetectors; idet++){
+    fRecoStepIndex[idet] = cont->GetStepIndex(fRecoContname.Data(), SortedDetectorName(idet));
+    fMCStepIndex[idet] = cont->GetStepIndex(fMCContname.Data(), SortedDetectorName(idet));
+    AliDebug(1, Form("Detector %s: step %d in %s, step %d in %s", SortedDetectorName(idet), fRecoStepIndex[idet], fRecoContname.Data(), fMCStepIndex[idet], fMCContname.Data()));
+  }
+}
+
 //____________________________________________________________
 void AliHFEpid::SortDetectors(){
   //
@@ -290,6 +323,7 @@ void AliHFEpid::SortDetectors(){
   //
   if(TestBit(kDetectorsSorted)) return; // Don't sort detectors when they are already sorted
   TMath::Sort(static_cast<UInt_t>(kNdetectorPID), fDetectorOrder, fSortedOrder, kFALSE);
+  fStepIndexContainer = NULL;
   SetBit(kDetectorsSorted);
 }
 
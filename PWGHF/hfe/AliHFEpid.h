@@ -114,6 +114,7 @@ class AliHFEpid : public TNamed{
 
     void AddCommonObject(TObject * const o);
     void ClearCommonObjects();
+    void CacheStepIndices(const AliHFEcontainer * const cont, const Char_t *contname);
     //-----Switch on/off detectors in PID sequence------
     void SwitchOnDetector(UInt_t det){ 
       if(det < kNdetectorPID) SETBIT(fEnabledDetectors, det);
@@ -135,8 +136,14 @@ class AliHFEpid : public TNamed{
     UInt_t fNPIDdetectors;                          //   Number of PID detectors
     AliHFEvarManager *fVarManager;                  //!  HFE Var Manager
     TObjArray *fCommonObjects;                      //   Garbage Collector
+    const AliHFEcontainer *fStepIndexContainer;     //!  Container the cached step indices belong to
+    TString fStepIndexContname;                     //!  Container name the cached step indices belong to
+    TString fRecoContname;                          //!  Name of the reconstructed container
+    TString fMCContname;                            //!  Name of the MC container
+    Int_t fRecoStepIndex[kNdetectorPID];            //!  Step of the sorted detectors in the reconstructed container
+    Int_t fMCStepIndex[kNdetectorPID];              //!  Step of the sorted detectors in the MC container
 
-  ClassDef(AliHFEpid, 1)      // Steering class for Electron ID
+  ClassDef(AliHFEpid, 2)      // Steering class for Electron ID
 };
 
 #endif
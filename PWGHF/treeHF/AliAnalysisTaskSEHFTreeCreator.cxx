@@ -260,6 +260,7 @@ fImpParProdOnFlyCut(9999.),
 fCosPOnFlyCut(-9999.),
 fCosPXYOnFlyCut(-9999.),
 fTreeSingleTrackVarsOpt(AliHFTreeHandler::kRedSingleTrackVars),
+fTreeVarPrecision(""),
 fJetRadius(0.4),
 fSubJetRadius(0.0),
 fJetAlgorithm(JetAlgorithm::antikt),
@@ -658,6 +659,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerD0->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
     fTreeHandlerD0->SetSubJetProperties(fSubJetRadius,fSubJetAlgorithm,fSoftDropZCut,fSoftDropBeta);
     fVariablesTreeD0 = (TTree*)fTreeHandlerD0->BuildTree(nameoutput,nameoutput);
+    if(!fTreeVarPrecision.IsNull()) fTreeHandlerD0->SetVariablePrecisions(fTreeVarPrecision);
     fVariablesTreeD0->SetMaxVirtualSize(1.e+8/nEnabledTrees);
     fTreeEvChar->AddFriend(fVariablesTreeD0);
     
@@ -688,6 +690,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerDs->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
     fTreeHandlerDs->SetSubJetProperties(fSubJetRadius,fSubJetAlgorithm,fSoftDropZCut,fSoftDropBeta);
     fVariablesTreeDs = (TTree*)fTreeHandlerDs->BuildTree(nameoutput,nameoutput);
+    if(!fTreeVarPrecision.IsNull()) fTreeHandlerDs->SetVariablePrecisions(fTreeVarPrecision);
     fVariablesTreeDs->SetMaxVirtualSize(1.e+8/nEnabledTrees);
     fTreeEvChar->AddFriend(fVariablesTreeDs);
     
@@ -717,6 +720,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerDplus->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
     fTreeHandlerDplus->SetSubJetProperties(fSubJetRadius,fSubJetAlgorithm,fSoftDropZCut,fSoftDropBeta);
     fVariablesTreeDplus = (TTree*)fTreeHandlerDplus->BuildTree(nameoutput,nameoutput);
+    if(!fTreeVarPrecision.IsNull()) fTreeHandlerDplus->SetVariablePrecisions(fTreeVarPrecision);
     fVariablesTreeDplus->SetMaxVirtualSize(1.e+8/nEnabledTrees);
     fTreeEvChar->AddFriend(fVariablesTreeDplus);
     if(fFillMCGenTrees && fReadMC) {
@@ -745,6 +749,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerLctopKpi->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
     fTreeHandlerLctopKpi->SetSubJetProperties(fSubJetRadius,fSubJetAlgorithm,fSoftDropZCut,fSoftDropBeta);
     fVariablesTreeLctopKpi = (TTree*)fTreeHandlerLctopKpi->BuildTree(nameoutput,nameoutput);
+    if(!fTreeVarPrecision.IsNull()) fTreeHandlerLctopKpi->SetVariablePrecisions(fTreeVarPrecision);
     fVariablesTreeLctopKpi->SetMaxVirtualSize(1.e+8/nEnabledTrees);
     fTreeEvChar->AddFriend(fVariablesTreeLctopKpi);
     if(fFillMCGenTrees && fReadMC) {
@@ -774,6 +779,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerBplus->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
     fTreeHandlerBplus->SetSubJetProperties(fSubJetRadius,fSubJetAlgorithm,fSoftDropZCut,fSoftDropBeta);
     fVariablesTreeBplus = (TTree*)fTreeHandlerBplus->BuildTree(nameoutput,nameoutput);
+    if(!fTreeVarPrecision.IsNull()) fTreeHandlerBplus->SetVariablePrecisions(fTreeVarPrecision);
     fVariablesTreeBplus->SetMaxVirtualSize(1.e+8/nEnabledTrees);
     fTreeEvChar->AddFriend(fVariablesTreeBplus);
     if(fFillMCGenTrees && fReadMC) {
@@ -802,6 +808,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerDstar->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
     fTreeHandlerDstar->SetSubJetProperties(fSubJetRadius,fSubJetAlgorithm,fSoftDropZCut,fSoftDropBeta);
     fVariablesTreeDstar = (TTree*)fTreeHandlerDstar->BuildTree(nameoutput,nameoutput);
+    if(!fTreeVarPrecision.IsNull()) fTreeHandlerDstar->SetVariablePrecisions(fTreeVarPrecision);
     fVariablesTreeDstar->SetMaxVirtualSize(1.e+8/nEnabledTrees);
     fTreeEvChar->AddFriend(fVariablesTreeDstar);
     if(fFillMCGenTrees && fReadMC) {
@@ -831,6 +838,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerLc2V0bachelor->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
     fTreeHandlerLc2V0bachelor->SetSubJetProperties(fSubJetRadius,fSubJetAlgorithm,fSoftDropZCut,fSoftDropBeta);
     fVariablesTreeLc2V0bachelor = (TTree*)fTreeHandlerLc2V0bachelor->BuildTree(nameoutput,nameoutput);
+    if(!fTreeVarPrecision.IsNull()) fTreeHandlerLc2V0bachelor->SetVariablePrecisions(fTreeVarPrecision);
     fVariablesTreeLc2V0bachelor->SetMaxVirtualSize(1.e+8/nEnabledTrees);
     fTreeEvChar->AddFriend(fVariablesTreeLc2V0bachelor);
     if(fFillMCGenTrees && fReadMC) {
@@ -860,6 +868,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerBs->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
     fTreeHandlerBs->SetSubJetProperties(fSubJetRadius,fSubJetAlgorithm,fSoftDropZCut,fSoftDropBeta);
     fVariablesTreeBs = (TTree*)fTreeHandlerBs->BuildTree(nameoutput,nameoutput);
+    if(!fTreeVarPrecision.IsNull()) fTreeHandlerBs->SetVariablePrecisions(fTreeVarPrecision);
     fVariablesTreeBs->SetMaxVirtualSize(1.e+8/nEnabledTrees);
     fTreeEvChar->AddFriend(fVariablesTreeBs);
     if(fFillMCGenTrees && fReadMC) {
@@ -888,6 +897,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerLb->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
     fTreeHandlerLb->SetSubJetProperties(fSubJetRadius,fSubJetAlgorithm,fSoftDropZCut,fSoftDropBeta);
     fVariablesTreeLb = (TTree*)fTreeHandlerLb->BuildTree(nameoutput,nameoutput);
+    if(!fTreeVarPrecision.IsNull()) fTreeHandlerLb->SetVariablePrecisions(fTreeVarPrecision);
     fVariablesTreeLb->SetMaxVirtualSize(1.e+8/nEnabledTrees);
     fTreeEvChar->AddFriend(fVariablesTreeLb);
     if(fFillMCGenTrees && fReadMC) {
@@ -178,6 +178,7 @@ public:
     }
 
     void SetTreeSingleTrackVarsOpt(Int_t opt) {fTreeSingleTrackVarsOpt=opt;}
+    void SetTreeVariablePrecision(TString config) {fTreeVarPrecision=config;} // see AliHFTreeHandler::SetVariablePrecisions
   
     Int_t  GetSystem() const {return fSys;}
     Bool_t GetWriteOnlySignalTree() const {return fWriteOnlySignal;}
@@ -407,6 +408,7 @@ private:
     Float_t                 fCosPXYOnFlyCut;                       ///Cut on cos pointing angle xy for on fly hadron selection
   
     Int_t                   fTreeSingleTrackVarsOpt;               /// option for single-track variables to be filled in the trees
+    TString                 fTreeVarPrecision;                     /// reduced precision of the candidate tree variables
 
     Double_t                fJetRadius;                            /// Setting the radius for jet finding
     Double_t                fSubJetRadius;                         /// Setting the radius for subjet finding
@@ -500,7 +502,7 @@ private:
     AliCDBEntry *fCdbEntry;
 
     /// \cond CLASSIMP
-    ClassDef(AliAnalysisTaskSEHFTreeCreator,28);
+    ClassDef(AliAnalysisTaskSEHFTreeCreator,29);
     /// \endcond
 };
 
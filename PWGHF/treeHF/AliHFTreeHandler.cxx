@@ -20,6 +20,7 @@
 /////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include "AliHFTreeHandler.h"
 #include "AliPID.h"
@@ -27,6 +28,9 @@
 #include "AliPIDResponse.h"
 #include "AliESDtrack.h"
 #include "TMath.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TObjString.h"
 
 /// \cond CLASSIMP
 ClassImp(AliHFTreeHandler);
@@ -112,7 +116,9 @@ AliHFTreeHandler::AliHFTreeHandler():
   fMinJetPt(0.0),
   fSoftDropZCut(0.1),
   fSoftDropBeta(0.0),
-  fTrackingEfficiency(1.0)
+  fTrackingEfficiency(1.0),
+  fColumnPrecision(),
+  fColumnPrecisionResolved(false)
 {
   //
   // Default constructor
@@ -230,7 +236,9 @@ AliHFTreeHandler::AliHFTreeHandler(int PIDopt):
   fMinJetPt(0.0),
   fSoftDropZCut(0.1),
   fSoftDropBeta(0.0),
-  fTrackingEfficiency(1.0)
+  fTrackingEfficiency(1.0),
+  fColumnPrecision(),
+  fColumnPrecisionResolved(false)
 {
   //
   // Standard constructor
@@ -910,3 +918,129 @@ void AliHFTreeHandler::GetNsigmaTPCMeanSigmaData(float &mean, float &sigma, AliP
     }
   }
 }
+
+//________________________________________________________________
+void AliHFTreeHandler::SetVariablePrecision(TString name, int nMantissaBits, int compression)
+{
+  //
+  // round the float variable to nMantissaBits mantissa bits (of 23) before each fill
+  //
+
+  if(nMantissaBits<0 || nMantissaBits>23) {
+    AliWarning(Form("Invalid number of mantissa bits %d for %s, full precision kept",nMantissaBits,name.Data()));
+    return;
+  }
+  ColumnPrecision col = {name.Data(),nMantissaBits,0.,0.,0,compression,nullptr};
+  fColumnPrecision.push_back(col);
+  fColumnPrecisionResolved = false;
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::SetVariableFixedPoint(TString name, float min, float max, int nBits, int compression)
+{
+  //
+  // round the float variable to a grid of 2^nBits values in [min,max] before each fill
+  //
+
+  if(nBits<1 || nBits>24 || !(max>min)) {
+    AliWarning(Form("Invalid fixed-point range [%f,%f] with %d bits for %s, full precision kept",min,max,nBits,name.Data()));
+    return;
+  }
+  ColumnPrecision col = {name.Data(),-1,min,max,nBits,compression,nullptr};
+  fColumnPrecision.push_back(col);
+  fColumnPrecisionResolved = false;
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::SetVariablePrecisions(TString config)
+{
+  //
+  // "name:nMantissaBits[:compression]" or "name:min:max:nBits[:compression]", comma separated
+  //
+
+  TObjArray* columns = config.Tokenize(",");
+  for(int iCol=0; iCol<columns->GetEntriesFast(); iCol++) {
+    TObjArray* fields = ((TObjString*)columns->At(iCol))->GetString().Tokenize(":");
+    int nFields = fields->GetEntriesFast();
+    TString name = nFields>0 ? ((TObjString*)fields->At(0))->GetString().Strip(TString::kBoth) : "";
+    std::vector<TString> values;
+    for(int iField=1; iField<nFields; iField++) values.push_back(((TObjString*)fields->At(iField))->GetString());
+    if(nFields==2 || nFields==3)
+      SetVariablePrecision(name,values[0].Atoi(),nFields==3 ? values[1].Atoi() : -1);
+    else if(nFields==4 || nFields==5)
+      SetVariableFixedPoint(name,values[0].Atof(),values[1].Atof(),values[2].Atoi(),nFields==5 ? values[3].Atoi() : -1);
+    else
+      AliWarning(Form("Invalid precision setting \"%s\"",((TObjString*)columns->At(iCol))->GetString().Data()));
+    delete fields;
+  }
+  delete columns;
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::ApplyColumnPrecision()
+{
+  //
+  // round the reduced precision variables before the fill
+  //
+
+  if(!fColumnPrecisionResolved) {
+    //branches are created in BuildTree, the compression is set before the first basket is written
+    for(auto col=fColumnPrecision.begin(); col!=fColumnPrecision.end();) {
+      TBranch* branch = fTreeVar ? fTreeVar->GetBranch(col->fName.c_str()) : nullptr;
+      TLeaf* leaf = branch ? (TLeaf*)branch->GetListOfLeaves()->At(0) : nullptr;
+      if(!leaf || branch->GetListOfLeaves()->GetEntriesFast()!=1 || leaf->GetLenStatic()!=1 || strcmp(leaf->GetTypeName(),"Float_t")!=0) {
+        AliWarning(Form("%s is not a float branch of the tree, full precision kept",col->fName.c_str()));
+        col = fColumnPrecision.erase(col);
+        continue;
+      }
+      col->fAddress = (float*)branch->GetAddress();
+      if(col->fCompression>=0) branch->SetCompressionSettings(col->fCompression);
+      ++col;
+    }
+    fColumnPrecisionResolved = true;
+  }
+
+  for(auto& col : fColumnPrecision) {
+    float& value = *col.fAddress;
+    if(col.fMantissaBits>=0) {
+      //round to nearest on the mantissa bits kept, inf and nan untouched
+      if(col.fMantissaBits==23) continue;
+      unsigned int bits;
+      memcpy(&bits,&value,sizeof(bits));
+      if((bits&0x7f800000u)==0x7f800000u) continue;
+      const unsigned int dropped = 23-col.fMantissaBits;
+      bits += 1u<<(dropped-1);
+      bits &= ~((1u<<dropped)-1);
+      memcpy(&value,&bits,sizeof(bits));
+    }
+    else {
+      const float step = (col.fMax-col.fMin)/((1<<col.fNBits)-1);
+      float clamped = value<col.fMin ? col.fMin : (value>col.fMax ? col.fMax : value);
+      value = col.fMin + std::round((clamped-col.fMin)/step)*step;
+    }
+  }
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::PrintColumnSizes() const
+{
+  //
+  // bytes per candidate of each branch, compressed sizes only for the baskets already written
+  //
+
+  if(!fTreeVar) return;
+  Long64_t nCand = fTreeVar->GetEntries();
+  if(nCand<=0) return;
+  printf("%s: %lld candidates\n",fTreeVar->GetName(),nCand);
+  printf("%-32s %12s %12s %8s\n","branch","bytes/cand","zipped/cand","ratio");
+  Long64_t totBytes=0, zipBytes=0;
+  TIter next(fTreeVar->GetListOfBranches());
+  while(TBranch* branch = (TBranch*)next()) {
+    Long64_t tot = branch->GetTotBytes("*");
+    Long64_t zip = branch->GetZipBytes("*");
+    totBytes += tot;
+    zipBytes += zip;
+    printf("%-32s %12.3f %12.3f %8.2f\n",branch->GetName(),(double)tot/nCand,(double)zip/nCand,zip>0 ? (double)tot/zip : 0.);
+  }
+  printf("%-32s %12.3f %12.3f %8.2f\n","total",(double)totBytes/nCand,(double)zipBytes/nCand,zipBytes>0 ? (double)totBytes/zipBytes : 0.);
+}
@@ -22,6 +22,8 @@
 // N. Zardoshti, nima.zardoshti@cern.ch
 /////////////////////////////////////////////////////////////
 
+#include <string>
+#include <vector>
 #include <TTree.h>
 #include "AliAODTrack.h"
 #include "AliPIDResponse.h"
@@ -101,6 +103,7 @@ class AliHFTreeHandler : public TObject
         fCandType=0;
       }
       else {      
+        if(!fColumnPrecision.empty()) ApplyColumnPrecision();
         fTreeVar->Fill(); 
         fCandType=0;
         fRunNumberPrevCand = fRunNumber;
@@ -173,6 +176,17 @@ class AliHFTreeHandler : public TObject
       fSystNsigmaTPCDataCorr=syst;
     }
 
+    //reduced precision output for float branches (to be set before the first FillTree):
+    //the variable is rounded before each fill to nMantissaBits mantissa bits, or to a fixed-point
+    //grid of 2^nBits values in [min,max] (clamped), so that the baskets of the branch compress better.
+    //compression (e.g. 505 for ZSTD level 5) is applied to the branch if >=0
+    void SetVariablePrecision(TString name, int nMantissaBits, int compression=-1);
+    void SetVariableFixedPoint(TString name, float min, float max, int nBits, int compression=-1);
+    //comma-separated list of "name:nMantissaBits[:compression]" or "name:min:max:nBits[:compression]"
+    void SetVariablePrecisions(TString config);
+    //bytes per candidate (in memory and compressed) for each branch of the tree
+    void PrintColumnSizes() const;
+
   protected:  
     //constant variables
     static const unsigned int knMaxProngs   = 4;
@@ -198,6 +212,17 @@ class AliHFTreeHandler : public TObject
   
     void GetNsigmaTPCMeanSigmaData(float &mean, float &sigma, AliPID::EParticleType species, float pTPC, float eta);
 
+    struct ColumnPrecision {
+      std::string fName; //branch name
+      int fMantissaBits; //mantissa bits kept (<0 for fixed-point)
+      float fMin; //fixed-point range
+      float fMax;
+      int fNBits; //fixed-point bits
+      int fCompression; //branch compression settings (<0 for the file settings)
+      float* fAddress; //address of the variable, set at the first fill
+    };
+    void ApplyColumnPrecision();
+
     TTree* fTreeVar; /// tree with variables
     unsigned int fNProngs; /// number of prongs
     unsigned int fNCandidates; /// number of candidates in one fill (event)
@@ -296,9 +321,11 @@ class AliHFTreeHandler : public TObject
     Double_t fSoftDropZCut; //soft drop z parameter
     Double_t fSoftDropBeta; //soft drop beta  parameter
     Double_t fTrackingEfficiency;
+    std::vector<ColumnPrecision> fColumnPrecision; //! reduced precision branches
+    bool fColumnPrecisionResolved; //! branch addresses and compression set
 
   /// \cond CLASSIMP
-  ClassDef(AliHFTreeHandler,9); ///
+  ClassDef(AliHFTreeHandler,10); ///
   /// \endcond
 };
 #endif
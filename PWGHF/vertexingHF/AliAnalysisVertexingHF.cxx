@@ -70,6 +70,7 @@
 #include "AliCodeTimer.h"
 #include "AliMultSelection.h"
 #include <cstring>
+#include <vector>
 
 /// \cond CLASSIMP
 ClassImp(AliAnalysisVertexingHF);
@@ -153,6 +154,8 @@ fOKInvMassD0to4p(kFALSE),
 fOKInvMassLctoV0(kFALSE),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
+fn2ProngVtxFitsTotal(0),
+fn2ProngPreselRejTotal(0),
 fMakeReducedRHF(kFALSE),
 fMassDzero(0.),
 fMassDplus(0.),
@@ -252,6 +255,8 @@ fOKInvMassD0to4p(source.fOKInvMassD0to4p),
 fOKInvMassLctoV0(source.fOKInvMassLctoV0),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
+fn2ProngVtxFitsTotal(0),
+fn2ProngPreselRejTotal(0),
 fMakeReducedRHF(kFALSE),
 fMassDzero(source.fMassDzero),
 fMassDplus(source.fMassDplus),
@@ -571,7 +576,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliESDtrack *negtrack1 = 0;
   AliESDtrack *negtrack2 = 0;
   AliESDtrack *trackPi   = 0;
-  Double_t mompos1[3],mompos2[3],momneg1[3],momneg2[3];
+  Double_t mompos1[3],momneg1[3];
   Float_t dcaMax = fCutsD0toKpi->GetDCACut();
   if(fCutsJpsitoee) dcaMax=TMath::Max(dcaMax,fCutsJpsitoee->GetDCACut());
   if(fCutsDplustoKpipi) dcaMax=TMath::Max(dcaMax,fCutsDplustoKpipi->GetDCACut());
@@ -629,6 +634,15 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // momenta at the primary vertex of the selected tracks, for the invariant
+  // mass preselections ahead of the track-to-track DCAs and of the vertexing
+  std::vector<Double_t> pxAtVtx(nSeleTrks),pyAtVtx(nSeleTrks),pzAtVtx(nSeleTrks);
+  for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+    Double_t momAtVtx[3];
+    ((AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrk))->GetPxPyPz(momAtVtx);
+    pxAtVtx[iTrk]=momAtVtx[0]; pyAtVtx[iTrk]=momAtVtx[1]; pzAtVtx[iTrk]=momAtVtx[2];
+  }
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -875,6 +889,20 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
       negtrack1->GetPxPyPz(momneg1);
 
+      // pairs used only for 2 prong candidates: invariant mass and pt
+      // preselection ahead of the track-to-track DCA and of the vertexing
+      if(fMassCutBeforeVertexing &&
+	 ((!f3Prong && !f4Prong) || (isLikeSign2Prong && !f3Prong))) {
+	Double_t pxDau[2]={pxAtVtx[iTrkP1],pxAtVtx[iTrkN1]};
+	Double_t pyDau[2]={pyAtVtx[iTrkP1],pyAtVtx[iTrkN1]};
+	Double_t pzDau[2]={pzAtVtx[iTrkP1],pzAtVtx[iTrkN1]};
+	if(!PreselectInvMassAndPt2prong(pxDau,pyDau,pzDau)) {
+	  fn2ProngPreselRejTotal++;
+	  negtrack1=0;
+	  continue;
+	}
+      }
+
       // DCA between the two tracks
       dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
       if(dcap1n1>dcaMax) { negtrack1=0; continue; }
@@ -882,6 +910,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       // Vertexing
       twoTrackArray1->AddAt(postrack1,0);
       twoTrackArray1->AddAt(negtrack1,1);
+      fn2ProngVtxFitsTotal++;
       AliAODVertex *vertexp1n1 = ReconstructSecondaryVertex(twoTrackArray1,dispersion);
       if(!vertexp1n1) {
 	twoTrackArray1->Clear();
@@ -1129,6 +1158,19 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  if(!TESTBIT(seleFlags[iTrkP1],kBitKaonCompat) &&
 	     !TESTBIT(seleFlags[iTrkP2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
 	}
+	// check invariant mass cuts for D+,Ds,Lc (before the track-to-track DCAs)
+	massCutOK=kTRUE;
+	if(f3Prong && fMassCutBeforeVertexing){
+	  Double_t pxDau[3]={mompos1[0],momneg1[0],pxAtVtx[iTrkP2]};
+	  Double_t pyDau[3]={mompos1[1],momneg1[1],pyAtVtx[iTrkP2]};
+	  Double_t pzDau[3]={mompos1[2],momneg1[2],pzAtVtx[iTrkP2]};
+	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
+	  if(!massCutOK && !f4Prong) {
+	    postrack2=0;
+	    continue;
+	  }
+	}
+
 	// back to primary vertex
 	//	postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	//	postrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1144,8 +1186,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
 	if(f3Prong) {
 	  if(postrack2->Charge()>0) {
 	    threeTrackArray->AddAt(postrack1,0);
@@ -1156,22 +1196,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    threeTrackArray->AddAt(postrack1,1);
 	    threeTrackArray->AddAt(postrack2,2);
 	  }
-	  if(fMassCutBeforeVertexing){
-	    postrack2->GetPxPyPz(mompos2);
-	    Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
-	    Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
-	    Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
-	    //	    massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	    massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	  }
-	}
-
-	if(f3Prong && !massCutOK) {
-	  threeTrackArray->Clear();
-	  if(!f4Prong) {
-	    postrack2=0;
-	    continue;
-	  }
+	  if(!massCutOK) threeTrackArray->Clear();
 	}
 
 	// Vertexing
@@ -1267,6 +1292,14 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 		 evtNumber[iTrkN1]==evtNumber[iTrkP2]) continue;
 	    }
 
+	    // check invariant mass cuts for D0 (before the track-to-track DCAs)
+	    if(fMassCutBeforeVertexing) {
+	      Double_t pxDau[4]={pxAtVtx[iTrkP1],pxAtVtx[iTrkN1],pxAtVtx[iTrkP2],pxAtVtx[iTrkN2]};
+	      Double_t pyDau[4]={pyAtVtx[iTrkP1],pyAtVtx[iTrkN1],pyAtVtx[iTrkP2],pyAtVtx[iTrkN2]};
+	      Double_t pzDau[4]={pzAtVtx[iTrkP1],pzAtVtx[iTrkN1],pzAtVtx[iTrkP2],pzAtVtx[iTrkN2]};
+	      if(!SelectInvMassAndPt4prong(pxDau,pyDau,pzDau)) { negtrack2=0; continue; }
+	    }
+
 	    // back to primary vertex
 	    // postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	    // postrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1288,17 +1321,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    fourTrackArray->AddAt(postrack2,2);
 	    fourTrackArray->AddAt(negtrack2,3);
 
-	    // check invariant mass cuts for D0
-	    massCutOK=kTRUE;
-	    if(fMassCutBeforeVertexing)
-	      massCutOK = SelectInvMassAndPt4prong(fourTrackArray);
-
-	    if(!massCutOK) {
-	      fourTrackArray->Clear();
-	      negtrack2=0;
-	      continue;
-	    }
-
 	    // Vertexing
 	    AliAODVertex* secVert4PrAOD = ReconstructSecondaryVertex(fourTrackArray,dispersion);
 	    io4Prong = Make4Prong(fourTrackArray,event,secVert4PrAOD,vertexp1n1,vertexp1n1p2,dcap1n1,dcap1n2,dcap2n1,dcap2n2,ok4Prong);
@@ -1401,6 +1423,14 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	     !TESTBIT(seleFlags[iTrkN2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
 	}
 
+	// check invariant mass cuts for D+,Ds,Lc (before the track-to-track DCAs)
+	if(fMassCutBeforeVertexing && f3Prong){
+	  Double_t pxDau[3]={momneg1[0],mompos1[0],pxAtVtx[iTrkN2]};
+	  Double_t pyDau[3]={momneg1[1],mompos1[1],pyAtVtx[iTrkN2]};
+	  Double_t pzDau[3]={momneg1[2],mompos1[2],pzAtVtx[iTrkN2]};
+	  if(!SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus)) { negtrack2=0; continue; }
+	}
+
 	// back to primary vertex
 	// postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	// negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1419,22 +1449,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	threeTrackArray->AddAt(postrack1,1);
 	threeTrackArray->AddAt(negtrack2,2);
 
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
-	if(fMassCutBeforeVertexing && f3Prong){
-	  negtrack2->GetPxPyPz(momneg2);
-	  Double_t pxDau[3]={momneg1[0],mompos1[0],momneg2[0]};
-	  Double_t pyDau[3]={momneg1[1],mompos1[1],momneg2[1]};
-	  Double_t pzDau[3]={momneg1[2],mompos1[2],momneg2[2]};
-	  //	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	}
-	if(!massCutOK) {
-	  threeTrackArray->Clear();
-	  negtrack2=0;
-	  continue;
-	}
-
 	// Vertexing
 	twoTrackArray2->AddAt(postrack1,0);
 	twoTrackArray2->AddAt(negtrack2,1);
@@ -1548,6 +1562,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 
   //printf("Trks: total %d  sele %d\n",fnTrksTotal,fnSeleTrksTotal);
+  AliDebug(1,Form(" 2 prong vertex fits: %d, pairs rejected before the vertexing: %d",fn2ProngVtxFitsTotal,fn2ProngPreselRejTotal));
 
   return;
 }
@@ -3110,6 +3125,72 @@ Bool_t AliAnalysisVertexingHF::SelectInvMassAndPtCascade(TObjArray *trkArray){
   return retval;
 }
 //-----------------------------------------------------------------------------
+static Bool_t InvMass2RangeOverlaps(Double_t pt1,Double_t pz1,Double_t p1sq,
+				    Double_t pt2,Double_t pz2,Double_t p2sq,
+				    Double_t m1,Double_t m2,
+				    Double_t lolim,Double_t hilim){
+  /// True if the invariant mass of two tracks with transverse momenta pt1,pt2,
+  /// longitudinal momenta pz1,pz2 and masses m1,m2 passes the cut of the
+  /// SelectInvMassAndPt methods (lolim^2 < minv2 < hilim^2) for at least one
+  /// azimuthal opening angle, with a small margin for the rounding
+  const Double_t kTolerance=1.e-6; // GeV^2
+  Double_t e1e2=TMath::Sqrt((p1sq+m1*m1)*(p2sq+m2*m2));
+  Double_t minv2min=m1*m1+m2*m2+2.*(e1e2-pz1*pz2-pt1*pt2);
+  Double_t minv2max=m1*m1+m2*m2+2.*(e1e2-pz1*pz2+pt1*pt2);
+  return minv2max+kTolerance>lolim*lolim && minv2min-kTolerance<hilim*hilim;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::PreselectInvMassAndPt2prong(const Double_t *px,
+							   const Double_t *py,
+							   const Double_t *pz) const {
+  /// Preselection of a pair ahead of the 2 prong vertexing with the mass and
+  /// pt cuts of Make2Prong (D0->Kpi, J/psi->ee and D0 from D*), using the
+  /// momenta at the primary vertex. Make2Prong applies the cuts to the
+  /// momenta at the secondary vertex, which only differ by a rotation in the
+  /// transverse plane (same pt and pz of each track), so the pair is kept if
+  /// the cuts can be passed for any azimuthal opening angle: no candidate
+  /// selected by Make2Prong is rejected here
+  static const Double_t kMassPi=TDatabasePDG::Instance()->GetParticle(211)->Mass();
+  static const Double_t kMassE=TDatabasePDG::Instance()->GetParticle(11)->Mass();
+  const Double_t kTolerance=1.e-6; // GeV
+
+  Double_t pt1=TMath::Sqrt(px[0]*px[0]+py[0]*py[0]);
+  Double_t pt2=TMath::Sqrt(px[1]*px[1]+py[1]*py[1]);
+  Double_t p1sq=pt1*pt1+pz[0]*pz[0];
+  Double_t p2sq=pt2*pt2+pz[1]*pz[1];
+  Double_t ptMax=pt1+pt2+kTolerance;
+  Double_t minPt,mrange;
+
+  if(fD0toKpi) {
+    minPt=fCutsD0toKpi->GetMinPtCandidate();
+    if(minPt<=0.1 || ptMax>=minPt) {
+      // the pt bin of the mass cut depends on the opening angle: all bins
+      for(Int_t iPtBin=0; iPtBin<TMath::Max(1,fCutsD0toKpi->GetNPtBins()); iPtBin++) {
+	mrange=fCutsD0toKpi->GetMassCut(iPtBin);
+	if(InvMass2RangeOverlaps(pt1,pz[0],p1sq,pt2,pz[1],p2sq,kMassPi,fMassK,fMassDzero-mrange,fMassDzero+mrange) ||
+	   InvMass2RangeOverlaps(pt1,pz[0],p1sq,pt2,pz[1],p2sq,fMassK,kMassPi,fMassDzero-mrange,fMassDzero+mrange)) return kTRUE;
+      }
+    }
+  }
+  if(fJPSItoEle) {
+    minPt=fCutsJpsitoee->GetMinPtCandidate();
+    if(minPt<=0.1 || ptMax>=minPt) {
+      mrange=fCutsJpsitoee->GetMassCut();
+      if(InvMass2RangeOverlaps(pt1,pz[0],p1sq,pt2,pz[1],p2sq,kMassE,kMassE,fMassJpsi-mrange,fMassJpsi+mrange)) return kTRUE;
+    }
+  }
+  if(fDstar) {
+    minPt=fCutsDStartoKpipi->GetMinPtCandidate();
+    if(minPt<=0.1 || ptMax>=minPt) {
+      for(Int_t iPtBin=0; iPtBin<TMath::Max(1,fCutsDStartoKpipi->GetNPtBins()); iPtBin++) {
+	mrange=fCutsDStartoKpipi->GetMassCut(iPtBin);
+	if(InvMass2RangeOverlaps(pt1,pz[0],p1sq,pt2,pz[1],p2sq,kMassPi,fMassDzero,fMassDstar-mrange,fMassDstar+mrange)) return kTRUE;
+      }
+    }
+  }
+  return kFALSE;
+}
+//-----------------------------------------------------------------------------
 Bool_t AliAnalysisVertexingHF::SelectInvMassAndPtD0Kpi(Double_t *px,
 						       Double_t *py,
 						       Double_t *pz){
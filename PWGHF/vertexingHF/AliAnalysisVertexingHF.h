@@ -179,6 +179,8 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetCutsDStartoKpipi(AliRDHFCutsDStartoKpipi* cuts) { fCutsDStartoKpipi = cuts; }
   AliRDHFCutsDStartoKpipi* GetCutsDStartoKpipi() const { return fCutsDStartoKpipi; }
   void SetMassCutBeforeVertexing(Bool_t flag) { fMassCutBeforeVertexing=flag; }
+  Int_t Get2ProngVertexFits() const { return fn2ProngVtxFitsTotal; }
+  Int_t Get2ProngPairsRejectedBeforeVertexing() const { return fn2ProngPreselRejTotal; }
 
   void SetMasses();
   Bool_t CheckCutsConsistency();
@@ -344,6 +346,8 @@ class AliAnalysisVertexingHF : public TNamed {
 
   Int_t  fnTrksTotal;
   Int_t  fnSeleTrksTotal;
+  Int_t  fn2ProngVtxFitsTotal;   /// number of 2 prong vertex fits
+  Int_t  fn2ProngPreselRejTotal; /// pairs rejected by PreselectInvMassAndPt2prong
   Bool_t fMakeReducedRHF;// switch the reduction of dAOD size on/off
 
   Double_t fMassDzero;
@@ -405,6 +409,7 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t SelectInvMassAndPt3prong(Double_t *px,Double_t *py,Double_t *pz, Int_t pidLcStatus=3);
   Bool_t SelectInvMassAndPt4prong(Double_t *px,Double_t *py,Double_t *pz);
   Bool_t SelectInvMassAndPtD0Kpi(Double_t *px,Double_t *py,Double_t *pz);
+  Bool_t PreselectInvMassAndPt2prong(const Double_t *px,const Double_t *py,const Double_t *pz) const;
   Bool_t SelectInvMassAndPtJpsiee(Double_t *px,Double_t *py,Double_t *pz);
   Bool_t SelectInvMassAndPtDstarD0pi(Double_t *px,Double_t *py,Double_t *pz);
   Bool_t SelectInvMassAndPtCascade(Double_t *px,Double_t *py,Double_t *pz);
@@ -429,7 +434,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,30);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,31);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
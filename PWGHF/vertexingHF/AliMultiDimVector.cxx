@@ -546,9 +546,16 @@ void AliMultiDimVector::Integrate(){
     AliError("MultiDimVector already integrated");
     return;
   }
-  TArrayF integral(fNTotCells);
-  for(ULong64_t i=0;i<fNTotCells;i++) integral[i]=CountsAboveCell(i);
-  for(ULong64_t i=0;i<fNTotCells;i++) fVett[i]= integral[i];
+  // cumulative sums over the cells above, one variable at a time: walking
+  // the cells backwards, the next cell along the variable is already summed
+  ULong64_t stride=fNPtBins;
+  for(Int_t iVar=fNVariables-1; iVar>=0; iVar--){
+    const ULong64_t nSteps=fNCutSteps[iVar];
+    for(ULong64_t i=fNTotCells; i-->0;){
+      if((i/stride)%nSteps < nSteps-1) fVett[i]+=fVett[i+stride];
+    }
+    stride*=nSteps;
+  }
   fIsIntegrated=kTRUE;
 }//_____________________________________________________________________________ 
 ULong64_t* AliMultiDimVector::GetGlobalAddressesAboveCuts(const Float_t *values, Int_t ptbin, Int_t& nVals) const{
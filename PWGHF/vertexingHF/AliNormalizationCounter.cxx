@@ -46,6 +46,12 @@
 ClassImp(AliNormalizationCounter);
 /// \endcond
 
+const char* AliNormalizationCounter::fgkCounterTypeNames[AliNormalizationCounter::kNCounterTypes]={
+  "triggered","V0AND","PileUp","PbPbC0SMH-B-NOPF-ALLNOTRD","Candles0.3","PrimaryV",
+  "countForNorm","noPrimaryV","zvtxGT10","!V0A&Candle03","!V0A&PrimaryV",
+  "Candid(Filter)","Candid(Analysis)","NCandid(Filter)","NCandid(Analysis)"
+};
+
 //____________________________________________
 AliNormalizationCounter::AliNormalizationCounter(): 
 TNamed(),
@@ -61,7 +67,15 @@ fHistTrackFilterSpdMult(0),
 fHistTrackAnaSpdMult(0),
 fHistGenVertexZ(0),
 fHistGenVertexZRecoPV(0),
-fHistRecoVertexZ(0)
+fHistRecoVertexZ(0),
+fUseFastCounters(kTRUE),
+fFastRun(),
+fFastMult(),
+fFastSph(),
+fFastCounts(),
+fFastIndex(),
+fLastKey(-1),
+fLastSlot(-1)
 {
   // empty constructor
 }
@@ -81,7 +95,15 @@ fHistTrackFilterSpdMult(0),
 fHistTrackAnaSpdMult(0),
 fHistGenVertexZ(0),
 fHistGenVertexZRecoPV(0),
-fHistRecoVertexZ(0)
+fHistRecoVertexZ(0),
+fUseFastCounters(kTRUE),
+fFastRun(),
+fFastMult(),
+fFastSph(),
+fFastCounts(),
+fFastIndex(),
+fLastKey(-1),
+fLastSlot(-1)
 {
   ;
 }
@@ -115,7 +137,9 @@ AliNormalizationCounter::~AliNormalizationCounter()
 void AliNormalizationCounter::Init()
 {
   //variables initialization
-  fCounters.AddRubric("Event","triggered/V0AND/PileUp/PbPbC0SMH-B-NOPF-ALLNOTRD/Candles0.3/PrimaryV/countForNorm/noPrimaryV/zvtxGT10/!V0A&Candle03/!V0A&PrimaryV/Candid(Filter)/Candid(Analysis)/NCandid(Filter)/NCandid(Analysis)");
+  TString eventKeys=fgkCounterTypeNames[0];
+  for(Int_t i=1;i<kNCounterTypes;i++) eventKeys+=Form("/%s",fgkCounterTypeNames[i]);
+  fCounters.AddRubric("Event",eventKeys.Data());
   if(fMultiplicity)  fCounters.AddRubric("Multiplicity", 5000);
   if(fSpherocity)  fCounters.AddRubric("Spherocity", (Int_t)fSpherocitySteps+1);
   fCounters.AddRubric("Run", 1000000);
@@ -135,6 +159,7 @@ void AliNormalizationCounter::Init()
   fHistGenVertexZ=new TH1F("hGenVertexZ","generated z vertex ; z_{vertex}^{MC} (cm) ; counts",600,-30,30);
   fHistGenVertexZRecoPV=new TH1F("hGenVertexZRecoPV","generated z vertex (events with reconstructed vertex); z_{vertex}^{MC} (cm) ; counts",600,-30,30);
   fHistRecoVertexZ=new TH1F("hRecoVertexZ","reconstructed z vertex; z_{vertex}^{rec} (cm) ; counts",600,-30,30);
+  ResetFastCounters();
 }
 
 //______________________________________________
@@ -162,6 +187,7 @@ Long64_t AliNormalizationCounter::Merge(TCollection* list){
 //_______________________________________
 void AliNormalizationCounter::Add(const AliNormalizationCounter *norm){
   fCounters.Add(&(norm->fCounters));
+  AddFast(norm);
   fHistTrackFilterEvMult->Add(norm->fHistTrackFilterEvMult);
   fHistTrackAnaEvMult->Add(norm->fHistTrackAnaEvMult);
   fHistTrackFilterSpdMult->Add(norm->fHistTrackFilterSpdMult);
@@ -202,7 +228,7 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   //event must be either physics or MC
   if(!(event->GetEventType() == 7||event->GetEventType() == 0))return;
   
-  FillCounters("triggered",runNumber,multiplicity,spherocity);
+  FillCounters(kTriggered,runNumber,multiplicity,spherocity);
 
   //Find V0AND
   AliTriggerAnalysis trAn; /// Trigger Analysis
@@ -213,7 +239,7 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
     v0B = trAn.IsOfflineTriggerFired(eventESD , AliTriggerAnalysis::kV0C);
     v0A = trAn.IsOfflineTriggerFired(eventESD , AliTriggerAnalysis::kV0A);
   }
-  if(v0A&&v0B) FillCounters("V0AND",runNumber,multiplicity,spherocity);
+  if(v0A&&v0B) FillCounters(kV0AND,runNumber,multiplicity,spherocity);
   
   //FindPrimary vertex  
   // AliVVertex *vtrc =  (AliVVertex*)event->GetPrimaryVertex();
@@ -226,30 +252,30 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   AliAODEvent *eventAOD = (AliAODEvent*)event;
   TString trigclass=eventAOD->GetFiredTriggerClasses();
   if(trigclass.Contains("C0SMH-B-NOPF-ALLNOTRD")||trigclass.Contains("C0SMH-B-NOPF-ALL")){
-    FillCounters("PbPbC0SMH-B-NOPF-ALLNOTRD",runNumber,multiplicity,spherocity);
+    FillCounters(kPbPbC0SMH,runNumber,multiplicity,spherocity);
   }
 
   //FindPrimary vertex  
   if(isEventSelected){
-    FillCounters("PrimaryV",runNumber,multiplicity,spherocity);
+    FillCounters(kPrimaryV,runNumber,multiplicity,spherocity);
     flagPV=kTRUE;
   }else{
     if(rdCut->GetWhyRejection()==0){
-      FillCounters("noPrimaryV",runNumber,multiplicity,spherocity);
+      FillCounters(kNoPrimaryV,runNumber,multiplicity,spherocity);
     }
     //find good vtx outside range
     if(rdCut->GetWhyRejection()==6){
-      FillCounters("zvtxGT10",runNumber,multiplicity,spherocity);
-      FillCounters("PrimaryV",runNumber,multiplicity,spherocity);
+      FillCounters(kZvtxGT10,runNumber,multiplicity,spherocity);
+      FillCounters(kPrimaryV,runNumber,multiplicity,spherocity);
       flagPV=kTRUE;
     }
     if(rdCut->GetWhyRejection()==1){
-      FillCounters("PileUp",runNumber,multiplicity,spherocity);
+      FillCounters(kPileUp,runNumber,multiplicity,spherocity);
     }
   }
   //to be counted for normalization
   if(rdCut->CountEventForNormalization()){
-    FillCounters("countForNorm",runNumber,multiplicity,spherocity);
+    FillCounters(kCountForNorm,runNumber,multiplicity,spherocity);
   }
   // fill histograms of vertex position
   if(mc){
@@ -270,17 +296,17 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   for(Int_t i=0;i<trkEntries&&!flag03;i++){
     AliAODTrack *track=(AliAODTrack*)event->GetTrack(i);
     if((track->Pt()>0.3)&&(!flag03)){
-      FillCounters("Candles0.3",runNumber,multiplicity,spherocity);
+      FillCounters(kCandles03,runNumber,multiplicity,spherocity);
       flag03=kTRUE;
       break;
     }
   }
   
   if(!(v0A&&v0B)&&(flag03)){ 
-    FillCounters("!V0A&Candle03",runNumber,multiplicity,spherocity);
+    FillCounters(kNotV0AandCandle03,runNumber,multiplicity,spherocity);
   }
   if(!(v0A&&v0B)&&flagPV){
-    FillCounters("!V0A&PrimaryV",runNumber,multiplicity,spherocity);
+    FillCounters(kNotV0AandPrimaryV,runNumber,multiplicity,spherocity);
   }
   
   return;
@@ -308,34 +334,20 @@ void AliNormalizationCounter::StoreCandidates(AliVEvent *event,Int_t nCand,Bool_
   Int_t runNumber = event->GetRunNumber();
   Int_t multiplicity = Multiplicity(event);
   if(nCand==0)return;
+  // candidate counters carry no spherocity keyword
   if(flagFilter){
-    if(fMultiplicity) 
-      fCounters.Count(Form("Event:Candid(Filter)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-    else 
-      fCounters.Count(Form("Event:Candid(Filter)/Run:%d",runNumber));
-    for(Int_t i=0;i<nCand;i++){ 
-      if(fMultiplicity) 
-	fCounters.Count(Form("Event:NCandid(Filter)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-      else 
-	fCounters.Count(Form("Event:NCandid(Filter)/Run:%d",runNumber));
-    }
+    Count(kCandidFilter,runNumber,multiplicity,0);
+    Count(kNCandidFilter,runNumber,multiplicity,0,nCand);
   }else{
-    if(fMultiplicity) 
-      fCounters.Count(Form("Event:Candid(Analysis)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-    else
-      fCounters.Count(Form("Event:Candid(Analysis)/Run:%d",runNumber));
-    for(Int_t i=0;i<nCand;i++){ 
-      if(fMultiplicity) 
-	fCounters.Count(Form("Event:NCandid(Analysis)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-      else
-	fCounters.Count(Form("Event:NCandid(Analysis)/Run:%d",runNumber));
-    }
+    Count(kCandidAnalysis,runNumber,multiplicity,0);
+    Count(kNCandidAnalysis,runNumber,multiplicity,0,nCand);
   }
   return;
 }
 //_______________________________________________________________________
 TH1D* AliNormalizationCounter::DrawAgainstRuns(TString candle,Bool_t drawHist){
   //
+  SyncCounters();
   fCounters.SortRubric("Run");
   TString selection;
   selection.Form("event:%s",candle.Data());
@@ -365,10 +377,12 @@ TH1D* AliNormalizationCounter::DrawRatio(TString candle1,TString candle2){
 }
 //___________________________________________________________________________
 void AliNormalizationCounter::PrintRubrics(){
+  SyncCounters();
   fCounters.PrintKeyWords();
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetSum(TString candle){
+  SyncCounters();
   TString selection="event:";
   selection.Append(candle);
   return fCounters.GetSum(selection.Data());
@@ -400,6 +414,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(){
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t runnumber){
+  SyncCounters();
   TString listofruns = fCounters.GetKeyWords("RUN");
   if(!listofruns.Contains(Form("%d",runnumber))){
     printf("WARNING: %d is not a valid run number\n",runnumber);
@@ -417,6 +432,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t runnumber){
 
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t maxmultiplicity){
+  SyncCounters();
 
   if(!fMultiplicity) {
     AliInfo("Sorry, you didn't activate the multiplicity in the counter!");
@@ -448,6 +464,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t maxmultiplicity, Double_t minspherocity, Double_t maxspherocity){
+  SyncCounters();
 
   if(!fMultiplicity || !fSpherocity) {
     AliInfo("You must activate both multiplicity and spherocity in the counters to use this method!");
@@ -489,6 +506,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t
 
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNormSpheroOnly(Double_t minspherocity, Double_t maxspherocity){
+  SyncCounters();
 
   if(!fSpherocity) {
     AliInfo("Sorry, you didn't activate the sphericity in the counter!");
@@ -524,6 +542,7 @@ Double_t AliNormalizationCounter::GetNEventsForNormSpheroOnly(Double_t minsphero
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetSum(TString candle,Int_t minmultiplicity, Int_t maxmultiplicity){
+  SyncCounters();
   // counts events of given type in a given multiplicity range
 
   if(!fMultiplicity) {
@@ -549,6 +568,7 @@ Double_t AliNormalizationCounter::GetSum(TString candle,Int_t minmultiplicity, I
 //___________________________________________________________________________
 TH1D* AliNormalizationCounter::DrawNEventsForNorm(Bool_t drawRatio){
   //usare algebra histos
+  SyncCounters();
   fCounters.SortRubric("Run");
   TString selection;
 
@@ -603,17 +623,119 @@ Int_t AliNormalizationCounter::Multiplicity(AliVEvent* event){
 }
 
 //___________________________________________________________________________
-void AliNormalizationCounter::FillCounters(TString name, Int_t runNumber, Int_t multiplicity, Double_t spherocity){
-
+void AliNormalizationCounter::FillCounters(ECounterType type, Int_t runNumber, Int_t multiplicity, Double_t spherocity){
 
   Int_t sphToInteger=spherocity*fSpherocitySteps;
-  if(fMultiplicity  && !fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Multiplicity:%d",name.Data(),runNumber,multiplicity));
-  else if(fMultiplicity  && fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Multiplicity:%d/Spherocity:%d",name.Data(),runNumber,multiplicity,sphToInteger));
-  else if(!fMultiplicity  && fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Spherocity:%d",name.Data(),runNumber,sphToInteger));
-  else 
-    fCounters.Count(Form("Event:%s/Run:%d",name.Data(),runNumber));
+  Count(type,runNumber,multiplicity,sphToInteger);
   return;
 }
+
+//___________________________________________________________________________
+TString AliNormalizationCounter::CounterKey(Int_t type, Int_t runNumber, Int_t multiplicity, Int_t sphToInteger) const {
+  /// key of the AliCounterCollection for a given event class and cell
+
+  TString key;
+  key.Form("Event:%s/Run:%d",fgkCounterTypeNames[type],runNumber);
+  if(fMultiplicity) key+=Form("/Multiplicity:%d",multiplicity);
+  if(fSpherocity && type<kCandidFilter) key+=Form("/Spherocity:%d",sphToInteger);
+  return key;
+}
+
+//___________________________________________________________________________
+void AliNormalizationCounter::Count(ECounterType type, Int_t runNumber, Int_t multiplicity, Int_t sphToInteger, Int_t value){
+  /// increment the counter of a given event class.
+  /// With fUseFastCounters the (run, multiplicity, spherocity) cell is looked up
+  /// through an integer hash and the count is stored in a dense array; the
+  /// string keys are built only when the counters are queried (SyncCounters)
+
+  Int_t slot=-1;
+  if(fUseFastCounters) slot=GetFastSlot(runNumber,multiplicity,sphToInteger);
+  if(slot<0){
+    fCounters.Count(CounterKey(type,runNumber,multiplicity,sphToInteger),value);
+    return;
+  }
+  fFastCounts[slot*kNCounterTypes+type]+=value;
+}
+
+//___________________________________________________________________________
+Int_t AliNormalizationCounter::GetFastSlot(Int_t runNumber, Int_t multiplicity, Int_t sphToInteger){
+  /// index of the fast-counter cell for (run, multiplicity, spherocity), created if needed.
+  /// Returns -1 for values that do not fit in the packed key (string path is used then)
+
+  if(!fMultiplicity) multiplicity=0;
+  if(!fSpherocity) sphToInteger=0;
+  if(multiplicity<-32768 || multiplicity>32767 || sphToInteger<-32768 || sphToInteger>32767) return -1;
+  Long64_t key=((Long64_t)(UInt_t)runNumber<<32) | ((Long64_t)(UShort_t)multiplicity<<16) | (Long64_t)(UShort_t)sphToInteger;
+  if(key==fLastKey) return fLastSlot;
+
+  // index is transient: rebuild it after reading from file or merging
+  if(fFastIndex.size()!=fFastRun.size()){
+    fFastIndex.clear();
+    for(UInt_t i=0;i<fFastRun.size();i++){
+      Long64_t k=((Long64_t)(UInt_t)fFastRun[i]<<32) | ((Long64_t)(UShort_t)fFastMult[i]<<16) | (Long64_t)(UShort_t)fFastSph[i];
+      fFastIndex[k]=i;
+    }
+  }
+
+  Int_t slot;
+  std::unordered_map<Long64_t,Int_t>::const_iterator it=fFastIndex.find(key);
+  if(it!=fFastIndex.end()){
+    slot=it->second;
+  }else{
+    slot=fFastRun.size();
+    fFastRun.push_back(runNumber);
+    fFastMult.push_back(multiplicity);
+    fFastSph.push_back(sphToInteger);
+    fFastCounts.resize(fFastCounts.size()+kNCounterTypes,0);
+    fFastIndex[key]=slot;
+  }
+  fLastKey=key;
+  fLastSlot=slot;
+  return slot;
+}
+
+//___________________________________________________________________________
+void AliNormalizationCounter::AddFast(const AliNormalizationCounter *norm){
+  /// add the fast counters of another object (used in Merge)
+
+  if(norm->fFastRun.empty()) return;
+  if(!fUseFastCounters){
+    for(UInt_t i=0;i<norm->fFastRun.size();i++){
+      for(Int_t j=0;j<kNCounterTypes;j++){
+        Int_t value=norm->fFastCounts[i*kNCounterTypes+j];
+        if(value) fCounters.Count(CounterKey(j,norm->fFastRun[i],norm->fFastMult[i],norm->fFastSph[i]),value);
+      }
+    }
+    return;
+  }
+  for(UInt_t i=0;i<norm->fFastRun.size();i++){
+    Int_t slot=GetFastSlot(norm->fFastRun[i],norm->fFastMult[i],norm->fFastSph[i]);
+    for(Int_t j=0;j<kNCounterTypes;j++) fFastCounts[slot*kNCounterTypes+j]+=norm->fFastCounts[i*kNCounterTypes+j];
+  }
+}
+
+//___________________________________________________________________________
+void AliNormalizationCounter::SyncCounters(){
+  /// move the content of the fast counters into fCounters, so that
+  /// the AliCounterCollection based queries see all the entries
+
+  if(fFastRun.empty()) return;
+  for(UInt_t i=0;i<fFastRun.size();i++){
+    for(Int_t j=0;j<kNCounterTypes;j++){
+      Int_t value=fFastCounts[i*kNCounterTypes+j];
+      if(value) fCounters.Count(CounterKey(j,fFastRun[i],fFastMult[i],fFastSph[i]),value);
+    }
+  }
+  ResetFastCounters();
+}
+
+//___________________________________________________________________________
+void AliNormalizationCounter::ResetFastCounters(){
+  fFastRun.clear();
+  fFastMult.clear();
+  fFastSph.clear();
+  fFastCounts.clear();
+  fFastIndex.clear();
+  fLastKey=-1;
+  fLastSlot=-1;
+}
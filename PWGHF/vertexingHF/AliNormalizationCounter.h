@@ -27,6 +27,8 @@
 /// with many thanks to P. Pillot
 /////////////////////////////////////////////////////////////
 
+#include <vector>
+#include <unordered_map>
 #include <TROOT.h>
 #include <TSystem.h>
 #include <TNtuple.h>
@@ -49,15 +51,23 @@ class AliNormalizationCounter : public TNamed
 {
  public:
 
+  /// event classes of the "Event" rubric, in the order they are declared in Init()
+  enum ECounterType {kTriggered, kV0AND, kPileUp, kPbPbC0SMH, kCandles03, kPrimaryV,
+                     kCountForNorm, kNoPrimaryV, kZvtxGT10, kNotV0AandCandle03, kNotV0AandPrimaryV,
+                     kCandidFilter, kCandidAnalysis, kNCandidFilter, kNCandidAnalysis, kNCounterTypes};
+
   AliNormalizationCounter();
   AliNormalizationCounter(const char *name);
   virtual ~AliNormalizationCounter();
   Long64_t Merge(TCollection* list);
 
-  AliCounterCollection* GetCounter(){return &fCounters;}
+  AliCounterCollection* GetCounter(){SyncCounters(); return &fCounters;}
   void Init();
   void Add(const AliNormalizationCounter*);
   void SetESD(Bool_t flag){fESD=flag;}
+  void SetUseFastCounters(Bool_t flag=kTRUE){SyncCounters(); fUseFastCounters=flag;}
+  Bool_t GetUseFastCounters() const {return fUseFastCounters;}
+  void SyncCounters();
   void SetStudyMultiplicity(Bool_t flag, Float_t etaRange){ fMultiplicity=flag; fMultiplicityEtaRange=etaRange; }
   void SetStudySpherocity(Bool_t flag, Double_t nsteps=100.){fSpherocity=flag;
     fSpherocitySteps=nsteps;}
@@ -87,7 +97,14 @@ class AliNormalizationCounter : public TNamed
   AliNormalizationCounter(const AliNormalizationCounter &source);
   AliNormalizationCounter& operator=(const AliNormalizationCounter& source);
   Int_t Multiplicity(AliVEvent* event);
-  void FillCounters(TString name, Int_t runNumber, Int_t multiplicity, Double_t spherocity);
+  void FillCounters(ECounterType type, Int_t runNumber, Int_t multiplicity, Double_t spherocity);
+  void Count(ECounterType type, Int_t runNumber, Int_t multiplicity, Int_t sphToInteger, Int_t value=1);
+  TString CounterKey(Int_t type, Int_t runNumber, Int_t multiplicity, Int_t sphToInteger) const;
+  Int_t GetFastSlot(Int_t runNumber, Int_t multiplicity, Int_t sphToInteger);
+  void AddFast(const AliNormalizationCounter *norm);
+  void ResetFastCounters();
+
+  static const char* fgkCounterTypeNames[kNCounterTypes]; /// keywords of the "Event" rubric
 
 
   AliCounterCollection fCounters; /// internal counter
@@ -103,9 +120,17 @@ class AliNormalizationCounter : public TNamed
   TH1F *fHistGenVertexZ;       /// histo of generated z vertex
   TH1F *fHistGenVertexZRecoPV; /// histo of generated z vertex for events with reco vert
   TH1F *fHistRecoVertexZ;      /// histo of reconstructed z vertex
+  Bool_t fUseFastCounters;     /// fill integer-indexed counters and move them to fCounters only when queried/merged
+  std::vector<Int_t> fFastRun;    /// run number of each fast-counter cell
+  std::vector<Int_t> fFastMult;   /// multiplicity of each fast-counter cell
+  std::vector<Int_t> fFastSph;    /// spherocity (x fSpherocitySteps) of each fast-counter cell
+  std::vector<Int_t> fFastCounts; /// dense counts, kNCounterTypes per cell
+  std::unordered_map<Long64_t,Int_t> fFastIndex; //! cell key -> cell index (rebuilt after I/O)
+  Long64_t fLastKey;           //! key of the last accessed cell
+  Int_t fLastSlot;             //! index of the last accessed cell
 
   /// \cond CLASSIMP    
-  ClassDef(AliNormalizationCounter,8);
+  ClassDef(AliNormalizationCounter,9);
   /// \endcond
 };
 #endif
@@ -24,6 +24,10 @@
 //                                                               //
 ///////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
 #include "AliMultiDimVector.h"
 #include "AliSignificanceCalculator.h"
 #include "TMath.h"
@@ -42,7 +46,8 @@ fErrSquareBackground(0),
 fSignificance(0),
 fErrSignificance(0),
 fNormSig(1.),  
-fNormBkg(1.)
+fNormBkg(1.),
+fNThreads(1)
 {
   // default constructor
   fSignal=new AliMultiDimVector();
@@ -57,7 +62,8 @@ fErrSquareBackground(0),
 fSignificance(0),
 fErrSignificance(0),
 fNormSig(normsig),
-fNormBkg(normbkg)
+fNormBkg(normbkg),
+fNThreads(1)
 {
   // standard constructor
   if(fSignal && fBackground) CalculateSignificance();
@@ -71,11 +77,26 @@ fErrSquareBackground(err2bkg),
 fSignificance(0),
 fErrSignificance(0),
 fNormSig(normsig),
-fNormBkg(normbkg)
+fNormBkg(normbkg),
+fNThreads(1)
 {
   // standard constructor
   if(fSignal && fBackground) CalculateSignificance();
 }
+namespace {
+  // runs func(iChunk,first,last) on nThreads chunks of [0,n)
+  void RunInChunks(ULong64_t n, Int_t nThreads, const std::function<void(Int_t,ULong64_t,ULong64_t)>& func){
+    if(nThreads<1) nThreads=1;
+    if((ULong64_t)nThreads>n) nThreads=(n>0 ? n : 1);
+    const ULong64_t chunk=(n+nThreads-1)/nThreads;
+    std::vector<std::thread> threads;
+    for(Int_t iThread=1; iThread<nThreads; iThread++){
+      threads.emplace_back(func,iThread,TMath::Min(n,iThread*chunk),TMath::Min(n,(iThread+1)*chunk));
+    }
+    func(0,0,TMath::Min(n,chunk));
+    for(auto& thread : threads) thread.join();
+  }
+}
 //___________________________________________________________________________
 AliSignificanceCalculator::~AliSignificanceCalculator(){
   // destructor
@@ -104,7 +125,14 @@ void AliSignificanceCalculator::CalculateSignificance(){
   fErrSignificance=new AliMultiDimVector();
   fErrSignificance->CopyStructure(fSignal);
 
-  for(ULong64_t i=0;i<fSignal->GetNTotCells();i++) {
+  RunInChunks(fSignal->GetNTotCells(),fNThreads,[this](Int_t, ULong64_t first, ULong64_t last){CalculateSignificance(first,last);});
+  fSignificance->SetNameTitle("Significance","Significance");
+  fErrSignificance->SetNameTitle("ErrorOnSignificance","ErrorOnSignificance");
+}
+//___________________________________________________________________________
+void AliSignificanceCalculator::CalculateSignificance(ULong64_t first, ULong64_t last){
+  // significance and its error for the cells [first,last)
+  for(ULong64_t i=first;i<last;i++) {
     if(fSignal->GetElement(i)!=-1 && fBackground->GetElement(i)!=-1){
       Float_t s=fSignal->GetElement(i)*fNormSig;
       Float_t b=fBackground->GetElement(i)*fNormBkg;
@@ -125,8 +153,45 @@ void AliSignificanceCalculator::CalculateSignificance(){
       fErrSignificance->SetElement(i,errsig);
     }
   }
-  fSignificance->SetNameTitle("Significance","Significance");
-  fErrSignificance->SetNameTitle("ErrorOnSignificance","ErrorOnSignificance");
+}
+//___________________________________________________________________________
+Int_t AliSignificanceCalculator::GetTopSignificances(Int_t ptbin, Int_t nTop, ULong64_t* globAddr, Float_t* signif, Float_t* errSignif) const {
+  // fills the global addresses, significances and errors of the nTop cut sets
+  // with the highest significance in a pt bin (decreasing significance),
+  // returns the number of cut sets found
+  if(!fSignificance || nTop<=0 || ptbin<0 || ptbin>=fSignificance->GetNPtBins()) return 0;
+  const ULong64_t nPtBins=fSignificance->GetNPtBins();
+  const ULong64_t nCells=fSignificance->GetNTotCells()/nPtBins;
+  Int_t nThreads=TMath::Max(fNThreads,1);
+  if((ULong64_t)nThreads>nCells) nThreads=TMath::Max((Int_t)nCells,1);
+
+  // best cut sets of each chunk, highest significance first (lowest address for equal values)
+  typedef std::pair<Float_t,ULong64_t> Candidate;
+  auto better=[](const Candidate& a, const Candidate& b){return a.first>b.first || (a.first==b.first && a.second<b.second);};
+  std::vector<std::vector<Candidate> > chunkTop(nThreads);
+  RunInChunks(nCells,nThreads,[&](Int_t iChunk, ULong64_t first, ULong64_t last){
+    std::vector<Candidate>& top=chunkTop[iChunk];
+    top.reserve(last-first);
+    for(ULong64_t i=first;i<last;i++){
+      const ULong64_t address=ptbin+i*nPtBins;
+      top.push_back(Candidate(fSignificance->GetElement(address),address));
+    }
+    if(top.size()>(size_t)nTop){
+      std::nth_element(top.begin(),top.begin()+nTop,top.end(),better);
+      top.resize(nTop);
+    }
+  });
+
+  std::vector<Candidate> merged;
+  for(auto& top : chunkTop) merged.insert(merged.end(),top.begin(),top.end());
+  const Int_t nFound=TMath::Min((Int_t)merged.size(),nTop);
+  std::partial_sort(merged.begin(),merged.begin()+nFound,merged.end(),better);
+  for(Int_t i=0;i<nFound;i++){
+    globAddr[i]=merged[i].second;
+    signif[i]=merged[i].first;
+    if(errSignif) errSignif[i]=fErrSignificance->GetElement(merged[i].second);
+  }
+  return nFound;
 }
 //___________________________________________________________________________
 AliMultiDimVector* AliSignificanceCalculator::CalculatePurity() const {
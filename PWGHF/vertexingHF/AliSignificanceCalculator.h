@@ -51,6 +51,7 @@ class AliSignificanceCalculator : public TObject{
     if(fSignal && fBackground) CalculateSignificance();
   }
   
+  void SetNThreads(Int_t nThreads){fNThreads=nThreads;}
   void SetNormalizations(Float_t normSig, Float_t normBkg){
     fNormSig=normSig;
     fNormBkg=normBkg;
@@ -68,6 +69,7 @@ class AliSignificanceCalculator : public TObject{
     if(fSignificance) fSignificance->FindMaximum(sigMax,cutIndices,ptbin);
     return sigMax;
   }
+  Int_t GetTopSignificances(Int_t ptbin, Int_t nTop, ULong64_t* globAddr, Float_t* signif, Float_t* errSignif=0x0) const;
   AliMultiDimVector* CalculatePurity() const;
   AliMultiDimVector* CalculatePurityError() const;
   AliMultiDimVector* CalculateSOverB() const;
@@ -75,6 +77,7 @@ class AliSignificanceCalculator : public TObject{
 
  private:
   Bool_t Check() const;
+  void CalculateSignificance(ULong64_t first, ULong64_t last);
   AliSignificanceCalculator(const AliSignificanceCalculator& c);
   AliSignificanceCalculator& operator=(const AliSignificanceCalculator& c);
 
@@ -86,6 +89,7 @@ class AliSignificanceCalculator : public TObject{
   AliMultiDimVector* fErrSignificance;     /// matrix with error on significance
   Float_t fNormSig;                        /// signal normalization
   Float_t fNormBkg;                        /// background normalization
+  Int_t fNThreads;                         /// threads for the significance calculation and the top significance search
 
   /// \cond CLASSIMP    
   ClassDef(AliSignificanceCalculator,0); /// class to compute and maximise significance
@@ -416,6 +416,10 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	fRingHistos.ls();
 	return false;
       }
+      // Per-strip acceptance and per-eta-bin cuts of this ring 
+      const Double_t* acc    = (q == 0 ? fAccI : fAccO)->GetArray() + 1;
+      const Double_t* lowCut = rh->fLowCutCache.GetArray();
+      const TAxis*    cutEta = fLowCuts->GetXaxis();
       // rh->fPoisson.SetObject(d,r,vtxbin,cent);
       rh->fPoisson.Reset(0);
       rh->fTotal->Reset();
@@ -432,6 +436,10 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 
       // --- Loop over sectors and strips ----------------------------
       for (UShort_t s=0; s<ns; s++) { 
+	// Poisson weights of this sector: <0 not used, 0 empty, >0 hit
+	Double_t poissonW[512];
+	for (UShort_t t=0; t<nt; t++) poissonW[t] = -1;
+
 	for (UShort_t t=0; t<nt; t++) {
 	  
 	  Float_t  mult   = fmd.Multiplicity(d,r,s,t);
@@ -485,18 +493,19 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 
 	  // --- Apply phi corner correction to eloss ----------------
 	  if (fUsePhiAcceptance == kPhiCorrectELoss) 
-	    mult *= AcceptanceCorrection(r,t);
+	    mult *= Float_t(acc[t]);
 
 	  // --- Get the low multiplicity cut ------------------------
 	  Double_t cut  = 1024;
-	  if (eta != AliESDFMD::kInvalidEta) cut = GetMultCut(d, r, eta,false);
+	  if (eta != AliESDFMD::kInvalidEta) 
+	    cut = lowCut[cutEta->FindFixBin(eta)];
 	  else AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
 			   d, r, s, t, eta);
 
 	  // --- Now caluculate Nch for this strip using fits --------
 	  START_TIMER(timer);
 	  Double_t n   = 0;
-	  if (cut > 0 && mult > cut) n = NParticles(mult,d,r,eta,lowFlux);
+	  if (cut > 0 && mult > cut) n = NParticles(mult,rh,eta,lowFlux);
 	  rh->fELoss->Fill(mult);
 	  // rh->fEvsN->Fill(mult,n);
 	  // rh->fEtaVsN->Fill(eta, n);
@@ -507,7 +516,7 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	  // Temporary stuff - remove Correction call 
 	  Double_t c = 1;
 	  if (fUsePhiAcceptance == kPhiCorrectNch) 
-	    c = AcceptanceCorrection(r,t);
+	    c = Float_t(acc[t]);
 	  // Double_t c = Correction(d,r,t,eta,lowFlux);
 	  ADD_TIMER(timer,corrTime);
 	  fCorrections->Fill(c);
@@ -528,12 +537,13 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	    }
 	    rh->fSignal->Fill(eta, mult);
 	  }
-	  rh->fPoisson.Fill(t,s,hit,1./c);
+	  poissonW[t] = (hit ? 1./c : 0);
 	  h->Fill(eta,phi,n);
 
 	  // --- If we use ELoss fits, apply now ---------------------
 	  if (!fUsePoisson) rh->fDensity->Fill(eta,phi,n);
 	} // for t
+	rh->fPoisson.FillRow(s, nt, poissonW);
       } // for s 
 
       // --- Automatic acceptance - Calculate as an efficiency -------
@@ -560,11 +570,13 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       
       // --- Store Poisson result ------------------------------------
       START_TIMER(timer);
-      TH2D* poisson = rh->fPoisson.Result();
+      TH2D*           poisson  = rh->fPoisson.Result();
+      const Double_t* poissonA = poisson->GetArray();
+      Int_t           poissonN = poisson->GetNbinsX()+2;
       for (Int_t t=0; t < poisson->GetNbinsX(); t++) { 
 	for (Int_t s=0; s < poisson->GetNbinsY(); s++) { 
 	  
-	  Double_t poissonV = poisson->GetBinContent(t+1,s+1);
+	  Double_t poissonV = poissonA[(s+1)*poissonN+t+1];
 	  // Use cached eta - since the calls to GetEtaFromStrip and
 	  // GetPhiFromStrip are _very_ expensive
 	  Double_t  phi  = phiCache[s*nt+t];
@@ -771,6 +783,26 @@ AliFMDDensityCalculator::CacheMaxWeights(const TAxis& axis)
 
   // Cache cuts in histogram
   fCuts.FillHistogram(fLowCuts);
+
+  // Per-ring lookup tables, indexed by the eta bin (including under-
+  // and overflow) of fLowCuts, which has the binning of the fits
+  const TArrayI* max[] = { &fFMD1iMax, &fFMD2iMax, &fFMD2oMax, 
+			   &fFMD3iMax, &fFMD3oMax };
+  for (Int_t j = 0; j < 5; j++) { 
+    UShort_t    d  = (j == 0 ? 1 : (j+3)/2);
+    Char_t      r  = (j == 0 || j == 1 || j == 3 ? 'I' : 'O');
+    RingHistos* rh = GetRingHistos(d, r);
+    if (!rh) continue;
+    rh->fLowCutCache.Set(nEta+2);
+    rh->fMaxWeightCache.Set(nEta+2);
+    rh->fFitCache.Clear();
+    rh->fFitCache.Expand(nEta+2);
+    for (Int_t i = 0; i <= nEta+1; i++) { 
+      rh->fLowCutCache[i]    = Rng2Cut(d, r, i, fLowCuts);
+      rh->fMaxWeightCache[i] = (i >= 1 && i <= nEta ? max[j]->At(i-1) : -1);
+      rh->fFitCache.AddAt(cor->FindFit(d, r, i, -1), i);
+    }
+  }
 }
 
 //_____________________________________________________________________
@@ -890,6 +922,59 @@ AliFMDDensityCalculator::NParticles(Float_t  mult,
   return ret;
 }
 
+//_____________________________________________________________________
+Float_t 
+AliFMDDensityCalculator::NParticles(Float_t           mult, 
+				    const RingHistos* rh,
+				    Float_t           eta,
+				    Bool_t            lowFlux) const
+{
+  // 
+  // Get the number of particles corresponding to the signal mult,
+  // using the fits and maximum weights cached for the ring in
+  // CacheMaxWeights.  Same result as NParticles(mult,d,r,eta,lowFlux)
+  // 
+  // Parameters:
+  //    mult     Signal
+  //    rh       Ring histograms and lookup tables 
+  //    eta      Pseudo-rapidity 
+  //    lowFlux  Low-flux flag 
+  // 
+  // Return:
+  //    The number of particles 
+  //
+  if (lowFlux) return 1;
+  
+  Int_t iEta = fLowCuts->GetXaxis()->FindFixBin(eta);
+  AliFMDCorrELossFit::ELossFit* fit = 
+    static_cast<AliFMDCorrELossFit::ELossFit*>(rh->fFitCache.UncheckedAt(iEta));
+  if (!fit) { 
+    AliWarning(Form("No energy loss fit for FMD%d%c at eta=%f qual=%d", 
+		    rh->fDet, rh->fRing, eta, fMinQuality));
+    return 0;
+  }
+  
+  Int_t    m   = rh->fMaxWeightCache[iEta];
+  if (m < 1) { 
+    AliWarning(Form("No good fits for FMD%d%c at eta=%f", 
+		    rh->fDet, rh->fRing, eta));
+    return 0;
+  }
+  
+  UShort_t n   = TMath::Min(fMaxParticles, UShort_t(m));
+  Double_t ret = fit->EvaluateWeighted(mult, n);
+  
+  if (fDebug > 10) {
+    AliInfo(Form("FMD%d%c, eta=%7.4f, %8.5f -> %8.5f", 
+		 rh->fDet, rh->fRing, eta, mult, ret));
+  }
+    
+  fWeightedSum->Fill(ret);
+  fSumOfWeights->Fill(ret);
+  
+  return ret;
+}
+
 //_____________________________________________________________________
 Float_t 
 AliFMDDensityCalculator::Correction(UShort_t d, 
@@ -1265,7 +1350,10 @@ AliFMDDensityCalculator::RingHistos::RingHistos()
     fPhiBefore(0),
     fPhiAfter(0),
     fEtaBefore(0),
-    fEtaAfter(0)
+    fEtaAfter(0),
+    fLowCutCache(),
+    fMaxWeightCache(),
+    fFitCache()
 {
   // 
   // Default CTOR
@@ -1298,7 +1386,10 @@ AliFMDDensityCalculator::RingHistos::RingHistos(UShort_t d, Char_t r)
     fPhiBefore(0),
     fPhiAfter(0),
     fEtaBefore(0),
-    fEtaAfter(0)
+    fEtaAfter(0),
+    fLowCutCache(),
+    fMaxWeightCache(),
+    fFitCache()
 {
   // 
   // Constructor
@@ -1484,7 +1575,10 @@ AliFMDDensityCalculator::RingHistos::RingHistos(const RingHistos& o)
     fPhiBefore(o.fPhiBefore),
     fPhiAfter(o.fPhiAfter),
     fEtaBefore(o.fEtaBefore),
-    fEtaAfter(o.fEtaAfter)
+    fEtaAfter(o.fEtaAfter),
+    fLowCutCache(o.fLowCutCache),
+    fMaxWeightCache(o.fMaxWeightCache),
+    fFitCache(o.fFitCache)
 {
   // 
   // Copy constructor 
@@ -1549,6 +1643,9 @@ AliFMDDensityCalculator::RingHistos::operator=(const RingHistos& o)
   fPhiAfter            = static_cast<TH1D*>(o.fPhiAfter->Clone());
   fEtaBefore           = static_cast<TH1D*>(o.fEtaBefore->Clone());
   fEtaAfter            = static_cast<TH1D*>(o.fEtaAfter->Clone());
+  fLowCutCache         = o.fLowCutCache;
+  fMaxWeightCache      = o.fMaxWeightCache;
+  fFitCache            = o.fFitCache;
   return *this;
 }
 //____________________________________________________________________
@@ -16,6 +16,8 @@
 #include <TNamed.h>
 #include <TList.h>
 #include <TArrayI.h>
+#include <TArrayD.h>
+#include <TObjArray.h>
 #include <TVector3.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
@@ -336,6 +338,22 @@ protected:
 			     Char_t   r, 
 			     Float_t  eta, 
 			     Bool_t   lowFlux) const;
+  struct RingHistos;
+  /** 
+   * Get the number of particles corresponding to the signal mult,
+   * using the lookup tables of the ring filled in CacheMaxWeights
+   * 
+   * @param mult     Signal
+   * @param rh       Ring histograms and lookup tables
+   * @param eta      Pseudo-rapidity 
+   * @param lowFlux  Low-flux flag 
+   * 
+   * @return The number of particles 
+   */
+  Float_t NParticles(Float_t           mult, 
+		     const RingHistos* rh, 
+		     Float_t           eta, 
+		     Bool_t            lowFlux) const;
   /** 
    * Get the inverse correction factor.  This consist of
    * 
@@ -465,6 +483,9 @@ protected:
     TH1D*     fPhiAfter;       // Phi after re-calc
     TH1D*     fEtaBefore;      // Phi before re-calce 
     TH1D*     fEtaAfter;       // Phi after re-calc
+    TArrayD   fLowCutCache;    // Low cut per eta bin (0 to N+1)
+    TArrayI   fMaxWeightCache; // Max weight per eta bin (0 to N+1)
+    TObjArray fFitCache;       // Energy loss fit per eta bin - not owner
     // ClassDef(RingHistos,10);
   };
   /** 
@@ -61,7 +61,11 @@ AliPoissonCalculator::AliPoissonCalculator()
     fEmptyVsTotal(0),
     fMean(0), 
     fOcc(0),
-    fCorr(0)
+    fCorr(0),
+    fXRegion(),
+    fYRegion(),
+    fRegionMean(),
+    fRegionCorr()
 {
   //
   // CTOR
@@ -79,7 +83,11 @@ AliPoissonCalculator::AliPoissonCalculator(const char*)
     fEmptyVsTotal(0),
     fMean(0), 
     fOcc(0),
-    fCorr(0)
+    fCorr(0),
+    fXRegion(),
+    fYRegion(),
+    fRegionMean(),
+    fRegionCorr()
 {
   //
   // CTOR
@@ -96,7 +104,11 @@ AliPoissonCalculator::AliPoissonCalculator(const AliPoissonCalculator& o)
     fEmptyVsTotal(0),
     fMean(0), 
     fOcc(0),
-    fCorr(0)
+    fCorr(0),
+    fXRegion(),
+    fYRegion(),
+    fRegionMean(),
+    fRegionCorr()
 {
   Init();
   Reset(o.fBasic);
@@ -302,6 +314,27 @@ AliPoissonCalculator::Reset(const TH2D* base)
   fEmpty->SetTitle(kEmptyT);
   fEmpty->SetDirectory(0);
   // fEmpty->Sumw2();
+
+  MakeRegionMaps();
+}
+
+//____________________________________________________________________
+void
+AliPoissonCalculator::MakeRegionMaps()
+{
+  // 
+  // Map bins (including under- and overflow) of the full histogram to
+  // the bins of the region histograms
+  // 
+  Int_t nX = fBasic->GetNbinsX() + 2;
+  Int_t nY = fBasic->GetNbinsY() + 2;
+  fXRegion.Set(nX);
+  fYRegion.Set(nY);
+  for (Int_t ix = 0; ix < nX; ix++) fXRegion[ix] = GetReducedXBin(ix);
+  for (Int_t iy = 0; iy < nY; iy++) fYRegion[iy] = GetReducedYBin(iy);
+  Int_t nR = (fEmpty->GetNbinsX() + 2) * (fEmpty->GetNbinsY() + 2);
+  fRegionMean.Set(nR);
+  fRegionCorr.Set(nR);
 }
 
 //____________________________________________________________________
@@ -322,6 +355,57 @@ AliPoissonCalculator::Fill(UShort_t x, UShort_t y, Bool_t hit, Double_t weight)
   else     fEmpty->Fill(x, y);
 }
 
+//____________________________________________________________________
+void
+AliPoissonCalculator::FillRow(UShort_t y, UShort_t n, const Double_t* weight)
+{
+  // 
+  // Fill in the observations of a row
+  // 
+  // Parameters:
+  //    y       Y value 
+  //    n       Number of X values 
+  //    weight  Weights: <0 not used, 0 empty, >0 hit with weight
+  //
+  if (fXRegion.GetSize() != fBasic->GetNbinsX() + 2) MakeRegionMaps();
+  // Weighted fills make the sum of squares in TH1::Fill 
+  if (!fBasic->GetSumw2N()) fBasic->Sumw2();
+
+  Int_t     nXF    = fBasic->GetNbinsX() + 2;
+  Int_t     nXR    = fEmpty->GetNbinsX() + 2;
+  Double_t* basic  = fBasic->GetArray() + (y+1) * nXF + 1;
+  Double_t* basic2 = fBasic->GetSumw2()->GetArray() + (y+1) * nXF + 1;
+  Double_t* total  = fTotal->GetArray() + fYRegion[y+1] * nXR;
+  Double_t* total2 = (fTotal->GetSumw2N() ? 
+		      fTotal->GetSumw2()->GetArray() + fYRegion[y+1] * nXR : 0);
+  Double_t* empty  = fEmpty->GetArray() + fYRegion[y+1] * nXR;
+  Double_t* empty2 = (fEmpty->GetSumw2N() ? 
+		      fEmpty->GetSumw2()->GetArray() + fYRegion[y+1] * nXR : 0);
+  const Int_t* reg = fXRegion.GetArray() + 1;
+  Int_t nUsed = 0;
+  Int_t nHit  = 0;
+  for (UShort_t x = 0; x < n; x++) { 
+    Double_t w = weight[x];
+    if (w < 0) continue;
+    Int_t    j = reg[x];
+    nUsed++;
+    total[j] += 1;
+    if (total2) total2[j] += 1;
+    if (w > 0) { 
+      basic[x]  += w;
+      basic2[x] += w * w;
+      nHit++;
+    }
+    else { 
+      empty[j] += 1;
+      if (empty2) empty2[j] += 1;
+    }
+  }
+  fTotal->SetEntries(fTotal->GetEntries() + nUsed);
+  fBasic->SetEntries(fBasic->GetEntries() + nHit);
+  fEmpty->SetEntries(fEmpty->GetEntries() + nUsed - nHit);
+}
+
 //____________________________________________________________________
 Double_t 
 AliPoissonCalculator::CalculateMean(Double_t empty, Double_t total) const
@@ -384,28 +468,43 @@ AliPoissonCalculator::Result(Bool_t correct)
   //
   
   // Double_t total = fXLumping * fYLumping;
-  
-  for (Int_t ix = 1; ix <= fBasic->GetNbinsX(); ix++) { 
-    // Double_t x        = fBasic->GetXaxis()->GetBinCenter(ix);
-    Int_t    jx       = GetReducedXBin(ix); // fEmpty->GetXaxis()->FindBin(x);
-    for (Int_t iy = 1; iy <= fBasic->GetNbinsY(); iy++) { 
-      // Double_t y        = fBasic->GetYaxis()->GetBinCenter(iy);
-      Int_t    jy       = GetReducedYBin(iy); // fEmpty->GetYaxis()->FindBin(y);
-      Double_t empty    = fEmpty->GetBinContent(jx, jy);
-      Double_t total    = fTotal->GetBinContent(jx, jy);
-      Double_t hits     = fBasic->GetBinContent(ix,iy);
+  if (fXRegion.GetSize() != fBasic->GetNbinsX() + 2) MakeRegionMaps();
+  if (!fBasic->GetSumw2N()) fBasic->Sumw2();
+
+  // Mean and correction once per region 
+  Int_t           nXR   = fEmpty->GetNbinsX() + 2;
+  const Double_t* empty = fEmpty->GetArray();
+  const Double_t* total = fTotal->GetArray();
+  Double_t*       mean  = fRegionMean.GetArray();
+  Double_t*       corr  = fRegionCorr.GetArray();
+  for (Int_t jy = 1; jy <= fEmpty->GetNbinsY(); jy++) { 
+    for (Int_t jx = 1; jx <= fEmpty->GetNbinsX(); jx++) { 
+      Int_t j = jy * nXR + jx;
       // Mean in region of interest 
-      Double_t poissonM = CalculateMean(empty, total);
-      Double_t poissonC = (correct ? CalculateCorrection(empty, total) : 1);
-      
-      Double_t poissonV = hits * poissonM * poissonC;
+      mean[j] = CalculateMean(empty[j], total[j]);
+      corr[j] = (correct ? CalculateCorrection(empty[j], total[j]) : 1);
+    }
+  }
+
+  // Then scale the hits of each cell, row by row 
+  Int_t        nX    = fBasic->GetNbinsX();
+  Int_t        nY    = fBasic->GetNbinsY();
+  const Int_t* reg   = fXRegion.GetArray();
+  Double_t*    hits  = fBasic->GetArray();
+  Double_t*    hits2 = fBasic->GetSumw2()->GetArray();
+  for (Int_t iy = 1; iy <= nY; iy++) { 
+    Int_t           row      = iy * (nX + 2);
+    const Double_t* poissonM = mean + fYRegion[iy] * nXR;
+    const Double_t* poissonC = corr + fYRegion[iy] * nXR;
+    for (Int_t ix = 1; ix <= nX; ix++) { 
+      Int_t    jx       = reg[ix];
+      Double_t poissonV = hits[row+ix] * poissonM[jx] * poissonC[jx];
       Double_t poissonE = TMath::Sqrt(poissonV);
-      if(poissonV > 0) poissonE = TMath::Sqrt(poissonV);
-	  
-      fBasic->SetBinContent(ix,iy,poissonV);
-      fBasic->SetBinError(ix,iy,poissonE);
+      hits[row+ix]      = poissonV;
+      hits2[row+ix]     = poissonE * poissonE;
     }
   }
+  fBasic->SetEntries(fBasic->GetEntries() + nX * nY);
   return fBasic;
 }
   
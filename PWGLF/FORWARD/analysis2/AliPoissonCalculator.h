@@ -1,6 +1,8 @@
 #ifndef ALIPOISSONCALCULATOR_H
 #define ALIPOISSONCALCULATOR_H
 #include <TNamed.h>
+#include <TArrayI.h>
+#include <TArrayD.h>
 class TH2D;
 class TH1D;
 class TBrowser;
@@ -126,6 +128,17 @@ public:
    * @param weight  Weight if this 
    */
   void Fill(UShort_t strip, UShort_t sec, Bool_t hit, Double_t weight=1);
+  /** 
+   * Fill in the observations of a row (sector) of @a n strips.  This
+   * is equivalent to calling Fill for each strip, but works
+   * directly on the bin contents.
+   * 
+   * @param sec     Y axis bin number 
+   * @param n       Number of X axis bins (strips) 
+   * @param weight  Per-strip weight: negative if the strip is not
+   *                used, 0 if empty, and the weight if hit
+   */
+  void FillRow(UShort_t sec, UShort_t n, const Double_t* weight);
   /** 
    * Calculate result and store in @a output
    * 
@@ -230,6 +243,11 @@ protected:
    * 
    */
   void CleanUp();
+  /** 
+   * Make the maps from bins of the full histogram to the bins of the
+   * reduced (region) histograms 
+   */
+  void MakeRegionMaps();
   /** 
    * Calculate the mean 
    *
@@ -284,7 +302,11 @@ protected:
   TH1D*    fMean;         // Mean calculated by poisson method 
   TH1D*    fOcc;          // Histogram of occupancies 
   TH2D*    fCorr;         // Correction as a function of mean 
-  ClassDef(AliPoissonCalculator,3) // Calculate N_ch using Poisson
+  TArrayI  fXRegion;      //! Region X bin of each full X bin 
+  TArrayI  fYRegion;      //! Region Y bin of each full Y bin 
+  TArrayD  fRegionMean;   //! Mean per region (reduced bin)
+  TArrayD  fRegionCorr;   //! Correction per region (reduced bin)
+  ClassDef(AliPoissonCalculator,4) // Calculate N_ch using Poisson
 };
 
 #endif
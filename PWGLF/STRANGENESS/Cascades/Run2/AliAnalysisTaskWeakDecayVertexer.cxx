@@ -104,6 +104,10 @@ class AliAODv0;
 #include "AliTrackerBase.h"
 #include "AliV0HypSel.h"
 
+#include <thread>
+#include <vector>
+#include "TROOT.h"
+
 using std::cout;
 using std::endl;
 
@@ -147,6 +151,8 @@ fkDoCascadeRefit( kFALSE ) ,
 fMaxIterationsWhenMinimizing(27),
 fkPreselectX(kTRUE),
 fkSkipLargeXYDCA(kTRUE),
+fkPreselectV0PairsXY(kFALSE),
+fNThreadsV0Finding(1),
 fkMonteCarlo(kFALSE),
 fkUseOptimalTrackParams(kFALSE),
 fkUseOptimalTrackParamsBachelor(kFALSE),
@@ -209,6 +215,8 @@ fkDoCascadeRefit( kFALSE ) ,
 fMaxIterationsWhenMinimizing(27),
 fkPreselectX(kTRUE),
 fkSkipLargeXYDCA(kTRUE),
+fkPreselectV0PairsXY(kFALSE),
+fNThreadsV0Finding(1),
 fkMonteCarlo(kFALSE), 
 fkUseOptimalTrackParams(kFALSE),
 fkUseOptimalTrackParamsBachelor(kFALSE),
@@ -270,6 +278,9 @@ AliAnalysisTaskWeakDecayVertexer::~AliAnalysisTaskWeakDecayVertexer()
 //________________________________________________________________________
 void AliAnalysisTaskWeakDecayVertexer::UserCreateOutputObjects()
 {
+    //V0 and cascade finding in parallel threads
+    if( fNThreadsV0Finding > 1 ) ROOT::EnableThreadSafety();
+    
     //------------------------------------------------
     // Particle Identification Setup
     //------------------------------------------------
@@ -675,9 +686,75 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
         if (esdTrack->GetSign() > 0. && TMath::Abs(d)>fV0VertexerSels[2]) pos[npos++]=i;
     }
     
-      int nHypSel = fV0HypSelArray ? fV0HypSelArray->GetEntriesFast() : 0;
-    
-    for (i=0; i<nneg; i++) {
+    //XY-plane pre-selection of the pairs (as in GetDCAV0Dau): helix circles of the selected tracks
+    Bool_t lPreselectXY = (fkPreselectV0PairsXY || (fkDoImprovedDCAV0DauPropagation && fkSkipLargeXYDCA)) && TMath::Abs(b)>kAlmost0Field;
+    std::vector<Double_t> lNegCircles, lPosCircles;
+    if (lPreselectXY) {
+        lNegCircles.resize(3*nneg);
+        lPosCircles.resize(3*npos);
+        for (i=0; i<nneg; i++) GetHelixCircle(event->GetTrack(neg[i]), &lNegCircles[3*i], b);
+        for (i=0; i<npos; i++) GetHelixCircle(event->GetTrack(pos[i]), &lPosCircles[3*i], b);
+    }
+
+    //Blocks of negative tracks, each with its own output buffer; the V0s are added
+    //to the event in block order, i.e. in the same order as with a single block.
+    //Single block with material corrections: AliTrackerBase::PropagateTrackTo
+    //uses the navigator of gGeoManager, which is shared by all the threads
+    Int_t lNBlocks = TMath::Max(1, (Int_t)TMath::Min((Long_t)fNThreadsV0Finding, nneg));
+    if (fkDoMaterialCorrection) lNBlocks = 1;
+    Long_t lBlockSize = (nneg + lNBlocks - 1)/lNBlocks;
+    std::vector<std::vector<AliESDv0> > lV0s(lNBlocks);
+    std::vector<std::vector<Long64_t> > lCounts(lNBlocks, std::vector<Long64_t>(kNV0FinderCounts, 0));
+    auto lFindV0s = [&](Int_t iBlock) {
+        Long_t lFirst = TMath::Min(nneg, iBlock*lBlockSize);
+        Long_t lLast = TMath::Min(nneg, (iBlock+1)*lBlockSize);
+        FindV0sInBlock(event, neg, lFirst, lLast, pos, npos,
+                       lPreselectXY ? lNegCircles.data() : 0x0, lPreselectXY ? lPosCircles.data() : 0x0,
+                       lV0s[iBlock], lCounts[iBlock].data());
+    };
+    std::vector<std::thread> lThreads;
+    for (Int_t iBlock=1; iBlock<lNBlocks; iBlock++) lThreads.emplace_back(lFindV0s, iBlock);
+    lFindV0s(0);
+    for (auto &lThread : lThreads) lThread.join();
+
+    for (Int_t iBlock=0; iBlock<lNBlocks; iBlock++) {
+        for (auto &vertex : lV0s[iBlock]) {
+            event->AddV0(&vertex);
+            nvtx++;
+        }
+        if (iBlock) for (Int_t ic=0; ic<kNV0FinderCounts; ic++) lCounts[0][ic] += lCounts[iBlock][ic];
+    }
+    AddCounts(fHistV0Statistics, &lCounts[0][kV0FinderStatistics], 9);
+    AddCounts(fHistV0OptimalTrackParamUse, &lCounts[0][kV0FinderOTFUse], 3);
+    if (lCounts[0][kV0FinderOTFUse+2]) AliWarning(Form("Invalid on-the-fly V0 for %lld pairs!", lCounts[0][kV0FinderOTFUse+2]));
+    AliWarning(Form("Tracks2V0vertices","Number of reconstructed V0 vertices: %ld",nvtx));
+    return nvtx;
+}
+
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::FindV0sInBlock(AliESDEvent *event, const TArrayI &neg, Long_t lFirst, Long_t lLast,
+                                                      const TArrayI &pos, Long_t npos,
+                                                      const Double_t *lNegCircles, const Double_t *lPosCircles,
+                                                      std::vector<AliESDv0> &lV0s, Long64_t *lCounts) {
+    //--------------------------------------------------------------------
+    //V0 finding for the negative tracks neg[lFirst..lLast-1] and all the
+    //positive tracks, see Tracks2V0vertices. The V0s are appended to lV0s
+    //and the statistics counted in lCounts. Runs in parallel threads without
+    //material corrections: no histogram filling or logging in here
+    //--------------------------------------------------------------------
+
+    const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
+
+    Double_t xPrimaryVertex=vtxT3D->GetX();
+    Double_t yPrimaryVertex=vtxT3D->GetY();
+    Double_t zPrimaryVertex=vtxT3D->GetZ();
+
+    Double_t b=event->GetMagneticField();
+
+    int nHypSel = fV0HypSelArray ? fV0HypSelArray->GetEntriesFast() : 0;
+
+    for (Long_t i=lFirst; i<lLast; i++) {
         Long_t nidx=neg[i];
         AliESDtrack *ntrk=event->GetTrack(nidx);
         if(!ntrk) continue;
@@ -687,12 +764,12 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
             AliESDtrack *ptrk=event->GetTrack(pidx);
             if(!ptrk) continue;
             
-            fHistV0Statistics->Fill(0.5); //number of considered pairs
+            lCounts[kV0FinderStatistics+0]++; //number of considered pairs
             
             Double_t lNegMassForTracking = ntrk->GetMassForTracking();
             Double_t lPosMassForTracking = ptrk->GetMassForTracking();
             
-            fHistV0Statistics->Fill(1.5); //pass distance to PV
+            lCounts[kV0FinderStatistics+1]++; //pass distance to PV
             
             AliExternalTrackParam nt(*ntrk), pt(*ptrk);
             Bool_t lUsedOptimalParams = kFALSE;
@@ -705,8 +782,8 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
                     Int_t lEquivalentOTFV0 = (*iter).second; // or iter->second;
                     AliESDv0 *v0_otf = ((AliESDEvent*)event)->GetV0(lEquivalentOTFV0);
                     if(!v0_otf){
-                        AliWarning(Form("Invalid V0 at position %i!", lEquivalentOTFV0));
-                        fHistV0OptimalTrackParamUse->Fill(2.5);
+                        //no logging in the threads, reported after the loop
+                        lCounts[kV0FinderOTFUse+2]++;
                     }else{
                         AliExternalTrackParam ptimproved(*(v0_otf->GetParamP()));
                         AliExternalTrackParam ntimproved(*(v0_otf->GetParamN()));
@@ -719,14 +796,23 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
                             pt = ntimproved;
                             nt = ptimproved;
                         }
-                        fHistV0OptimalTrackParamUse->Fill(1.5);
+                        lCounts[kV0FinderOTFUse+1]++;
                         lUsedOptimalParams=kTRUE;
                     }
                 }else{
                     //OTF not available for this pair
-                    fHistV0OptimalTrackParamUse->Fill(0.5);
+                    lCounts[kV0FinderOTFUse+0]++;
                 }
             }
+            //XY-plane pre-selection, not for the on-the-fly track parameters
+            if (lNegCircles && !lUsedOptimalParams) {
+                const Double_t *lNegCircle = &lNegCircles[3*i], *lPosCircle = &lPosCircles[3*k];
+                Double_t lDist = TMath::Sqrt(TMath::Power(lPosCircle[0]-lNegCircle[0],2) +
+                                             TMath::Power(lPosCircle[1]-lNegCircle[1],2));
+                if( lDist > lNegCircle[2] + lPosCircle[2] + 2*fV0VertexerSels[3] ) continue;
+                if( lDist < TMath::Abs(lNegCircle[2] - lPosCircle[2]) - 2*fV0VertexerSels[3] ) continue;
+            }
+
             AliExternalTrackParam *ntp=&nt, *ptp=&pt;
             Double_t xn, xp, dca;
             
@@ -750,12 +836,12 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
             
             if (dca > fV0VertexerSels[3]) continue;
             
-            fHistV0Statistics->Fill(2.5); //pass dca
+            lCounts[kV0FinderStatistics+2]++; //pass dca
             
             if ((xn+xp) > 2*fV0VertexerSels[6] && fkPreselectX) continue;
             if ((xn+xp) < 2*fV0VertexerSels[5] && fkPreselectX) continue;
             
-            fHistV0Statistics->Fill(3.5); //pass X within R2D cut
+            lCounts[kV0FinderStatistics+3]++; //pass X within R2D cut
             
             if(!fkDoMaterialCorrection){
                 nt.PropagateTo(xn,b);
@@ -770,7 +856,7 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
             if (TMath::Abs(nt.Eta())>0.8&&fkExtraCleanup) continue;
             if (TMath::Abs(pt.Eta())>0.8&&fkExtraCleanup) continue;
             
-            fHistV0Statistics->Fill(4.5); //pass eta cut
+            lCounts[kV0FinderStatistics+4]++; //pass eta cut
             
             AliESDv0 vertex(nt,nidx,pt,pidx);
             
@@ -785,14 +871,14 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
             if (r2 < fV0VertexerSels[5]*fV0VertexerSels[5]) continue;
             if (r2 > fV0VertexerSels[6]*fV0VertexerSels[6]) continue;
             
-            fHistV0Statistics->Fill(5.5); //pass radius cut
+            lCounts[kV0FinderStatistics+5]++; //pass radius cut
             
             Float_t cpa=vertex.GetV0CosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex);
             
             //Simple cosine cut (no pt dependence for now)
             if (cpa < fV0VertexerSels[4]) continue;
             
-            fHistV0Statistics->Fill(6.5); //pass cosPA
+            lCounts[kV0FinderStatistics+6]++; //pass cosPA
             
             vertex.SetDcaV0Daughters(dca);
             vertex.SetV0CosineOfPointingAngle(cpa);
@@ -806,8 +892,8 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
             if(lTransvMom<fMinPtV0) continue;
             if(lTransvMom>fMaxPtV0) continue;
             
-            fHistV0Statistics->Fill(7.5); //within pT range
-            if (lUsedOptimalParams) fHistV0Statistics->Fill(8.5); //good V0, used OTF params
+            lCounts[kV0FinderStatistics+7]++; //within pT range
+            if (lUsedOptimalParams) lCounts[kV0FinderStatistics+8]++; //good V0, used OTF params
 
             if (nHypSel) { // do we select particular hypthesis? - i.e. does object exist
                 Bool_t reject = kTRUE;
@@ -823,18 +909,11 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
                 if (reject) continue;
             }
             
-            event->AddV0(&vertex);
-            
-            nvtx++;
-            
-            //if ( nvtx % 10000 ) gObjectTable->Print(); //debug, REMOVE ME PLEASE
+            lV0s.push_back(vertex);
         }
     }
-    AliWarning(Form("Tracks2V0vertices","Number of reconstructed V0 vertices: %ld",nvtx));
-    return nvtx;
 }
 
-
 //________________________________________________________________________
 Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0verticesMC(AliESDEvent *event) {
     //--------------------------------------------------------------------
@@ -1235,51 +1314,116 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
         trk[ntr++]=i;
     }
     
-    Double_t massLambda=1.11568;
+    //Blocks of V0s, each with its own output buffers for the cascades and the
+    //anti-cascades; added to the event in block order, i.e. in the same order
+    //as with a single block (all the cascades first, then the anti-cascades).
+    //Single block with material corrections, see Tracks2V0vertices
+    Int_t lNBlocks = TMath::Max(1, TMath::Min(fNThreadsV0Finding, nV0));
+    if (fkDoMaterialCorrection) lNBlocks = 1;
+    Long_t lBlockSize = (nV0 + lNBlocks - 1)/lNBlocks;
+    std::vector<std::vector<AliESDcascade> > lCascades(lNBlocks), lAntiCascades(lNBlocks);
+    std::vector<std::vector<Long64_t> > lCounts(lNBlocks, std::vector<Long64_t>(kNCascadeFinderCounts, 0));
+    auto lFindCascades = [&](Int_t iBlock) {
+        Long_t lFirst = TMath::Min((Long_t)nV0, iBlock*lBlockSize);
+        Long_t lLast = TMath::Min((Long_t)nV0, (iBlock+1)*lBlockSize);
+        FindCascadesInBlock(event, vtcs, lFirst, lLast, trk, ntr, -1, lCascades[iBlock], lCounts[iBlock].data());
+        FindCascadesInBlock(event, vtcs, lFirst, lLast, trk, ntr, +1, lAntiCascades[iBlock], lCounts[iBlock].data());
+    };
+    std::vector<std::thread> lThreads;
+    for (Int_t iBlock=1; iBlock<lNBlocks; iBlock++) lThreads.emplace_back(lFindCascades, iBlock);
+    lFindCascades(0);
+    for (auto &lThread : lThreads) lThread.join();
+    
     Long_t ncasc=0;
+    for (Int_t iBlock=0; iBlock<lNBlocks; iBlock++) {
+        for (auto &cascade : lCascades[iBlock]) {
+            event->AddCascade(&cascade);
+            ncasc++;
+        }
+        if (iBlock) for (Int_t ic=0; ic<kNCascadeFinderCounts; ic++) lCounts[0][ic] += lCounts[iBlock][ic];
+    }
+    for (Int_t iBlock=0; iBlock<lNBlocks; iBlock++) {
+        for (auto &cascade : lAntiCascades[iBlock]) {
+            event->AddCascade(&cascade);
+            ncasc++;
+        }
+    }
+    AddCounts(fHistV0ToBachelorPropagationStatus, &lCounts[0][kCascadeFinderPropagation], 10);
+    AddCounts(fHistV0OptimalTrackParamUseBachelor, &lCounts[0][kCascadeFinderOTFUse], 3);
+    if (lCounts[0][kCascadeFinderPropagation+1]) Error("PropagateToDCA","Propagation failed for %lld V0-bachelor pairs !", lCounts[0][kCascadeFinderPropagation+1]);
+    if (lCounts[0][kCascadeFinderOTFUse+2]) AliWarning(Form("Invalid on-the-fly V0 for %lld bachelors!", lCounts[0][kCascadeFinderOTFUse+2]));
     
-    // Looking for the cascades...
-    for (i=0; i<nV0; i++) { //loop on V0s
+    AliWarning(Form("V0sTracks2CascadeVertices","Number of reconstructed cascades: %ld",ncasc));
+    
+    return ncasc;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::FindCascadesInBlock(AliESDEvent *event, const TObjArray &vtcs, Long_t lFirst, Long_t lLast,
+                                                           const TArrayI &trk, Long_t ntr, Int_t lBachCharge,
+                                                           std::vector<AliESDcascade> &lCascades, Long64_t *lCounts) {
+    //--------------------------------------------------------------------
+    //Cascade finding for the V0s vtcs[lFirst..lLast-1] and the bachelor
+    //tracks of charge lBachCharge (-1: Xi-/Omega-, +1: Xi+/Omega+), see
+    //V0sTracks2CascadeVertices. The cascades are appended to lCascades and
+    //the statistics counted in lCounts. Runs in parallel threads without
+    //material corrections: no histogram filling or logging in here
+    //--------------------------------------------------------------------
+    const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
+    
+    Double_t xPrimaryVertex=vtxT3D->GetX();
+    Double_t yPrimaryVertex=vtxT3D->GetY();
+    Double_t zPrimaryVertex=vtxT3D->GetZ();
+    
+    Double_t b=event->GetMagneticField();
+    
+    Double_t massLambda=1.11568;
+    //cascades: Lambda and negative bachelor; anti-cascades: anti-Lambda and positive bachelor
+    const Bool_t lAnti = lBachCharge > 0;
+    const Int_t lPdgXi = lAnti ? -3312 : 3312, lPdgOmega = lAnti ? -3334 : 3334;
+    
+    for (Long_t i=lFirst; i<lLast; i++) { //loop on V0s
         AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
         AliESDv0 v0(*v);
-        v0.ChangeMassHypothesis(kLambda0); // the v0 must be Lambda
+        v0.ChangeMassHypothesis(lAnti ? kLambda0Bar : kLambda0);
         if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
         for (Int_t j=0; j<ntr; j++) {//loop on tracks
             Int_t bidx=trk[j];
             //Bo:   if (bidx==v->GetNindex()) continue; //bachelor and v0's negative tracks must be different
-            if (bidx==v0.GetIndex(0)) continue; //Bo:  consistency 0 for neg
+            if (bidx==v0.GetIndex(lAnti ? 1 : 0)) continue; //Bo:  consistency 0 for neg, 1 for pos
             
             AliESDtrack *btrk=event->GetTrack(bidx);
             Float_t lBachMassForTracking=btrk->GetMassForTracking();
             
-            if (btrk->GetSign()>0) continue;  // bachelor's charge
+            if (btrk->GetSign()*lBachCharge<0) continue;  // bachelor's charge
             
             AliESDv0 *pv0=&v0;
             AliExternalTrackParam bt(*btrk);
             if(fkUseOptimalTrackParamsBachelor) {
                 //Look for a better bachelor description, please
                 //reroute to pointers obtained with on-the-fly finding
-                map<pair<int,int>, int>::iterator iter = fOTFMap.find(make_pair(bidx,v->GetPindex()));
+                map<pair<int,int>, int>::const_iterator iter = lAnti ?
+                    fOTFMap.find(make_pair(v->GetNindex(),bidx)) : fOTFMap.find(make_pair(bidx,v->GetPindex()));
                 if(iter != fOTFMap.end())
                 {
                     Int_t lEquivalentOTFV0 = (*iter).second; // or iter->second;
                     AliESDv0 *v0_otf = ((AliESDEvent*)event)->GetV0(lEquivalentOTFV0);
                     if(!v0_otf){
-                        AliWarning(Form("Invalid V0 at position %i!", lEquivalentOTFV0));
-                        fHistV0OptimalTrackParamUseBachelor->Fill(2.5);
+                        //no logging in the threads, reported after the loop
+                        lCounts[kCascadeFinderOTFUse+2]++;
                     }else{
-                        AliExternalTrackParam btimproved(*(v0_otf->GetParamN()));
+                        AliExternalTrackParam btimproved(*(lAnti ? v0_otf->GetParamP() : v0_otf->GetParamN()));
                         bt = btimproved;
-                        fHistV0OptimalTrackParamUseBachelor->Fill(1.5);
+                        lCounts[kCascadeFinderOTFUse+1]++;
                     }
                 }else{
                     //OTF not available for this pair
-                    fHistV0OptimalTrackParamUseBachelor->Fill(0.5);
+                    lCounts[kCascadeFinderOTFUse+0]++;
                 }
             }
             AliExternalTrackParam *pbt=&bt;
             
-            Double_t dca=PropagateToDCA(pv0,pbt,event,b,lBachMassForTracking);
+            Double_t dca=PropagateToDCA(pv0,pbt,event,b,lBachMassForTracking,&lCounts[kCascadeFinderPropagation]);
             if (dca > fCascadeVertexerSels[4]) continue;
             
             //eta cut - test
@@ -1313,11 +1457,11 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
             if(lXiTransvMom<fMinPtCascade) continue;
             if(lXiTransvMom>fMaxPtCascade) continue;
             
-            //Filter masses: anti-cascade hypotheses
+            //Filter masses: Xi and Omega hypotheses of the charge of the bachelor
             Double_t lV0quality = 0.;
-            cascade.ChangeMassHypothesis(lV0quality , 3312); // pdg code -3312 = Xi+
+            cascade.ChangeMassHypothesis(lV0quality , lPdgXi);
             Double_t lInvMassXi = cascade.GetEffMassXi();
-            cascade.ChangeMassHypothesis(lV0quality , 3334); // pdg code -3312 = Xi+
+            cascade.ChangeMassHypothesis(lV0quality , lPdgOmega);
             Double_t lInvMassOmega = cascade.GetEffMassXi();
             
             //Remove if outside window of interest
@@ -1326,112 +1470,11 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
             
             cascade.SetDcaXiDaughters(dca);
             
-            //Change back to default XiMinus hypothesis
-            cascade.ChangeMassHypothesis(lV0quality , 3312);
-            event->AddCascade(&cascade);
-            ncasc++;
+            //Change back to default Xi hypothesis
+            cascade.ChangeMassHypothesis(lV0quality , lPdgXi);
+            lCascades.push_back(cascade);
         } // end loop tracks
     } // end loop V0s
-    
-    // Looking for the anti-cascades...
-    for (i=0; i<nV0; i++) { //loop on V0s
-        AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
-        AliESDv0 v0(*v);
-        v0.ChangeMassHypothesis(kLambda0Bar); //the v0 must be anti-Lambda
-        if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
-        
-        for (Int_t j=0; j<ntr; j++) {//loop on tracks
-            Int_t bidx=trk[j];
-            if (bidx==v0.GetIndex(1)) continue; //Bo:  consistency 1 for pos
-            
-            AliESDtrack *btrk=event->GetTrack(bidx);
-            Float_t lBachMassForTracking=btrk->GetMassForTracking();
-            
-            if (btrk->GetSign()<0) continue;  // bachelor's charge
-            
-            AliESDv0 *pv0=&v0;
-            AliExternalTrackParam bt(*btrk);
-            if(fkUseOptimalTrackParamsBachelor) {
-                //Look for a better bachelor description, please
-                //reroute to pointers obtained with on-the-fly finding
-                map<pair<int,int>, int>::iterator iter = fOTFMap.find(make_pair(v->GetNindex(),bidx));
-                if(iter != fOTFMap.end())
-                {
-                    Int_t lEquivalentOTFV0 = (*iter).second; // or iter->second;
-                    AliESDv0 *v0_otf = ((AliESDEvent*)event)->GetV0(lEquivalentOTFV0);
-                    if(!v0_otf){
-                        AliWarning(Form("Invalid V0 at position %i!", lEquivalentOTFV0));
-                        fHistV0OptimalTrackParamUseBachelor->Fill(2.5);
-                    }else{
-                        AliExternalTrackParam btimproved(*(v0_otf->GetParamP()));
-                        bt = btimproved;
-                        fHistV0OptimalTrackParamUseBachelor->Fill(1.5);
-                    }
-                }else{
-                    //OTF not available for this pair
-                    fHistV0OptimalTrackParamUseBachelor->Fill(0.5);
-                }
-            }
-            AliExternalTrackParam *pbt=&bt;
-            
-            Double_t dca=PropagateToDCA(pv0,pbt,event,b,lBachMassForTracking);
-            if (dca > fCascadeVertexerSels[4]) continue;
-            
-            //eta cut - test
-            if (TMath::Abs(pbt->Eta())>0.8 && fkExtraCleanup) continue;
-            
-            AliESDcascade cascade(*pv0,*pbt,bidx); //constucts a cascade candidate
-            //PH         if (cascade.GetChi2Xi() > fChi2max) continue;
-            
-            //Improve estimate of cascade decay position using uncertainties if requested to do so
-            if( fkDoCascadeRefit ) cascade.RefitCascade(pbt);
-            
-            Double_t x,y,z; cascade.GetXYZcascade(x,y,z); // Bo: bug correction
-            Double_t r2=x*x + y*y;
-            if (r2 > fCascadeVertexerSels[7]*fCascadeVertexerSels[7]) continue;   // condition on fiducial zone
-            if (r2 < fCascadeVertexerSels[6]*fCascadeVertexerSels[6]) continue;
-            
-            Double_t pxV0,pyV0,pzV0;
-            pv0->GetPxPyPz(pxV0,pyV0,pzV0);
-            if (x*pxV0+y*pyV0+z*pzV0 < 0) continue; //causality
-            
-            Double_t x1,y1,z1; pv0->GetXYZ(x1,y1,z1);
-            if (r2 > (x1*x1+y1*y1)) continue;
-            
-            if (cascade.GetCascadeCosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex) < fCascadeVertexerSels[5]) continue; //condition on the cascade pointing angle
-            
-            //pre-select on pT
-            Double_t lXiMomX       = 0. , lXiMomY = 0., lXiMomZ = 0.;
-            Double_t lXiTransvMom  = 0. ;
-            cascade.GetPxPyPz( lXiMomX, lXiMomY, lXiMomZ );
-            lXiTransvMom  	= TMath::Sqrt( lXiMomX*lXiMomX   + lXiMomY*lXiMomY );
-            if(lXiTransvMom<fMinPtCascade) continue;
-            if(lXiTransvMom>fMaxPtCascade) continue;
-            
-            //Filter masses: anti-cascade hypotheses
-            Double_t lV0quality = 0.;
-            cascade.ChangeMassHypothesis(lV0quality , -3312); // pdg code -3312 = Xi+
-            Double_t lInvMassXi = cascade.GetEffMassXi();
-            cascade.ChangeMassHypothesis(lV0quality , -3334); // pdg code -3312 = Xi+
-            Double_t lInvMassOmega = cascade.GetEffMassXi();
-            
-            //Remove if outside window of interest
-            if(TMath::Abs(lInvMassXi   -1.322)>fMassWindowAroundCascade &&
-               TMath::Abs(lInvMassOmega-1.672)>fMassWindowAroundCascade ) continue;
-            
-            cascade.SetDcaXiDaughters(dca);
-            
-            //Change back to default XiPlus hypothesis
-            cascade.ChangeMassHypothesis(lV0quality , -3312);
-            event->AddCascade(&cascade);
-            ncasc++;
-            
-        } // end loop tracks
-    } // end loop V0s
-    
-    AliWarning(Form("V0sTracks2CascadeVertices","Number of reconstructed cascades: %ld",ncasc));
-    
-    return ncasc;
 }
 
 //________________________________________________________________________
@@ -2047,13 +2090,15 @@ Double_t AliAnalysisTaskWeakDecayVertexer::Det(Double_t a00,Double_t a01,Double_
 }
 
 //________________________________________________________________________
-Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExternalTrackParam *t, AliESDEvent *event, Double_t b, Double_t lBachMassForTracking) {
+Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExternalTrackParam *t, AliESDEvent *event, Double_t b, Double_t lBachMassForTracking, Long64_t *lCounts) {
     //--------------------------------------------------------------------
     // This function returns the DCA between the V0 and the track
+    // The propagation status is counted in lCounts[0..9] if given (for the
+    // threaded cascade finding), otherwise in fHistV0ToBachelorPropagationStatus
     //--------------------------------------------------------------------
     
     //Count received
-    fHistV0ToBachelorPropagationStatus->Fill(0.5);
+    CountPropagationStatus(lCounts, 0);
     
     Double_t alpha=t->GetAlpha(), cs1=TMath::Cos(alpha), sn1=TMath::Sin(alpha);
     Double_t r[3]; t->GetXYZ(r);
@@ -2088,17 +2133,17 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
         x1=x1*cs1 + y1*sn1;
         if (!t->PropagateTo(x1,b)) {
             //Count linear propagation failures
-            fHistV0ToBachelorPropagationStatus->Fill(1.5);
-            Error("PropagateToDCA","Propagation failed !");
+            CountPropagationStatus(lCounts, 1);
+            if (!lCounts) Error("PropagateToDCA","Propagation failed !");
             return 1.e+33;
         }
         //Count linear propagation successes
-        fHistV0ToBachelorPropagationStatus->Fill(2.5);
+        CountPropagationStatus(lCounts, 2);
     }
     
     if( fkDoImprovedDCACascDauPropagation ){
         //Count Improved Cascade propagation received
-        fHistV0ToBachelorPropagationStatus->Fill(3.5); //bin 4
+        CountPropagationStatus(lCounts, 3); //bin 4
         
         //DCA Calculation improved -> non-linear propagation
         //Preparatory step 1: get two tracks corresponding to V0
@@ -2312,12 +2357,12 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
                     if ((gt1*gt1+gt2*gt2) > 1.e-4/dy2/dy2){
                         AliDebug(1," stopped at not a stationary point !");
                         //Count not stationary point
-                        fHistV0ToBachelorPropagationStatus->Fill(4.5); //bin 5
+                        CountPropagationStatus(lCounts, 4); //bin 5
                     }
                     Double_t lmb=h11+h22; lmb=lmb-TMath::Sqrt(lmb*lmb-4*det);
                     if (lmb < 0.){
                         //Count stopped at not a minimum
-                        fHistV0ToBachelorPropagationStatus->Fill(5.5);
+                        CountPropagationStatus(lCounts, 5);
                         AliDebug(1," stopped at not a minimum !");
                     }
                     break;
@@ -2334,7 +2379,7 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
                 if (div>512) {
                     AliDebug(1," overshoot !"); break;
                     //Count overshoots
-                    fHistV0ToBachelorPropagationStatus->Fill(6.5);
+                    CountPropagationStatus(lCounts, 6);
                 }
             }
             dm=dd;
@@ -2347,7 +2392,7 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
         if (max<=0){
             AliDebug(1," too many iterations !");
             //Count excessive iterations
-            fHistV0ToBachelorPropagationStatus->Fill(7.5);
+            CountPropagationStatus(lCounts, 7);
         }
         
         Double_t cs=TMath::Cos(t->GetAlpha());
@@ -2359,7 +2404,7 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
             if (!t->PropagateTo(xthis,b)) {
                 //AliWarning(" propagation failed !";
                 //Count curved propagation failures
-                fHistV0ToBachelorPropagationStatus->Fill(8.5);
+                CountPropagationStatus(lCounts, 8);
                 return 1e+33;
             }
         }else{
@@ -2369,7 +2414,7 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
         //V0 distance to bachelor: the desired distance
         Double_t rBachDCAPt[3]; t->GetXYZ(rBachDCAPt);
         dca = v->GetD(rBachDCAPt[0],rBachDCAPt[1],rBachDCAPt[2]);
-        fHistV0ToBachelorPropagationStatus->Fill(9.5);
+        CountPropagationStatus(lCounts, 9);
     }
     
     return dca;
@@ -2860,6 +2905,37 @@ void AliAnalysisTaskWeakDecayVertexer::GetHelixCenter(const AliExternalTrackPara
     return;
 }
 
+///________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::GetHelixCircle(const AliExternalTrackParam *track, Double_t circle[3], Double_t b){
+    //Center (circle[0], circle[1]) and radius (circle[2]) of the track helix in the XY plane
+    Double_t helix[6];
+    track->GetHelixParameters(helix,b);
+    GetHelixCenter(track, circle, b);
+    circle[2] = TMath::Abs(1./helix[4]);
+}
+
+///________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::CountPropagationStatus(Long64_t *lCounts, Int_t lStatus){
+    //Counts a V0-bachelor propagation status (bin lStatus+1 of fHistV0ToBachelorPropagationStatus)
+    if (lCounts) lCounts[lStatus]++;
+    else fHistV0ToBachelorPropagationStatus->Fill(lStatus+0.5);
+}
+
+///________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::AddCounts(TH1 *h, const Long64_t *lCounts, Int_t n){
+    //Adds lCounts[0..n-1] entries to the bins 1..n, as many Fill(bin center)
+    if (!h) return;
+    Bool_t lFilled = kFALSE;
+    for (Int_t ib=0; ib<n; ib++) {
+        if (!lCounts[ib]) continue;
+        lFilled = kTRUE;
+        h->AddBinContent(ib+1, lCounts[ib]);
+        if (h->GetSumw2N()) h->GetSumw2()->AddAt(h->GetSumw2()->At(ib+1) + lCounts[ib], ib+1);
+    }
+    //entries and sums of weights from the bin contents
+    if (lFilled) h->ResetStats();
+}
+
 ///________________________________________________________________________
 void AliAnalysisTaskWeakDecayVertexer::SelectiveResetV0s(AliESDEvent *event, Int_t lType){
     //Selectively reset V0s
@@ -35,10 +35,16 @@ class AliV0HypSel;
 class AliESDpid;
 class AliESDEvent;
 class AliPhysicsSelection;
+class AliESDv0;
+class AliESDcascade;
+class TArrayI;
+class TObjArray;
+class TH1;
 
 #include "AliEventCuts.h"
 //For mapping functionality
 #include <map>
+#include <vector>
 
 using namespace std;
 
@@ -235,6 +241,15 @@ public:
     void SetSkipLargeXYDCA( Bool_t lOpt = kTRUE) {
         fkSkipLargeXYDCA=lOpt;
     }
+    //XY-plane helix circle pre-selection of the V0 pairs (always on with improved DCA + SkipLargeXYDCA)
+    void SetPreselectV0PairsXY( Bool_t lOpt = kTRUE) {
+        fkPreselectV0PairsXY=lOpt;
+    }
+    //Number of threads for the V0 pair loop (negative tracks split in blocks) and the
+    //V0-bachelor loop of V0sTracks2CascadeVertices (V0s split in blocks); one thread with material corrections
+    void SetNThreadsV0Finding( Int_t lNThreads ) {
+        fNThreadsV0Finding = lNThreads > 0 ? lNThreads : 1;
+    }
     void SetUseMonteCarloAssociation( Bool_t lOpt = kTRUE) {
         fkMonteCarlo=lOpt;
     }
@@ -270,6 +285,11 @@ public:
 //---------------------------------------------------------------------------------------
     //Re-vertex V0s
     Long_t Tracks2V0vertices(AliESDEvent *event);
+    //V0 pair loop over a block of negative tracks (runs in threads, except with material corrections)
+    void FindV0sInBlock(AliESDEvent *event, const TArrayI &neg, Long_t lFirst, Long_t lLast,
+                        const TArrayI &pos, Long_t npos,
+                        const Double_t *lNegCircles, const Double_t *lPosCircles,
+                        std::vector<AliESDv0> &lV0s, Long64_t *lCounts);
 
     //======================================================================
     //Re-vertex V0s based solely on perfect MC V0s
@@ -282,6 +302,10 @@ public:
     
     //Re-vertex Cascades
     Long_t V0sTracks2CascadeVertices(AliESDEvent *event);
+    //V0-bachelor loop over a block of V0s (runs in threads, except with material corrections)
+    void FindCascadesInBlock(AliESDEvent *event, const TObjArray &vtcs, Long_t lFirst, Long_t lLast,
+                             const TArrayI &trk, Long_t ntr, Int_t lBachCharge,
+                             std::vector<AliESDcascade> &lCascades, Long64_t *lCounts);
     Long_t V0sTracks2CascadeVerticesMC(AliESDEvent *event);
     //Re-vertex Cascades without checking bachelor charge - V0 Mass hypo correspondence
     Long_t V0sTracks2CascadeVerticesUncheckedCharges(AliESDEvent *event);
@@ -290,7 +314,7 @@ public:
     Double_t Det(Double_t a00,Double_t a01,Double_t a02,
                  Double_t a10,Double_t a11,Double_t a12,
                  Double_t a20,Double_t a21,Double_t a22) const;
-    Double_t PropagateToDCA(AliESDv0 *vtx,AliExternalTrackParam *trk, AliESDEvent *event, Double_t b, Double_t lBachMassForTracking=0.139);
+    Double_t PropagateToDCA(AliESDv0 *vtx,AliExternalTrackParam *trk, AliESDEvent *event, Double_t b, Double_t lBachMassForTracking=0.139, Long64_t *lCounts=0x0);
     void Evaluate(const Double_t *h, Double_t t,
                   Double_t r[3],  //radius vector
                   Double_t g[3],  //first defivatives
@@ -300,6 +324,9 @@ public:
     //Improved DCA V0 Dau
     Double_t GetDCAV0Dau ( AliExternalTrackParam *pt, AliExternalTrackParam *nt, Double_t &xp, Double_t &xn, Double_t b, Double_t lNegMassForTracking=0.139, Double_t lPosMassForTracking=0.139);
     void GetHelixCenter(const AliExternalTrackParam *track,Double_t center[2], Double_t b);
+    void GetHelixCircle(const AliExternalTrackParam *track,Double_t circle[3], Double_t b);
+    void CountPropagationStatus(Long64_t *lCounts, Int_t lStatus);
+    static void AddCounts(TH1 *h, const Long64_t *lCounts, Int_t n);
     //---------------------------------------------------------------------------------------
     
     //---------------------------------------------------------------------------------------
@@ -361,6 +388,8 @@ private:
     Long_t fMaxIterationsWhenMinimizing;
     Bool_t fkPreselectX;
     Bool_t fkSkipLargeXYDCA;
+    Bool_t fkPreselectV0PairsXY; //XY-plane pre-selection of the V0 pairs before the DCA
+    Int_t fNThreadsV0Finding; //number of threads of the V0 pair and V0-bachelor loops
     
     //Master MC switch
     Bool_t fkMonteCarlo; //do MC association in vertexing
@@ -408,8 +437,14 @@ private:
     AliAnalysisTaskWeakDecayVertexer(const AliAnalysisTaskWeakDecayVertexer&);            // not implemented
     AliAnalysisTaskWeakDecayVertexer& operator=(const AliAnalysisTaskWeakDecayVertexer&); // not implemented
 
-    ClassDef(AliAnalysisTaskWeakDecayVertexer, 1);
+    //Counters of the V0 pair and V0-bachelor loops, added to the histograms after the loops
+    enum { kV0FinderStatistics=0, kV0FinderOTFUse=9, kNV0FinderCounts=12 };
+    enum { kCascadeFinderPropagation=0, kCascadeFinderOTFUse=10, kNCascadeFinderCounts=13 };
+    static constexpr Double_t kAlmost0Field = 1e-3; //no XY-plane pre-selection below (kG)
+
+    ClassDef(AliAnalysisTaskWeakDecayVertexer, 2);
     //1: first implementation
+    //2: V0 pair XY-plane pre-selection, threaded V0 and cascade finding
 };
 
 #endif
@@ -88,6 +88,7 @@
 #include "TVectorD.h"
 #include "TStatToolkit.h"
 #include "AliESDtools.h"
+#include "AliFilteredTreeAsyncWriter.h"
 #include "TVectorF.h"
 using namespace std;
 
@@ -113,6 +114,9 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fTrigger(AliTriggerAnalysis::kMB1) 
   , fAnalysisMode(kTPCAnalysisMode) 
   , fTreeSRedirector(0)
+  , fAsyncWriter(0)
+  , fAsyncWriterQueueSize(0)
+  , fAsyncWriterChunkSize(32000000)
   , fCentralityEstimator(0)
   , fLowPtTrackDownscaligF(0)
   , fLowPtV0DownscaligF(0)
@@ -204,17 +208,22 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
 
   //
   //get the output file to make sure the trees will be associated to it
-  OpenFile(1);
-  fTreeSRedirector = new TTreeSRedirector();
-
-  //
-  // Create trees
-  fV0Tree = ((*fTreeSRedirector)<<"V0s").GetTree();
-  fHighPtTree = ((*fTreeSRedirector)<<"highPt").GetTree();
-  fdEdxTree = ((*fTreeSRedirector)<<"dEdx").GetTree();
-  fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
-  fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
-  fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+  TFile *outputFile = OpenFile(1);
+  if (fAsyncWriterQueueSize>0) {
+    // streaming to in-memory chunks, the output trees are created by the writer thread
+    fAsyncWriter = new AliFilteredTreeAsyncWriter(outputFile, fAsyncWriterQueueSize, fAsyncWriterChunkSize);
+    fTreeSRedirector = fAsyncWriter->GetRedirector();
+  } else {
+    fTreeSRedirector = new TTreeSRedirector();
+    //
+    // Create trees
+    fV0Tree = ((*fTreeSRedirector)<<"V0s").GetTree();
+    fHighPtTree = ((*fTreeSRedirector)<<"highPt").GetTree();
+    fdEdxTree = ((*fTreeSRedirector)<<"dEdx").GetTree();
+    fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
+    fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
+    fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+  }
 
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
@@ -307,13 +316,16 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   fOutput->Add(fPtResCentPtTPCITS);
 
   // post data to outputs
+  // (with the asynchronous writer the trees are posted in FinishTaskOutput)
 
-  PostData(1,fV0Tree);
-  PostData(2,fHighPtTree);
-  PostData(3,fdEdxTree);
-  PostData(4,fLaserTree);
-  PostData(5,fMCEffTree);
-  PostData(6,fCosmicPairsTree);
+  if (!fAsyncWriter) {
+    PostData(1,fV0Tree);
+    PostData(2,fHighPtTree);
+    PostData(3,fdEdxTree);
+    PostData(4,fLaserTree);
+    PostData(5,fMCEffTree);
+    PostData(6,fCosmicPairsTree);
+  }
 
   PostData(7,fOutput);
 }
@@ -403,6 +415,11 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
     //ProcessMC();  //TODO - enable MC detailed view switch after holidays
   }
   if (fProcessITSTPCmatchOut) ProcessITSTPCmatchOut(fESD, fESDfriend);
+  if (fAsyncWriter && fAsyncWriter->EndEvent()) {
+    // full chunk handed over to the writer thread - continue with a new one
+    fTreeSRedirector = fAsyncWriter->GetRedirector();
+    fESDtool->SetStreamer(fTreeSRedirector);
+  }
   printf("processed event %d\n", Int_t(Entry()));
 }
 
@@ -519,19 +536,11 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
 	}
       }
       if (fFriendDownscaling<=0){
-	if (((*fTreeSRedirector)<<"CosmicPairs").GetTree()){
-	  TTree * tree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
-	  if (tree){
-	    Double_t sizeAll=tree->GetZipBytes();
-	    TBranch * br= tree->GetBranch("friendTrack0.fPoints");
-	    Double_t sizeFriend=(br!=NULL)?br->GetZipBytes():0;
-	    br= tree->GetBranch("friendTrack0.fCalibContainer");
-	    if (br) sizeFriend+=br->GetZipBytes();
-	    if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
-	      friendTrackStore0=0;
-	      friendTrackStore1=0;
-	    }
-	  }
+	Double_t sizeAll=GetZipBytes("CosmicPairs");
+	Double_t sizeFriend=GetZipBytes("CosmicPairs","friendTrack0.fPoints")+GetZipBytes("CosmicPairs","friendTrack0.fCalibContainer");
+	if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
+	  friendTrackStore0=0;
+	  friendTrackStore1=0;
 	}
       }
       if(!fFillTree) return;
@@ -1439,17 +1448,9 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	  friendTrackStore = (gRandom->Rndm()<1./fFriendDownscaling)? friendTrack:0;
 	}
 	if (fFriendDownscaling<=0){
-	  if (((*fTreeSRedirector)<<"highPt").GetTree()){
-	    TTree * tree = ((*fTreeSRedirector)<<"highPt").GetTree();
-	    if (tree){
-	      Double_t sizeAll=tree->GetZipBytes();
-	      TBranch * br= tree->GetBranch("friendTrack.fPoints");
-	      Double_t sizeFriend=(br!=NULL)?br->GetZipBytes():0;
-	      br= tree->GetBranch("friendTrack.fCalibContainer");
-	      if (br) sizeFriend+=br->GetZipBytes();
-	      if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) friendTrackStore=0;
-	    }
-	  }
+	  Double_t sizeAll=GetZipBytes("highPt");
+	  Double_t sizeFriend=GetZipBytes("highPt","friendTrack.fPoints")+GetZipBytes("highPt","friendTrack.fCalibContainer");
+	  if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) friendTrackStore=0;
 	}
 
 
@@ -2073,19 +2074,11 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
 	}
       }
       if (fFriendDownscaling<=0){
-	if (((*fTreeSRedirector)<<"V0s").GetTree()){
-	  TTree * tree = ((*fTreeSRedirector)<<"V0s").GetTree();
-	  if (tree){
-	    Double_t sizeAll=tree->GetZipBytes();
-	    TBranch * br= tree->GetBranch("friendTrack0.fPoints");
-	    Double_t sizeFriend=(br!=NULL)?br->GetZipBytes():0;
-	    br= tree->GetBranch("friendTrack0.fCalibContainer");
-	    if (br) sizeFriend+=br->GetZipBytes();
-	    if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
-	      friendTrackStore0=0;
-	      friendTrackStore1=0;
-	    }
-	  }
+	Double_t sizeAll=GetZipBytes("V0s");
+	Double_t sizeFriend=GetZipBytes("V0s","friendTrack0.fPoints")+GetZipBytes("V0s","friendTrack0.fCalibContainer");
+	if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
+	  friendTrackStore0=0;
+	  friendTrackStore1=0;
 	}
       }
 
@@ -2434,6 +2427,22 @@ Int_t   AliAnalysisTaskFilteredTree::GetKFParticle(AliESDv0 *const v0, AliESDEve
   return ptype;  
 }
 
+//_____________________________________________________________________________
+Double_t AliAnalysisTaskFilteredTree::GetZipBytes(const char *treeName, const char *branchName)
+{
+  //
+  // Size of the tree (branch) written so far - used for the friend downscaling in respect to the data volume
+  // With the asynchronous writer the trees are streamed to chunks, the sizes are summed over all chunks
+  //
+  if (fAsyncWriter) return fAsyncWriter->GetZipBytes(treeName, branchName);
+  if (!fTreeSRedirector) return 0;
+  TTree *tree = ((*fTreeSRedirector)<<treeName).GetTree();
+  if (!tree) return 0;
+  if (!branchName) return tree->GetZipBytes();
+  TBranch *br = tree->GetBranch(branchName);
+  return (br!=NULL)?br->GetZipBytes():0;
+}
+
 //_____________________________________________________________________________
 Bool_t AliAnalysisTaskFilteredTree::IsV0Downscaled(AliESDv0 *const v0)
 {
@@ -2725,6 +2734,26 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
   // Called one at the end 
   // locally on working node
   //
+  if (fAsyncWriter) {
+    // wait for the writer thread, the output trees are complete
+    fAsyncWriter->Close();
+    fV0Tree = fAsyncWriter->GetTree("V0s");
+    fHighPtTree = fAsyncWriter->GetTree("highPt");
+    fdEdxTree = fAsyncWriter->GetTree("dEdx");
+    fLaserTree = fAsyncWriter->GetTree("Laser");
+    fMCEffTree = fAsyncWriter->GetTree("MCEffTree");
+    fCosmicPairsTree = fAsyncWriter->GetTree("CosmicPairs");
+    PostData(1,fV0Tree);
+    PostData(2,fHighPtTree);
+    PostData(3,fdEdxTree);
+    PostData(4,fLaserTree);
+    PostData(5,fMCEffTree);
+    PostData(6,fCosmicPairsTree);
+    delete fAsyncWriter;
+    fAsyncWriter=NULL;
+    fTreeSRedirector=NULL;
+    return;
+  }
   Bool_t deleteTrees=kTRUE;
   if ((AliAnalysisManager::GetAnalysisManager()))
   {
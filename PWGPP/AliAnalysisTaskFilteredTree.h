@@ -22,6 +22,8 @@
    3.) "Laser"      - dump laser tracks with space points if exists
    4.) "CosmicTree" - cosmic track candidate (random or triggered) + esdTracks(up/down)+ optional points
    5.) "dEdx"       - tree with high dEdx tpc tracks
+
+   Optionally (SetAsyncWriter) the trees are buffered in memory and compressed/written by a background thread, see AliFilteredTreeAsyncWriter
 */
 class AliESDEvent;
 class AliMCEvent;
@@ -45,6 +47,7 @@ class TTreeSRedirector;
 class TParticle;
 class TH3D;
 class AliESDtools;
+class AliFilteredTreeAsyncWriter;
 #include <string>
 
 #include "AliTriggerAnalysis.h"
@@ -117,6 +120,8 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   void SetLowPtTrackDownscaligF(Double_t fact) { fLowPtTrackDownscaligF = fact; }
   void SetLowPtV0DownscaligF(Double_t fact)    { fLowPtV0DownscaligF = fact; }
   void SetFriendDownscaling(Double_t fact)    { fFriendDownscaling = fact; }
+  /// write the trees in a background thread, chunkSize bytes are buffered in memory per chunk, at most queueSize chunks wait for the writer (0 - synchronous writing)
+  void SetAsyncWriter(Int_t queueSize=4, Long64_t chunkSize=32000000) { fAsyncWriterQueueSize = queueSize; fAsyncWriterChunkSize = chunkSize; }
   
   void   SetProcessCosmics(Bool_t flag) { fProcessCosmics = flag; }
   Bool_t GetProcessCosmics() { return fProcessCosmics; }
@@ -142,6 +147,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   static Double_t TsalisCharged(Double_t pt, Double_t mass, Double_t sqrts);
   static Int_t    DownsampleTsalisCharged(Double_t pt, Double_t factorPt, Double_t factor1Pt,  Double_t sqrts=5020, Double_t mass=0.2);
   Int_t  PIDSelection(AliESDtrack *track, TParticle *particle = nullptr);
+  Double_t GetZipBytes(const char *treeName, const char *branchName = 0);
  private:
   AliESDEvent *fESD;    //! ESD event
   AliMCEvent *fMC;      //! MC event
@@ -162,6 +168,9 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   EAnalysisMode fAnalysisMode;   // analysis mode TPC only, TPC + ITS
 
   TTreeSRedirector* fTreeSRedirector;      //! temp tree to dump output
+  AliFilteredTreeAsyncWriter* fAsyncWriter; //! asynchronous writer of the trees (optional)
+  Int_t fAsyncWriterQueueSize;              // maximal number of chunks queued for the asynchronous writer (0 - synchronous writing)
+  Long64_t fAsyncWriterChunkSize;           // bytes buffered in memory per chunk of the asynchronous writer
 
   TString fCentralityEstimator;     // use centrality can be "VOM" (default), "FMD", "TRK", "TKL", "CL0", "CL1", "V0MvsFMD", "TKLvsV0M", "ZEMvsZDC"
 
@@ -202,7 +211,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
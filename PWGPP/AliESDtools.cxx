@@ -43,11 +43,17 @@
   tree->Draw("AliESDtools::SDumpEventVariables()","AliESDtools::SCalculateEventVariables(Entry$)");
   tools->SetStreamer(0);
   delete pcstream;
+  /// 3.) Exercise: materialise the event variables once into a friend tree, and query them as columns
+  tools.MaterializeEventVariables("eventVariables.root");
+  AliESDtools::AddEventVariablesFriend(tree,"eventVariables.root");
+  tree->Draw("ev.trackCounters[0]:ev.TPCVertexInfo[2]","ev.trackMatchEff[0]>0");   // instead of AliESDtools::GetTrackCounters(0,0) ...
 */
 
 
 #include "TStopwatch.h"
 #include "TTree.h"
+#include "TFile.h"
+#include "TFriendElement.h"
 #include "TGrid.h"
 #include "TChain.h"
 #include "TVectorF.h"
@@ -83,6 +89,7 @@
 
 ClassImp(AliESDtools)
 AliESDtools*  AliESDtools::fgInstance;
+const char*   AliESDtools::fgkEventVariablesTreeName="eventVariables";
 
 AliESDtools::AliESDtools():
   fVerbose(0),
@@ -1110,6 +1117,119 @@ Int_t AliESDtools::DumpEventVariables() {
 
   return 0;
 }
+/// Materialise the derived event variables into a friend tree
+/// * CalculateEventVariables() is called once per entry of the ESD tree and the selected caches are stored as
+///   fixed size float arrays (one branch per cache, named as the corresponding getter e.g trackCounters[20])
+/// * the tree is indexed by the event identifier (period, orbit*3564+bunch crossing), the run number, gid and
+///   input entry are stored as well - see AddEventVariablesFriend
+/// \param outputName    - output file name
+/// \param variableMask  - caches to store - see EEventVariables
+/// \param firstEntry    - first entry of the ESD tree
+/// \param nEntries      - number of entries (<0 - all)
+/// \param compression   - compression settings of the output file (default LZ4 - fast reading)
+/// \return              - number of stored events
+Int_t AliESDtools::MaterializeEventVariables(const char *outputName, Int_t variableMask, Long64_t firstEntry, Long64_t nEntries, Int_t compression) {
+  if (fESDtree == nullptr || fEvent == nullptr || fCacheTrackCounters == nullptr || fTaskMode) {
+    ::Error("AliESDtools::MaterializeEventVariables", "Tool not initialized in the tree mode");
+    return 0;
+  }
+  if (fgInstance != this) {
+    ::Error("AliESDtools::MaterializeEventVariables", "Only the last created instance can load the ESD");
+    return 0;
+  }
+  Long64_t lastEntry = fESDtree->GetEntries();
+  if (nEntries >= 0 && firstEntry + nEntries < lastEntry) lastEntry = firstEntry + nEntries;
+  TFile *fout = TFile::Open(outputName, "recreate");
+  if (fout == nullptr || fout->IsZombie()) {
+    ::Error("AliESDtools::MaterializeEventVariables", "Can not open output file %s", outputName);
+    delete fout;
+    return 0;
+  }
+  fout->SetCompressionSettings(compression);
+  TTree *tree = new TTree(fgkEventVariablesTreeName, "AliESDtools derived event variables");
+  Int_t run = 0;
+  UInt_t period = 0;
+  Long64_t orbitBC = 0, entry = 0;
+  ULong64_t gid = 0;
+  Float_t meanTPCVertexA = 0, meanTPCVertexC = 0;
+  tree->Branch("run", &run, "run/I");
+  tree->Branch("period", &period, "period/i");
+  tree->Branch("orbitBC", &orbitBC, "orbitBC/L");
+  tree->Branch("gid", &gid, "gid/l");
+  tree->Branch("entry", &entry, "entry/L");
+  // the caches are allocated once in Init - branches point directly to their arrays
+  const struct {
+    Int_t mask;
+    const char *name;
+    TVectorF *cache;
+  } caches[] = {
+    {kTrackCounters, "trackCounters", fCacheTrackCounters},
+    {kTrackTPCCountersZ, "trackTPCCountersZ", fCacheTrackTPCCountersZ},
+    {kTrackdEdxRatio, "trackdEdxRatio", fCacheTrackdEdxRatio},
+    {kTrackNcl, "trackNcl", fCacheTrackNcl},
+    {kTrackChi2, "trackChi2", fCacheTrackChi2},
+    {kTrackMatchEff, "trackMatchEff", fCacheTrackMatchEff},
+    {kTPCVertexInfo, "TPCVertexInfo", fTPCVertexInfo},
+    {kITSVertexInfo, "ITSVertexInfo", fITSVertexInfo}
+  };
+  for (const auto &cache : caches) {
+    if ((variableMask & cache.mask) == 0) continue;
+    tree->Branch(cache.name, cache.cache->GetMatrixArray(), TString::Format("%s[%d]/F", cache.name, cache.cache->GetNrows()));
+  }
+  if (variableMask & kTPCVertexInfo) {
+    tree->Branch("meanTPCVertexA", &meanTPCVertexA, "meanTPCVertexA/F");
+    tree->Branch("meanTPCVertexC", &meanTPCVertexC, "meanTPCVertexC/F");
+  }
+  //
+  TStopwatch timer;
+  for (entry = firstEntry; entry < lastEntry; entry++) {
+    LoadESD(entry);
+    CalculateEventVariables();
+    run = fEvent->GetRunNumber();
+    period = fEvent->GetPeriodNumber();
+    orbitBC = Long64_t(fEvent->GetOrbitNumber()) * 3564 + fEvent->GetBunchCrossNumber();
+    gid = (ULong64_t(period) << 36) | (ULong64_t(fEvent->GetOrbitNumber()) << 12) | fEvent->GetBunchCrossNumber();
+    meanTPCVertexA = fHisTPCVertexA->GetMean();
+    meanTPCVertexC = fHisTPCVertexC->GetMean();
+    tree->Fill();
+    if (fVerbose > 0 && (entry - firstEntry) % 1000 == 0) {
+      ::Info("AliESDtools::MaterializeEventVariables", "Entry %lld/%lld", entry, lastEntry);
+    }
+  }
+  tree->BuildIndex("period", "orbitBC");
+  tree->Write();
+  Int_t nStored = tree->GetEntries();
+  if (fVerbose > 0) {
+    ::Info("AliESDtools::MaterializeEventVariables", "%d events stored in %s, real time %f s", nStored, outputName, timer.RealTime());
+  }
+  delete fout;   // closes the file and deletes the tree
+  return nStored;
+}
+
+/// Attach the event variables written by MaterializeEventVariables as friend
+/// * entries are matched using the event identifier - the input can be any (sub)set of the events, in any order;
+///   the expressions are evaluated in the input tree (defaults for the esdTree, for filtered trees e.g "gid>>36")
+/// * cached variables can be then queried as columns, e.g  AliESDtools::GetTrackCounters(0,0) -> ev.trackCounters[0]
+/// \param tree                - input tree or chain
+/// \param fileName            - file with the event variables
+/// \param friendAlias         - friend alias
+/// \param periodExpression    - period number expression in the input tree
+/// \param orbitBCExpression   - orbit*3564+bunch crossing expression in the input tree
+/// \return                    - friend tree or nullptr
+TTree* AliESDtools::AddEventVariablesFriend(TTree *tree, const char *fileName, const char *friendAlias, const char *periodExpression, const char *orbitBCExpression) {
+  if (tree == nullptr) return nullptr;
+  // the friend index is evaluated in the input tree using the index names
+  if (TString(periodExpression) != "period") tree->SetAlias("period", periodExpression);
+  if (TString(orbitBCExpression) != "orbitBC") tree->SetAlias("orbitBC", orbitBCExpression);
+  TFriendElement *element = tree->AddFriend(TString::Format("%s=%s", friendAlias, fgkEventVariablesTreeName), fileName);
+  if (element == nullptr || element->GetTree() == nullptr) {
+    ::Error("AliESDtools::AddEventVariablesFriend", "Tree %s not found in %s", fgkEventVariablesTreeName, fileName);
+    if (element) tree->RemoveFriend(element->GetTree());
+    return nullptr;
+  }
+  return element->GetTree();
+}
+
 /// Set default tree aliases and corresponding metadata for anotation
 /// \param tree - input tree
 /// \return
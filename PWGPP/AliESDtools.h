@@ -16,6 +16,12 @@ class AliTriggerAnalysis;
 
 class AliESDtools : public TNamed {
   public:
+  /// groups of cached event variables stored by MaterializeEventVariables
+  enum EEventVariables {
+    kTrackCounters=0x1, kTrackTPCCountersZ=0x2, kTrackdEdxRatio=0x4, kTrackNcl=0x8,
+    kTrackChi2=0x10, kTrackMatchEff=0x20, kTPCVertexInfo=0x40, kITSVertexInfo=0x80,
+    kAllEventVariables=0xFF
+  };
   AliESDtools();
   void Init(TTree* tree, AliESDEvent *event= nullptr);
   void SetStreamer(TTreeSRedirector *streamer){fStreamer=streamer;}
@@ -33,6 +39,11 @@ class AliESDtools : public TNamed {
   //
   Int_t DumpEventVariables();
   static Int_t SDumpEventVariables(){return fgInstance->DumpEventVariables();}
+  // columnar cache of the event variables - friend tree instead of the static functions
+  Int_t MaterializeEventVariables(const char *outputName, Int_t variableMask=kAllEventVariables, Long64_t firstEntry=0, Long64_t nEntries=-1, Int_t compression=404);
+  static TTree* AddEventVariablesFriend(TTree *tree, const char *fileName, const char *friendAlias="ev",
+                                        const char *periodExpression="AliESDHeader.fPeriodNumber",
+                                        const char *orbitBCExpression="AliESDHeader.fOrbitNumber*3564+AliESDHeader.fBunchCrossNumber");
   // static functions for querying cached variables in TTree formula
   static Int_t    SCalculateEventVariables(Int_t entry){LoadESD(entry,0); return fgInstance->CalculateEventVariables();}
   static Double_t GetTrackCounters(Int_t index, Int_t toolIndex){return (*fgInstance->fCacheTrackCounters)[index];}
@@ -87,6 +98,7 @@ class AliESDtools : public TNamed {
   //
   TTreeSRedirector * fStreamer;                  /// streamer
   static AliESDtools* fgInstance;                /// instance of the tool -needed in order to use static functions (for TTreeFormula)
+  static const char* fgkEventVariablesTreeName;  /// name of the event variables friend tree
   private:
   AliESDtools(AliESDtools&);
   AliESDtools &operator=(const AliESDtools&);
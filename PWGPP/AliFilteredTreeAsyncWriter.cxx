@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+// Implementation of AliFilteredTreeAsyncWriter - asynchronous writer of the
+// filtered trees, see the header.
+//------------------------------------------------------------------------------
+
+#include <chrono>
+
+#include "TROOT.h"
+#include "TDirectory.h"
+#include "TMemFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TTreeStream.h"
+#include "TString.h"
+
+#include "AliFilteredTreeAsyncWriter.h"
+
+namespace {
+  Double_t WallTime()
+  {
+    return std::chrono::duration<Double_t>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeAsyncWriter::AliFilteredTreeAsyncWriter(TDirectory *outputDirectory, Int_t maxQueuedChunks, Long64_t chunkSize):
+  fOutputDirectory(outputDirectory),
+  fMaxQueuedChunks(maxQueuedChunks > 0 ? maxQueuedChunks : 1),
+  fChunkSize(chunkSize),
+  fRedirector(0),
+  fChunkFile(0),
+  fNChunks(0),
+  fQueue(),
+  fMutex(),
+  fQueueNotFull(),
+  fQueueNotEmpty(),
+  fStop(kFALSE),
+  fThread(),
+  fTrees(),
+  fZipBytes(),
+  fNRecords(0),
+  fNBytes(0),
+  fMaxQueueDepth(0),
+  fSumQueueDepth(0),
+  fBlockedTime(0),
+  fWriteTime(0),
+  fStartTime(WallTime()),
+  fElapsedTime(0)
+{
+  // the chunks are filled and the output trees written in different threads
+  ROOT::EnableThreadSafety();
+  OpenChunk();
+  fThread = std::thread(&AliFilteredTreeAsyncWriter::Run, this);
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeAsyncWriter::~AliFilteredTreeAsyncWriter()
+{
+  Close();
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeAsyncWriter::OpenChunk()
+{
+  // the redirector creates its trees in the current directory
+  TDirectory::TContext context;
+  fChunkFile = new TMemFile(TString::Format("filteredTreeChunk%d.root", fNChunks++), "RECREATE", "", 0);
+  fRedirector = new TTreeSRedirector();
+}
+
+//_____________________________________________________________________________
+Bool_t AliFilteredTreeAsyncWriter::EndEvent()
+{
+  if (!fChunkFile || fChunkFile->GetEND() < fChunkSize) return kFALSE;
+  Submit();
+  OpenChunk();
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeAsyncWriter::Submit()
+{
+  // hand over the current chunk, wait while the queue is full
+  // the sizes queried so far are accumulated with all baskets of the chunk written
+  TIter next(fChunkFile->GetList());
+  while (TObject *obj = next()) {
+    if (TTree *chunkTree = dynamic_cast<TTree*>(obj)) chunkTree->FlushBaskets();
+  }
+  for (auto &bytes : fZipBytes) bytes.second += GetChunkZipBytes(bytes.first.first, bytes.first.second);
+  Chunk chunk = {fRedirector, fChunkFile};
+  fNBytes += fChunkFile->GetEND();
+  fRedirector = 0;
+  fChunkFile = 0;
+
+  const Double_t start = WallTime();
+  std::unique_lock<std::mutex> lock(fMutex);
+  fQueueNotFull.wait(lock, [this] { return (Int_t)fQueue.size() < fMaxQueuedChunks; });
+  fBlockedTime += WallTime() - start;
+  fQueue.push_back(chunk);
+  const Int_t depth = fQueue.size();
+  if (depth > fMaxQueueDepth) fMaxQueueDepth = depth;
+  fSumQueueDepth += depth;
+  lock.unlock();
+  fQueueNotEmpty.notify_one();
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeAsyncWriter::Run()
+{
+  // writer thread: copy the queued chunks until the writer is closed
+  for (;;) {
+    Chunk chunk;
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fQueueNotEmpty.wait(lock, [this] { return fStop || !fQueue.empty(); });
+      if (fQueue.empty()) return;
+      chunk = fQueue.front();
+      fQueue.pop_front();
+    }
+    fQueueNotFull.notify_one();
+    const Double_t start = WallTime();
+    CopyChunk(chunk);
+    fWriteTime += WallTime() - start;
+  }
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeAsyncWriter::CopyChunk(Chunk &chunk)
+{
+  // the redirector flushes its trees to the in-memory file when deleted
+  delete chunk.fRedirector;
+  TIter next(chunk.fFile->GetList());
+  while (TObject *obj = next()) {
+    TTree *chunkTree = dynamic_cast<TTree*>(obj);
+    if (!chunkTree || chunkTree->GetEntries() <= 0) continue;
+    // the branch addresses point to the variables streamed by the task
+    chunkTree->ResetBranchAddresses();
+    TTree *&tree = fTrees[chunkTree->GetName()];
+    if (!tree) {
+      TDirectory::TContext context(fOutputDirectory);
+      tree = chunkTree->CloneTree(0);
+    }
+    fNRecords += chunkTree->GetEntries();
+    tree->CopyEntries(chunkTree);
+    tree->ResetBranchAddresses();
+  }
+  delete chunk.fFile;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeAsyncWriter::Close()
+{
+  if (!fThread.joinable()) return;
+  Submit();
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = kTRUE;
+  }
+  fQueueNotEmpty.notify_one();
+  fThread.join();
+  fElapsedTime = WallTime() - fStartTime;
+
+  TDirectory::TContext context(fOutputDirectory);
+  for (auto &tree : fTrees) tree.second->Write(tree.first.c_str());
+  PrintStatistics();
+}
+
+//_____________________________________________________________________________
+TTree *AliFilteredTreeAsyncWriter::GetTree(const char *name)
+{
+  TTree *&tree = fTrees[name];
+  if (!tree) {
+    TDirectory::TContext context(fOutputDirectory);
+    tree = new TTree(name, name);
+  }
+  return tree;
+}
+
+//_____________________________________________________________________________
+Double_t AliFilteredTreeAsyncWriter::GetZipBytes(const char *treeName, const char *branchName)
+{
+  // the first query registers the (tree, branch) for the accumulation at Submit()
+  const std::pair<std::string, std::string> key(treeName, branchName ? branchName : "");
+  return fZipBytes[key] + GetChunkZipBytes(key.first, key.second);
+}
+
+//_____________________________________________________________________________
+Double_t AliFilteredTreeAsyncWriter::GetChunkZipBytes(const std::string &treeName, const std::string &branchName) const
+{
+  TTree *tree = fChunkFile ? dynamic_cast<TTree*>(fChunkFile->GetList()->FindObject(treeName.c_str())) : 0;
+  if (!tree) return 0;
+  if (branchName.empty()) return tree->GetZipBytes();
+  TBranch *br = tree->GetBranch(branchName.c_str());
+  return br ? br->GetZipBytes() : 0;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeAsyncWriter::PrintStatistics() const
+{
+  const Double_t elapsed = fElapsedTime > 0 ? fElapsedTime : WallTime() - fStartTime;
+  const Int_t nSubmitted = fNChunks - (fChunkFile ? 1 : 0);
+  printf("AliFilteredTreeAsyncWriter: %lld records, %.1f MB in %d chunks, %.1f s\n",
+         fNRecords, fNBytes / 1.e6, nSubmitted, elapsed);
+  if (elapsed > 0) printf("  %.1f records/s, %.2f MB/s\n", fNRecords / elapsed, fNBytes / 1.e6 / elapsed);
+  printf("  queue depth: mean %.2f, max %d of %d\n", nSubmitted > 0 ? fSumQueueDepth / nSubmitted : 0., fMaxQueueDepth, fMaxQueuedChunks);
+  printf("  writer busy %.1f s, task blocked %.1f s\n", fWriteTime, fBlockedTime);
+}
@@ -0,0 +1,98 @@
+#ifndef ALIFILTEREDTREEASYNCWRITER_H
+#define ALIFILTEREDTREEASYNCWRITER_H
+
+//------------------------------------------------------------------------------
+// Asynchronous writer of the filtered trees (AliAnalysisTaskFilteredTree).
+//
+// The task streams into a TTreeSRedirector attached to an uncompressed
+// in-memory file (chunk). Once a chunk exceeds the chunk size it is handed
+// over, at the end of an event, to a queue of limited depth and the task
+// continues with a new chunk. A background thread appends the entries of the
+// queued chunks to the trees of the output file, where the baskets are
+// compressed and written. When the queue is full the task waits for the
+// writer (back-pressure), so that the memory use is bounded by
+// (queue depth + 1) x chunk size.
+//
+// The output trees are created at the first non empty chunk with the branch
+// structure of the streamed trees, and are available after Close().
+//
+// GetZipBytes() gives the size of a tree (branch) summed over the chunks,
+// for decisions of the task based on the data volume written so far. The
+// chunks are not compressed, the sizes are the uncompressed ones.
+//------------------------------------------------------------------------------
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include "Rtypes.h"
+
+class TDirectory;
+class TMemFile;
+class TTree;
+class TTreeSRedirector;
+
+class AliFilteredTreeAsyncWriter {
+public:
+  AliFilteredTreeAsyncWriter(TDirectory *outputDirectory, Int_t maxQueuedChunks = 4, Long64_t chunkSize = 32000000);
+  ~AliFilteredTreeAsyncWriter();
+
+  // redirector of the current chunk - changes when EndEvent() returns kTRUE
+  TTreeSRedirector *GetRedirector() const { return fRedirector; }
+  // to be called after each event - hands over the chunk when full
+  Bool_t EndEvent();
+  // hands over the last chunk, waits for the writer and writes the trees
+  void Close();
+  // output tree (an empty tree is created for streams without entries)
+  TTree *GetTree(const char *name);
+  // bytes of the tree (branch) written to the chunks so far, including the current one
+  Double_t GetZipBytes(const char *treeName, const char *branchName = 0);
+  void PrintStatistics() const;
+
+private:
+  struct Chunk {
+    TTreeSRedirector *fRedirector;  // redirector of the chunk
+    TMemFile *fFile;                // in-memory file of the chunk trees
+  };
+
+  void OpenChunk();
+  void Submit();
+  void Run();
+  void CopyChunk(Chunk &chunk);
+  Double_t GetChunkZipBytes(const std::string &treeName, const std::string &branchName) const;
+
+  TDirectory *fOutputDirectory;     // directory of the output trees - not owner
+  Int_t fMaxQueuedChunks;           // queue depth
+  Long64_t fChunkSize;              // bytes streamed to a chunk before it is handed over
+  TTreeSRedirector *fRedirector;    // redirector of the current chunk
+  TMemFile *fChunkFile;             // in-memory file of the current chunk
+  Int_t fNChunks;                   // number of chunks opened
+
+  std::deque<Chunk> fQueue;         // chunks waiting for the writer
+  std::mutex fMutex;                // protects the queue and fStop
+  std::condition_variable fQueueNotFull;
+  std::condition_variable fQueueNotEmpty;
+  Bool_t fStop;                     // no more chunks will be submitted
+  std::thread fThread;              // writer thread
+
+  std::map<std::string, TTree*> fTrees;  // output trees - owned by the output directory
+  std::map<std::pair<std::string, std::string>, Double_t> fZipBytes;  // bytes of the submitted chunks per (tree, branch) queried by GetZipBytes - task thread only
+
+  // statistics
+  Long64_t fNRecords;               // entries written
+  Long64_t fNBytes;                 // bytes streamed to the chunks
+  Int_t fMaxQueueDepth;             // maximal queue depth at submission
+  Double_t fSumQueueDepth;          // sum of the queue depths at submission
+  Double_t fBlockedTime;            // time the task waited for a free queue slot (s)
+  Double_t fWriteTime;              // time spent by the writer thread (s)
+  Double_t fStartTime;              // creation time (s)
+  Double_t fElapsedTime;            // time between creation and close (s)
+
+  AliFilteredTreeAsyncWriter(const AliFilteredTreeAsyncWriter&); // not implemented
+  AliFilteredTreeAsyncWriter& operator=(const AliFilteredTreeAsyncWriter&); // not implemented
+};
+
+#endif
@@ -35,11 +35,15 @@
 
 #include "AliLog.h" 
 #include "AliPerformanceObject.h" 
+#include "AliPerformanceSparseProjector.h"
 
 using namespace std;
 
 ClassImp(AliPerformanceObject)
 
+Bool_t AliPerformanceObject::fgSinglePassProjections = kTRUE;
+Int_t  AliPerformanceObject::fgProjectionThreads = 1;
+
 //_____________________________________________________________________________
 AliPerformanceObject::AliPerformanceObject(TRootIOCtor*):
   AliMergeable(),
@@ -56,7 +60,8 @@ AliPerformanceObject::AliPerformanceObject(TRootIOCtor*):
   fUseTOFBunchCrossing(kFALSE),
   fUseSparse(1),
   fCutsRC(),
-  fCutsMC()
+  fCutsMC(),
+  fProjector(0)
 {
   // io constructor
 }
@@ -77,7 +82,8 @@ AliPerformanceObject::AliPerformanceObject(const char* name, const char* title,
   fUseTOFBunchCrossing(kFALSE),
   fUseSparse(1),
   fCutsRC(),
-  fCutsMC()
+  fCutsMC(),
+  fProjector(0)
 {
 
     // constructor
@@ -86,6 +92,7 @@ AliPerformanceObject::AliPerformanceObject(const char* name, const char* title,
 //_____________________________________________________________________________
 AliPerformanceObject::~AliPerformanceObject(){
   // destructor 
+  delete fProjector;
 }
 
 //_____________________________________________________________________________
@@ -195,7 +202,8 @@ void AliPerformanceObject::AddProjection(TObjArray* aFolderObj, TString nameSpar
   name += xDim;
   TString title = hSparse->GetAxis(xDim)->GetTitle();  
   if (selString) { title += " (" + *selString + ")"; }
-  h1 = hSparse->Projection(xDim);
+  if (fProjector && fProjector->GetSparse() == hSparse) h1 = fProjector->Book(xDim);
+  else h1 = hSparse->Projection(xDim);
   h1->SetName(name.Data());
   h1->GetXaxis()->SetTitle(hSparse->GetAxis(xDim)->GetTitle());
   h1->SetTitle(title.Data());  
@@ -217,7 +225,8 @@ void AliPerformanceObject::AddProjection(TObjArray* aFolderObj, TString nameSpar
   title += " vs ";
   title += hSparse->GetAxis(xDim)->GetTitle();
   if (selString) { title += " (" + *selString + ")"; }  
-  h2 = hSparse->Projection(yDim,xDim);
+  if (fProjector && fProjector->GetSparse() == hSparse) h2 = (TH2*)fProjector->Book(yDim,xDim);
+  else h2 = hSparse->Projection(yDim,xDim);
   h2->SetName(name.Data());
   h2->GetXaxis()->SetTitle(hSparse->GetAxis(xDim)->GetTitle());
   h2->GetYaxis()->SetTitle(hSparse->GetAxis(yDim)->GetTitle());
@@ -244,7 +253,8 @@ void AliPerformanceObject::AddProjection(TObjArray* aFolderObj, TString nameSpar
   title += " vs ";
   title += hSparse->GetAxis(zDim)->GetTitle();
   if (selString) { title += " (" + *selString + ")"; }
-  h3 = hSparse->Projection(xDim,yDim,zDim);
+  if (fProjector && fProjector->GetSparse() == hSparse) h3 = (TH3*)fProjector->Book(xDim,yDim,zDim);
+  else h3 = hSparse->Projection(xDim,yDim,zDim);
   h3->SetName(name.Data());
   h3->GetXaxis()->SetTitle(hSparse->GetAxis(xDim)->GetTitle());
   h3->GetYaxis()->SetTitle(hSparse->GetAxis(yDim)->GetTitle());
@@ -252,3 +262,24 @@ void AliPerformanceObject::AddProjection(TObjArray* aFolderObj, TString nameSpar
   h3->SetTitle(title.Data());  
   aFolderObj->Add(h3);
 }
+
+
+//_____________________________________________________________________________
+void AliPerformanceObject::BeginProjections(THnSparse *hSparse)
+{
+  // book the following projections of hSparse instead of projecting them one by one
+  // (each THnSparse::Projection is a sweep over all filled bins)
+  EndProjections();
+  if (!fgSinglePassProjections || !hSparse) return;
+  fProjector = new AliPerformanceSparseProjector(hSparse);
+}
+
+//_____________________________________________________________________________
+void AliPerformanceObject::EndProjections()
+{
+  // fill the booked projections with one pass over the filled bins
+  if (!fProjector) return;
+  fProjector->Fill(fgProjectionThreads);
+  delete fProjector;
+  fProjector = 0;
+}
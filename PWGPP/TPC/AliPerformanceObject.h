@@ -23,6 +23,7 @@ class AliMCInfoCuts;
 class AliVfriendEvent;
 class AliESDVertex;
 class TRootIOCtor;
+class AliPerformanceSparseProjector;
 #include "AliRecInfoCuts.h"
 #include "AliMCInfoCuts.h"
 
@@ -117,9 +118,21 @@ public :
   Bool_t IsUseTOFBunchCrossing() { return fUseTOFBunchCrossing; }
 
   virtual void ResetOutputData() { ; }
+
+  // projections of a THnSparse computed with a single pass over its filled bins
+  // (see BeginProjections), with the given number of threads
+  static void SetSinglePassProjections(Bool_t singlePass) { fgSinglePassProjections = singlePass; }
+  static Bool_t GetSinglePassProjections() { return fgSinglePassProjections; }
+  static void SetProjectionThreads(Int_t nThreads) { fgProjectionThreads = nThreads; }
+  static Int_t GetProjectionThreads() { return fgProjectionThreads; }
     
 protected: 
 
+  // AddProjection calls for hSparse between BeginProjections and EndProjections only book
+  // the projections (with the current axis ranges), EndProjections fills them all at once
+  void BeginProjections(THnSparse *hSparse);
+  void EndProjections();
+
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, Int_t zDim, TString* selString = 0);
@@ -155,7 +168,12 @@ protected:
   AliRecInfoCuts fCutsRC;  // selection cuts for reconstructed tracks
   AliMCInfoCuts  fCutsMC;  // selection cuts for MC tracks
 
-  ClassDef(AliPerformanceObject,11);
+  AliPerformanceSparseProjector *fProjector; //! booked single pass projections
+
+  static Bool_t fgSinglePassProjections; // single pass projections in BeginProjections/EndProjections
+  static Int_t  fgProjectionThreads;     // threads filling the single pass projections
+
+  ClassDef(AliPerformanceObject,12);
 };
 
 #endif
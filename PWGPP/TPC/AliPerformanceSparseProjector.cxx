@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+// Implementation of AliPerformanceSparseProjector - single pass projections
+// of a THnSparse, see the header.
+//------------------------------------------------------------------------------
+
+#include <thread>
+
+#include "TH1.h"
+#include "TAxis.h"
+#include "TMath.h"
+#include "TString.h"
+#include "THnSparse.h"
+
+#include "AliPerformanceSparseProjector.h"
+
+//_____________________________________________________________________________
+AliPerformanceSparseProjector::AliPerformanceSparseProjector(THnSparse *hSparse):
+  fSparse(hSparse),
+  fEmpty(0),
+  fProjections()
+{
+  // the projection histograms are created by projecting an empty sparse
+  // with the same binning, axis ranges and errors
+  fEmpty = THnSparse::CreateSparse(TString::Format("%s_projector",hSparse->GetName()), hSparse->GetTitle(), hSparse);
+  if (hSparse->GetCalculateErrors()) fEmpty->Sumw2();
+}
+
+//_____________________________________________________________________________
+AliPerformanceSparseProjector::~AliPerformanceSparseProjector()
+{
+  delete fEmpty;
+}
+
+//_____________________________________________________________________________
+TH1 *AliPerformanceSparseProjector::Book(Int_t xDim)
+{
+  Int_t dim[1] = {xDim};
+  return Book(1, dim, dim);
+}
+
+//_____________________________________________________________________________
+TH1 *AliPerformanceSparseProjector::Book(Int_t yDim, Int_t xDim)
+{
+  // same argument order as THnSparse::Projection(yDim,xDim)
+  Int_t dim[2] = {xDim, yDim};
+  Int_t args[2] = {yDim, xDim};
+  return Book(2, dim, args);
+}
+
+//_____________________________________________________________________________
+TH1 *AliPerformanceSparseProjector::Book(Int_t xDim, Int_t yDim, Int_t zDim)
+{
+  Int_t dim[3] = {xDim, yDim, zDim};
+  return Book(3, dim, dim);
+}
+
+//_____________________________________________________________________________
+TH1 *AliPerformanceSparseProjector::Book(Int_t nDim, const Int_t *dim, const Int_t *projectionArgs)
+{
+  Projection proj;
+  proj.fNDim = nDim;
+  proj.fDim[0] = proj.fDim[1] = proj.fDim[2] = 0;
+  proj.fOffset[0] = proj.fOffset[1] = proj.fOffset[2] = 0;
+
+  // current ranges of the sparse: selection of the bins and binning of the target axes
+  for (Int_t d = 0; d < fSparse->GetNdimensions(); d++) {
+    TAxis *axis = fSparse->GetAxis(d);
+    TAxis *emptyAxis = fEmpty->GetAxis(d);
+    Bool_t hasRange = axis->TestBit(TAxis::kAxisRange);
+    if (hasRange) emptyAxis->SetRange(axis->GetFirst(), axis->GetLast());
+    else emptyAxis->SetRange();
+    emptyAxis->SetBit(TAxis::kAxisRange, hasRange);
+    if (!hasRange) continue;
+    Int_t rangeMin = axis->GetFirst();
+    Int_t rangeMax = axis->GetLast();
+    if (rangeMin == 0 && rangeMax == 0) { rangeMin = 1; rangeMax = axis->GetNbins(); }
+    proj.fRangeDim.push_back(d);
+    proj.fRangeMin.push_back(rangeMin);
+    proj.fRangeMax.push_back(rangeMax);
+  }
+  for (Int_t i = 0; i < nDim; i++) {
+    proj.fDim[i] = dim[i];
+    TAxis *axis = fSparse->GetAxis(dim[i]);
+    if (axis->TestBit(TAxis::kAxisRange) && axis->GetFirst() > 0) proj.fOffset[i] = axis->GetFirst() - 1;
+  }
+
+  if (nDim == 1) proj.fHisto = fEmpty->Projection(projectionArgs[0]);
+  else if (nDim == 2) proj.fHisto = fEmpty->Projection(projectionArgs[0], projectionArgs[1]);
+  else proj.fHisto = fEmpty->Projection(projectionArgs[0], projectionArgs[1], projectionArgs[2]);
+  proj.fComputeErrors = proj.fHisto->GetSumw2N() > 0;
+
+  fProjections.push_back(proj);
+  return proj.fHisto;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceSparseProjector::FillProjections(const Int_t *coord, const Double_t *content, const Double_t *error2, Long64_t nBins, Int_t first, Int_t step)
+{
+  // fill the projections first, first+step, ... with a block of decoded bins
+  const Int_t nSparseDim = fSparse->GetNdimensions();
+  for (Int_t iProj = first; iProj < GetNProjections(); iProj += step) {
+    Projection &proj = fProjections[iProj];
+    const Int_t nRanges = proj.fRangeDim.size();
+    Double_t *sumw2 = proj.fComputeErrors ? proj.fHisto->GetSumw2()->GetArray() : 0;
+    for (Long64_t iBin = 0; iBin < nBins; iBin++) {
+      const Int_t *binCoord = coord + iBin*nSparseDim;
+      Bool_t selected = kTRUE;
+      for (Int_t iRange = 0; iRange < nRanges; iRange++) {
+        const Int_t c = binCoord[proj.fRangeDim[iRange]];
+        if (c < proj.fRangeMin[iRange] || c > proj.fRangeMax[iRange]) { selected = kFALSE; break; }
+      }
+      if (!selected) continue;
+      Int_t bins[3] = {0, 0, 0};
+      for (Int_t i = 0; i < proj.fNDim; i++) bins[i] = binCoord[proj.fDim[i]] - proj.fOffset[i];
+      const Int_t targetBin = proj.fHisto->GetBin(bins[0], bins[1], bins[2]);
+      proj.fHisto->AddBinContent(targetBin, content[iBin]);
+      if (sumw2) sumw2[targetBin] += error2[iBin];
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void AliPerformanceSparseProjector::Fill(Int_t nThreads)
+{
+  // single pass over the filled bins, decoded block by block; the
+  // projections of a block are filled by up to nThreads threads
+  if (fProjections.empty()) return;
+  if (nThreads > GetNProjections()) nThreads = GetNProjections();
+  if (nThreads < 1) nThreads = 1;
+
+  const Int_t nSparseDim = fSparse->GetNdimensions();
+  const Long64_t kBlockSize = 1 << 16;
+  const Long64_t nFilled = fSparse->GetNbins();
+  std::vector<Int_t> coord(kBlockSize*nSparseDim);
+  std::vector<Double_t> content(kBlockSize), error2(kBlockSize);
+
+  for (Long64_t blockStart = 0; blockStart < nFilled; blockStart += kBlockSize) {
+    const Long64_t nBins = TMath::Min(kBlockSize, nFilled - blockStart);
+    for (Long64_t iBin = 0; iBin < nBins; iBin++) {
+      content[iBin] = fSparse->GetBinContent(blockStart + iBin, &coord[iBin*nSparseDim]);
+      error2[iBin] = fSparse->GetBinError2(blockStart + iBin);
+    }
+    std::vector<std::thread> threads;
+    for (Int_t iThread = 1; iThread < nThreads; iThread++) {
+      threads.emplace_back(&AliPerformanceSparseProjector::FillProjections, this, coord.data(), content.data(), error2.data(), nBins, iThread, nThreads);
+    }
+    FillProjections(coord.data(), content.data(), error2.data(), nBins, 0, nThreads);
+    for (auto &thread : threads) thread.join();
+  }
+
+  // entries as in THnBase::Projection
+  for (auto &proj : fProjections) {
+    if (proj.fRangeDim.empty()) {
+      proj.fHisto->SetEntries(fSparse->GetEntries());
+    } else {
+      proj.fHisto->ResetStats();
+      Double_t entries = proj.fHisto->GetEffectiveEntries();
+      if (!proj.fComputeErrors) entries = TMath::Floor(entries + 0.5);
+      proj.fHisto->SetEntries(entries);
+    }
+  }
+}
@@ -0,0 +1,66 @@
+#ifndef ALIPERFORMANCESPARSEPROJECTOR_H
+#define ALIPERFORMANCESPARSEPROJECTOR_H
+
+//------------------------------------------------------------------------------
+// Helper to compute many 1D/2D/3D projections of a THnSparse with a single
+// pass over its filled bins (THnSparse::Projection sweeps all filled bins
+// for each projection).
+//
+// Projections are booked with the axis ranges set on the sparse at booking
+// time and are returned empty; Fill() loops once over the filled bins and
+// fills all of them. The projections are identical to THnSparse::Projection
+// (binning of the ranged target axes, errors, entries). The filling can be
+// shared between threads, each thread filling its own projections.
+//
+// Used by AliPerformanceObject::AddProjection between BeginProjections()
+// and EndProjections().
+//------------------------------------------------------------------------------
+
+#include <vector>
+#include "Rtypes.h"
+
+class TH1;
+class THnSparse;
+
+class AliPerformanceSparseProjector {
+public :
+  AliPerformanceSparseProjector(THnSparse *hSparse);
+  ~AliPerformanceSparseProjector();
+
+  THnSparse *GetSparse() const { return fSparse; }
+  Int_t GetNProjections() const { return fProjections.size(); }
+
+  // book projections with the current axis ranges of the sparse
+  // the histograms are owned by the caller
+  TH1 *Book(Int_t xDim);
+  TH1 *Book(Int_t yDim, Int_t xDim);
+  TH1 *Book(Int_t xDim, Int_t yDim, Int_t zDim);
+
+  // fill all booked projections, nThreads > 1 shares them between threads
+  void Fill(Int_t nThreads = 1);
+
+private :
+
+  struct Projection {
+    TH1 *fHisto;                   // projection histogram
+    Int_t fNDim;                   // 1, 2 or 3
+    Int_t fDim[3];                 // sparse axis of the x, y, z axes of the histogram
+    Int_t fOffset[3];              // bin offset of the x, y, z axes (ranged target axes)
+    std::vector<Int_t> fRangeDim;  // ranged axes of the sparse
+    std::vector<Int_t> fRangeMin;  // first bin of the ranged axes
+    std::vector<Int_t> fRangeMax;  // last bin of the ranged axes
+    Bool_t fComputeErrors;         // errors are accumulated
+  };
+
+  TH1 *Book(Int_t nDim, const Int_t *dim, const Int_t *projectionArgs);
+  void FillProjections(const Int_t *coord, const Double_t *content, const Double_t *error2, Long64_t nBins, Int_t first, Int_t step);
+
+  THnSparse *fSparse;                    // projected sparse - not owner
+  THnSparse *fEmpty;                     // empty sparse with the same binning - creates the projection histograms
+  std::vector<Projection> fProjections;  // booked projections
+
+  AliPerformanceSparseProjector(const AliPerformanceSparseProjector&); // not implemented
+  AliPerformanceSparseProjector& operator=(const AliPerformanceSparseProjector&); // not implemented
+};
+
+#endif
@@ -956,6 +956,8 @@ void AliPerformanceTPC::Analyse()
 //
     // Cluster histograms
     //
+    // the projections of each THnSparse are filled with a single pass over its filled bins
+    BeginProjections(fTPCClustHisto);
     AddProjection(aFolderObj, "clust", fTPCClustHisto, 0, 1, 2);
     
 
@@ -967,6 +969,7 @@ void AliPerformanceTPC::Analyse()
         //
         // event histograms
         //
+        BeginProjections(fTPCEventHisto);
         for(Int_t i=0; i<=6; i++) {
           AddProjection(aFolderObj, "event", fTPCEventHisto, i);
         }    
@@ -995,6 +998,7 @@ void AliPerformanceTPC::Analyse()
         // Track histograms 
         // 
         // all with vertex
+        BeginProjections(fTPCTrackHisto);
         fTPCTrackHisto->GetAxis(8)->SetRangeUser(-1.5,1.5);
         fTPCTrackHisto->GetAxis(9)->SetRangeUser(0.5,1.5);
         selString = "all_recVertex";
@@ -1045,6 +1049,7 @@ void AliPerformanceTPC::Analyse()
         //restore cuts
         fTPCTrackHisto->GetAxis(8)->SetRangeUser(-1.5,1.5);
         fTPCTrackHisto->GetAxis(9)->SetRangeUser(-0.5,1.5);
+        EndProjections();
       
         printf("exportToFolder\n");
         // export objects to analysis folder
@@ -1130,7 +1135,31 @@ Long64_t AliPerformanceTPC::Merge(TCollection* list)
 
     count++;
   }
-  if (fFolderObj) { fFolderObj->Merge(objArrayList); } 
+  if (fFolderObj) {
+    // projections-only mode (useSparse=kFALSE): the histograms of all objects are
+    // booked in Init with the same binning, add their bin arrays directly
+    TObjArray genericList;
+    TIter nextFolderObj(objArrayList);
+    TObjArray *folderObj = 0;
+    while ((folderObj = (TObjArray*)nextFolderObj())) {
+      Bool_t sameBinning = !fUseSparse && folderObj->GetEntriesFast() == fFolderObj->GetEntriesFast();
+      for (Int_t i = 0; sameBinning && i < fFolderObj->GetEntriesFast(); i++) {
+        TH1 *h = dynamic_cast<TH1*>(fFolderObj->At(i));
+        TH1 *hEntry = dynamic_cast<TH1*>(folderObj->At(i));
+        sameBinning = h && hEntry && h->IsA() == hEntry->IsA() && !strcmp(h->GetName(), hEntry->GetName())
+          && h->GetNcells() == hEntry->GetNcells()
+          && h->GetXaxis()->GetXmin() == hEntry->GetXaxis()->GetXmin() && h->GetXaxis()->GetXmax() == hEntry->GetXaxis()->GetXmax()
+          && h->GetYaxis()->GetXmin() == hEntry->GetYaxis()->GetXmin() && h->GetYaxis()->GetXmax() == hEntry->GetYaxis()->GetXmax()
+          && h->GetZaxis()->GetXmin() == hEntry->GetZaxis()->GetXmin() && h->GetZaxis()->GetXmax() == hEntry->GetZaxis()->GetXmax();
+      }
+      if (sameBinning) {
+        for (Int_t i = 0; i < fFolderObj->GetEntriesFast(); i++) ((TH1*)fFolderObj->At(i))->Add((TH1*)folderObj->At(i));
+      } else {
+        genericList.Add(folderObj);
+      }
+    }
+    if (!genericList.IsEmpty()) fFolderObj->Merge(&genericList);
+  }
   // to signal that track histos were not merged: reset
   if (!merge) {
       if(fTPCTrackHisto) fTPCTrackHisto->Reset();
@@ -31,6 +31,12 @@ class TRootIOCtor;
 #include "THnSparse.h"
 #include "AliPerformanceObject.h"
 
+//
+// With useSparse=kTRUE (default) the THnSparse are filled and the projections are
+// computed in Analyse(), one pass over the filled bins of each THnSparse (see
+// AliPerformanceObject::SetProjectionThreads). With useSparse=kFALSE only the
+// projections are filled, during the event loop, and merged bin by bin.
+//
 class AliPerformanceTPC : public AliPerformanceObject {
 public :
   AliPerformanceTPC(TRootIOCtor*);